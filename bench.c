@@ -0,0 +1,442 @@
+/*
+    Benchmark harness for dbc_fft.h, see "make bench".
+
+    Unlike the timings in check.c (CPU time, printed alongside the accuracy
+    tests), this measures wall-clock time and emits machine-readable
+    results (CSV or JSON), one record per configuration, to compare builds
+    and catch performance regressions.
+    For every configuration the number of transforms per sample is first
+    calibrated (doubled until a sample takes at least -t seconds), then the
+    code is warmed up for -w seconds, and then -r samples are taken.
+    Reported are the median and 99th percentile (nearest rank) of time per
+    transform, the corresponding CTG (5*N*log2(N)/(median time in ns))
+    and the throughput in bytes/s (N complex values read and written per
+    transform).
+
+    Usage: bench [options]
+        -m LOG2     smallest power-of-2 size (default 4)
+        -M LOG2     largest power-of-2 size (default 20)
+        -n LIST     explicit sizes (comma-separated, any N>=1), replaces -m/-M
+        -p LIST     precisions, of f,d,l (default f,d)
+        -l LIST     layouts, of soa,aos,strided (default soa,aos,strided)
+                    soa is dbc_fft_*c, aos is dbc_fft_*i and strided is
+                    dbc_fft_*s with stride 2 in separate arrays
+        -i LIST     placement, of out,in (default out,in)
+        -P LIST     plans, of none,plan,measure (default none): none is the
+                    functions above, plan executes a plan (dbc_fft_execute_*)
+                    created with DBCF_PLAN_FORWARD, measure one created with
+                    DBCF_PLAN_MEASURE as well (see "Bluestein's algorithm"
+                    in dbc_fft.h: where measure is faster than plan, the cost
+                    model of the inner sizes is off for this machine)
+        -x LIST     SIMD levels, of none,sse2,avx,avx512,native (default
+                    native); levels not supported by the CPU are skipped.
+                    Only available for GCC-compatible compilers on x86/x64.
+        -T N        number of threads (with DBC_FFT_THREADS, default 1)
+        -r N        samples per configuration (default 51)
+        -w SEC      warm-up time per configuration (default 0.02)
+        -t SEC      minimum time per sample (default 0.0005)
+        -a CPU      pin to the given CPU (Linux and Windows only; threads
+                    started by the library inherit the affinity on Linux)
+        -W FILE     wisdom file (see dbc_fft_wisdom_export): the measure
+                    plans of each SIMD level start from the wisdom in FILE
+                    (if it exists, and is for this CPU and level), and the
+                    wisdom of the last level is saved to FILE at the end,
+                    so a run with -P measure makes the wisdom for the
+                    other processes to load
+        -f FORMAT   csv or json (default csv)
+        -o FILE     output file (default stdout)
+*/
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+/* For sched_setaffinity() and clock_gettime(). */
+#define _GNU_SOURCE
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+#if !defined(DBC_FFT_NO_SIMD) && !defined(DBC_FFT_FORCE_SIMD) && !defined(dbcf_detect_simd) && defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+/* SIMD levels are selected by masking the CPU detection. */
+#define BENCH_SIMD_LEVELS
+static int bench_simd_mask=-1;
+static int bench_detect_simd(void);
+#define dbcf_detect_simd() bench_detect_simd()
+#endif
+
+#define DBC_FFT_IMPLEMENTATION
+#include "dbc_fft.h"
+
+#ifdef BENCH_SIMD_LEVELS
+static int bench_cpu_simd(void)
+{
+    static int cached=-1;
+    if(cached==-1)
+    {
+        cached=0;
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("sse2"))    cached|=DBCF_HAS_SIMD4F |DBCF_HAS_SIMD2D;
+        if(__builtin_cpu_supports("avx"))     cached|=DBCF_HAS_SIMD8F |DBCF_HAS_SIMD4D;
+        if(__builtin_cpu_supports("avx512f")) cached|=DBCF_HAS_SIMD16F|DBCF_HAS_SIMD8D;
+    }
+    return cached;
+}
+
+static int bench_detect_simd(void)
+{
+    return bench_cpu_simd()&bench_simd_mask;
+}
+#endif /* BENCH_SIMD_LEVELS */
+
+#define CONCAT1(l,r) l##r
+#define CONCAT(l,r) CONCAT1(l,r)
+#define NAME(name) CONCAT(name,Suffix)
+#define NAME2(l,r) CONCAT(l,CONCAT(Suffix,r))
+#define STRINGIFY1(x) #x
+#define STRINGIFY(x) STRINGIFY1(x)
+#define CAST(Type,value) ((Type)(value))
+
+#define MAX_SIZES 64
+
+enum {LAYOUT_SOA,LAYOUT_AOS,LAYOUT_STRIDED};
+static const char *layout_names[]={"soa","aos","strided"};
+static const char *placement_names[]={"out","in"};
+static const char *plan_names[]={"none","plan","measure"};
+static const char *simd_names[]={"none","sse2","avx","avx512","native",0};
+
+typedef struct Options
+{
+    dbcf_index sizes[MAX_SIZES];
+    int num_sizes;
+    const char *types,*layouts,*placements,*plans,*simd;
+    int threads,reps,cpu,json;
+    double warmup_time,sample_time;
+} Options;
+
+typedef struct Result
+{
+    const char *type,*layout,*placement,*plan,*simd;
+    size_t size;
+    dbcf_index n;
+    int threads,reps;
+    double median,p99,ctg,bytes_per_s;
+} Result;
+
+typedef struct Output
+{
+    FILE *f;
+    int json,count;
+} Output;
+
+static double get_wall_time(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER f,c;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&c);
+    return (double)c.QuadPart/(double)f.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC,&t);
+    return (double)t.tv_sec+1.0e-9*(double)t.tv_nsec;
+#else
+    return (double)clock()/(double)CLOCKS_PER_SEC;
+#endif
+}
+
+static int pin_to_cpu(int cpu)
+{
+#if defined(_WIN32)
+    return SetThreadAffinityMask(GetCurrentThread(),(DWORD_PTR)1<<cpu)!=0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET((size_t)cpu,&set);
+    return sched_setaffinity(0,sizeof(set),&set)==0;
+#else
+    (void)cpu;
+    return 0;
+#endif
+}
+
+/* Check whether a comma-separated list contains the item. */
+static int in_list(const char *list,const char *item)
+{
+    size_t len=strlen(item);
+    while(*list)
+    {
+        size_t k=strcspn(list,",");
+        if(k==len&&!strncmp(list,item,len)) return 1;
+        list+=k;
+        if(*list) ++list;
+    }
+    return 0;
+}
+
+/* Check that every item of the list is one of names[]. */
+static int valid_list(const char *list,const char **names,int count)
+{
+    while(*list)
+    {
+        size_t k=strcspn(list,",");
+        int i,found=0;
+        for(i=0;i<count;++i)
+            if(strlen(names[i])==k&&!strncmp(list,names[i],k)) found=1;
+        if(!found) return 0;
+        list+=k;
+        if(*list) ++list;
+    }
+    return 1;
+}
+
+static int compare_doubles(const void *l,const void *r)
+{
+    double a=*(const double*)l,b=*(const double*)r;
+    return (a>b)-(a<b);
+}
+
+static void summarize(Result *r,double *samples)
+{
+    int p99=(r->reps*99+99)/100-1;
+    double n=(double)r->n;
+    qsort(samples,(size_t)r->reps,sizeof(double),compare_doubles);
+    if(r->reps%2) r->median=samples[r->reps/2];
+    else          r->median=0.5*(samples[r->reps/2-1]+samples[r->reps/2]);
+    r->p99=samples[p99];
+    r->ctg=(n>1.0?5.0*n*log(n)/log(2.0)/r->median:0.0);
+    r->bytes_per_s=2.0*2.0*n*(double)r->size*1.0e+9/r->median;
+}
+
+static void emit(Output *out,const Result *r)
+{
+    if(out->json)
+    {
+        fprintf(out->f,"%s\n  {\"type\": \"%s\", \"n\": %.0f, \"layout\": \"%s\", \"placement\": \"%s\", \"plan\": \"%s\", \"simd\": \"%s\", \"threads\": %d, \"reps\": %d, "
+            "\"median_ns\": %.6g, \"p99_ns\": %.6g, \"ctg\": %.6g, \"bytes_per_s\": %.6g}",
+            (out->count?",":"["),r->type,(double)r->n,r->layout,r->placement,r->plan,r->simd,r->threads,r->reps,r->median,r->p99,r->ctg,r->bytes_per_s);
+    }
+    else
+    {
+        if(!out->count) fprintf(out->f,"type,n,layout,placement,plan,simd,threads,reps,median_ns,p99_ns,ctg,bytes_per_s\n");
+        fprintf(out->f,"%s,%.0f,%s,%s,%s,%s,%d,%d,%.6g,%.6g,%.6g,%.6g\n",
+            r->type,(double)r->n,r->layout,r->placement,r->plan,r->simd,r->threads,r->reps,r->median,r->p99,r->ctg,r->bytes_per_s);
+    }
+    fflush(out->f);
+    ++out->count;
+}
+
+#ifndef DBC_FFT_NO_FLOAT
+#define Type float
+#define Suffix f
+#include "bench.inc"
+#undef Type
+#undef Suffix
+#endif
+
+#ifndef DBC_FFT_NO_DOUBLE
+#define Type double
+#define Suffix d
+#include "bench.inc"
+#undef Type
+#undef Suffix
+#endif
+
+#ifndef DBC_FFT_NO_LONGDOUBLE
+#define Type long double
+#define Suffix l
+#include "bench.inc"
+#undef Type
+#undef Suffix
+#endif
+
+/* Returns the DBCF_HAS_SIMD* mask for the level, or 0 if unsupported. */
+static int simd_level_mask(const char *name,int *mask)
+{
+#ifdef BENCH_SIMD_LEVELS
+    int cpu=bench_cpu_simd();
+    int sse2=DBCF_HAS_SIMD4F|DBCF_HAS_SIMD2D;
+    int avx=sse2|DBCF_HAS_SIMD8F|DBCF_HAS_SIMD4D;
+    int avx512=avx|DBCF_HAS_SIMD16F|DBCF_HAS_SIMD8D;
+    if(!strcmp(name,"none"))   *mask=0;
+    if(!strcmp(name,"sse2"))   *mask=sse2;
+    if(!strcmp(name,"avx"))    *mask=avx;
+    if(!strcmp(name,"avx512")) *mask=avx512;
+    if(!strcmp(name,"native")) *mask=-1;
+    return *mask==-1||(*mask&cpu)==*mask;
+#else
+    *mask=-1;
+    return !strcmp(name,"native");
+#endif
+}
+
+/* The contents of the file (NULL if it can't be read), in a buffer from malloc. */
+static unsigned char *read_file(const char *name,dbcf_index *size)
+{
+    FILE *f=fopen(name,"rb");
+    unsigned char *buf=0;
+    long length;
+    if(!f) return 0;
+    if(fseek(f,0,SEEK_END)==0&&(length=ftell(f))>=0&&fseek(f,0,SEEK_SET)==0&&
+       (buf=(unsigned char*)malloc((size_t)length+1))!=0&&
+       fread(buf,1,(size_t)length,f)!=(size_t)length)
+    {
+        free(buf);
+        buf=0;
+    }
+    if(buf) *size=(dbcf_index)length;
+    fclose(f);
+    return buf;
+}
+
+static int save_wisdom(const char *name)
+{
+    dbcf_index size=dbc_fft_wisdom_export(0,0);
+    unsigned char *buf=(unsigned char*)malloc((size_t)size);
+    FILE *f;
+    int ok=0;
+    if(buf&&dbc_fft_wisdom_export(buf,size)<=size&&(f=fopen(name,"wb"))!=0)
+    {
+        ok=(fwrite(buf,1,(size_t)size,f)==(size_t)size);
+        ok&=(fclose(f)==0);
+    }
+    free(buf);
+    return ok;
+}
+
+static int usage(void)
+{
+    fprintf(stderr,"Usage: bench [-m LOG2] [-M LOG2] [-n LIST] [-p f,d,l] [-l soa,aos,strided] [-i out,in]\n"
+                   "             [-P none,plan,measure] [-x none,sse2,avx,avx512,native] [-T N] [-r N]\n"
+                   "             [-w SEC] [-t SEC] [-a CPU] [-W FILE] [-f csv|json] [-o FILE]\n");
+    return 1;
+}
+
+int main(int argc,char **argv)
+{
+    static const char *type_names[]={"f","d","l"};
+    Options opts;
+    Output out;
+    int i,j,minlog2=4,maxlog2=20,ret=0;
+    const char *sizes=0,*output=0,*wisdom_file=0;
+    unsigned char *wisdom=0;
+    dbcf_index wisdom_size=0;
+    opts.num_sizes=0;
+    opts.types="f,d";
+    opts.layouts="soa,aos,strided";
+    opts.placements="out,in";
+    opts.plans="none";
+    opts.simd="native";
+    opts.threads=1;
+    opts.reps=51;
+    opts.cpu=-1;
+    opts.json=0;
+    opts.warmup_time=0.02;
+    opts.sample_time=0.0005;
+    for(i=1;i<argc;++i)
+    {
+        const char *arg=argv[i];
+        const char *val=(i+1<argc?argv[i+1]:0);
+        if(arg[0]!='-'||!arg[1]||arg[2]||!val) return usage();
+        switch(arg[1])
+        {
+            case 'm': minlog2=atoi(val); break;
+            case 'M': maxlog2=atoi(val); break;
+            case 'n': sizes=val; break;
+            case 'p': opts.types=val; break;
+            case 'l': opts.layouts=val; break;
+            case 'i': opts.placements=val; break;
+            case 'P': opts.plans=val; break;
+            case 'x': opts.simd=val; break;
+            case 'T': opts.threads=atoi(val); break;
+            case 'r': opts.reps=atoi(val); break;
+            case 'w': opts.warmup_time=atof(val); break;
+            case 't': opts.sample_time=atof(val); break;
+            case 'a': opts.cpu=atoi(val); break;
+            case 'f': opts.json=!strcmp(val,"json"); if(!opts.json&&strcmp(val,"csv")) return usage(); break;
+            case 'o': output=val; break;
+            case 'W': wisdom_file=val; break;
+            default: return usage();
+        }
+        ++i;
+    }
+    if(!valid_list(opts.types,type_names,3)||
+       !valid_list(opts.layouts,layout_names,3)||
+       !valid_list(opts.placements,placement_names,2)||
+       !valid_list(opts.plans,plan_names,3)||
+       !valid_list(opts.simd,simd_names,5)||
+       opts.reps<1||opts.threads<1) return usage();
+    if(sizes)
+    {
+        while(*sizes&&opts.num_sizes<MAX_SIZES)
+        {
+            dbcf_index n=(dbcf_index)atof(sizes);
+            if(n<1) return usage();
+            opts.sizes[opts.num_sizes++]=n;
+            sizes+=strcspn(sizes,",");
+            if(*sizes) ++sizes;
+        }
+    }
+    else
+    {
+        if(minlog2<0||maxlog2>30) return usage();
+        for(i=minlog2;i<=maxlog2&&opts.num_sizes<MAX_SIZES;++i)
+            opts.sizes[opts.num_sizes++]=DBCF_POW2(i);
+    }
+    if(opts.cpu>=0&&!pin_to_cpu(opts.cpu))
+        fprintf(stderr,"bench: failed to pin to CPU %d\n",opts.cpu);
+#ifdef DBC_FFT_THREADS
+    dbc_fft_set_threads(opts.threads,0,0,0);
+#else
+    if(opts.threads!=1) fprintf(stderr,"bench: not compiled with DBC_FFT_THREADS, using 1 thread\n");
+    opts.threads=1;
+#endif
+    out.f=(output?fopen(output,"w"):stdout);
+    out.json=opts.json;
+    out.count=0;
+    if(!out.f) {fprintf(stderr,"bench: can't open %s\n",output);return 1;}
+    if(wisdom_file) wisdom=read_file(wisdom_file,&wisdom_size);
+    for(i=0;simd_names[i]&&!ret;++i)
+    {
+        int mask;
+        if(!in_list(opts.simd,simd_names[i])) continue;
+        if(!simd_level_mask(simd_names[i],&mask))
+        {
+            fprintf(stderr,"bench: SIMD level %s is not available, skipped\n",simd_names[i]);
+            continue;
+        }
+#ifdef BENCH_SIMD_LEVELS
+        bench_simd_mask=mask;
+#endif
+        /* The choices of the measure plans are only valid for this level. */
+        dbc_fft_wisdom_forget();
+        if(wisdom&&dbc_fft_wisdom_import(wisdom,wisdom_size)!=0)
+            fprintf(stderr,"bench: %s is not for this CPU or SIMD level %s, ignored\n",wisdom_file,simd_names[i]);
+        for(j=0;j<3&&!ret;++j)
+        {
+            if(!in_list(opts.types,type_names[j])) continue;
+#ifndef DBC_FFT_NO_FLOAT
+            if(j==0) ret=bench_f(&opts,simd_names[i],&out);
+#endif
+#ifndef DBC_FFT_NO_DOUBLE
+            if(j==1) ret=bench_d(&opts,simd_names[i],&out);
+#endif
+#ifndef DBC_FFT_NO_LONGDOUBLE
+            if(j==2) ret=bench_l(&opts,simd_names[i],&out);
+#endif
+        }
+    }
+    if(out.json) fprintf(out.f,"%s]\n",(out.count?"\n":"["));
+    if(output) fclose(out.f);
+    if(wisdom_file&&!ret&&!save_wisdom(wisdom_file))
+    {
+        fprintf(stderr,"bench: can't write %s\n",wisdom_file);
+        ret=1;
+    }
+    free(wisdom);
+    return ret;
+}
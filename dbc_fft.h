@@ -80,25 +80,651 @@ USAGE
                   float *dst_real,      float *dst_imag,
             dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
             float scale);
-    This function can be convenient, if e.g. performing 2D FFT, and
-    want stride to be size of the row.
+    This function can be convenient, if e.g. you want stride to be size of
+    the row (but for 2D FFT, see dbc_fft2d_fc below, which is faster).
     Again, src can be NULL, dst shall not, and src==dst is allowed,
     but other overlap is not. src_*_stride can be 0, but not dst_*_stride.
     The function may be slower than contiguous version, especially for
-    dst strides other than 1 (src strides have less impact).
+    dst strides other than 1 (src strides have less impact). With SIMD,
+    a strided (not interleaved) dst of at least DBCF_STAGE_MIN (default
+    64) elements is therefore handled by computing the transform into
+    a contiguous buffer of 2*num_elements elements (allocated on the heap)
+    and copying it to dst in a single pass, so that the butterflies
+    stay vectorized. This roughly halves the time for large N on the test
+    machine. Sizes that use Bluestein's algorithm (see ALGORITHM) already
+    write dst only once, and are computed directly.
 
     There are also corresponding IFFT versions (dbc_ifft_fc, dbc_ifft_fi,
     dbc_ifft_fs).
 
+    For real input, use
+        int dbc_rfft_fc(
+            dbcf_index num_elements,
+            const float *src,
+                  float *dst_real,      float *dst_imag,
+            float scale);
+    which only computes the num_elements/2+1 (rounded down) first elements
+    of the output (the rest follows from dst[num_elements-k]=conj(dst[k])).
+    For even sizes, this is done via a complex FFT of half the size,
+    making it about 2 times faster than dbc_fft_fc with src_imag==NULL.
+    The inverse is
+        int dbc_irfft_fc(
+            dbcf_index num_elements,
+            const float *src_real,const float *src_imag,
+                  float *dst,
+            float scale);
+    which reads num_elements/2+1 elements of the input, and writes
+    num_elements real outputs. It gives the same result as dbc_ifft_fc
+    with the full (conjugate-symmetric) input, but the imaginary parts
+    of src[0] (and of src[num_elements/2] for even sizes) are ignored.
+    There are also dbc_rfft_fi, dbc_irfft_fi (interleaved complex side),
+    and dbc_rfft_fs, dbc_irfft_fs (strided), with the arguments
+        (num_elements,src,src_stride,dst_real,dst_imag,dst_real_stride,dst_imag_stride,scale)
+        (num_elements,src_real,src_imag,src_real_stride,src_imag_stride,dst,dst_stride,scale)
+    respectively. The same rules for src/dst apply, and, in addition,
+    src==dst is allowed for dbc_rfft_fi and dbc_irfft_fi (in which case
+    the array must hold 2*(num_elements/2+1) elements).
+    Odd sizes are computed via a full complex transform (and, unlike
+    the complex functions, allocate heap memory for it).
+
+    If the same size is transformed repeatedly, the size-dependent setup
+    can be done once, by creating a plan:
+        dbcf_plan *dbc_fft_plan_create_f(dbcf_index num_elements,int flags);
+    where flags is DBCF_PLAN_FORWARD or DBCF_PLAN_INVERSE (selecting the
+    direction of the transform). The plan then can be executed any number
+    of times, by
+        int dbc_fft_execute_fc(
+            dbcf_plan *plan,
+            const float *src_real,const float *src_imag,
+                  float *dst_real,      float *dst_imag,
+            float scale);
+    or by dbc_fft_execute_fi, dbc_fft_execute_fs, which take the same
+    arguments as dbc_fft_fi, dbc_fft_fs (with plan instead of
+    num_elements), and follow the same rules. When no longer needed,
+    the plan is freed by
+        void dbc_fft_plan_destroy(dbcf_plan *plan);
+    (which accepts NULL as well).
+    * dbc_fft_plan_create_f returns NULL on error (negative size, unknown
+    flags, out of memory).
+    * the plan shall only be executed by the functions of the same type
+    it was created for (e.g. dbc_fft_execute_fc for dbc_fft_plan_create_f),
+    otherwise DBCF_ERROR_INVALID_ARGUMENT is returned.
+    * the plan owns its scratch memory, so executing the same plan from
+    several threads simultaneously is not allowed (create a plan per
+    thread instead).
+    For non-power-of-2 sizes the plan owns the work buffer for in-place
+    transforms, and, for sizes with a prime factor above DBCF_MAX_RADIX,
+    precomputes the chirp and the transformed kernel of Bluestein's
+    algorithm, so that execution does not allocate memory, and performs
+    2 inner FFTs instead of 3.
+    Adding DBCF_PLAN_TWIDDLE_TABLE to flags (e.g.
+    DBCF_PLAN_INVERSE|DBCF_PLAN_TWIDDLE_TABLE) makes the plan also store
+    the twiddle factors for all butterfly passes, instead of recomputing
+    them on each execution. This costs 2*num_elements*sizeof(type) bytes
+    (twice the size of the inner FFT for Bluestein's algorithm, or of its
+    power-of-2 part, and of the power-of-2 part for mixed-radix sizes), and is
+    mostly beneficial for sizes too large for the tmp buffer (see
+    DBCF_TMP_BUF_LOG2), and small enough for the table to stay in cache.
+    The results are identical up to roundoff (the table is computed with
+    the same O(log(n)) method).
+    For convolution, correlation, and other uses where the order of the
+    spectrum does not matter (as long as it is undone by the inverse
+    transform), adding DBCF_PLAN_PERMUTED to flags of a power-of-2 plan
+    (including DBCF_PLAN_TWIDDLE_TABLE, whether given or not) skips the
+    bit-reversal permutation: the forward plan writes the spectrum in
+    bit-reversed order, dst[bitreverse(k)]=X[k] (bitreverse of log2(N)
+    bits), and the inverse plan takes src in that order, and writes
+    natural order. So the pair computes the same as the natural-order
+    plans (up to roundoff), with two fewer passes over the data, e.g.
+        dbc_fft_execute_fc(fwd,x_re,x_im,x_re,x_im,1.0f);
+        dbc_fft_execute_fc(fwd,h_re,h_im,h_re,h_im,1.0f);
+        ...multiply x by h, elementwise (complex)...
+        dbc_fft_execute_fc(inv,x_re,x_im,x_re,x_im,1.0f/N);
+    computes the circular convolution of x and h. The forward transform is
+    done by decimation in frequency. It skips
+    the permutation for unit dst strides only (e.g. not for
+    dbc_fft_execute_fi), otherwise the result is permuted after the
+    transform instead. Plans for other sizes, and Q15 (Q31) plans, cannot
+    be created with DBCF_PLAN_PERMUTED. Bluestein's algorithm skips the
+    permutations of its inner transforms the same way, for inner sizes
+    of at least 2^DBCF_DIF_MIN_LOG2 (see dbc_convolve_fc).
+    The SIMD passes use aligned loads and stores where the arrays (and
+    the twiddles) are aligned to the SIMD width, which is up to about 20%
+    faster on the test machine. Buffers aligned to DBCF_ALIGNMENT (64
+    bytes, enough for every SIMD width, AVX-512 included) are returned by
+        void *dbc_fft_alloc(dbcf_index size);
+    (size in bytes, NULL if out of memory; the memory comes from
+    dbcf_malloc), and must be released by
+        void dbc_fft_free(void *p);
+    (not by free). Adding DBCF_PLAN_ALIGNED to flags promises that every
+    array the plan is executed on (src_real, src_imag, dst_real, dst_imag,
+    or src, dst for the interleaved ones) is aligned to DBCF_ALIGNMENT,
+    e.g. comes from dbc_fft_alloc: instead of quietly taking the slower
+    kernels, an execution on misaligned arrays fails with
+    DBCF_ERROR_INVALID_ARGUMENT. The promise is checked once per
+    execution, the choice of the kernels themselves costs a few
+    instructions per pass either way. The twiddle tables of the plans
+    and the internal buffers are always aligned. Q15 (Q31) plans cannot be
+    created with DBCF_PLAN_ALIGNED.
+    For sizes that use Bluestein's algorithm, adding DBCF_PLAN_MEASURE to
+    flags makes the plan choose the inner FFT size (see ALGORITHM) by
+    timing instead of the cost model: the inner FFTs of every candidate
+    size are run a few times at creation (on about 2^14 elements per
+    candidate and run, timed by dbcf_profile_clock, see PROFILING), and
+    the fastest candidate is used. The choice is cached (per type, for up
+    to DBCF_MEASURE_CACHE_SIZE sizes, default 64, shared by all threads),
+    so later plans of the same size take it without timing. The results
+    differ from those without the flag only by roundoff. For other sizes
+    the flag does nothing.
+    The measured choices ("wisdom") can be saved, e.g. by a single tuning
+    run, and loaded by other processes, so that their DBCF_PLAN_MEASURE
+    plans are created without timing (and are the same everywhere):
+        dbcf_index dbc_fft_wisdom_export(void *dst,dbcf_index size);
+    returns the size of the wisdom in bytes, and writes it to dst if it
+    is at most size (otherwise dst is left alone, so a call with size 0
+    gets the size to allocate);
+        int dbc_fft_wisdom_import(const void *src,dbcf_index size);
+    adds the wisdom in src (size bytes, e.g. a file mapped read-only; it
+    is only read, and not referenced afterwards) to the cache, and
+        void dbc_fft_wisdom_forget(void);
+    clears the cache. The wisdom is a flat binary record of the inner
+    size, keyed by the size and the type (float, double, long double;
+    the custom types, see CUSTOM TYPES, are not included), for the CPU
+    signature it was measured on (the SIMD widths detected, see
+    dbcf_detect_simd, and, on x86, the family/model/stepping of CPUID).
+    That is all there is to record: the rest of the plan (the algorithm,
+    the radices, and the SIMD kernels) is determined by the size and the
+    CPU, and the same plan serves every layout. dbc_fft_wisdom_import
+    returns DBCF_ERROR_INVALID_ARGUMENT, and imports nothing, if the
+    wisdom is malformed, or is for a different CPU signature (so it
+    should be measured again there); the entries for the types not
+    compiled in are skipped. Imported entries replace the cached ones
+    for the same size and type, and, like them, do not fit once the
+    cache is full. With DBC_FFT_NO_NPOT the wisdom is always empty.
+    A real window (e.g. Hann, for spectral analysis) can be attached to
+    the plan by
+        int dbc_fft_plan_set_window_f(dbcf_plan *plan,const float *window);
+    after which each execution transforms src[k]*window[k] instead of
+    src[k] (0<=k<num_elements). The multiplication is folded into the
+    first memory pass over the data (the bit-reversal permutation, or the
+    chirp for Bluestein's algorithm), so it is cheaper than windowing the
+    input separately, and works for the in-place transforms as well.
+    The plan only stores the pointer: the window must hold num_elements
+    elements, and stay valid (and unchanged) while it is attached. NULL
+    removes the window. DBCF_ERROR_INVALID_ARGUMENT is returned for the plan
+    of a different type. Similarly, scale is applied to the small
+    (cache-sized) subtransforms as soon as they are complete, rather than
+    in a separate pass at the end (for power-of-2 sizes above 4096 this
+    means before the last butterfly passes, which may change the roundoff
+    slightly).
+
+    Many transforms of the same size can be computed by a single call to
+        int dbc_fft_many_fs(
+            dbcf_index num_elements,
+            dbcf_index howmany,
+            const float *src_real,const float *src_imag,
+            dbcf_index src_stride,dbcf_index src_dist,
+                  float *dst_real,      float *dst_imag,
+            dbcf_index dst_stride,dbcf_index dst_dist,
+            float scale);
+    where the transform j (0<=j<howmany) reads src_*[j*src_dist+k*src_stride]
+    and writes dst_*[j*dst_dist+k*dst_stride]. The same rules for src/dst
+    apply as for dbc_fft_fs (for each of the transforms), in addition,
+    if src_real==dst_real (or src_imag==dst_imag), then src_dist must be
+    equal to dst_dist. The transforms themselves shall not overlap.
+    dbc_fft_many_fc (stride 1, dist num_elements) and dbc_fft_many_fi
+    (interleaved; stride 2, dist 2*num_elements) take
+    (num_elements,howmany) followed by the same arguments as dbc_fft_fc
+    and dbc_fft_fi respectively, and there are dbc_ifft_many_* versions.
+    The size-dependent setup is done once per call, and for small
+    power-of-2 sizes (up to 256 by default, see DBCF_BATCH_BUF_LOG2) with
+    SIMD, the transforms are computed several at once, one per SIMD lane.
+    Larger sizes with strided dst are staged as for dbc_fft_fs, in blocks
+    of up to DBCF_ND_BLOCK transforms (at most DBCF_STAGE_SIZE elements in
+    total, default 2^18, unless a single transform is larger), gathered
+    from src and scattered to dst together. For columns of an array
+    (stride>1, dist 1) this is 3-5 times faster than without staging.
+    On the test machine this is about 2-7 times faster than separate calls
+    for N<=64 (and somewhat faster up to 256). Non-power-of-2 sizes
+    allocate heap memory once per call (like a plan with
+    DBCF_PLAN_TWIDDLE_TABLE).
+
+    For multi-dimensional transforms use
+        int dbc_fft2d_fc(
+            dbcf_index num_rows,dbcf_index num_columns,
+            const float *src_real,const float *src_imag,
+                  float *dst_real,      float *dst_imag,
+            float scale);
+    for a row-major num_rows x num_columns array, or
+        int dbc_fftnd_fc(
+            dbcf_index rank,const dbcf_index *dims,
+            const float *src_real,const float *src_imag,
+                  float *dst_real,      float *dst_imag,
+            float scale);
+    for a row-major dims[0] x ... x dims[rank-1] array (dims[rank-1] being
+    the contiguous dimension). dbc_fft2d_fi and dbc_fftnd_fi take
+    interleaved src, dst instead, and there are dbc_ifft2d_*, dbc_ifftnd_*
+    versions. The same rules for src/dst apply as for dbc_fft_fc.
+    scale is applied once (not per dimension).
+    The rows are transformed as a batch (see dbc_fft_many_fs), and the
+    other dimensions in blocks of DBCF_ND_BLOCK (default 16) adjacent
+    columns, copied to a contiguous buffer and back. This keeps every 1D
+    transform on the contiguous (SIMD) path, and is considerably faster
+    than transforming the columns via dbc_fft_fs with a large stride.
+    Unless rank==1, this allocates heap memory for the column buffer
+    (2*DBCF_ND_BLOCK*max(dims[0..rank-2])*sizeof(type) bytes), and
+    non-power-of-2 dimensions allocate it as dbc_fft_many_fs does.
+
+    If heap allocation is undesirable (e.g. in a real-time thread), every
+    function above, except the plan functions, has a version with _w
+    appended (dbc_fft_fc_w, dbc_rfft_fi_w, dbc_fft_many_fs_w,
+    dbc_ifftnd_fc_w, etc.), that takes 2 extra arguments after scale:
+        void *work,dbcf_index work_size
+    and takes all of its scratch memory from the caller-supplied work
+    buffer of work_size bytes, instead of dbcf_malloc(). The required size
+    is returned by
+        dbcf_index dbc_fft_workspace_size_f(dbcf_index num_elements);
+        dbcf_index dbc_fft2d_workspace_size_f(dbcf_index num_rows,dbcf_index num_columns);
+        dbcf_index dbc_fftnd_workspace_size_f(dbcf_index rank,const dbcf_index *dims);
+    The first one covers all the 1D functions (complex, real, and
+    dbc_fft_many_* with any howmany) of that size and type. The size
+    includes room for the alignment, so work needs no particular
+    alignment, and it may be 0 (in which case work may be NULL, e.g. for
+    power-of-2 1D transforms below DBCF_STAGE_MIN, or without SIMD). The results are identical to the versions
+    without _w. If work_size is smaller than required,
+    DBCF_ERROR_INVALID_ARGUMENT is returned, and nothing is computed.
+    The buffer can be reused for any number of calls, but not by several
+    calls at once. Executing a plan never allocates memory, so there are
+    no _w versions of dbc_fft_execute_*. Note, that with DBC_FFT_THREADS
+    the default threading backend allocates the thread handles on the
+    heap (see THREAD SAFETY), so provide your own spawn() and join() if
+    that matters.
+
+    Linear convolution and correlation are computed by
+        int dbc_convolve_fc(
+            dbcf_index signal_length,
+            const float *signal_real,const float *signal_imag,
+            dbcf_index kernel_length,
+            const float *kernel_real,const float *kernel_imag,
+                  float *dst_real,      float *dst_imag,
+            float scale);
+    and dbc_correlate_fc (same arguments), which write
+    signal_length+kernel_length-1 outputs:
+        dst[j]=scale*sum(kernel[i]*signal[j-i])                (convolve)
+        dst[j]=scale*sum(conj(kernel[i])*signal[i+j-(kernel_length-1)]) (correlate)
+    over all i where the indices are valid, i.e. the "full" output, with the
+    correlation lag of dst[j] being j-(kernel_length-1). dbc_convolve_fi,
+    dbc_correlate_fi take (signal_length,signal,kernel_length,kernel,dst,scale)
+    with interleaved arrays. The inputs are staged (zero-padded) into
+    a heap buffer of 4*M elements (6*M for M>=2^DBCF_DIF_MIN_LOG2, see
+    below), where M is the smallest power of 2 not
+    less than the output length, so dst may overlap them (in particular,
+    dst==signal is allowed, if it has room for the output). NULL
+    signal/kernel parts are treated as zeros. If either length is 0,
+    nothing is written.
+    For long (or unbounded) signals, and a fixed kernel, create a convolver:
+        dbcf_conv *dbc_conv_create_fc(
+            dbcf_index kernel_length,
+            const float *kernel_real,const float *kernel_imag,
+            dbcf_index block_length,
+            int flags);
+    (or dbc_conv_create_fi for interleaved kernel), which precomputes the
+    FFT of the kernel, and the twiddle tables, for the FFT size M (the
+    smallest power of 2 not less than block_length+kernel_length-1).
+    block_length==0 selects M of about 4*kernel_length (at least 64), and
+    the largest block_length for it, returned by
+        dbcf_index dbc_conv_block_length(const dbcf_conv *conv);
+    flags is DBCF_CONV_OVERLAP_ADD (default) or DBCF_CONV_OVERLAP_SAVE,
+    optionally combined with DBCF_CONV_CORRELATE. Then
+        int dbc_conv_execute_fc(
+            dbcf_conv *conv,
+            const float *src_real,const float *src_imag,
+                  float *dst_real,      float *dst_imag,
+            float scale);
+    (or dbc_conv_execute_fi) consumes the next block_length inputs, and
+    writes the next block_length outputs of the convolution of the whole
+    stream so far (as if preceded by zeros), i.e. the outputs are the same
+    as dbc_convolve_fc of the concatenated blocks, up to roundoff. With
+    DBCF_CONV_CORRELATE the outputs are those of dbc_correlate_fc, which
+    amounts to a delay of kernel_length-1 for the zero lag. Each block costs
+    one forward and one inverse FFT of size M and the pointwise product;
+    the overlap is combined while staging the inputs (overlap-save keeps
+    the last kernel_length-1 inputs) or storing the outputs (overlap-add
+    keeps the kernel_length-1 pending outputs), so that no other passes
+    over the data are made. The results of the two only differ in
+    roundoff. For M>=2^DBCF_DIF_MIN_LOG2, both
+    dbc_convolve and the convolver skip the bit-reversal permutations:
+    the forward transforms are done by decimation in frequency, which
+    leaves the spectra in bit-reversed order, the product does not care
+    about the order, and the inverse transform (decimation in time) takes
+    them as they are, and returns the natural order. The convolver does not allocate memory after creation, and
+    src==dst is allowed. To start a new stream, call
+        int dbc_conv_reset_f(dbcf_conv *conv);
+    and free the convolver with
+        void dbc_conv_destroy(dbcf_conv *conv);
+    The same rules as for plans apply: dbc_conv_create_fc returns NULL on
+    error (kernel_length<1, negative block_length, unknown flags, out of
+    memory), the convolver shall only be used by the functions of its
+    type, and not from several threads at once. It takes
+    (8*M+2*kernel_length)*sizeof(type) bytes.
+
+    Spectrograms (short-time Fourier transforms) of long (or unbounded)
+    real signals are computed by the STFT object
+        dbcf_stft *dbc_stft_create_f(
+            dbcf_index fft_size,
+            dbcf_index hop,
+            const float *window,
+            int flags);
+    with flags DBCF_STFT_FORWARD, and fft_size elements of window (copied;
+    NULL for rectangular), 1<=hop<=fft_size. Then
+        int dbc_stft_execute_fc(
+            dbcf_stft *stft,
+            dbcf_index src_length,
+            const float *src,
+                  float *dst_real,float *dst_imag,
+            float scale);
+    consumes the next src_length inputs (any number, NULL for zeros,
+    which may be used to flush the end of the signal), and writes all
+    frames completed by them: the frame j (j=0,1,...) of the whole stream
+    is the dbc_rfft_fc of size fft_size of src[j*hop+k]*window[k],
+    0<=k<fft_size, i.e. fft_size/2+1 elements, and consecutive frames
+    are stored one after another (the first one of the call at dst[0]).
+    The number of frames the call will write is returned by
+        dbcf_index dbc_stft_num_frames(const dbcf_stft *stft,dbcf_index src_length);
+    beforehand. dbc_stft_execute_fi writes interleaved complex elements
+    instead (stft,src_length,src,dst,scale). The object keeps the inputs
+    of the incomplete frames (fewer than fft_size), so every input is read
+    once, and the window is applied while the frame is being gathered.
+    With flags DBCF_STFT_INVERSE the object resynthesizes the signal by
+    overlap-add:
+        int dbc_istft_execute_fc(
+            dbcf_stft *stft,
+            dbcf_index num_frames,
+            const float *src_real,const float *src_imag,
+                  float *dst,
+            float scale);
+    (or dbc_istft_execute_fi with interleaved src) takes num_frames frames
+    of fft_size/2+1 elements in the same layout, computes their
+    dbc_irfft_fc (with scale), multiplies them by the window, adds them up at
+    the offsets j*hop, and writes the next num_frames*hop outputs, which are
+    complete (the remaining fft_size-hop are kept until the next call).
+    ISTFT(STFT(x)) is x up to roundoff, except for the first fft_size-hop
+    outputs, if scale is 1/(fft_size*C) for the forward transform scale 1,
+    where C=sum(window[k+i*hop]^2) over i is the same for all k (e.g.
+    C=0.375*fft_size/hop for the periodic Hann window
+    0.5-0.5*cos(2*pi*k/fft_size), if fft_size is a multiple of hop, at
+    least 3*hop). src and dst shall not overlap. To start a new stream,
+    call
+        int dbc_stft_reset_f(dbcf_stft *stft);
+    and free the object with
+        void dbc_stft_destroy(dbcf_stft *stft);
+    The same rules as for plans apply: dbc_stft_create_f returns NULL on
+    error (fft_size<1, hop outside [1;fft_size], unknown flags, out of
+    memory), the object shall only be used by the functions of its type
+    and direction (DBCF_ERROR_INVALID_ARGUMENT otherwise), and not from
+    several threads at once. It does not allocate memory after creation,
+    and takes 3*fft_size*sizeof(type) bytes, plus the workspace of the
+    (inverse) real transform of size fft_size (see
+    dbc_fft_workspace_size_f).
+
+    Real-to-real transforms (the DCT and the DST of types II, III and IV)
+    are computed by
+        int dbc_dct2_f(
+            dbcf_index num_elements,
+            const float *src,
+                  float *dst,
+            float scale);
+    and dbc_dct3_f, dbc_dct4_f, dbc_dst2_f, dbc_dst3_f, dbc_dst4_f with
+    the same arguments, which compute (for N=num_elements, 0<=k<N, and
+    the sums over 0<=n<N)
+        DCT-II:  dst[k]=sum(src[n]*cos(pi/N*(n+1/2)*k))
+        DCT-III: dst[k]=src[0]/2+sum(src[n]*cos(pi/N*n*(k+1/2))), n>0
+        DCT-IV:  dst[k]=sum(src[n]*cos(pi/N*(n+1/2)*(k+1/2)))
+        DST-II:  dst[k]=sum(src[n]*sin(pi/N*(n+1/2)*(k+1)))
+        DST-III: dst[k]=(-1)^k*src[N-1]/2+sum(src[n]*sin(pi/N*(n+1)*(k+1/2))), n<N-1
+        DST-IV:  dst[k]=sum(src[n]*sin(pi/N*(n+1/2)*(k+1/2)))
+    times scale, so type III with scale 2/N is the inverse of type II,
+    and type IV with scale 2/N is its own inverse. The MDCT of 2*N inputs
+    and its inverse (N inputs, 2*N outputs) are computed by
+        int dbc_mdct_f(dbcf_index num_elements,const float *src,float *dst,float scale);
+        int dbc_imdct_f(dbcf_index num_elements,const float *src,float *dst,float scale);
+    for even num_elements=N (the number of coefficients):
+        MDCT:  dst[k]=sum(src[n]*cos(pi/N*(n+1/2+N/2)*(k+1/2))), 0<=n<2*N
+        IMDCT: dst[n]=sum(src[k]*cos(pi/N*(n+1/2+N/2)*(k+1/2))), 0<=n<2*N
+    The frames of 2*N samples at a hop of N, multiplied by a window w with
+    w[n]^2+w[n+N]^2=1 (e.g. sin(pi/(2*N)*(n+1/2))) before the MDCT, and
+    after the IMDCT with scale 2/N, add up to the original signal
+    (time-domain aliasing cancellation). Batches are computed by
+        int dbc_dct2_many_f(
+            dbcf_index num_elements,
+            dbcf_index howmany,
+            const float *src,
+            dbcf_index src_stride,dbcf_index src_dist,
+                  float *dst,
+            dbcf_index dst_stride,dbcf_index dst_dist,
+            float scale);
+    (dbc_dct3_many_f, ..., dbc_imdct_many_f), where the transform j reads
+    src[j*src_dist+k*src_stride] and writes dst[j*dst_dist+k*dst_stride],
+    as for dbc_fft_many_fs. src==dst is allowed (with the same stride and
+    dist, the transforms themselves shall not overlap) except for the
+    MDCT and the IMDCT, and NULL src means zeros. dbc_mdct_* and
+    dbc_imdct_* with odd num_elements return DBCF_ERROR_INVALID_ARGUMENT.
+    For even N the transforms are computed via complex FFTs of size N/2,
+    for odd N via complex FFTs of size N (types II and III) or 2*N (type
+    IV), which need DBC_FFT_NO_NPOT to be undefined where they are not
+    powers of 2. The twiddles (and, for non-power-of-2 sizes of the FFT,
+    the plan) are computed once per call, and the transforms of a batch
+    are processed in blocks, whose FFTs are computed one per SIMD lane for
+    small sizes, as in dbc_fft_many_fs. E.g. the 2D DCT-II of all 8x8
+    blocks of a row-major W x H image (W, H multiples of 8) is
+        dbc_dct2_many_f(8,W*H/8,image,1,8,image,1,8,1.0f);
+    for the rows, and, for the columns, for each y=0,8,16,...
+        dbc_dct2_many_f(8,W,image+y*W,W,1,image+y*W,W,1,1.0f);
+    On the test machine, for a 512x512 float image, this is about 45
+    times faster than separate calls per row and column, which allocate
+    heap memory and compute the twiddles each time. The _w versions
+    (dbc_dct2_f_w, dbc_dct2_many_f_w, ..., dbc_imdct_many_f_w) take work,
+    work_size as the functions above, of at least
+        dbcf_index dbc_dct_workspace_size_f(dbcf_index num_elements);
+    bytes, which covers all of them (with any howmany) of that size.
+
+    Transforms too large to be addressable (or to fit in memory) can be
+    computed out-of-core, on storage accessed via callbacks:
+        typedef struct dbcf_io
+        {
+            int (*read)(void *user,dbcf_index offset,dbcf_index size,void *buffer);
+            int (*write)(void *user,dbcf_index offset,dbcf_index size,const void *buffer);
+            void *user;
+        } dbcf_io;
+        int dbc_fft_fio(
+            dbcf_index num_elements,
+            const dbcf_io *src,
+            const dbcf_io *dst,
+            float scale);
+    and dbc_ifft_fio (same arguments). The storage holds num_elements
+    interleaved complex numbers (element k at the bytes
+    [2*k*sizeof(type);2*(k+1)*sizeof(type))), and read (write) copies size
+    bytes at the byte offset from (to) the storage to (from) buffer, e.g.
+    via pread (pwrite) on a file, or memcpy on a memory-mapped one. They
+    return 0 on success; anything else aborts the transform with
+    DBCF_ERROR_IO (leaving dst undefined). src is only read, while dst is
+    written and read back (it holds the intermediate result), so src and
+    dst must be different storages (src==dst is
+    DBCF_ERROR_INVALID_ARGUMENT). This is the four-step algorithm:
+    N=N1*N2, where N1 is the largest divisor of N not above sqrt(N), and
+    the transforms of size N2 and N1 run in memory, on blocks of up to B
+    adjacent columns, so that the storage is read twice and written twice,
+    B consecutive elements (or more) per call, instead of the random
+    accesses of the in-memory algorithm. The memory it takes is about
+    2*B*N2*sizeof(type) bytes, with B=DBCF_IO_BLOCK (default 64), and is
+    allocated on the heap; dbc_fft_fio_w, dbc_ifft_fio_w take the 2 extra
+    arguments (void *work,dbcf_index work_size) instead, as the _w
+    functions above, and use the largest B that fits (at least 1), while
+        dbcf_index dbc_fft_io_workspace_size_f(dbcf_index num_elements);
+    returns the size for the default B. Powers of 2 work best; sizes
+    without large enough divisors (e.g. primes) are computed with N2 close
+    to N, i.e. with every element in memory. The results are the same as
+    of dbc_fft_fc up to roundoff. The callbacks are only called from the
+    calling thread.
+
+    The same four-step algorithm can be split between the NUMA nodes of
+    one machine, or between processes (e.g. MPI ranks on different
+    machines), each holding 1/P of the data. With N=n1*n2, where n1 and n2
+    are multiples of P, and x[a+n1*b] viewed as n2 rows of n1 columns,
+    rank r holds the n1/P columns a=r*n1/P+j, 0<=j<n1/P, one after
+    another: x[r*n1/P+j+n1*b] at src[j*n2+b]. The output X[c+n2*k]
+    (n1 rows of n2 columns) is distributed the same way, with n1 and n2
+    swapped: rank r gets the columns c=r*n2/P+t at dst[t*n1+k]. Each rank
+    only computes its own columns (n1/P transforms of size n2, and,
+    after a single exchange, n2/P transforms of size n1, both as by
+    dbc_fft_many_fc, on its own memory), so there is no other traffic
+    between them. The inverse takes the output distribution and gives
+    the input one (i.e. it is called with the same n1, n2), so a forward
+    transform followed by the inverse gives the input back, with no
+    global transposes in between (which is what convolutions need).
+    Between processes, each rank calls
+        int dbc_fft_dist_fc(
+            dbcf_index n1,dbcf_index n2,
+            const dbcf_dist *dist,
+            const float *src_real,const float *src_imag,
+                  float *dst_real,      float *dst_imag,
+            float scale);
+    (and dbc_ifft_dist_fc, same arguments) on its N/P elements in src,
+    dst (src==dst is allowed), where dist holds num_ranks (P), its rank,
+    and the exchange:
+        int alltoall(void *user,const void *send,void *recv,dbcf_index block_size);
+    is called once by every rank with P blocks of block_size bytes in
+    send, and should put the block r of rank s at the block s of recv on
+    rank r (i.e. it is MPI_Alltoall on bytes, with the user pointer for
+    the communicator). It returns 0 on success, anything else fails the
+    transform with DBCF_ERROR_IO, and so should fail it on every rank.
+    The send and recv buffers (N/P complex numbers each, plus the plans
+    for non-power-of-2 n1, n2) are taken from the heap, or from work of
+    dbc_fft_dist_fc_w, dbc_ifft_dist_fc_w (which take the 2 extra
+    arguments) of at least
+        dbcf_index dbc_fft_dist_workspace_size_f(dbcf_index n1,dbcf_index n2,int num_ranks);
+    bytes (0 for invalid arguments). Within one process,
+        int dbc_fft_numa_fc(
+            dbcf_index n1,dbcf_index n2,
+            const dbcf_numa *numa,
+            const float *const *src_real,const float *const *src_imag,
+                  float *const *dst_real,      float *const *dst_imag,
+            float scale);
+    (and dbc_ifft_numa_fc) computes the whole transform, with the data
+    of node r at src_real[r], ..., dst_imag[r] (num_nodes nodes). For
+    each node the work is run as a task by
+        void *spawn(int node,void (*func)(void*),void *arg,void *user);
+    which should start func(arg) on a thread bound to the node (e.g. via
+    numa_run_on_node), and return a handle for join (as in
+    dbc_fft_set_threads; NULL runs it in the calling thread, as do NULL
+    spawn, join). The tasks allocate their buffers themselves, so the
+    memory is first touched (i.e. placed) on their own node. Then each
+    node gets the blocks of the others, starting with the next one
+    (node r from r+1, r+2, ..., as in a ring), so that no node is read
+    by all at once, and the remote memory is only read, once, and only
+    for the exchange. The data arrays should be allocated on their nodes
+    (e.g. by numa_alloc_onnode, or by writing them first from a thread
+    on the node), otherwise this gains nothing. The results are the same
+    as of dbc_fft_fc up to roundoff, e.g. dst[t*n1+k] of rank r is
+    X[r*n2/P+t+n2*k].
+
     These functions also exist in versions for double and long double.
     They have 'd' and 'l' instead of 'f' in their suffixes (e.g.
     dbc_fft_dc, dbc_fft_li).
     Generating code for specific type can be suppressed by defining
     DBC_FFT_NO_FLOAT, DBC_FFT_NO_DOUBLE, DBC_FFT_NO_LONGDOUBLE.
 
+    For data stored in half precision (to halve the memory footprint and
+    bandwidth) there are mixed-precision versions of the complex
+    transforms, which compute in float:
+        int dbc_fft_hc(
+            dbcf_index num_elements,
+            const dbcf_f16 *src_real,const dbcf_f16 *src_imag,
+                  dbcf_f16 *dst_real,      dbcf_f16 *dst_imag,
+            float scale);
+    and dbc_fft_hi (interleaved), dbc_ifft_hc, dbc_ifft_hi, with the same
+    arguments and rules as dbc_fft_fc etc. dbcf_f16 holds the bit pattern
+    of an IEEE binary16 number, so arrays of _Float16 or __fp16 can be
+    passed by a cast. dbc_fft_bc, dbc_fft_bi, dbc_ifft_bc, dbc_ifft_bi take
+    bfloat16 (dbcf_bf16, e.g. __bf16) instead. The input is converted to
+    float while it is copied into a (split) work buffer, and back, with
+    rounding to nearest-even, while the output is copied out, so there are
+    no separate conversion passes, and the interleaved versions are as fast
+    as the split ones. On x86/x64 the binary16 conversions use F16C, if
+    available (see SIMD). The work buffer (2*num_elements*sizeof(float)
+    bytes) is allocated on the heap, or taken from the caller by the _w
+    versions (dbc_fft_hc_w etc.), for which the size is returned by
+        dbcf_index dbc_fft_workspace_size_h(dbcf_index num_elements);
+    The result is that of dbc_fft_fc of the converted input, rounded
+    (values beyond the half-precision range become infinite, so choose the
+    scale accordingly). There are no C++ overloads of these, as dbcf_f16
+    and dbcf_bf16 are the same type.
+
+    For integer-only targets, there is a fixed-point (Q15) transform of
+    interleaved complex int16 (dbcf_q15) data, for power-of-2 sizes:
+        dbcf_plan *dbc_fft_plan_create_q15(dbcf_index num_elements,int flags);
+        int dbc_fft_execute_q15i(
+            dbcf_plan *plan,
+            const dbcf_q15 *src,
+                  dbcf_q15 *dst,
+            int *exponent);
+    The plan (created as above, with DBCF_PLAN_TWIDDLE_TABLE implied, and
+    freed by dbc_fft_plan_destroy) holds the Q15 twiddles, so that the
+    execution uses integer arithmetic only. To use the full range without
+    overflow, the transform uses block floating point: before each
+    butterfly pass, the data is shifted right just enough for the pass not
+    to overflow (judging by the largest magnitude written by the previous
+    pass, so this takes no extra passes over the data), and the total
+    shift is returned in *exponent, i.e. DFT(src) is dst*2^(*exponent)
+    (with scale 1). Inputs well below full scale are first shifted left
+    (exactly, making *exponent negative) to use the whole range, so the
+    signal-to-noise ratio is roughly independent of the input level: about
+    60 dB at N=65536 (more for smaller sizes), for full-scale inputs and
+    +-3 LSB ones alike. Rounding is to nearest (ties up) throughout, and
+    the results are bitwise reproducible: the SIMD butterflies (SSSE3
+    pmulhrsw, or AVX2 for the passes of 8 and more butterflies, on
+    x86/x64, detected at runtime, or NEON vqrdmulh on AArch64) give the
+    same results as the scalar code. src==dst is allowed, src==NULL means
+    zeros.
+    The same for interleaved complex int32 (Q31, dbcf_q31) data:
+        dbcf_plan *dbc_fft_plan_create_q31(dbcf_index num_elements,int flags);
+        int dbc_fft_execute_q31i(
+            dbcf_plan *plan,
+            const dbcf_q31 *src,
+                  dbcf_q31 *dst,
+            int *exponent);
+    with a signal-to-noise ratio of about 155 dB at N=65536. These use
+    the scalar code only (about 8x slower than the SIMD Q15 passes on the
+    test machine). Q15 plans are rejected by dbc_fft_execute_q31i, and
+    vice versa.
+
     For C++ all of the above (3 functions x 3 types) are available as
-    overloads of dbc_fft and dbc_ifft, unless DBC_FFT_NO_CPP_OVERLOADS is
-    defined.
+    overloads of dbc_fft and dbc_ifft (and dbc_rfft, dbc_irfft for real
+    input/output, dbc_fft_many, dbc_ifft_many for batches, dbc_fft2d,
+    dbc_ifft2d, dbc_fftnd, dbc_ifftnd for multi-dimensional arrays,
+    dbc_fft_execute, dbc_fft_plan_set_window for plans, dbc_fft_w, dbc_ifft_w, etc. for the _w
+    versions, dbc_convolve, dbc_correlate, dbc_conv_create,
+    dbc_conv_execute, dbc_stft_create, dbc_stft_execute,
+    dbc_istft_execute, and dbc_dct2, dbc_dct2_many, ..., dbc_imdct_many),
+    unless DBC_FFT_NO_CPP_OVERLOADS is defined.
+    C++11 and later also get a class template for sizes known at compile
+    time:
+        dbc::fft<N,T> f;
+        f.forward(src_real,src_imag,dst_real,dst_imag,scale);
+        f.forward(src,dst,scale); // Interleaved T*, or std::complex<T>*.
+        f.inverse(...);           // The same forms.
+    where scale defaults to 1, and C++20 std::span<std::complex<T>,N> is
+    accepted as well. The rules for src and dst are those of dbc_fft_fc.
+    For powers of 2 up to DBCF_UNROLL_MAX (default 64) the transform is
+    a fully unrolled kernel, with the twiddle factors computed at compile
+    time (so T only needs to be constructible from long double), and the
+    object holds nothing. For the small sizes it is several times faster
+    than dbc_fft, mostly by avoiding the dispatch and the call overhead.
+    Other sizes (float, double and long double only) use a pair of plans,
+    owned by the object (dbc::fft<N,T> f(flags) passes e.g.
+    DBCF_PLAN_TWIDDLE_TABLE to them), so the object cannot be copied, and
+    shall not be used by several threads at once. Defining
+    DBC_FFT_NO_CPP_TEMPLATES removes the template (and #include <complex>).
 
 ACCURACY
     Experimentally, the average error is estimated as:
@@ -113,28 +739,113 @@ PERFORMANCE
     On the test machine (Intel(R) Xeon(R) Platinum 8124M CPU @ 3.00GHz),
     the peak performance of bdc_fft.h is around 14 CTGs for float,
     and around 10 CTGs for double (both around N=4096), with N=128 being about
-    twice slower. Interleaved output is about twice slower than contiguous
-    for larger N in optimized (SIMD) case (not much difference otherwise).
-    Non-power-of-2 case is about 10 times slower than power-of-2 of similar
-    size.
+    twice slower. Interleaved output is within about 30% of contiguous
+    (mostly due to the strided bit-reversal).
+    Sizes with small prime factors (e.g. 3*2^k, 1000, 1920, 4800, see
+    ALGORITHM) are within about 2 times of power-of-2 speed (closer for
+    sizes with large power-of-2 part), interleaved output of those is
+    slower, since the prime factor passes are only SIMDified for contiguous
+    data. Other non-power-of-2 sizes are about 10 times slower than
+    power-of-2 of similar size.
     The benchmark was compiled as C++ using GCC 11.2 with -m64 -march=native -O3
     on Linux. -O2 is slightly (and -O1/-Os significantly) slower. -march=native
     helps somewhat. Observed slowdown if compiled as C in some situations.
+    The timings in check.c are printed alongside the accuracy tests. For
+    tracking performance across builds there is a separate benchmark
+    (bench.c, "make bench"), which reports median/p99 wall-clock time, CTGs
+    and bytes/s as CSV or JSON, for a range of sizes, precisions, layouts
+    and SIMD levels.
+
+PROFILING
+    To find out where the time of a slow transform goes, you can
+#define DBC_FFT_PROFILE
+    before including the implementation (and, for the declarations, in
+    every translation unit that uses the API below). Without it there is
+    no instrumentation at all. With it, the library keeps per-thread
+    counters (in thread-local storage, if the compiler supports it), read
+    and cleared via
+        void dbc_fft_profile_get(dbcf_profile *profile);
+        void dbc_fft_profile_reset(void);
+    dbcf_profile contains, for each stage s (DBCF_PROFILE_BITREVERSAL,
+    _TWIDDLES, _SIMD, _SCALAR, _COPY, _HEAP, _JOIN), the number of times
+    it was entered (calls[s]) and the time spent in it (ticks[s]). The
+    stages are: the bit-reversal permutation, twiddle computation, the
+    SIMD kernels, the scalar butterflies (including the scalar fallback
+    of the power-of-2 passes), copies through the staging buffers
+    (strided or interleaved destinations, see dbc_fft_many), heap
+    allocations and frees of the temporary buffers (e.g. of Bluestein's
+    algorithm, when no workspace is given), and waiting for the helper
+    threads.
+    dbc_fft_profile_stage_name(s) returns a short name for s, or NULL.
+    Stages do not nest inside themselves (e.g. the recursion of the
+    bit-reversal counts once), but may nest inside other stages (e.g. the
+    twiddles of a pass are computed inside it), so the ticks don't add up
+    to the total time. simd[w][v] counts the calls of the SIMD pass
+    kernels of width 2^(w+1) elements, in the variant v: DBCF_PROFILE_UU,
+    _AU, _UA, _AA (twiddles, then data, aligned or unaligned, the suffixes
+    of the kernel names), or DBCF_PROFILE_INTERLEAVED. fallbacks[r] counts
+    the times the SIMD passes were not used for the reason r:
+    DBCF_PROFILE_FALLBACK_STRIDE (data neither contiguous nor
+    interleaved), _NO_SIMD (no SIMD available), _SIZE (the blocks are too
+    small for any SIMD width).
+    The ticks come from
+#define dbcf_profile_clock() ...implementation...
+    which should return double. By default it is the time stamp counter
+    (rdtsc) on x86/x64, the virtual counter (cntvct_el0) on AArch64, and
+    clock() otherwise, so the units depend on the platform. With
+    DBC_FFT_THREADS, the counts made by the helper threads are added to
+    those of the thread that waited for them (when it does), so their
+    ticks can exceed the wall-clock time. Profiling costs a few counter
+    updates and 2 clock reads per stage entry, which is noticeable for
+    small transforms.
 
 THREAD SAFETY
     The library should be thread-safe in a sense that computing 2 distinct
-    FFTs in different threads should cause no problems. WARNING: by default
-    there is a performance penalty on x86 with SIMD enabled, unless the
-    code is compiled as C++11 or newer. You can avoid it by
-#define DBC_FFT_CACHE_CPU_DETECTION
-    which makes the first call to dbc_fft not thread-safe. The first call
-    may be e.g. dbc_fft_fi(0,0,0,0.0f);. Yes, this is lame.
-    There is also
+    FFTs in different threads should cause no problems. The runtime CPU
+    detection is done once, on the first use, and cached in a single
+    atomic int (via __atomic builtins, std::atomic, or C11 stdatomic.h,
+    whichever is available), through which the SIMD kernels are chosen
+    from constant per-type tables. This is thread-safe in C and C++ alike
+    (including the first call), and needs no locks: threads racing on the
+    first call simply repeat the detection. You can
 #define DBC_FFT_DONT_CACHE_CPU_DETECTION
-    to disable it even in C++11.
+    to repeat the detection on every call instead. DBC_FFT_CACHE_CPU_DETECTION
+    is accepted, but no longer needed.
     If you are using custom dbcf_detect_simd(), dbcf_malloc(), dbcf_free()
     you are responsible for their thread safety.
-    The library itself uses no threading internally. 
+    By default the library itself uses no threading internally. If you
+#define DBC_FFT_THREADS
+    before including the implementation, a single large transform may be
+    split between several threads. This is opt-in at runtime as well:
+        void dbc_fft_set_threads(
+            int num_threads,
+            void *(*spawn)(void (*func)(void*),void *arg,void *user),
+            void (*join)(void *task,void *user),
+            void *user);
+    sets the (global) number of threads to use (1, the default, disables
+    threading). spawn() should start func(arg) as a separate task and
+    return a non-NULL handle for it, which is later passed to join()
+    (which should wait for the task and release the handle). If spawn()
+    returns NULL, func(arg) is simply run by the calling thread. The user
+    pointer is passed to both callbacks, so they can e.g. submit tasks to
+    an existing thread pool. If spawn or join is NULL, the default backend
+    is used: std::thread in C++11, Win32 threads or pthreads otherwise
+    (you may need to link with -pthread). With
+#define DBC_FFT_NO_DEFAULT_THREADS
+    there is no default backend (and no dependency on the platform
+    threading headers), and NULL callbacks mean no threading.
+    dbc_fft_set_threads() is not thread-safe itself, and should not be
+    called while any transform is running.
+    Only transforms with at least 2^DBCF_THREADS_MIN_LOG2 (65536 by
+    default) points (or inner transform size, for non-power-of-2 N) are
+    split. What runs in parallel: the two halves of the recursive
+    butterfly (recursively, until threads are exhausted), the blocks of
+    the bit-reversal permutation, and the FFTs of the kernel and of the
+    input in non-power-of-2 case. The final combining passes are serial,
+    so do not expect linear scaling. The results are identical to the
+    single-threaded ones. In batched and multidimensional transforms,
+    each individual transform is split the same way, if it is large
+    enough.
 
 CUSTOM TYPES
     dbc_fft.h uses #include __FILE__ trick to instantiate the FFT code for
@@ -177,17 +888,51 @@ CUSTOM TYPES
     It is recommended to #undef those 4 after #include.
     If you really know what you are doing, you can also provide an optimized
     pass implementation (DBCF_butterfly_multipass_optimized).
+    For accuracy beyond double (e.g. for reference results) in C++,
+#define DBC_FFT_DOUBLE_DOUBLE
+    before the first #include provides dbcf_dd, the double-double type
+    (the unevaluated sum of 2 doubles, hi+lo, with about 32 significant
+    digits, close to __float128's 34), and all the functions for it,
+    with the suffix 'dd' (dbc_fft_ddc, dbc_ifft_ddi, etc.), including
+    its own complex exponent routines, accurate to double-double. It
+    only uses double arithmetic (with FMA, e.g. -mfma, if available), so
+    it is several times faster than the software __float128. On x86/x64
+    the power-of-2 passes have SIMD versions (4 lanes with AVX and FMA,
+    8 with AVX512, detected at runtime as DBCF_HAS_SIMD4D|DBCF_HAS_FMA
+    and DBCF_HAS_SIMD8D), giving the same results as the scalar ones:
+    with AVX512, power-of-2 sizes take about 6-13 times as long as in
+    double (about 20 times less than __float128 for N=2^12..2^16), other
+    sizes, which use the generic scalar radix-3/5/7 and Bluestein
+    passes, 15-30 times. It needs strict IEEE double arithmetic (no
+    -ffast-math or x87 excess precision). Literals like dbcf_dd(0.1)
+    are only accurate to double, dbcf_dd(hi,lo) gives both parts.
 
 MEMORY USAGE
     The heap ("dynamic") memory allocation only happens for non-power-of-2
-    sizes. Memory is allocated/freed via the dbcf_malloc()/dbcf_free() calls,
-    which you can #define to your own implementations. At most 10 times the
-    size of output is allocated. You can
+    sizes (except out-of-place transforms of sizes with small prime factors,
+    see ALGORITHM), plans, multi-dimensional transforms, and convolution
+    (see dbc_convolve_fc; convolvers allocate once, at creation). Memory is allocated/freed via the dbcf_malloc()/dbcf_free() calls,
+    which you can #define to your own implementations, or avoided
+    entirely by the _w versions of the functions (see USAGE), which take
+    the same amount of memory (plus up to 64 bytes of alignment slack per
+    buffer) from the caller. At most 10 times the
+    size of output is allocated (exactly 2 for in-place transforms of sizes
+    with small prime factors, and up to 13 for Bluestein's algorithm with
+    the inner size of at least 2^DBCF_DIF_MIN_LOG2, which also takes the
+    twiddle table, see DBCF_PLAN_PERMUTED). Plans allocate their memory
+    once, at creation (at most 10 times the size of output for
+    non-power-of-2 sizes, 13 with the inner size as above,
+    2 for sizes with small prime factors, and only the plan itself for
+    power-of-2 sizes; DBCF_PLAN_TWIDDLE_TABLE adds up to 8 more for
+    non-power-of-2 sizes, and exactly 2 for power-of-2 sizes, as does
+    DBCF_PLAN_PERMUTED). You can
 #define DBC_FFT_NO_NPOT
     to disable the non-power-of-2 code entirely (the call to fft functions
     with non-power-of-2 size will return DBCF_ERROR_INVALID_ARGUMENT in
     this case).
-    For power-of-2 sizes no heap memory allocation whatsoever occurs.
+    For power-of-2 sizes no heap memory allocation whatsoever occurs (except
+    for the column buffer of multi-dimensional transforms, see dbc_fft2d_fc,
+    and the contiguous buffer for strided dst, see dbc_fft_fs).
     A few modest tables (less than 2KB in total for float+double+long double)
     are statically allocated. They can be disabled by
 #define DBC_FFT_NO_BITREVERSE_TABLE // Saves 512 bytes.
@@ -200,8 +945,34 @@ MEMORY USAGE
 #define DBCF_TMP_BUF_LOG2 value
     The default is 10 (resulting in 1024*sizeof(type) bytes). You can set it
     as low as 2, but that noticeably degrades performance compared
-    to 4 (which itself is somewhat slower than the default). Increasing it
+    to 4 (which itself is somewhat slower than the default; radix-4 passes
+    need at least 4). Increasing it
     may improve the performance slightly for large inputs.
+    dbc_fft_many* additionally use a buffer of the same size on the stack
+    (for the twiddle table), and, with SIMD, a tile of
+#define DBCF_BATCH_BUF_LOG2 value
+    The default is DBCF_TMP_BUF_LOG2+2 (4096*sizeof(type) bytes). Transforms
+    of up to 1/16 of its size are computed one per SIMD lane.
+    The prime factor passes of mixed-radix sizes use 4 buffers of half its
+    size (but at least DBCF_MAX_RADIX elements) for the twiddles. The
+    largest prime factor, handled by mixed-radix algorithm, is set by
+#define DBCF_MAX_RADIX value
+    (default 31; larger values increase the stack usage, and the cost
+    per element of a radix-p pass grows linearly with p).
+    The staging of strided dst (see dbc_fft_fs) is controlled by
+#define DBCF_STAGE_MIN value
+#define DBCF_STAGE_SIZE value
+    (the smallest staged size, default 64, and the elements staged at once
+    by dbc_fft_many_fs, default 2^18; its heap buffer takes up to
+    2*(DBCF_STAGE_SIZE+16*DBCF_ND_BLOCK)*sizeof(type) bytes).
+    The smallest convolution FFT size, which skips the bit-reversal
+    permutations (see dbc_convolve_fc), is 2^DBCF_DIF_MIN_LOG2, set by
+#define DBCF_DIF_MIN_LOG2 value
+    (default 16).
+    The largest size dbc::fft (see the C++ overloads) unrolls is set by
+#define DBCF_UNROLL_MAX value
+    (default 64; a call inlines about N*log2(N) operations, and takes
+    about 4*N elements of stack).
     Also, a small amount of space (O(log(N))) on stack is used for recursion.
     Since dbc_fft can work inplace, the separate destination buffer might
     not be neccessary.
@@ -215,15 +986,47 @@ SIMD
     By default, dbc_fft.h tries to use SIMD where available. On x86/x64 it
     tries to automatically detect it at runtime. On other platforms SIMD is
     only available for GCC-style compilers (GCC, clang, ICC), and needs to
-    be explicitly enabled at compile-time (no runtime detection is performed)
+    be explicitly enabled at compile-time (no runtime detection is performed,
+    except for the fixed-length SVE and RVV options below)
     for all desired type/width combinations, e.g.:
 #define DBC_FFT_IMPLEMENTATION
 #define DBC_FFT_FORCE_SIMD (DBCF_HAS_SIMD4F|DBCF_HAS_SIMD2D)
 #inlcude "dbc_fft.h"
     For ARM NEON (if detected at compile time) the dbc_fft.h does this
     internally (with exactly DBCF_HAS_SIMD4F|DBCF_HAS_SIMD2D).
+    On AArch64 Linux, the wider kernels can be compiled as SVE for one
+    fixed vector length, by
+#define DBC_FFT_SVE_FIXED_BITS 256 // Or 512.
+    and compiling with -msve-vector-bits=256 (resp. 512), without
+    enabling SVE globally (it is enabled just for these kernels). These
+    are not vector-length-agnostic kernels: -msve-vector-bits makes the
+    compiler assume that exact length, so the SVE kernels are only used
+    where the vector length (getauxval(AT_HWCAP), PR_SVE_GET_VL) is
+    exactly DBC_FFT_SVE_FIXED_BITS, e.g. a 256-bit build on Graviton3, a
+    512-bit one on A64FX. Everywhere else, including 128-bit SVE (e.g.
+    Graviton4) and the other wide length, the same binary falls back to
+    NEON.
+    Similarly, on RISC-V Linux
+#define DBC_FFT_RVV_FIXED_BITS 256 // Or 128, 512.
+    compiles all the kernels with the V extension enabled (again, just
+    for them), for that one fixed VLEN: compile with -mrvv-vector-bits=zvl
+    and the matching Zvl*b extension in -march (e.g.
+    -march=rv64gcv_zvl256b), so that the GCC vector extensions give
+    vector instructions. The kernels up to VLEN (128-bit ones for
+    VLEN=128, and also 256-bit for VLEN=256, 512-bit for VLEN=512) are
+    only used if AT_HWCAP reports V and VLEN (vlenb) is exactly
+    DBC_FFT_RVV_FIXED_BITS; otherwise the transforms are scalar.
+    Neither option selects the vector length at runtime: a binary that
+    should use the vectors of several machines needs one build per
+    length.
+    Both need reasonably recent compilers (target("+sve") or
+    target("arch=+v") function attributes).
     Supported flags are DBCF_HAS_SIMD{4|8|16}F for float and
-    DBCF_HAS_SIMD{2|4|8}D for double. You may also need to specify
+    DBCF_HAS_SIMD{2|4|8}D for double (and DBCF_HAS_F16C, DBCF_HAS_SSSE3,
+    DBCF_HAS_AVX2, DBCF_HAS_FMA on x86/x64 for the half-precision
+    conversions, see dbc_fft_hc, the Q15 transforms, see
+    dbc_fft_plan_create_q15, and double-double, see
+    DBC_FFT_DOUBLE_DOUBLE). You may also need to specify
     the complier options to actually enable the instructions in question.
     This can also be used on x86/x64 and/or NEON to override the default
     detection (you get exactly what you requested, and no runtime detection
@@ -234,7 +1037,8 @@ SIMD
     a bitmask of DBCF_HAS_SIMD* flags. It gets called several times per FFT,
     so you may want to cache the result.
     WARNING: Using dbcf_detect_simd to get the runtime SIMD detection
-    on non-x86 platform (with GCC-style compiler) is NOT GUARANTEED TO WORK.
+    on non-x86 platform (with GCC-style compiler), other than the
+    fixed-length SVE and RVV setups above, is NOT GUARANTEED TO WORK.
     If you want to try anyway, you probably need to provide the appropriate
     ABI declarations for all relevant type/width combinations, along
     the lines of:
@@ -273,7 +1077,7 @@ https://github.com/nothings/stb/issues/81
 
 ALGORITHM
     The implementation details are documented below.
-    For power-of-2 sizes a simple radix-2 decimation-in-time Cooley–Tukey FFT
+    For power-of-2 sizes a radix-4 decimation-in-time Cooley–Tukey FFT
     algorithm ( https://en.wikipedia.org/wiki/Cooley%E2%80%93Tukey_FFT_algorithm )
     is used. The FFT function performs an explicit bit-reversal, followed by
     the butterflies. The bit-reversal is the only step that touches src.
@@ -287,10 +1091,17 @@ ALGORITHM
     The butterflies are done either as a number of passes over the entire input,
     or recursively on two halves, followed by a single butterfly pass (for larger
     inputs), to improve locality. The bottom passes are combined into
-    hand-written FFT8.
-    Interleaved dst is temporarily deinterleaved to make better use of SIMD
-    (only when SIMD is enabled). The (de)interleave is simply bit-reversal
-    permutation on the array and its halves.
+    hand-written FFT8, and the rest are done in pairs, as radix-4 passes
+    (3 complex multiplications per 4 elements instead of 4, and half as many
+    sweeps over the data); when the number of passes is odd a single
+    radix-2 pass remains. The radix-4 passes take the twiddles W^j, W^{2j}
+    (from the table, or computed in chunks: the first chunk as above, the
+    subsequent ones multiplied by W^{j0}, computed in the same way), and
+    W^{3j}=W^j*W^{2j}.
+    With SIMD, interleaved dst is processed by separate versions of the
+    SIMD kernels, which (de)interleave the complex numbers in registers
+    with shuffles, so the arithmetic (and the twiddles) is the same as for
+    the contiguous case.
     All twiddle factors are calculated from O(log(N)) values W^{2^k} (where
     W is the twiddle for the smallest angle), computed by complex exponent
     routines (which simply use precomputed tables or Taylor series), ensuring
@@ -301,8 +1112,34 @@ ALGORITHM
     which is then supplied to the butterfly passes. If the buffer is too
     small, the function recurses, and additional multipliers are supplied on top
     of buffer (so, roughly, twiddle[i]=multiplier*buffer[i%BUFFER_SIZE]).
-    For all non-power-of-2 sizes Bluestein's algorithm is used, even though
-    for some sizes different algorithms may be significantly more efficient.
+    Sizes N=2^a*p1*...*pk, where all the primes pi are at most DBCF_MAX_RADIX
+    (31 by default), are computed by the mixed-radix decimation-in-time
+    Cooley–Tukey algorithm. The odd prime factors are split off outermost
+    (smallest first), and the power-of-2 transforms of size 2^a of the
+    decimated (strided) subsequences of src are computed as above directly
+    into dst, followed by a pass per odd prime factor over the entire output.
+    A pass of radix p does size-p DFTs, with the sums and differences of
+    the symmetric inputs x[q]+-x[p-q], which about halves the
+    multiplications; radix-3/5/7 have separate compile-time-specialized
+    versions, and all of them are SIMDified over the consecutive butterflies.
+    The pass twiddles are computed by the same O(log(N)) method, in blocks
+    (see DBCF_TMP_BUF_LOG2). In-place transforms are computed into
+    a temporary buffer, which is then copied to dst.
+    For all other non-power-of-2 sizes Bluestein's algorithm is used. Its
+    inner (circular convolution) size is the cheapest of the smallest
+    2^k, 3*2^k, 5*2^k, 9*2^k, 15*2^k of at least 2*N-1 (other than 2^k, up
+    to 3*N), the non-power-of-2 ones computed by the mixed-radix
+    algorithm, so that e.g. N=32771 takes 73728 instead of 131072 (about
+    2.4 times faster for float). The cost of the size M=s*2^k is
+    M*(4*k+DBCF_NPOT_COST3*(factors of 3 in s)+DBCF_NPOT_COST5*(factors
+    of 5 in s)+DBCF_NPOT_COST0), i.e. the time per element in quarters of
+    a radix-2 pass, the last term being the chirp and the product. The
+    defaults (24, 36 and 4) were fitted to the execution times of the
+    plans with each candidate on the test machine, within about 5% (float)
+    and 1% (double) on average of the best candidate. To check them on
+    another machine, compare "bench -P plan,measure" (see bench.c) for the
+    sizes of interest: where measure is consistently faster, the
+    constants need adjusting (or the plans need DBCF_PLAN_MEASURE).
 
 LICENSE
     This software is dual-licensed to the public domain and under the following
@@ -315,6 +1152,8 @@ LICENSE
 #ifndef DBC_FFT_H
 #define DBC_FFT_H
 
+#include <limits.h>
+
 #ifndef dbcf_index
 #include <stddef.h>
 typedef ptrdiff_t dbcf_index;
@@ -328,6 +1167,18 @@ typedef ptrdiff_t dbcf_index;
 
 #define DBCF_ERROR_INVALID_ARGUMENT (-1)
 #define DBCF_ERROR_OUT_OF_MEMORY    (-2)
+#define DBCF_ERROR_IO               (-3)
+
+/* Plan flags. */
+#define DBCF_PLAN_FORWARD        0
+#define DBCF_PLAN_INVERSE        1
+#define DBCF_PLAN_TWIDDLE_TABLE  2
+#define DBCF_PLAN_PERMUTED       4
+#define DBCF_PLAN_ALIGNED        8
+#define DBCF_PLAN_MEASURE       16
+
+/* Alignment (in bytes) of dbc_fft_alloc, enough for all SIMD kernels. */
+#define DBCF_ALIGNMENT 64
 
 #define DBCF_CONCAT1(x,y) x##y
 #define DBCF_CONCAT(x,y) DBCF_CONCAT1(x,y)
@@ -335,6 +1186,321 @@ typedef ptrdiff_t dbcf_index;
 #define DBCF_NAME2(nameL,nameR) DBCF_CONCAT(nameL,DBCF_CONCAT(_,DBCF_CONCAT(DBCF_Id,nameR)))
 #define DBCF_NAME(name) DBCF_CONCAT(name,DBCF_CONCAT(_,DBCF_Id))/*DBCF_NAME2(name,)*/
 
+/* Opaque plan type, shared by all types. */
+typedef struct dbcf_plan dbcf_plan;
+
+/* Convolver flags. */
+#define DBCF_CONV_OVERLAP_ADD    0
+#define DBCF_CONV_OVERLAP_SAVE   1
+#define DBCF_CONV_CORRELATE      2
+
+/* Opaque convolver type (see dbc_conv_create_fc), shared by all types. */
+typedef struct dbcf_conv dbcf_conv;
+
+/* STFT flags. */
+#define DBCF_STFT_FORWARD        0
+#define DBCF_STFT_INVERSE        1
+
+/* Opaque STFT type (see dbc_stft_create_f), shared by all types. */
+typedef struct dbcf_stft dbcf_stft;
+
+/*
+    Storage of the out-of-core transforms (see dbc_fft_fio): offset and
+    size are in bytes, the callbacks return 0 on success.
+*/
+typedef struct dbcf_io
+{
+    int (*read)(void *user,dbcf_index offset,dbcf_index size,void *buffer);
+    int (*write)(void *user,dbcf_index offset,dbcf_index size,const void *buffer);
+    void *user;
+} dbcf_io;
+
+/*
+    Participants of the distributed transforms (see dbc_fft_dist_fc):
+    this rank of num_ranks, and the exchange, which returns 0 on success.
+*/
+typedef struct dbcf_dist
+{
+    int num_ranks;
+    int rank;
+    int (*alltoall)(void *user,const void *send,void *recv,dbcf_index block_size);
+    void *user;
+} dbcf_dist;
+
+/* NUMA nodes of the NUMA-aware transforms (see dbc_fft_numa_fc). */
+typedef struct dbcf_numa
+{
+    int num_nodes;
+    void *(*spawn)(int node,void (*func)(void*),void *arg,void *user);
+    void (*join)(void *task,void *user);
+    void *user;
+} dbcf_numa;
+
+/*
+    Storage of the mixed-precision transforms (see dbc_fft_hc): the bit
+    patterns of IEEE binary16 (_Float16, __fp16) and bfloat16 (__bf16)
+    numbers respectively.
+*/
+typedef unsigned short dbcf_f16;
+typedef unsigned short dbcf_bf16;
+
+/* Sample of the Q15 transforms (see dbc_fft_plan_create_q15). */
+typedef short dbcf_q15;
+
+/* Sample of the Q31 transforms (see dbc_fft_plan_create_q31), 32 bits. */
+#if INT_MAX>=2147483647
+typedef int dbcf_q31;
+#else
+typedef long dbcf_q31;
+#endif
+
+#ifdef DBC_FFT_PROFILE
+/* Profiled stages (see dbc_fft_profile_get). */
+#define DBCF_PROFILE_BITREVERSAL 0
+#define DBCF_PROFILE_TWIDDLES    1
+#define DBCF_PROFILE_SIMD        2
+#define DBCF_PROFILE_SCALAR      3
+#define DBCF_PROFILE_COPY        4
+#define DBCF_PROFILE_HEAP        5
+#define DBCF_PROFILE_JOIN        6
+#define DBCF_PROFILE_STAGES      7
+
+/* SIMD kernel variants: alignment of the twiddles and of the data, or interleaved. */
+#define DBCF_PROFILE_UU          0
+#define DBCF_PROFILE_AU          1
+#define DBCF_PROFILE_UA          2
+#define DBCF_PROFILE_AA          3
+#define DBCF_PROFILE_INTERLEAVED 4
+#define DBCF_PROFILE_VARIANTS    5
+
+/* Reasons for power-of-2 passes to fall back to the scalar code. */
+#define DBCF_PROFILE_FALLBACK_STRIDE  0
+#define DBCF_PROFILE_FALLBACK_NO_SIMD 1
+#define DBCF_PROFILE_FALLBACK_SIZE    2
+#define DBCF_PROFILE_FALLBACKS        3
+
+/*
+    Per-thread counters. Counts are whole numbers, kept in doubles
+    to stay exact well past 2^32 without requiring long long.
+*/
+typedef struct dbcf_profile
+{
+    double calls[DBCF_PROFILE_STAGES];
+    double ticks[DBCF_PROFILE_STAGES];
+    double simd[4][DBCF_PROFILE_VARIANTS]; /* [log2(width)-1][variant]. */
+    double fallbacks[DBCF_PROFILE_FALLBACKS];
+} dbcf_profile;
+#endif /* DBC_FFT_PROFILE */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+DBCF_DEF void dbc_fft_plan_destroy(dbcf_plan *plan);
+DBCF_DEF void *dbc_fft_alloc(dbcf_index size);
+DBCF_DEF void dbc_fft_free(void *p);
+DBCF_DEF void dbc_conv_destroy(dbcf_conv *conv);
+DBCF_DEF dbcf_index dbc_conv_block_length(const dbcf_conv *conv);
+DBCF_DEF void dbc_stft_destroy(dbcf_stft *stft);
+DBCF_DEF dbcf_index dbc_stft_num_frames(const dbcf_stft *stft,dbcf_index src_length);
+DBCF_DEF dbcf_plan *dbc_fft_plan_create_q15(dbcf_index num_elements,int flags);
+DBCF_DEF int dbc_fft_execute_q15i(dbcf_plan *plan,const dbcf_q15 *src,dbcf_q15 *dst,int *exponent);
+DBCF_DEF dbcf_plan *dbc_fft_plan_create_q31(dbcf_index num_elements,int flags);
+DBCF_DEF int dbc_fft_execute_q31i(dbcf_plan *plan,const dbcf_q31 *src,dbcf_q31 *dst,int *exponent);
+
+#ifndef DBC_FFT_NO_FLOAT
+/* Half-precision storage, float arithmetic (see dbc_fft_hc). */
+DBCF_DEF dbcf_index dbc_fft_workspace_size_h(dbcf_index num_elements);
+DBCF_DEF int dbc_fft_hc(
+    dbcf_index num_elements,
+    const dbcf_f16 *src_real,const dbcf_f16 *src_imag,
+          dbcf_f16 *dst_real,      dbcf_f16 *dst_imag,
+    float scale);
+DBCF_DEF int dbc_fft_hc_w(
+    dbcf_index num_elements,
+    const dbcf_f16 *src_real,const dbcf_f16 *src_imag,
+          dbcf_f16 *dst_real,      dbcf_f16 *dst_imag,
+    float scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_fft_hi(
+    dbcf_index num_elements,
+    const dbcf_f16 *src,
+          dbcf_f16 *dst,
+    float scale);
+DBCF_DEF int dbc_fft_hi_w(
+    dbcf_index num_elements,
+    const dbcf_f16 *src,
+          dbcf_f16 *dst,
+    float scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_ifft_hc(
+    dbcf_index num_elements,
+    const dbcf_f16 *src_real,const dbcf_f16 *src_imag,
+          dbcf_f16 *dst_real,      dbcf_f16 *dst_imag,
+    float scale);
+DBCF_DEF int dbc_ifft_hc_w(
+    dbcf_index num_elements,
+    const dbcf_f16 *src_real,const dbcf_f16 *src_imag,
+          dbcf_f16 *dst_real,      dbcf_f16 *dst_imag,
+    float scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_ifft_hi(
+    dbcf_index num_elements,
+    const dbcf_f16 *src,
+          dbcf_f16 *dst,
+    float scale);
+DBCF_DEF int dbc_ifft_hi_w(
+    dbcf_index num_elements,
+    const dbcf_f16 *src,
+          dbcf_f16 *dst,
+    float scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_fft_bc(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src_real,const dbcf_bf16 *src_imag,
+          dbcf_bf16 *dst_real,      dbcf_bf16 *dst_imag,
+    float scale);
+DBCF_DEF int dbc_fft_bc_w(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src_real,const dbcf_bf16 *src_imag,
+          dbcf_bf16 *dst_real,      dbcf_bf16 *dst_imag,
+    float scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_fft_bi(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src,
+          dbcf_bf16 *dst,
+    float scale);
+DBCF_DEF int dbc_fft_bi_w(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src,
+          dbcf_bf16 *dst,
+    float scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_ifft_bc(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src_real,const dbcf_bf16 *src_imag,
+          dbcf_bf16 *dst_real,      dbcf_bf16 *dst_imag,
+    float scale);
+DBCF_DEF int dbc_ifft_bc_w(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src_real,const dbcf_bf16 *src_imag,
+          dbcf_bf16 *dst_real,      dbcf_bf16 *dst_imag,
+    float scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_ifft_bi(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src,
+          dbcf_bf16 *dst,
+    float scale);
+DBCF_DEF int dbc_ifft_bi_w(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src,
+          dbcf_bf16 *dst,
+    float scale,
+    void *work,dbcf_index work_size);
+#endif /* DBC_FFT_NO_FLOAT */
+#ifdef DBC_FFT_THREADS
+DBCF_DEF void dbc_fft_set_threads(
+    int num_threads,
+    void *(*spawn)(void (*func)(void*),void *arg,void *user),
+    void (*join)(void *task,void *user),
+    void *user);
+#endif
+DBCF_DEF dbcf_index dbc_fft_wisdom_export(void *dst,dbcf_index size);
+DBCF_DEF int dbc_fft_wisdom_import(const void *src,dbcf_index size);
+DBCF_DEF void dbc_fft_wisdom_forget(void);
+#ifdef DBC_FFT_PROFILE
+DBCF_DEF void dbc_fft_profile_get(dbcf_profile *profile);
+DBCF_DEF void dbc_fft_profile_reset(void);
+DBCF_DEF const char *dbc_fft_profile_stage_name(int stage);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#if defined(__cplusplus) && defined(DBC_FFT_DOUBLE_DOUBLE)
+/*
+    Double-double: the unevaluated sum hi+lo of 2 doubles, with
+    |lo|<=ULP(hi)/2, i.e. 106 bits of mantissa (but the exponent range
+    of double). Built from the error-free transforms: two_sum (a+b=s+e
+    exactly, 6 additions) and two_prod (a*b=p+e exactly, 1 FMA, or
+    Dekker's 17 operations without it). These need IEEE double
+    arithmetic, rounding to nearest, and no excess precision (e.g. no
+    x87 without -mfpmath=sse) or value-changing optimizations (e.g. no
+    -ffast-math).
+*/
+struct dbcf_dd
+{
+    double hi,lo;
+#if __cplusplus>=201103L
+    dbcf_dd()=default; /* Trivial, e.g. for unions. */
+#else
+    dbcf_dd() {}
+#endif
+    dbcf_dd(double x):hi(x),lo(0.0) {}
+    dbcf_dd(double h,double l):hi(h),lo(l) {}
+
+    static inline dbcf_dd two_sum(double a,double b)
+    {
+        double s=a+b,v=s-a;
+        return dbcf_dd(s,(a-(s-v))+(b-v));
+    }
+    /* Only for |a|>=|b| (or a==0). */
+    static inline dbcf_dd quick_two_sum(double a,double b)
+    {
+        double s=a+b;
+        return dbcf_dd(s,b-(s-a));
+    }
+    static inline dbcf_dd two_prod(double a,double b)
+    {
+        double p=a*b;
+#if defined(__GNUC__) && (defined(__FMA__) || defined(__FMA4__))
+        return dbcf_dd(p,__builtin_fma(a,b,-p));
+#else
+        /* Dekker's product: split into 26-bit halves, whose products are exact. */
+        const double split=134217729.0; /* 2^27+1. */
+        double t=split*a,ah=t-(t-a),al=a-ah;
+        double u=split*b,bh=u-(u-b),bl=b-bh;
+        return dbcf_dd(p,((ah*bh-p)+ah*bl+al*bh)+al*bl);
+#endif
+    }
+
+    friend inline dbcf_dd operator+(const dbcf_dd &l,const dbcf_dd &r)
+    {
+        dbcf_dd s=two_sum(l.hi,r.hi),t=two_sum(l.lo,r.lo);
+        s=quick_two_sum(s.hi,s.lo+t.hi);
+        return quick_two_sum(s.hi,s.lo+t.lo);
+    }
+    friend inline dbcf_dd operator-(const dbcf_dd &src) {return dbcf_dd(-src.hi,-src.lo);}
+    friend inline dbcf_dd operator-(const dbcf_dd &l,const dbcf_dd &r) {return l+(-r);}
+    friend inline dbcf_dd operator*(const dbcf_dd &l,const dbcf_dd &r)
+    {
+        dbcf_dd p=two_prod(l.hi,r.hi);
+#if defined(__GNUC__) && (defined(__FMA__) || defined(__FMA4__))
+        /* fma(x,y,+0) rounds like x*y, but is not contracted (like in the SIMD passes). */
+        double c=__builtin_fma(l.hi,r.lo,0.0)+__builtin_fma(l.lo,r.hi,0.0);
+#else
+        double c=l.hi*r.lo+l.lo*r.hi;
+#endif
+        return quick_two_sum(p.hi,p.lo+c);
+    }
+    friend inline dbcf_dd operator/(const dbcf_dd &l,const dbcf_dd &r)
+    {
+        /* 3 steps of long division. */
+        double q1=l.hi/r.hi,q2,q3;
+        dbcf_dd t=l-r*dbcf_dd(q1);
+        q2=t.hi/r.hi;
+        t=t-r*dbcf_dd(q2);
+        q3=t.hi/r.hi;
+        return quick_two_sum(q1,q2)+dbcf_dd(q3);
+    }
+    friend inline bool operator==(const dbcf_dd &l,const dbcf_dd &r) {return l.hi==r.hi&&l.lo==r.lo;}
+    friend inline bool operator!=(const dbcf_dd &l,const dbcf_dd &r) {return !(l==r);}
+};
+#endif /* defined(__cplusplus) && defined(DBC_FFT_DOUBLE_DOUBLE) */
+
 /* Declarations */
 #define DBC_FFT_DECLARATION
 
@@ -368,776 +1534,3213 @@ typedef ptrdiff_t dbcf_index;
 
 #endif /* DBC_FFT_NO_LONGDOUBLE */
 
-#undef DBC_FFT_DECLARATION
+#if defined(__cplusplus) && defined(DBC_FFT_DOUBLE_DOUBLE)
 
-#endif /* DBC_FFT_H */
+#define DBCF_Type dbcf_dd
+#define DBCF_Id dd
+    #include __FILE__
+#undef DBCF_Type
+#undef DBCF_Id
 
-/*============================================================================*/
-/* Declaration section */
-#ifdef DBC_FFT_DECLARATION
+#endif /* defined(__cplusplus) && defined(DBC_FFT_DOUBLE_DOUBLE) */
 
-#ifdef __cplusplus
-extern "C" {
-#endif
+#undef DBC_FFT_DECLARATION
 
-DBCF_DEF int DBCF_NAME2(dbc_fft,c)(
-    dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
-    DBCF_Type scale);
+/*============================================================================*/
+/* C++ templates for fixed sizes. */
+#if defined(__cplusplus) && (__cplusplus>=201103L) && !defined(DBC_FFT_NO_CPP_TEMPLATES)
+
+#include <complex>
+#if (__cplusplus>=202002L) && defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#define DBCF_HAS_SPAN
+#endif
+#endif
 
-DBCF_DEF int DBCF_NAME2(dbc_ifft,c)(
-    dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
-    DBCF_Type scale);
+#ifndef DBCF_UNROLL_MAX
+#define DBCF_UNROLL_MAX 64
+#endif
 
-DBCF_DEF int DBCF_NAME2(dbc_fft,i)(
-    dbcf_index num_elements,
-    const DBCF_Type *src,
-          DBCF_Type *dst,
-    DBCF_Type scale);
+/* The kernels only pay off if inlined all the way down. */
+#if defined(__GNUC__)
+#define DBCF_CPP_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define DBCF_CPP_INLINE __forceinline
+#else
+#define DBCF_CPP_INLINE inline
+#endif
 
-DBCF_DEF int DBCF_NAME2(dbc_ifft,i)(
-    dbcf_index num_elements,
-    const DBCF_Type *src,
-          DBCF_Type *dst,
-    DBCF_Type scale);
+namespace dbc {
+namespace detail {
 
-DBCF_DEF int DBCF_NAME2(dbc_fft,s)(
-    dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-    dbcf_index src_real_stride,dbcf_index src_imag_stride,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
-    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
-    DBCF_Type scale);
+/* Compile-time sin and cos (Taylor series, for |x|<=pi/4). */
+constexpr long double pi=3.14159265358979323846264338327950288L;
 
-DBCF_DEF int DBCF_NAME2(dbc_ifft,s)(
-    dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-    dbcf_index src_real_stride,dbcf_index src_imag_stride,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
-    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
-    DBCF_Type scale);
+constexpr long double sin_series(long double x2,long double term,int k)
+{
+    return k>12?term:term+sin_series(x2,-term*x2/(long double)((2*k)*(2*k+1)),k+1);
+}
 
-#ifdef __cplusplus
+constexpr long double cos_series(long double x2,long double term,int k)
+{
+    return k>12?term:term+cos_series(x2,-term*x2/(long double)((2*k-1)*(2*k)),k+1);
 }
-#endif
 
-/* Overloaded versions. */
-#if defined(__cplusplus) && !defined(DBC_FFT_NO_CPP_OVERLOADS)
-DBCF_DEF int dbc_fft(
-    dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
-    DBCF_Type scale);
-DBCF_DEF int dbc_ifft(
-    dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
-    DBCF_Type scale);
-DBCF_DEF int dbc_fft(
-    dbcf_index num_elements,
-    const DBCF_Type *src,
-          DBCF_Type *dst,
-    DBCF_Type scale);
-DBCF_DEF int dbc_ifft(
-    dbcf_index num_elements,
-    const DBCF_Type *src,
-          DBCF_Type *dst,
-    DBCF_Type scale);
-DBCF_DEF int dbc_fft(
-    dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-    dbcf_index src_real_stride,dbcf_index src_imag_stride,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
-    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
-    DBCF_Type scale);
-DBCF_DEF int dbc_ifft(
-    dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-    dbcf_index src_real_stride,dbcf_index src_imag_stride,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
-    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
-    DBCF_Type scale);
-#endif /* defined(__cplusplus) && !defined(DBC_FFT_NO_CPP_OVERLOADS) */
+constexpr long double angle(dbcf_index a,dbcf_index d)
+{
+    return 2.0L*pi*(long double)a/(long double)d;
+}
 
-#endif /* DBC_FFT_DECLARATION */
+/*
+    cos and sin of 2*pi*a/d, 0<=a<=d, reduced to [0;pi/4] exactly
+    (in integers), so that e.g. cos(pi/2) is exactly 0.
+*/
+constexpr long double tw_sin(dbcf_index a,dbcf_index d);
 
-/*============================================================================*/
-/* Implementation section. */
-#if defined(DBC_FFT_IMPLEMENTATION) && !defined(DBC_FFT_DECLARATION) && !defined(DBC_FFT_INSTANTIATION)
+constexpr long double tw_cos(dbcf_index a,dbcf_index d)
+{
+    return 2*a>d?tw_cos(d-a,d):
+           4*a>d?-tw_cos(d-2*a,2*d):
+           8*a>d?tw_sin(d-4*a,4*d):
+           cos_series(angle(a,d)*angle(a,d),1.0L,1);
+}
 
-#define DBCF_POW2(n) (((dbcf_index)1)<<(n))
+constexpr long double tw_sin(dbcf_index a,dbcf_index d)
+{
+    return 2*a>d?-tw_sin(d-a,d):
+           4*a>d?tw_sin(d-2*a,2*d):
+           8*a>d?tw_cos(d-4*a,4*d):
+           sin_series(angle(a,d)*angle(a,d),angle(a,d),1);
+}
 
-#ifndef DBCF_TMP_BUF_LOG2
-#define DBCF_TMP_BUF_LOG2 10
+/*
+    a*b and a*b+c. Where the target has FMA, GCC contracts a*b+c
+    differently depending on the code the kernel is inlined into (e.g. in
+    place or not), so that the results would depend on the call. The
+    kernels therefore fuse explicitly there: a*b+c is fma(a,b,c), and
+    the other products that are added are fma(a,b,+0), which is the same
+    rounded product (up to the sign of zero), and is never contracted.
+*/
+template<class T> DBCF_CPP_INLINE T product(T a,T b) {return a*b;}
+template<class T> DBCF_CPP_INLINE T mul_add(T a,T b,T c) {return a*b+c;}
+#if defined(__GNUC__) && defined(__FP_FAST_FMAF)
+template<> DBCF_CPP_INLINE float product(float a,float b) {return __builtin_fmaf(a,b,0.0f);}
+template<> DBCF_CPP_INLINE float mul_add(float a,float b,float c) {return __builtin_fmaf(a,b,c);}
 #endif
-#define DBCF_TMP_BUF_SIZE DBCF_POW2(DBCF_TMP_BUF_LOG2)
-#define DBCF_TWIDDLES_BUF_LOG2 ((DBCF_TMP_BUF_LOG2)-1)
-#define DBCF_TWIDDLES_BUF_SIZE DBCF_POW2(DBCF_TWIDDLES_BUF_LOG2)
-#ifndef DBCF_Q /* Parameter Q from  "Towards an Optimal Bit-Reversal Permutation Program". */
-#define DBCF_Q (((DBCF_TMP_BUF_LOG2)>>1)<6?((DBCF_TMP_BUF_LOG2)>>1):6)
+#if defined(__GNUC__) && defined(__FP_FAST_FMA)
+template<> DBCF_CPP_INLINE double product(double a,double b) {return __builtin_fma(a,b,0.0);}
+template<> DBCF_CPP_INLINE double mul_add(double a,double b,double c) {return __builtin_fma(a,b,c);}
 #endif
 
-typedef int dbcF_static_assert_tmp_buf_size[(DBCF_TMP_BUF_LOG2)>=2                        ?1:-1];
-typedef int dbcF_static_assert_Q           [(DBCF_Q)>=1&&(2*(DBCF_Q)<=(DBCF_TMP_BUF_LOG2))?1:-1];
+/*
+    t=b*w, w=exp(-+2*pi*i*K/N) (forward/inverse). Kind: 0 - w=1, 1 - w=-+i,
+    2 and 3 - w=(+-1-+i)*sqrt(0.5) (the trick of dbcF_fft8), 4 - general.
+*/
+template<class T,dbcf_index N,dbcf_index K,int inverse,int kind=(K==0?0:4*K==N?1:8*K==N?2:8*K==3*N?3:4)>
+struct twiddle
+{
+    static DBCF_CPP_INLINE void mul(T br,T bi,T &tr,T &ti)
+    {
+        constexpr T wr=T(tw_cos(K,N));
+        constexpr T wi=T(inverse?tw_sin(K,N):-tw_sin(K,N));
+        tr=mul_add(br,wr,-product(bi,wi));
+        ti=mul_add(br,wi,product(bi,wr));
+    }
+};
 
-/* malloc replacement. */
-#ifndef dbcf_malloc
-#include <stddef.h>
-#include <stdlib.h>
-#define dbcf_malloc(n) malloc((size_t)(n))
-#define dbcf_free(p)   free(p)
-#endif
+template<class T,dbcf_index N,dbcf_index K,int inverse>
+struct twiddle<T,N,K,inverse,0>
+{
+    static DBCF_CPP_INLINE void mul(T br,T bi,T &tr,T &ti) {tr=br;ti=bi;}
+};
 
-/* Architecture detection. */
-#if defined(__i386__) || defined(_M_IX86) || defined(_X86_) || defined(__i386) || defined(__THW_INTEL)
-#define DBCF_X86
-#endif
+template<class T,dbcf_index N,dbcf_index K,int inverse>
+struct twiddle<T,N,K,inverse,1>
+{
+    static DBCF_CPP_INLINE void mul(T br,T bi,T &tr,T &ti)
+    {
+        if(inverse) {tr=-bi;ti=br;}
+        else        {tr=bi;ti=-br;}
+    }
+};
 
-#if defined(__x86_64__) || defined(_M_X64) || defined(__amd64)
-#define DBCF_X64
-#endif
+template<class T,dbcf_index N,dbcf_index K,int inverse>
+struct twiddle<T,N,K,inverse,2>
+{
+    static DBCF_CPP_INLINE void mul(T br,T bi,T &tr,T &ti)
+    {
+        constexpr T c=T(tw_cos(1,8));
+        if(inverse) {tr=product(c,br-bi);ti=product(c,br+bi);}
+        else        {tr=product(c,br+bi);ti=product(c,bi-br);}
+    }
+};
 
-#if defined(DBCF_X86) || defined(DBCF_X64)
-#define DBCF_X86_OR_X64
-#endif
+template<class T,dbcf_index N,dbcf_index K,int inverse>
+struct twiddle<T,N,K,inverse,3>
+{
+    static DBCF_CPP_INLINE void mul(T br,T bi,T &tr,T &ti)
+    {
+        constexpr T c=T(tw_cos(1,8));
+        if(inverse) {tr=product(-c,br+bi);ti=product(c,br-bi);}
+        else        {tr=product(c,bi-br);ti=product(-c,br+bi);}
+    }
+};
 
-/* 8-bit bitreverse table. */
-#ifndef DBC_FFT_NO_BITREVERSE_TABLE
-static unsigned char dbcF_bitreverse_table[512]=
+/* Butterflies K..N/2-1 of a pass of size N, on a local block. */
+template<class T,dbcf_index N,dbcf_index K,int inverse,bool done=(2*K==N)>
+struct pass
 {
-/* Adapted from https://graphics.stanford.edu/~seander/bithacks.html#BitReverseTable . */
-#define DBCF_R1(n,c) n,n+c
-#define DBCF_R2(n,c) DBCF_R1(n,2*c),DBCF_R1(n+c,2*c)
-#define DBCF_R3(n,c) DBCF_R2(n,2*c),DBCF_R2(n+c,2*c)
-#define DBCF_R4(n,c) DBCF_R3(n,2*c),DBCF_R3(n+c,2*c)
-#define DBCF_R5(n,c) DBCF_R4(n,2*c),DBCF_R4(n+c,2*c)
-#define DBCF_R6(n,c) DBCF_R5(n,2*c),DBCF_R5(n+c,2*c)
-#define DBCF_R7(n,c) DBCF_R6(n,2*c),DBCF_R6(n+c,2*c)
-#define DBCF_R8(n,c) DBCF_R7(n,2*c),DBCF_R7(n+c,2*c)
-0,0,DBCF_R1(0,1),DBCF_R2(0,1),DBCF_R3(0,1),DBCF_R4(0,1),DBCF_R5(0,1),DBCF_R6(0,1),DBCF_R7(0,1),DBCF_R8(0,1)
-#undef DBCF_R1
-#undef DBCF_R2
-#undef DBCF_R3
-#undef DBCF_R4
-#undef DBCF_R5
-#undef DBCF_R6
-#undef DBCF_R7
-#undef DBCF_R8
+    static DBCF_CPP_INLINE void run(T *re,T *im)
+    {
+        T ar=re[K],ai=im[K],tr,ti;
+        twiddle<T,N,K,inverse>::mul(re[K+N/2],im[K+N/2],tr,ti);
+        re[K]=ar+tr;re[K+N/2]=ar-tr;
+        im[K]=ai+ti;im[K+N/2]=ai-ti;
+        pass<T,N,K+1,inverse>::run(re,im);
+    }
 };
-#endif /* DBC_FFT_NO_BITREVERSE_TABLE */
 
-static dbcf_index dbcF_bitreverse(dbcf_index i,dbcf_index bits)
+template<class T,dbcf_index N,dbcf_index K,int inverse>
+struct pass<T,N,K,inverse,true>
 {
-#ifndef DBC_FFT_NO_BITREVERSE_TABLE
-    if(bits<=8) return (dbcF_bitreverse_table+DBCF_POW2(bits))[i];
-    return ((dbcf_index)((dbcF_bitreverse_table+256)[i&255])<<(bits-8))^dbcF_bitreverse(i>>8,bits-8);
-#else
-    dbcf_index j=i&255,b=(bits<8?bits:8);
-    j=(j>>4)^(j<<4);
-    j=((j&0xCC)>>2)^((j&0x33)<<2);
-    j=((j&0xAA)>>1)^((j&0x55)<<1);
-    j=j>>(8-b);
-    if(bits>8) j=(j<<(bits-8))^dbcF_bitreverse(i>>8,bits-8);
-    return j;
-#endif
-}
+    static DBCF_CPP_INLINE void run(T*,T*) {}
+};
 
-/* SIMD feature detection flags. */
-#define DBCF_HAS_SIMD4F   1
-#define DBCF_HAS_SIMD2D   2 
-#define DBCF_HAS_SIMD8F   4 
-#define DBCF_HAS_SIMD4D   8
-#define DBCF_HAS_SIMD16F 16 
-#define DBCF_HAS_SIMD8D  32
+/* Passes of size M..N (powers of 2) over the N/M blocks each. */
+template<class T,dbcf_index N,dbcf_index M,dbcf_index B,int inverse,bool done=(B*M==N)>
+struct blocks
+{
+    static DBCF_CPP_INLINE void run(T *re,T *im)
+    {
+        pass<T,M,0,inverse>::run(re+B*M,im+B*M);
+        blocks<T,N,M,B+1,inverse>::run(re,im);
+    }
+};
 
-#if (defined(__MINGW32__)||defined(__MINGW64__))&&!defined(DBCF_X64)
-#if !defined(DBC_FFT_ENABLE_MINGW_SIMD) && !defined(DBC_FFT_NO_SIMD) && !defined(DBC_FFT_FORCE_SIMD)
-#define DBC_FFT_NO_SIMD
-#endif
-#endif
+template<class T,dbcf_index N,dbcf_index M,dbcf_index B,int inverse>
+struct blocks<T,N,M,B,inverse,true>
+{
+    static DBCF_CPP_INLINE void run(T *re,T *im)
+    {
+        blocks<T,N,2*M,0,inverse>::run(re,im);
+    }
+};
 
-#if defined(DBC_FFT_FORCE_SIMD) && defined(DBC_FFT_NO_SIMD)
-#error Both DBC_FFT_FORCE_SIMD and DBC_FFT_NO_SIMD are specified
-#endif
+template<class T,dbcf_index N,dbcf_index B,int inverse>
+struct blocks<T,N,2*N,B,inverse,false>
+{
+    static DBCF_CPP_INLINE void run(T*,T*) {}
+};
 
-#if defined(__GNUC__) && (defined(__ARM_NEON)||defined(__ARM_NEON__)) && !defined(DBC_FFT_NO_SIMD) && !defined(DBC_FFT_FORCE_SIMD)
-#define DBC_FFT_FORCE_SIMD (DBCF_HAS_SIMD4F|DBCF_HAS_SIMD2D)
-#endif
+constexpr dbcf_index bitrev(dbcf_index k,dbcf_index n)
+{
+    return n<=1?0:((k&1)?n/2:0)+bitrev(k>>1,n/2);
+}
 
-#if !defined(DBCF_X86_OR_X64) && !defined(DBC_FFT_NO_SIMD) && !defined(DBC_FFT_FORCE_SIMD)
-#define DBC_FFT_NO_SIMD
-#endif
+/* Gather x in bit-reversed order, and scatter the result, unrolled. */
+template<class T,dbcf_index N,dbcf_index K,bool done=(K==N)>
+struct io
+{
+    static DBCF_CPP_INLINE void load(T *re,T *im,const T *xr,const T *xi,dbcf_index xs)
+    {
+        re[K]=xr[bitrev(K,N)*xs];
+        im[K]=xi[bitrev(K,N)*xs];
+        io<T,N,K+1>::load(re,im,xr,xi,xs);
+    }
+    static DBCF_CPP_INLINE void store(const T *re,const T *im,T *yr,T *yi,dbcf_index ys,T scale)
+    {
+        yr[K*ys]=re[K]*scale;
+        yi[K*ys]=im[K]*scale;
+        io<T,N,K+1>::store(re,im,yr,yi,ys,scale);
+    }
+};
 
-#if !defined(DBCF_X86_OR_X64) && !defined(__GNUC__) && defined(DBC_FFT_FORCE_SIMD)
-/* DBC_FFT_FORCE_SIMD is only supported on x86/x64 or for __GNUC__ compilers. */
-#error DBC_FFT_FORCE_SIMD is not supported for this platform
-#endif
+template<class T,dbcf_index N,dbcf_index K>
+struct io<T,N,K,true>
+{
+    static DBCF_CPP_INLINE void load(T*,T*,const T*,const T*,dbcf_index) {}
+    static DBCF_CPP_INLINE void store(const T*,const T*,T*,T*,dbcf_index,T) {}
+};
 
-#if !defined(DBCF_X86_OR_X64)
-#if defined(DBC_FFT_NO_AVX)
-#undef DBC_FFT_NO_AVX
-#endif
-#if defined(DBC_FFT_NO_AVX512)
-#undef DBC_FFT_NO_AVX512
-#endif
-#endif
+/*
+    Radix-2 decimation in time on a local copy: all of x is read before
+    any of y is written (so src==dst needs no special care), and the
+    compiler is free to keep the block in registers.
+*/
+template<class T,dbcf_index N,int inverse,bool split=(N>32)>
+struct kernel
+{
+    static DBCF_CPP_INLINE void run(const T *xr,const T *xi,dbcf_index xs,T *yr,T *yi,dbcf_index ys,T scale)
+    {
+        T re[(size_t)N],im[(size_t)N];
+        io<T,N,0>::load(re,im,xr,xi,xs);
+        blocks<T,N,2,0,inverse>::run(re,im);
+        io<T,N,0>::store(re,im,yr,yi,ys,scale);
+    }
+};
 
-#if defined(DBCF_X86_OR_X64)
-#if defined(DBC_FFT_NO_AVX)
-#define DBCF_NO_SIMD8F
-#define DBCF_NO_SIMD4D
-#endif
-#if defined(DBC_FFT_NO_AVX512)
-#define DBCF_NO_SIMD16F
-#define DBCF_NO_SIMD8D
-#endif
-#endif /* defined(DBCF_X86_OR_X64) */
+/* Larger blocks no longer fit in registers: transform the halves first. */
+template<class T,dbcf_index N,int inverse>
+struct kernel<T,N,inverse,true>
+{
+    static DBCF_CPP_INLINE void run(const T *xr,const T *xi,dbcf_index xs,T *yr,T *yi,dbcf_index ys,T scale)
+    {
+        T re[(size_t)N],im[(size_t)N];
+        kernel<T,N/2,inverse>::run(xr   ,xi   ,2*xs,re    ,im    ,1,T(1));
+        kernel<T,N/2,inverse>::run(xr+xs,xi+xs,2*xs,re+N/2,im+N/2,1,T(1));
+        pass<T,N,0,inverse>::run(re,im);
+        io<T,N,0>::store(re,im,yr,yi,ys,scale);
+    }
+};
 
-#if defined(DBC_FFT_FORCE_SIMD)
-#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_SIMD4F)
-#define DBCF_NO_SIMD4F
-#endif
-#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_SIMD8F)
-#define DBCF_NO_SIMD8F
-#endif
-#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_SIMD16F)
-#define DBCF_NO_SIMD16F
-#endif
-#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_SIMD2D)
-#define DBCF_NO_SIMD2D
-#endif
-#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_SIMD4D)
-#define DBCF_NO_SIMD4D
-#endif
-#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_SIMD8D)
-#define DBCF_NO_SIMD8D
-#endif
-#endif /* defined(DBC_FFT_FORCE_SIMD) */
+template<class T,dbcf_index N>
+struct is_unrolled
+{
+    static constexpr bool value=(N>0&&(N&(N-1))==0&&N<=DBCF_UNROLL_MAX);
+};
 
-#if defined(DBC_FFT_USE_VECTOR_EXTENSIONS) && defined(DBC_FFT_USE_INTRINSICS)
-#error Both DBC_FFT_USE_VECTOR_EXTENSIONS and DBC_FFT_USE_INTRINSICS are specified
-#endif
+/* Small power-of-2 sizes: no state. */
+template<dbcf_index N,class T,bool unrolled=is_unrolled<T,N>::value>
+class fft_impl
+{
+public:
+    explicit fft_impl(int) {}
+protected:
+    static int run(int inverse,const T *xr,const T *xi,dbcf_index xs,T *yr,T *yi,dbcf_index ys,T scale)
+    {
+        T tr[(size_t)N],ti[(size_t)N];
+        dbcf_index i;
+        /* NULL means zeros. */
+        if(!xr||!xi)
+        {
+            for(i=0;i<N;++i)
+            {
+                tr[i]=(xr?xr[i*xs]:T(0));
+                ti[i]=(xi?xi[i*xs]:T(0));
+            }
+            xr=tr;xi=ti;xs=1;
+        }
+        if(inverse) kernel<T,N,1>::run(xr,xi,xs,yr,yi,ys,scale);
+        else        kernel<T,N,0>::run(xr,xi,xs,yr,yi,ys,scale);
+        return 0;
+    }
+    static int run(int inverse,const T *src,T *dst,T scale)
+    {
+        return run(inverse,src,src?src+1:0,2,dst,dst?dst+1:0,2,scale);
+    }
+};
 
-#if !defined(DBC_FFT_USE_VECTOR_EXTENSIONS) && !defined(DBC_FFT_USE_INTRINSICS)
-#if defined(__GNUC__) || !defined(DBCF_X86_OR_X64)
-#define DBC_FFT_USE_VECTOR_EXTENSIONS
-#else
-#define DBC_FFT_USE_INTRINSICS
-#endif
-#endif
+/* Which dbc_fft_plan_create_* and dbc_fft_execute_* to use for T. */
+template<class T> struct plan_traits;
 
-#if defined(DBC_FFT_CACHE_CPU_DETECTION) && defined(DBC_FFT_DONT_CACHE_CPU_DETECTION)
-#error Both DBC_FFT_CACHE_CPU_DETECTION and DBC_FFT_DONT_CACHE_CPU_DETECTION are specified
+#ifndef DBC_FFT_NO_FLOAT
+template<> struct plan_traits<float>
+{
+    static dbcf_plan *create(dbcf_index n,int flags) {return dbc_fft_plan_create_f(n,flags);}
+    static int execute(dbcf_plan *p,const float *xr,const float *xi,float *yr,float *yi,float s) {return dbc_fft_execute_fc(p,xr,xi,yr,yi,s);}
+    static int execute(dbcf_plan *p,const float *x,float *y,float s) {return dbc_fft_execute_fi(p,x,y,s);}
+};
 #endif
 
-#if !defined(DBC_FFT_CACHE_CPU_DETECTION) && !defined(DBC_FFT_DONT_CACHE_CPU_DETECTION)
-#if !(__cplusplus>=201103L) 
-#define DBC_FFT_CACHE_CPU_DETECTION
-#else
-#define DBC_FFT_DONT_CACHE_CPU_DETECTION
+#ifndef DBC_FFT_NO_DOUBLE
+template<> struct plan_traits<double>
+{
+    static dbcf_plan *create(dbcf_index n,int flags) {return dbc_fft_plan_create_d(n,flags);}
+    static int execute(dbcf_plan *p,const double *xr,const double *xi,double *yr,double *yi,double s) {return dbc_fft_execute_dc(p,xr,xi,yr,yi,s);}
+    static int execute(dbcf_plan *p,const double *x,double *y,double s) {return dbc_fft_execute_di(p,x,y,s);}
+};
 #endif
+
+#ifndef DBC_FFT_NO_LONGDOUBLE
+template<> struct plan_traits<long double>
+{
+    static dbcf_plan *create(dbcf_index n,int flags) {return dbc_fft_plan_create_l(n,flags);}
+    static int execute(dbcf_plan *p,const long double *xr,const long double *xi,long double *yr,long double *yi,long double s) {return dbc_fft_execute_lc(p,xr,xi,yr,yi,s);}
+    static int execute(dbcf_plan *p,const long double *x,long double *y,long double s) {return dbc_fft_execute_li(p,x,y,s);}
+};
 #endif
 
-/* Alignment specifiers. */
-#if defined(__GNUC__)
-#define DBCF_ALIGNED(n) __attribute__((aligned(n)))
-#elif defined(_MSC_VER)
-#define DBCF_ALIGNED(n) __declspec(align(n))
-#else
-#define DBCF_NO_ALIGNMENT
-#define DBCF_ALIGNED(n)
+/* Other sizes: a pair of plans, owned by the object. */
+template<dbcf_index N,class T>
+class fft_impl<N,T,false>
+{
+public:
+    explicit fft_impl(int flags):
+        fwd(plan_traits<T>::create(N,(flags&~DBCF_PLAN_INVERSE)|DBCF_PLAN_FORWARD)),
+        inv(plan_traits<T>::create(N,flags|DBCF_PLAN_INVERSE)) {}
+    ~fft_impl()
+    {
+        dbc_fft_plan_destroy(fwd);
+        dbc_fft_plan_destroy(inv);
+    }
+    fft_impl(const fft_impl&)=delete;
+    fft_impl &operator=(const fft_impl&)=delete;
+protected:
+    int run(int inverse,const T *xr,const T *xi,dbcf_index,T *yr,T *yi,dbcf_index,T scale) const
+    {
+        dbcf_plan *plan=(inverse?inv:fwd);
+        if(!plan) return DBCF_ERROR_OUT_OF_MEMORY;
+        return plan_traits<T>::execute(plan,xr,xi,yr,yi,scale);
+    }
+    int run(int inverse,const T *src,T *dst,T scale) const
+    {
+        dbcf_plan *plan=(inverse?inv:fwd);
+        if(!plan) return DBCF_ERROR_OUT_OF_MEMORY;
+        return plan_traits<T>::execute(plan,src,dst,scale);
+    }
+private:
+    dbcf_plan *fwd,*inv;
+};
+
+} /* namespace detail */
+
+template<dbcf_index N,class T>
+class fft:public detail::fft_impl<N,T>
+{
+    static_assert(N>0,"dbc::fft size must be positive");
+public:
+    explicit fft(int flags=0):detail::fft_impl<N,T>(flags) {}
+    /* Split real/imaginary arrays. */
+    int forward(const T *src_real,const T *src_imag,T *dst_real,T *dst_imag,T scale=T(1))
+    {
+        return this->run(0,src_real,src_imag,1,dst_real,dst_imag,1,scale);
+    }
+    int inverse(const T *src_real,const T *src_imag,T *dst_real,T *dst_imag,T scale=T(1))
+    {
+        return this->run(1,src_real,src_imag,1,dst_real,dst_imag,1,scale);
+    }
+    /* Interleaved arrays. */
+    int forward(const T *src,T *dst,T scale=T(1)) {return this->run(0,src,dst,scale);}
+    int inverse(const T *src,T *dst,T scale=T(1)) {return this->run(1,src,dst,scale);}
+    /* std::complex, viewed as interleaved (without copying). */
+    int forward(const std::complex<T> *src,std::complex<T> *dst,T scale=T(1))
+    {
+        return this->run(0,reinterpret_cast<const T*>(src),reinterpret_cast<T*>(dst),scale);
+    }
+    int inverse(const std::complex<T> *src,std::complex<T> *dst,T scale=T(1))
+    {
+        return this->run(1,reinterpret_cast<const T*>(src),reinterpret_cast<T*>(dst),scale);
+    }
+#ifdef DBCF_HAS_SPAN
+    int forward(std::span<const std::complex<T>,(size_t)N> src,std::span<std::complex<T>,(size_t)N> dst,T scale=T(1))
+    {
+        return forward(src.data(),dst.data(),scale);
+    }
+    int inverse(std::span<const std::complex<T>,(size_t)N> src,std::span<std::complex<T>,(size_t)N> dst,T scale=T(1))
+    {
+        return inverse(src.data(),dst.data(),scale);
+    }
 #endif
+};
 
-/* Is this reliable? */
-#define DBCF_IS_ALIGNED(p,n) ((((dbcf_index)(p))&((dbcf_index)(n)-1))==0)
+} /* namespace dbc */
 
-/* SIMD stuff. */
-#if !defined(DBC_FFT_NO_SIMD)
+#endif /* defined(__cplusplus) && (__cplusplus>=201103L) && !defined(DBC_FFT_NO_CPP_TEMPLATES) */
 
-#if !defined(DBC_FFT_FORCE_SIMD) && !defined(dbcf_detect_simd) && defined(DBCF_X86_OR_X64) && !defined(_WIN16)
-/*
-    x86 runtime CPU detection.
+#endif /* DBC_FFT_H */
 
-    We need to check both CPU-level support and OS-level support. This
-    is because the OS needs know to preserve SIMD state on context switch.
-    Generally, the corresponding instructions are disabled (cause exception
-    if used) on OSes that do not support them. XGETBV is used to check
-    OS-level support for AVX and AVX512. Some older OSes (Windows 95 and
-    earlier, Linux kernel before something like 2.4) may not have the
-    OS-level support for SSE (do not preserve the state on context switch).
-    The dbc_fft.h does not check for it. If you need to support them,
-    consider checking it yourself and providing a custom dbcf_detect_simd.
+/*============================================================================*/
+/* Declaration section */
+#ifdef DBC_FFT_DECLARATION
 
-    SSE2 is used as a minimum SIMD target on x86, even if SSE could
-    suffice for float. This is because SSE can result in slow code
-    with x86 GCC ( https://godbolt.org/z/4T7fx5b7o ), as well as in x64.
-*/
-#if !defined(__GNUC__) && (!defined(_MSC_VER) || (_MSC_VER>=1400))
-#include <intrin.h>
-#endif
-
-/* All Pentiums and later should have CPUID. Some later 486s have it as well. */
-static int dbcF_has_cpuid(void)
-{
-#if defined(DBCF_X64)
-    return 1; /* Always have CPUID on x64. */
-#elif defined(__GNUC__)
-    /* Check by trying to set the 21st bit in EFLAGS. */
-    unsigned a,b;
-    __asm__ __volatile__(
-        "pushfl\n\t"
-        "pushfl\n\t"
-        "popl %0\n\t"
-        "movl %0,%1\n\t"
-        "xorl $0x00200000,%0\n\t"
-        "pushl %0\n\t"
-        "popfl\n\t"
-        "pushfl\n\t"
-        "popl %0\n\t"
-        "popfl\n\t"
-	:"=&r"(a),"=&r"(b));
-    return !!((a^b)&0x00200000u);
-#else
-    return 1; /* Assume the CPU has CPUID. */
+#ifdef __cplusplus
+extern "C" {
 #endif
-}
 
-static void dbcF_cpuid(int level,int sublevel,unsigned *eax,unsigned *ebx,unsigned *ecx,unsigned *edx)
-{
-#if defined(__GNUC__)
-    unsigned a,b,c,d;
-    __asm__ __volatile__(
-        "cpuid\n\t"
-        :"=a"(a),"=b"(b),"=c"(c),"=d"(d)
-        :"0"(level),"2"(sublevel));
-    *eax=a;
-    *ebx=b;
-    *ecx=c;
-    *edx=d;
-#elif defined(_MSC_VER) && !(_MSC_VER>=1400) /* VC6 */
-    int res;
-    __asm {
-        mov  eax,1
-        cpuid
-        mov  res,edx
-    }
-    /* Only check edx. */
-    *eax=0;
-    *ebx=0;
-    *ecx=0;
-    *edx=(unsigned)res;
-#else
-    int regs[4];
-    __cpuidex(regs,level,sublevel);
-    *eax=(unsigned)regs[0];
-    *ebx=(unsigned)regs[1];
-    *ecx=(unsigned)regs[2];
-    *edx=(unsigned)regs[3];
-#endif
-}
+DBCF_DEF int DBCF_NAME2(dbc_fft,c)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
 
-/* Only return lower 32 bits of xgetbv. */
-static unsigned dbcF_xgetbv(unsigned level)
-{
-    unsigned ret=0;
-#if defined(__GNUC__)
-    /*
-        Using __builtin_ia32_xgetbv (or _xgetbv intrinsic) needs the function
-        to be compiled as AVX or higher, but using xgetbv from within the
-        inline assembly does not. Seems to cause no problems (as long as
-        the availability of XGETBV is checked at runtime).
-    */
-    unsigned eax,edx;
-    __asm__ __volatile__("xgetbv\n\t":"=a"(eax),"=d"(edx):"c"(level));
-    ret=eax; /* Full result: eax^((unsigned long long)edx<<32). */
-#elif defined(_MSC_VER) && !(_MSC_VER>=1400) /* VC6 */
-    /* Pretend that xgetbv always returns 0. */
-#else
-    ret=(unsigned)_xgetbv(level);
-#endif
-    return ret;
-}
-#endif /* !defined(DBC_FFT_FORCE_SIMD) && !defined(dbcf_detect_simd) && defined(DBCF_X86_OR_X64) && !defined(_WIN16) */
+DBCF_DEF int DBCF_NAME2(dbc_fft,c_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
 
-#ifndef dbcf_detect_simd
-static int dbcF_detect_simd(void)
-{
-    int ret=0;
-#if defined(DBC_FFT_FORCE_SIMD)
-    ret=(DBC_FFT_FORCE_SIMD);
-#elif defined(DBCF_X86_OR_X64)
-    /* Compile-time CPU detection. */
-#if defined(__SSE2__) || (_M_IX86_FP>=2) /* MSVC does not have __SSE2__ macro. */
-    ret|=DBCF_HAS_SIMD4F |DBCF_HAS_SIMD2D;
-#endif
-#if !defined(DBC_FFT_NO_AVX) && defined(__AVX__)
-    ret|=DBCF_HAS_SIMD8F |DBCF_HAS_SIMD4D;
-#endif
-#if !defined(DBC_FFT_NO_AVX512) && defined(__AVX512F__)
-    ret|=DBCF_HAS_SIMD16F|DBCF_HAS_SIMD8D;
-#endif
-#if !defined(_WIN16)
-    /* Runtime CPU detection. */
-    if(dbcF_has_cpuid())
-    {
-        unsigned eax,ebx,ecx,edx;
-        unsigned maxlevel;
-        dbcF_cpuid(0,0,&maxlevel,&ebx,&ecx,&edx);
-        if(maxlevel>0)
-        {
-            dbcF_cpuid(1,0,&eax,&ebx,&ecx,&edx);
-            if(edx&0x04000000u) ret|=DBCF_HAS_SIMD4F |DBCF_HAS_SIMD2D; /* SSE2 */
-#if !defined(DBC_FFT_NO_AVX)
-            if(ecx&0x18000000u) /* CPU has AVX & XGETBV. */
-            {
-                unsigned xcr0=dbcF_xgetbv(0);
-                if((xcr0&0x6)==0x6) /* OS-level support for AVX. */
-                {
-                    ret|=DBCF_HAS_SIMD8F |DBCF_HAS_SIMD4D; /* AVX */
-#if !defined(DBC_FFT_NO_AVX512)
-                    if(maxlevel>=7)
-                    {
-                        dbcF_cpuid(7,0,&eax,&ebx,&ecx,&edx);
-                        if((xcr0&0xE6)==0xE6) /* OS-level support for AVX512. */
-                        {
-                            if(ebx&0x00010000u) ret|=DBCF_HAS_SIMD16F|DBCF_HAS_SIMD8D; /* AVX512 */
-                        }
-                    }
-#endif
-                }
-            }
-#endif
-        }
+DBCF_DEF int DBCF_NAME2(dbc_ifft,c)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
 
-    }
-#endif /* !defined(_WIN16) */
-#endif /* defined(DBC_FFT_FORCE_SIMD) */
-    return ret;
-}
+DBCF_DEF int DBCF_NAME2(dbc_ifft,c_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
 
-static int dbcf_detect_simd(void)
-{
-#if defined(DBC_FFT_CACHE_CPU_DETECTION)
-    static int cached=
-#ifndef __cplusplus
-    -1;
-    if(cached==-1) cached=
-#endif
-    dbcF_detect_simd();
-    return cached;
-#else
-    return dbcF_detect_simd();
-#endif /* DBC_FFT_CACHE_CPU_DETECTION */
-}
-#endif /* dbcf_detect_simd */
+DBCF_DEF int DBCF_NAME2(dbc_fft,i)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
 
-#if defined(DBC_FFT_USE_VECTOR_EXTENSIONS)
-#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD4F)
-typedef float  dbcf_simd4f  __attribute__((vector_size(16)));
-#endif
-#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD2D)
-typedef double dbcf_simd2d  __attribute__((vector_size(16)));
-#endif
-#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD8F)
-typedef float  dbcf_simd8f  __attribute__((vector_size(32)));
-#endif
-#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD4D)
-typedef double dbcf_simd4d  __attribute__((vector_size(32)));
-#endif
-#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD16F)
-typedef float  dbcf_simd16f __attribute__((vector_size(64)));
-#endif
-#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD8D)
-typedef double dbcf_simd8d  __attribute__((vector_size(64)));
-#endif
-#elif defined(DBCF_X86_OR_X64)
-#include <emmintrin.h>
-#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD4F)
-typedef __m128  dbcf_simd4f;
-#endif
-#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD2D)
-typedef __m128d dbcf_simd2d;
-#endif
-#ifndef DBC_FFT_NO_AVX
-#include <immintrin.h>
-#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD8F)
-typedef __m256  dbcf_simd8f;
-#endif
-#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD4D)
-typedef __m256d dbcf_simd4d;
-#endif
-#endif /* DBC_FFT_NO_AVX */
-#ifndef DBC_FFT_NO_AVX512
-#include <immintrin.h>
-#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD16F)
-typedef __m512  dbcf_simd16f;
-#endif
-#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD8D)
-typedef __m512d dbcf_simd8d;
-#endif
-#endif /* DBC_FFT_NO_AVX512 */
-#endif /* defined(DBC_FFT_USE_VECTOR_EXTENSIONS) */
+DBCF_DEF int DBCF_NAME2(dbc_fft,i_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
 
-/* SIMD functions attributes. */
-#ifdef DBCF_X86_OR_X64
-#if defined(__GNUC__)
-#if defined(__SSE2__)
-/*
-    SSE2 is already globally enabled. No need to specify it,
-    and possibly constrain the compiler from using better
-    instructions.
-*/
-#define DBCF_AUTODECL_SIMD4F
-#define DBCF_AUTODECL_SIMD2D
-#else
-/*
-    Note: stdcall is there to work around the problem, pointed by
-    "error: calling 'function' with SSE calling convention without SSE/SSE2 enabled"
-    diagnostic. Short version: GCC seems to see fit to use SSE
-    calling convention on static SSE functions, breaking the calls from
-    FPU functions. So does clang, except with no error message.
-    Using stdcall overrides that. Possibly unnecessary in this case,
-    since the behavior seems to be triggered only if the function
-    uses floating point arguments/returns.
-    Note: fpmath=sse is not used, as it is not needed (SSE is only used for SIMD),
-    and introduces additional hassle.
-*/
-#define DBCF_AUTODECL_SIMD4F __attribute__((target("sse2"),stdcall))
-#define DBCF_AUTODECL_SIMD2D __attribute__((target("sse2"),stdcall))
-#endif /* defined(__SSE2__) */
-#else
-#define DBCF_AUTODECL_SIMD4F
-#define DBCF_AUTODECL_SIMD2D
-#endif /* defined(__GNUC__) */
+DBCF_DEF int DBCF_NAME2(dbc_ifft,i)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
 
-#if defined(__GNUC__)
-#if defined(__AVX2__)
-/*
-    AVX2 is already globally enabled. No need to specify it,
-    and possibly constrain the compiler from using better
-    instructions.
-*/
-#define DBCF_AUTODECL_SIMD8F
-#define DBCF_AUTODECL_SIMD4D
-#else
-#ifdef DBCF_X64
-#define DBCF_AUTODECL_SIMD8F __attribute__((target("avx"))) /* No stdcall in x64. */
-#define DBCF_AUTODECL_SIMD4D __attribute__((target("avx"))) /* No stdcall in x64. */
-#else
-#define DBCF_AUTODECL_SIMD8F __attribute__((target("avx"),stdcall))
-#define DBCF_AUTODECL_SIMD4D __attribute__((target("avx"),stdcall))
-#endif /* DBCF_X64 */
-#endif /* defined(__AVX2__) */
-#else
-#define DBCF_AUTODECL_SIMD8F
-#define DBCF_AUTODECL_SIMD4D
-#endif /* defined(__GNUC__) */
+DBCF_DEF int DBCF_NAME2(dbc_ifft,i_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
 
-#if defined(__GNUC__)
-#if defined(__AVX512F__)
-/*
-    AVX512F is already globally enabled. No need to specify it,
-    and possibly constrain the compiler from using better
-    instructions.
-*/
-#define DBCF_AUTODECL_SIMD16F
-#define DBCF_AUTODECL_SIMD8D
-#else
-#ifdef DBCF_X64
-#define DBCF_AUTODECL_SIMD16F __attribute__((target("avx512f"))) /* No stdcall in x64. */
-#define DBCF_AUTODECL_SIMD8D  __attribute__((target("avx512f"))) /* No stdcall in x64. */
-#else
-#define DBCF_AUTODECL_SIMD16F __attribute__((target("avx512f"),stdcall))
-#define DBCF_AUTODECL_SIMD8D  __attribute__((target("avx512f"),stdcall))
-#endif /* DBCF_X64 */
-#endif /* defined(__AVX512F__) */
-#else
-#define DBCF_AUTODECL_SIMD16F
-#define DBCF_AUTODECL_SIMD8D
-#endif /* defined(__GNUC__) */
+DBCF_DEF int DBCF_NAME2(dbc_fft,s)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale);
 
-#else /* DBCF_X86_OR_X64 */
-#define DBCF_AUTODECL_SIMD4F
-#define DBCF_AUTODECL_SIMD2D
-#define DBCF_AUTODECL_SIMD8F
-#define DBCF_AUTODECL_SIMD4D
-#define DBCF_AUTODECL_SIMD16F
-#define DBCF_AUTODECL_SIMD8D
-#endif /* DBCF_X86_OR_X64 */
+DBCF_DEF int DBCF_NAME2(dbc_fft,s_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
 
-/* Allow custom declarations. */
-#ifndef DBCF_DECL_SIMD4F
-#define DBCF_DECL_SIMD4F DBCF_AUTODECL_SIMD4F
-#endif
-#ifndef DBCF_DECL_SIMD2D
-#define DBCF_DECL_SIMD2D DBCF_AUTODECL_SIMD2D
-#endif
-#ifndef DBCF_DECL_SIMD8F
-#define DBCF_DECL_SIMD8F DBCF_AUTODECL_SIMD8F
-#endif
-#ifndef DBCF_DECL_SIMD4D
-#define DBCF_DECL_SIMD4D DBCF_AUTODECL_SIMD4D
-#endif
-#ifndef DBCF_DECL_SIMD16F
-#define DBCF_DECL_SIMD16F DBCF_AUTODECL_SIMD16F
-#endif
-#ifndef DBCF_DECL_SIMD8D
-#define DBCF_DECL_SIMD8D DBCF_AUTODECL_SIMD8D
-#endif
+DBCF_DEF int DBCF_NAME2(dbc_ifft,s)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale);
 
-#if defined(DBC_FFT_USE_VECTOR_EXTENSIONS)
-#define DBCF_DEF_SIMD_LOAD( name,type,alignment) static type name(const void *p) {type ret;__builtin_memcpy(&ret,__builtin_assume_aligned(p,alignment),sizeof(ret));return ret;}
-#define DBCF_DEF_SIMD_STORE(name,type,alignment) static void name(type v,void *p) {__builtin_memcpy(__builtin_assume_aligned(p,alignment),&v,sizeof(v));}
+DBCF_DEF int DBCF_NAME2(dbc_ifft,s_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
 
-#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD4F)
-DBCF_DECL_SIMD4F DBCF_DEF_SIMD_LOAD (dbcF_load4f ,dbcf_simd4f,1)
-DBCF_DECL_SIMD4F DBCF_DEF_SIMD_STORE(dbcF_store4f,dbcf_simd4f,1)
-DBCF_DECL_SIMD4F DBCF_DEF_SIMD_LOAD (dbcF_load4f_aligned ,dbcf_simd4f,16)
-DBCF_DECL_SIMD4F DBCF_DEF_SIMD_STORE(dbcF_store4f_aligned,dbcf_simd4f,16)
-DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_set4f(float v0,float v1,float v2,float v3) {return (__extension__ (dbcf_simd4f){v0,v1,v2,v3});}
-DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_fill4f(float v) {return dbcF_set4f(v,v,v,v);}
-DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_add4f(dbcf_simd4f l,dbcf_simd4f r) {return l+r;}
-DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_sub4f(dbcf_simd4f l,dbcf_simd4f r) {return l-r;}
-DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_mul4f(dbcf_simd4f l,dbcf_simd4f r) {return l*r;}
-#endif
-#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD2D)
-DBCF_DECL_SIMD2D DBCF_DEF_SIMD_LOAD (dbcF_load2d ,dbcf_simd2d,1)
-DBCF_DECL_SIMD2D DBCF_DEF_SIMD_STORE(dbcF_store2d,dbcf_simd2d,1)
-DBCF_DECL_SIMD2D DBCF_DEF_SIMD_LOAD (dbcF_load2d_aligned ,dbcf_simd2d,16)
-DBCF_DECL_SIMD2D DBCF_DEF_SIMD_STORE(dbcF_store2d_aligned,dbcf_simd2d,16)
-DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_set2d(double v0,double v1) {return (__extension__ (dbcf_simd2d){v0,v1});}
-DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_fill2d(double v) {return dbcF_set2d(v,v);}
-DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_add2d(dbcf_simd2d l,dbcf_simd2d r) {return l+r;}
-DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_sub2d(dbcf_simd2d l,dbcf_simd2d r) {return l-r;}
-DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_mul2d(dbcf_simd2d l,dbcf_simd2d r) {return l*r;}
-#endif
-#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD8F)
-DBCF_DECL_SIMD8F DBCF_DEF_SIMD_LOAD (dbcF_load8f ,dbcf_simd8f,1)
-DBCF_DECL_SIMD8F DBCF_DEF_SIMD_STORE(dbcF_store8f,dbcf_simd8f,1)
-DBCF_DECL_SIMD8F DBCF_DEF_SIMD_LOAD (dbcF_load8f_aligned ,dbcf_simd8f,32)
-DBCF_DECL_SIMD8F DBCF_DEF_SIMD_STORE(dbcF_store8f_aligned,dbcf_simd8f,32)
-DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_set8f(float v0,float v1,float v2,float v3,float v4,float v5,float v6,float v7) {return (__extension__ (dbcf_simd8f){v0,v1,v2,v3,v4,v5,v6,v7});}
-DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_fill8f(float v) {return dbcF_set8f(v,v,v,v,v,v,v,v);}
-DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_add8f(dbcf_simd8f l,dbcf_simd8f r) {return l+r;}
-DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_sub8f(dbcf_simd8f l,dbcf_simd8f r) {return l-r;}
-DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_mul8f(dbcf_simd8f l,dbcf_simd8f r) {return l*r;}
-#endif
-#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD4D)
-DBCF_DECL_SIMD4D DBCF_DEF_SIMD_LOAD (dbcF_load4d ,dbcf_simd4d,1)
-DBCF_DECL_SIMD4D DBCF_DEF_SIMD_STORE(dbcF_store4d,dbcf_simd4d,1)
-DBCF_DECL_SIMD4D DBCF_DEF_SIMD_LOAD (dbcF_load4d_aligned ,dbcf_simd4d,32)
-DBCF_DECL_SIMD4D DBCF_DEF_SIMD_STORE(dbcF_store4d_aligned,dbcf_simd4d,32)
-DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_set4d(double v0,double v1,double v2,double v3) {return (__extension__ (dbcf_simd4d){v0,v1,v2,v3});}
-DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_fill4d(double v) {return dbcF_set4d(v,v,v,v);}
-DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_add4d(dbcf_simd4d l,dbcf_simd4d r) {return l+r;}
-DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_sub4d(dbcf_simd4d l,dbcf_simd4d r) {return l-r;}
-DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_mul4d(dbcf_simd4d l,dbcf_simd4d r) {return l*r;}
-#endif
-#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD16F)
-DBCF_DECL_SIMD16F DBCF_DEF_SIMD_LOAD (dbcF_load16f ,dbcf_simd16f,1)
-DBCF_DECL_SIMD16F DBCF_DEF_SIMD_STORE(dbcF_store16f,dbcf_simd16f,1)
-DBCF_DECL_SIMD16F DBCF_DEF_SIMD_LOAD (dbcF_load16f_aligned ,dbcf_simd16f,64)
-DBCF_DECL_SIMD16F DBCF_DEF_SIMD_STORE(dbcF_store16f_aligned,dbcf_simd16f,64)
-DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_set16f(float v0,float v1,float v2,float v3,float v4,float v5,float v6,float v7,float v8,float v9,float v10,float v11,float v12,float v13,float v14,float v15) {return (__extension__ (dbcf_simd16f){v0,v1,v2,v3,v4,v5,v6,v7,v8,v9,v10,v11,v12,v13,v14,v15});}
-DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_fill16f(float v) {return dbcF_set16f(v,v,v,v,v,v,v,v,v,v,v,v,v,v,v,v);}
-DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_add16f(dbcf_simd16f l,dbcf_simd16f r) {return l+r;}
-DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_sub16f(dbcf_simd16f l,dbcf_simd16f r) {return l-r;}
-DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_mul16f(dbcf_simd16f l,dbcf_simd16f r) {return l*r;}
-#endif
-#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD8D)
-DBCF_DECL_SIMD8D DBCF_DEF_SIMD_LOAD (dbcF_load8d ,dbcf_simd8d,1)
-DBCF_DECL_SIMD8D DBCF_DEF_SIMD_STORE(dbcF_store8d,dbcf_simd8d,1)
-DBCF_DECL_SIMD8D DBCF_DEF_SIMD_LOAD (dbcF_load8d_aligned ,dbcf_simd8d,64)
-DBCF_DECL_SIMD8D DBCF_DEF_SIMD_STORE(dbcF_store8d_aligned,dbcf_simd8d,64)
-DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_set8d(double v0,double v1,double v2,double v3,double v4,double v5,double v6,double v7) {return (__extension__ (dbcf_simd8d){v0,v1,v2,v3,v4,v5,v6,v7});}
-DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_fill8d(double v) {return dbcF_set8d(v,v,v,v,v,v,v,v);}
-DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_add8d(dbcf_simd8d l,dbcf_simd8d r) {return l+r;}
-DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_sub8d(dbcf_simd8d l,dbcf_simd8d r) {return l-r;}
-DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_mul8d(dbcf_simd8d l,dbcf_simd8d r) {return l*r;}
-#endif
+DBCF_DEF int DBCF_NAME2(dbc_rfft,c)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
 
-#elif defined(DBCF_X86_OR_X64)
+DBCF_DEF int DBCF_NAME2(dbc_rfft,c_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
 
-#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD4F)
-DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_load4f (const void *p) {return _mm_loadu_ps((const float*)p);}
-DBCF_DECL_SIMD4F static void        dbcF_store4f(dbcf_simd4f v,void *p) {_mm_storeu_ps((float*)p,v);}
-DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_load4f_aligned (const void *p) {return _mm_load_ps((const float*)p);}
-DBCF_DECL_SIMD4F static void        dbcF_store4f_aligned(dbcf_simd4f v,void *p) {_mm_store_ps((float*)p,v);}
-DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_set4f(float v0,float v1,float v2,float v3) {return _mm_setr_ps(v0,v1,v2,v3);}
-DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_fill4f(float v) {return dbcF_set4f(v,v,v,v);}
-DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_add4f(dbcf_simd4f l,dbcf_simd4f r) {return _mm_add_ps(l,r);}
-DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_sub4f(dbcf_simd4f l,dbcf_simd4f r) {return _mm_sub_ps(l,r);}
-DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_mul4f(dbcf_simd4f l,dbcf_simd4f r) {return _mm_mul_ps(l,r);}
-#endif
-#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD2D)
-DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_load2d (const void *p) {return _mm_loadu_pd((const double*)p);}
-DBCF_DECL_SIMD2D static void        dbcF_store2d(dbcf_simd2d v,void *p) {_mm_storeu_pd((double*)p,v);}
-DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_load2d_aligned (const void *p) {return _mm_load_pd((const double*)p);}
-DBCF_DECL_SIMD2D static void        dbcF_store2d_aligned(dbcf_simd2d v,void *p) {_mm_store_pd((double*)p,v);}
-DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_set2d(double v0,double v1) {return _mm_setr_pd(v0,v1);}
-DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_fill2d(double v) {return dbcF_set2d(v,v);}
-DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_add2d(dbcf_simd2d l,dbcf_simd2d r) {return _mm_add_pd(l,r);}
-DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_sub2d(dbcf_simd2d l,dbcf_simd2d r) {return _mm_sub_pd(l,r);}
-DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_mul2d(dbcf_simd2d l,dbcf_simd2d r) {return _mm_mul_pd(l,r);}
-#endif
-#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD8F)
-DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_load8f (const void *p) {return _mm256_loadu_ps((const float*)p);}
-DBCF_DECL_SIMD8F static void        dbcF_store8f(dbcf_simd8f v,void *p) {_mm256_storeu_ps((float*)p,v);}
-DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_load8f_aligned (const void *p) {return _mm256_load_ps((const float*)p);}
-DBCF_DECL_SIMD8F static void        dbcF_store8f_aligned(dbcf_simd8f v,void *p) {_mm256_store_ps((float*)p,v);}
-DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_set8f(float v0,float v1,float v2,float v3,float v4,float v5,float v6,float v7) {return _mm256_setr_ps(v0,v1,v2,v3,v4,v5,v6,v7);}
-DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_fill8f(float v) {return dbcF_set8f(v,v,v,v,v,v,v,v);}
-DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_add8f(dbcf_simd8f l,dbcf_simd8f r) {return _mm256_add_ps(l,r);}
-DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_sub8f(dbcf_simd8f l,dbcf_simd8f r) {return _mm256_sub_ps(l,r);}
-DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_mul8f(dbcf_simd8f l,dbcf_simd8f r) {return _mm256_mul_ps(l,r);}
-#endif
-#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD4D)
-DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_load4d (const void *p) {return _mm256_loadu_pd((const double*)p);}
-DBCF_DECL_SIMD4D static void        dbcF_store4d(dbcf_simd4d v,void *p) {_mm256_storeu_pd((double*)p,v);}
-DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_load4d_aligned (const void *p) {return _mm256_load_pd((const double*)p);}
-DBCF_DECL_SIMD4D static void        dbcF_store4d_aligned(dbcf_simd4d v,void *p) {_mm256_store_pd((double*)p,v);}
-DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_set4d(double v0,double v1,double v2,double v3) {return _mm256_setr_pd(v0,v1,v2,v3);}
-DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_fill4d(double v) {return dbcF_set4d(v,v,v,v);}
-DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_add4d(dbcf_simd4d l,dbcf_simd4d r) {return _mm256_add_pd(l,r);}
-DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_sub4d(dbcf_simd4d l,dbcf_simd4d r) {return _mm256_sub_pd(l,r);}
-DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_mul4d(dbcf_simd4d l,dbcf_simd4d r) {return _mm256_mul_pd(l,r);}
-#endif
-#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD16F)
-DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_load16f (const void *p) {return _mm512_loadu_ps((const float*)p);}
-DBCF_DECL_SIMD16F static void        dbcF_store16f(dbcf_simd16f v,void *p) {_mm512_storeu_ps((float*)p,v);}
-DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_load16f_aligned (const void *p) {return _mm512_load_ps((const float*)p);}
-DBCF_DECL_SIMD16F static void        dbcF_store16f_aligned(dbcf_simd16f v,void *p) {_mm512_store_ps((float*)p,v);}
-DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_set16f(float v0,float v1,float v2,float v3,float v4,float v5,float v6,float v7,float v8,float v9,float v10,float v11,float v12,float v13,float v14,float v15) {return _mm512_setr_ps(v0,v1,v2,v3,v4,v5,v6,v7,v8,v9,v10,v11,v12,v13,v14,v15);}
-DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_fill16f(float v) {return dbcF_set16f(v,v,v,v,v,v,v,v,v,v,v,v,v,v,v,v);}
-DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_add16f(dbcf_simd16f l,dbcf_simd16f r) {return _mm512_add_ps(l,r);}
-DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_sub16f(dbcf_simd16f l,dbcf_simd16f r) {return _mm512_sub_ps(l,r);}
-DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_mul16f(dbcf_simd16f l,dbcf_simd16f r) {return _mm512_mul_ps(l,r);}
-#endif
-#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD8D)
-DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_load8d (const void *p) {return _mm512_loadu_pd((const double*)p);}
-DBCF_DECL_SIMD8D static void        dbcF_store8d(dbcf_simd8d v,void *p) {_mm512_storeu_pd((double*)p,v);}
-DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_load8d_aligned (const void *p) {return _mm512_load_pd((const double*)p);}
-DBCF_DECL_SIMD8D static void        dbcF_store8d_aligned(dbcf_simd8d v,void *p) {_mm512_store_pd((double*)p,v);}
-DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_set8d(double v0,double v1,double v2,double v3,double v4,double v5,double v6,double v7) {return _mm512_setr_pd(v0,v1,v2,v3,v4,v5,v6,v7);}
-DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_fill8d(double v) {return dbcF_set8d(v,v,v,v,v,v,v,v);}
-DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_add8d(dbcf_simd8d l,dbcf_simd8d r) {return _mm512_add_pd(l,r);}
-DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_sub8d(dbcf_simd8d l,dbcf_simd8d r) {return _mm512_sub_pd(l,r);}
-DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_mul8d(dbcf_simd8d l,dbcf_simd8d r) {return _mm512_mul_pd(l,r);}
-#endif
+DBCF_DEF int DBCF_NAME2(dbc_rfft,i)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
 
-#endif /* defined(DBC_FFT_USE_VECTOR_EXTENSIONS) */
+DBCF_DEF int DBCF_NAME2(dbc_rfft,i_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
 
-#define DBCF_DEF_SIMD_BLOCK(name,type,size,simd,load_t,load_d,store_d,fill,add,sub,mul,cexp)\
-static void name(                                                                             \
-    dbcf_index log2n,                                                                         \
-    dbcf_index log2b,                                                                         \
-    type *LR,type *LI,                                                                        \
-    type *HR,type *HI,                                                                        \
-    type C,type S,                                                                            \
-    int inverse,                                                                              \
+DBCF_DEF int DBCF_NAME2(dbc_rfft,s)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+    dbcf_index src_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_rfft,s_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+    dbcf_index src_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_irfft,c)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_irfft,c_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_irfft,i)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_irfft,i_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_irfft,s)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_irfft,s_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_many,c)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_many,c_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_many,i)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_many,i_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_many,s)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_many,s_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_many,c)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_many,c_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_many,i)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_many,i_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_many,s)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_many,s_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft2d,c)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft2d,c_w)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft2d,i)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft2d,i_w)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_fftnd,c)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_fftnd,c_w)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_fftnd,i)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_fftnd,i_w)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft2d,c)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft2d,c_w)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft2d,i)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft2d,i_w)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifftnd,c)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifftnd,c_w)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifftnd,i)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifftnd,i_w)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF dbcf_index DBCF_NAME(dbc_fft_workspace_size)(
+    dbcf_index num_elements);
+
+DBCF_DEF dbcf_index DBCF_NAME(dbc_fft2d_workspace_size)(
+    dbcf_index num_rows,dbcf_index num_columns);
+
+DBCF_DEF dbcf_index DBCF_NAME(dbc_fftnd_workspace_size)(
+    dbcf_index rank,const dbcf_index *dims);
+
+DBCF_DEF dbcf_index DBCF_NAME(dbc_fft_io_workspace_size)(
+    dbcf_index num_elements);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft,io)(
+    dbcf_index num_elements,
+    const dbcf_io *src,
+    const dbcf_io *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft,io_w)(
+    dbcf_index num_elements,
+    const dbcf_io *src,
+    const dbcf_io *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft,io)(
+    dbcf_index num_elements,
+    const dbcf_io *src,
+    const dbcf_io *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft,io_w)(
+    dbcf_index num_elements,
+    const dbcf_io *src,
+    const dbcf_io *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF dbcf_index DBCF_NAME(dbc_fft_dist_workspace_size)(
+    dbcf_index n1,dbcf_index n2,
+    int num_ranks);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_dist,c)(
+    dbcf_index n1,dbcf_index n2,
+    const dbcf_dist *dist,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_dist,c_w)(
+    dbcf_index n1,dbcf_index n2,
+    const dbcf_dist *dist,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_dist,c)(
+    dbcf_index n1,dbcf_index n2,
+    const dbcf_dist *dist,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_dist,c_w)(
+    dbcf_index n1,dbcf_index n2,
+    const dbcf_dist *dist,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_numa,c)(
+    dbcf_index n1,dbcf_index n2,
+    const dbcf_numa *numa,
+    const DBCF_Type *const *src_real,const DBCF_Type *const *src_imag,
+          DBCF_Type *const *dst_real,      DBCF_Type *const *dst_imag,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_numa,c)(
+    dbcf_index n1,dbcf_index n2,
+    const dbcf_numa *numa,
+    const DBCF_Type *const *src_real,const DBCF_Type *const *src_imag,
+          DBCF_Type *const *dst_real,      DBCF_Type *const *dst_imag,
+    DBCF_Type scale);
+
+DBCF_DEF dbcf_plan *DBCF_NAME(dbc_fft_plan_create)(
+    dbcf_index num_elements,
+    int flags);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_execute,c)(
+    dbcf_plan *plan,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_execute,i)(
+    dbcf_plan *plan,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_execute,s)(
+    dbcf_plan *plan,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME(dbc_fft_plan_set_window)(
+    dbcf_plan *plan,
+    const DBCF_Type *window);
+
+DBCF_DEF int DBCF_NAME2(dbc_convolve,c)(
+    dbcf_index signal_length,
+    const DBCF_Type *signal_real,const DBCF_Type *signal_imag,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel_real,const DBCF_Type *kernel_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_convolve,i)(
+    dbcf_index signal_length,
+    const DBCF_Type *signal,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_correlate,c)(
+    dbcf_index signal_length,
+    const DBCF_Type *signal_real,const DBCF_Type *signal_imag,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel_real,const DBCF_Type *kernel_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_correlate,i)(
+    dbcf_index signal_length,
+    const DBCF_Type *signal,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF dbcf_conv *DBCF_NAME2(dbc_conv_create,c)(
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel_real,const DBCF_Type *kernel_imag,
+    dbcf_index block_length,
+    int flags);
+
+DBCF_DEF dbcf_conv *DBCF_NAME2(dbc_conv_create,i)(
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel,
+    dbcf_index block_length,
+    int flags);
+
+DBCF_DEF int DBCF_NAME2(dbc_conv_execute,c)(
+    dbcf_conv *conv,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_conv_execute,i)(
+    dbcf_conv *conv,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME(dbc_conv_reset)(
+    dbcf_conv *conv);
+
+DBCF_DEF dbcf_stft *DBCF_NAME(dbc_stft_create)(
+    dbcf_index fft_size,
+    dbcf_index hop,
+    const DBCF_Type *window,
+    int flags);
+
+DBCF_DEF int DBCF_NAME2(dbc_stft_execute,c)(
+    dbcf_stft *stft,
+    dbcf_index src_length,
+    const DBCF_Type *src,
+          DBCF_Type *dst_real,DBCF_Type *dst_imag,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_stft_execute,i)(
+    dbcf_stft *stft,
+    dbcf_index src_length,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_istft_execute,c)(
+    dbcf_stft *stft,
+    dbcf_index num_frames,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_istft_execute,i)(
+    dbcf_stft *stft,
+    dbcf_index num_frames,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME(dbc_stft_reset)(
+    dbcf_stft *stft);
+
+DBCF_DEF int DBCF_NAME(dbc_dct2)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_dct2,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME(dbc_dct2_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_dct2_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME(dbc_dct3)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_dct3,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME(dbc_dct3_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_dct3_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME(dbc_dct4)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_dct4,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME(dbc_dct4_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_dct4_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME(dbc_dst2)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_dst2,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME(dbc_dst2_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_dst2_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME(dbc_dst3)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_dst3,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME(dbc_dst3_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_dst3_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME(dbc_dst4)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_dst4,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME(dbc_dst4_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_dst4_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME(dbc_mdct)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_mdct,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME(dbc_mdct_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_mdct_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME(dbc_imdct)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_imdct,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF int DBCF_NAME(dbc_imdct_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+
+DBCF_DEF int DBCF_NAME2(dbc_imdct_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+
+DBCF_DEF dbcf_index DBCF_NAME(dbc_dct_workspace_size)(
+    dbcf_index num_elements);
+
+#ifdef __cplusplus
+}
+#endif
+
+/* Overloaded versions. */
+#if defined(__cplusplus) && !defined(DBC_FFT_NO_CPP_OVERLOADS)
+DBCF_DEF int dbc_fft(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+DBCF_DEF int dbc_fft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_ifft(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+DBCF_DEF int dbc_ifft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_fft(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_fft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_ifft(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_ifft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_fft(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale);
+DBCF_DEF int dbc_fft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_ifft(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale);
+DBCF_DEF int dbc_ifft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_rfft(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+DBCF_DEF int dbc_rfft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_rfft(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_rfft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_rfft(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+    dbcf_index src_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale);
+DBCF_DEF int dbc_rfft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+    dbcf_index src_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_irfft(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_irfft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_irfft(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_irfft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_irfft(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,
+    DBCF_Type scale);
+DBCF_DEF int dbc_irfft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_fft_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+DBCF_DEF int dbc_fft_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_fft_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_fft_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_fft_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+DBCF_DEF int dbc_fft_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_ifft_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+DBCF_DEF int dbc_ifft_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_ifft_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_ifft_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_ifft_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+DBCF_DEF int dbc_ifft_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_fft2d(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+DBCF_DEF int dbc_fft2d_w(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_fft2d(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_fft2d_w(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_fftnd(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+DBCF_DEF int dbc_fftnd_w(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_fftnd(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_fftnd_w(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_ifft2d(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+DBCF_DEF int dbc_ifft2d_w(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_ifft2d(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_ifft2d_w(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_ifftnd(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+DBCF_DEF int dbc_ifftnd_w(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_ifftnd(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_ifftnd_w(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_fft_execute(
+    dbcf_plan *plan,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+DBCF_DEF int dbc_fft_execute(
+    dbcf_plan *plan,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_fft_execute(
+    dbcf_plan *plan,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale);
+DBCF_DEF int dbc_fft_plan_set_window(
+    dbcf_plan *plan,
+    const DBCF_Type *window);
+DBCF_DEF int dbc_convolve(
+    dbcf_index signal_length,
+    const DBCF_Type *signal_real,const DBCF_Type *signal_imag,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel_real,const DBCF_Type *kernel_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+DBCF_DEF int dbc_convolve(
+    dbcf_index signal_length,
+    const DBCF_Type *signal,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_correlate(
+    dbcf_index signal_length,
+    const DBCF_Type *signal_real,const DBCF_Type *signal_imag,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel_real,const DBCF_Type *kernel_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+DBCF_DEF int dbc_correlate(
+    dbcf_index signal_length,
+    const DBCF_Type *signal,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF dbcf_conv *dbc_conv_create(
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel_real,const DBCF_Type *kernel_imag,
+    dbcf_index block_length,
+    int flags);
+DBCF_DEF dbcf_conv *dbc_conv_create(
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel,
+    dbcf_index block_length,
+    int flags);
+DBCF_DEF int dbc_conv_execute(
+    dbcf_conv *conv,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale);
+DBCF_DEF int dbc_conv_execute(
+    dbcf_conv *conv,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF dbcf_stft *dbc_stft_create(
+    dbcf_index fft_size,
+    dbcf_index hop,
+    const DBCF_Type *window,
+    int flags);
+DBCF_DEF int dbc_stft_execute(
+    dbcf_stft *stft,
+    dbcf_index src_length,
+    const DBCF_Type *src,
+          DBCF_Type *dst_real,DBCF_Type *dst_imag,
+    DBCF_Type scale);
+DBCF_DEF int dbc_stft_execute(
+    dbcf_stft *stft,
+    dbcf_index src_length,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_istft_execute(
+    dbcf_stft *stft,
+    dbcf_index num_frames,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_istft_execute(
+    dbcf_stft *stft,
+    dbcf_index num_frames,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_dct2(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_dct2_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_dct2_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+DBCF_DEF int dbc_dct2_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_dct3(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_dct3_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_dct3_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+DBCF_DEF int dbc_dct3_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_dct4(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_dct4_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_dct4_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+DBCF_DEF int dbc_dct4_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_dst2(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_dst2_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_dst2_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+DBCF_DEF int dbc_dst2_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_dst3(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_dst3_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_dst3_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+DBCF_DEF int dbc_dst3_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_dst4(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_dst4_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_dst4_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+DBCF_DEF int dbc_dst4_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_mdct(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_mdct_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_mdct_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+DBCF_DEF int dbc_mdct_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_imdct(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale);
+DBCF_DEF int dbc_imdct_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+DBCF_DEF int dbc_imdct_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale);
+DBCF_DEF int dbc_imdct_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size);
+#endif /* defined(__cplusplus) && !defined(DBC_FFT_NO_CPP_OVERLOADS) */
+
+#endif /* DBC_FFT_DECLARATION */
+
+/*============================================================================*/
+/* Implementation section. */
+#if defined(DBC_FFT_IMPLEMENTATION) && !defined(DBC_FFT_DECLARATION) && !defined(DBC_FFT_INSTANTIATION)
+
+#define DBCF_POW2(n) (((dbcf_index)1)<<(n))
+
+#ifndef DBCF_TMP_BUF_LOG2
+#define DBCF_TMP_BUF_LOG2 10
+#endif
+#define DBCF_TMP_BUF_SIZE DBCF_POW2(DBCF_TMP_BUF_LOG2)
+#define DBCF_TWIDDLES_BUF_LOG2 ((DBCF_TMP_BUF_LOG2)-1)
+#define DBCF_TWIDDLES_BUF_SIZE DBCF_POW2(DBCF_TWIDDLES_BUF_LOG2)
+#ifndef DBCF_BATCH_BUF_LOG2
+#define DBCF_BATCH_BUF_LOG2 ((DBCF_TMP_BUF_LOG2)+2)
+#endif
+#define DBCF_BATCH_BUF_SIZE DBCF_POW2(DBCF_BATCH_BUF_LOG2)
+#ifndef DBCF_ND_BLOCK
+#define DBCF_ND_BLOCK 16
+#endif
+#ifndef DBCF_IO_BLOCK
+#define DBCF_IO_BLOCK 64
+#endif
+#ifndef DBCF_STAGE_MIN
+#define DBCF_STAGE_MIN 64
+#endif
+#ifndef DBCF_STAGE_SIZE
+#define DBCF_STAGE_SIZE DBCF_POW2(18)
+#endif
+#define DBCF_STAGE_PAD 16
+#ifndef DBCF_DIF_MIN_LOG2
+#define DBCF_DIF_MIN_LOG2 16
+#endif
+#ifndef DBCF_MAX_RADIX
+#define DBCF_MAX_RADIX 31
+#endif
+/* Cost model of the inner sizes of Bluestein's algorithm (see dbcF_npot_cost). */
+#ifndef DBCF_NPOT_COST0
+#define DBCF_NPOT_COST0 4
+#endif
+#ifndef DBCF_NPOT_COST3
+#define DBCF_NPOT_COST3 24
+#endif
+#ifndef DBCF_NPOT_COST5
+#define DBCF_NPOT_COST5 36
+#endif
+/* Largest odd part of the inner sizes (at most 15, see dbcF_npot_measured). */
+#define DBCF_NPOT_MAX_ODD 15
+#ifndef DBCF_MEASURE_CACHE_SIZE
+#define DBCF_MEASURE_CACHE_SIZE 64
+#endif
+/* Timing of DBCF_PLAN_MEASURE: trials per candidate, and elements transformed per trial. */
+#define DBCF_MEASURE_TRIALS 3
+#define DBCF_MEASURE_ELEMENTS DBCF_POW2(14)
+/*
+    Radix-4 passes process the quarters in chunks of 2^DBCF_RADIX4_CHUNK_LOG2
+    elements (5 chunks of twiddles fit into the twiddle buffer), and are not
+    used if it is negative.
+*/
+#define DBCF_RADIX4_CHUNK_LOG2 ((DBCF_TWIDDLES_BUF_LOG2)-3)
+/* Size of the twiddle buffers of the mixed-radix passes. */
+#define DBCF_RADIX_BUF_SIZE (DBCF_TWIDDLES_BUF_SIZE/2>=DBCF_MAX_RADIX?DBCF_TWIDDLES_BUF_SIZE/2:DBCF_MAX_RADIX)
+#ifndef DBCF_Q /* Parameter Q from  "Towards an Optimal Bit-Reversal Permutation Program". */
+#define DBCF_Q (((DBCF_TMP_BUF_LOG2)>>1)<6?((DBCF_TMP_BUF_LOG2)>>1):6)
+#endif
+
+typedef int dbcF_static_assert_tmp_buf_size[(DBCF_TMP_BUF_LOG2)>=2                        ?1:-1];
+typedef int dbcF_static_assert_Q           [(DBCF_Q)>=1&&(2*(DBCF_Q)<=(DBCF_TMP_BUF_LOG2))?1:-1];
+typedef int dbcF_static_assert_max_radix   [(DBCF_MAX_RADIX)>=1                           ?1:-1];
+
+/* malloc replacement. */
+#ifndef dbcf_malloc
+#include <stddef.h>
+#include <stdlib.h>
+#define dbcf_malloc(n) malloc((size_t)(n))
+#define dbcf_free(p)   free(p)
+#endif
+
+/* Architecture detection. */
+#if defined(__i386__) || defined(_M_IX86) || defined(_X86_) || defined(__i386) || defined(__THW_INTEL)
+#define DBCF_X86
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__amd64)
+#define DBCF_X64
+#endif
+
+#if defined(DBCF_X86) || defined(DBCF_X64)
+#define DBCF_X86_OR_X64
+#endif
+
+#if defined(__aarch64__)
+#define DBCF_ARM64
+#endif
+
+#if defined(__riscv)
+#define DBCF_RISCV
+#endif
+
+/* Clock of the profiling (see dbc_fft_profile_get) and of DBCF_PLAN_MEASURE. */
+#if (defined(DBC_FFT_PROFILE) || !defined(DBC_FFT_NO_NPOT)) && !defined(dbcf_profile_clock)
+#if defined(__GNUC__) && defined(DBCF_X86_OR_X64)
+#define dbcf_profile_clock() ((double)__builtin_ia32_rdtsc())
+#elif defined(_MSC_VER) && defined(DBCF_X86_OR_X64)
+#include <intrin.h>
+#define dbcf_profile_clock() ((double)__rdtsc())
+#elif defined(__GNUC__) && defined(DBCF_ARM64)
+static double dbcF_profile_clock(void)
+{
+    unsigned long ret;
+    __asm__ __volatile__("mrs %0, cntvct_el0":"=r"(ret));
+    return (double)ret;
+}
+#define dbcf_profile_clock() dbcF_profile_clock()
+#else
+#include <time.h>
+#define dbcf_profile_clock() ((double)clock())
+#endif
+#endif /* dbcf_profile_clock */
+
+/* Profiling (see dbc_fft_profile_get). */
+#ifdef DBC_FFT_PROFILE
+
+#ifndef DBCF_THREAD_LOCAL
+#if defined(__cplusplus) && (__cplusplus>=201103L)
+#define DBCF_THREAD_LOCAL thread_local
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__>=201112L)
+#define DBCF_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define DBCF_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define DBCF_THREAD_LOCAL __declspec(thread)
+#else
+#define DBCF_THREAD_LOCAL
+#endif
+#endif /* DBCF_THREAD_LOCAL */
+
+/*
+    Nested entries into a stage (recursion, or a stage entered again
+    from inside itself) are counted and timed once, at the outermost level.
+*/
+typedef struct dbcF_profile_state
+{
+    dbcf_profile counters;
+    double start[DBCF_PROFILE_STAGES];
+    int depth[DBCF_PROFILE_STAGES];
+} dbcF_profile_state;
+
+static DBCF_THREAD_LOCAL dbcF_profile_state dbcF_profile;
+
+static void dbcF_profile_clear(dbcf_profile *profile)
+{
+    int i,j;
+    for(i=0;i<DBCF_PROFILE_STAGES;++i) profile->calls[i]=profile->ticks[i]=0.0;
+    for(i=0;i<4;++i) for(j=0;j<DBCF_PROFILE_VARIANTS;++j) profile->simd[i][j]=0.0;
+    for(i=0;i<DBCF_PROFILE_FALLBACKS;++i) profile->fallbacks[i]=0.0;
+}
+
+static void dbcF_profile_enter(int stage)
+{
+    if(dbcF_profile.depth[stage]++) return;
+    dbcF_profile.counters.calls[stage]+=1.0;
+    dbcF_profile.start[stage]=dbcf_profile_clock();
+}
+
+static void dbcF_profile_leave(int stage)
+{
+    if(--dbcF_profile.depth[stage]) return;
+    dbcF_profile.counters.ticks[stage]+=dbcf_profile_clock()-dbcF_profile.start[stage];
+}
+
+#define DBCF_PROFILE_ENTER(stage)          dbcF_profile_enter(stage)
+#define DBCF_PROFILE_LEAVE(stage)          dbcF_profile_leave(stage)
+#define DBCF_PROFILE_KERNEL(width,variant) ((void)(dbcF_profile.counters.simd[(width)>=16?3:(width)>=8?2:(width)>=4?1:0][variant]+=1.0))
+#define DBCF_PROFILE_FALLBACK(reason)      ((void)(dbcF_profile.counters.fallbacks[reason]+=1.0))
+
+DBCF_DEF void dbc_fft_profile_get(dbcf_profile *profile)
+{
+    if(profile) *profile=dbcF_profile.counters;
+}
+
+DBCF_DEF void dbc_fft_profile_reset(void)
+{
+    dbcF_profile_clear(&dbcF_profile.counters);
+}
+
+DBCF_DEF const char *dbc_fft_profile_stage_name(int stage)
+{
+    static const char *const names[DBCF_PROFILE_STAGES]={"bitreversal","twiddles","simd","scalar","copy","heap","join"};
+    return (stage>=0&&stage<DBCF_PROFILE_STAGES?names[stage]:0);
+}
+#else
+#define DBCF_PROFILE_ENTER(stage)          ((void)0)
+#define DBCF_PROFILE_LEAVE(stage)          ((void)0)
+#define DBCF_PROFILE_KERNEL(width,variant) ((void)0)
+#define DBCF_PROFILE_FALLBACK(reason)      ((void)0)
+#endif /* DBC_FFT_PROFILE */
+
+/*
+    Words shared between threads without a lock (the cache of
+    DBCF_PLAN_MEASURE, see dbcF_npot_measured), loaded and stored the same
+    way as the SIMD detection cache (see dbcf_detect_simd).
+*/
+#ifndef DBC_FFT_NO_NPOT
+#if defined(__ATOMIC_RELAXED)
+typedef dbcf_index dbcF_atomic_index;
+#define DBCF_ATOMIC_LOAD(p)    __atomic_load_n((p),__ATOMIC_RELAXED)
+#define DBCF_ATOMIC_STORE(p,x) __atomic_store_n((p),(x),__ATOMIC_RELAXED)
+#elif defined(__cplusplus) && (__cplusplus>=201103L)
+#include <atomic>
+typedef std::atomic<dbcf_index> dbcF_atomic_index;
+#define DBCF_ATOMIC_LOAD(p)    (p)->load(std::memory_order_relaxed)
+#define DBCF_ATOMIC_STORE(p,x) (p)->store((x),std::memory_order_relaxed)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__>=201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+typedef _Atomic(dbcf_index) dbcF_atomic_index;
+#define DBCF_ATOMIC_LOAD(p)    atomic_load_explicit((p),memory_order_relaxed)
+#define DBCF_ATOMIC_STORE(p,x) atomic_store_explicit((p),(x),memory_order_relaxed)
+#else
+typedef volatile dbcf_index dbcF_atomic_index;
+#define DBCF_ATOMIC_LOAD(p)    (*(p))
+#define DBCF_ATOMIC_STORE(p,x) (*(p)=(x))
+#endif
+#endif /* DBC_FFT_NO_NPOT */
+
+/* 8-bit bitreverse table. */
+#ifndef DBC_FFT_NO_BITREVERSE_TABLE
+static unsigned char dbcF_bitreverse_table[512]=
+{
+/* Adapted from https://graphics.stanford.edu/~seander/bithacks.html#BitReverseTable . */
+#define DBCF_R1(n,c) n,n+c
+#define DBCF_R2(n,c) DBCF_R1(n,2*c),DBCF_R1(n+c,2*c)
+#define DBCF_R3(n,c) DBCF_R2(n,2*c),DBCF_R2(n+c,2*c)
+#define DBCF_R4(n,c) DBCF_R3(n,2*c),DBCF_R3(n+c,2*c)
+#define DBCF_R5(n,c) DBCF_R4(n,2*c),DBCF_R4(n+c,2*c)
+#define DBCF_R6(n,c) DBCF_R5(n,2*c),DBCF_R5(n+c,2*c)
+#define DBCF_R7(n,c) DBCF_R6(n,2*c),DBCF_R6(n+c,2*c)
+#define DBCF_R8(n,c) DBCF_R7(n,2*c),DBCF_R7(n+c,2*c)
+0,0,DBCF_R1(0,1),DBCF_R2(0,1),DBCF_R3(0,1),DBCF_R4(0,1),DBCF_R5(0,1),DBCF_R6(0,1),DBCF_R7(0,1),DBCF_R8(0,1)
+#undef DBCF_R1
+#undef DBCF_R2
+#undef DBCF_R3
+#undef DBCF_R4
+#undef DBCF_R5
+#undef DBCF_R6
+#undef DBCF_R7
+#undef DBCF_R8
+};
+#endif /* DBC_FFT_NO_BITREVERSE_TABLE */
+
+static dbcf_index dbcF_bitreverse(dbcf_index i,dbcf_index bits)
+{
+#ifndef DBC_FFT_NO_BITREVERSE_TABLE
+    if(bits<=8) return (dbcF_bitreverse_table+DBCF_POW2(bits))[i];
+    return ((dbcf_index)((dbcF_bitreverse_table+256)[i&255])<<(bits-8))^dbcF_bitreverse(i>>8,bits-8);
+#else
+    dbcf_index j=i&255,b=(bits<8?bits:8);
+    j=(j>>4)^(j<<4);
+    j=((j&0xCC)>>2)^((j&0x33)<<2);
+    j=((j&0xAA)>>1)^((j&0x55)<<1);
+    j=j>>(8-b);
+    if(bits>8) j=(j<<(bits-8))^dbcF_bitreverse(i>>8,bits-8);
+    return j;
+#endif
+}
+
+/* SIMD feature detection flags. */
+#define DBCF_HAS_SIMD4F   1
+#define DBCF_HAS_SIMD2D   2 
+#define DBCF_HAS_SIMD8F   4 
+#define DBCF_HAS_SIMD4D   8
+#define DBCF_HAS_SIMD16F 16 
+#define DBCF_HAS_SIMD8D  32
+/* Not a SIMD width: the half-precision conversions (see dbc_fft_hc). */
+#define DBCF_HAS_F16C    64
+/* Not SIMD widths either: the Q15 butterflies (see dbc_fft_plan_create_q15). */
+#define DBCF_HAS_SSSE3  128
+#define DBCF_HAS_AVX2   256
+/* Nor is FMA: the double-double passes (see DBC_FFT_DOUBLE_DOUBLE). */
+#define DBCF_HAS_FMA    512
+
+#if (defined(__MINGW32__)||defined(__MINGW64__))&&!defined(DBCF_X64)
+#if !defined(DBC_FFT_ENABLE_MINGW_SIMD) && !defined(DBC_FFT_NO_SIMD) && !defined(DBC_FFT_FORCE_SIMD)
+#define DBC_FFT_NO_SIMD
+#endif
+#endif
+
+#if defined(DBC_FFT_FORCE_SIMD) && defined(DBC_FFT_NO_SIMD)
+#error Both DBC_FFT_FORCE_SIMD and DBC_FFT_NO_SIMD are specified
+#endif
+
+/* Runtime detection of fixed-length SVE and RVV (see SIMD). */
+#if defined(DBC_FFT_SVE_BITS) || defined(DBC_FFT_RVV)
+#error DBC_FFT_SVE_BITS and DBC_FFT_RVV are now DBC_FFT_SVE_FIXED_BITS and DBC_FFT_RVV_FIXED_BITS
+#endif
+#if defined(__GNUC__) && !defined(DBC_FFT_NO_SIMD) && !defined(DBC_FFT_FORCE_SIMD)
+#if defined(DBCF_ARM64) && defined(DBC_FFT_SVE_FIXED_BITS)
+#define DBCF_ARM64_SVE
+#if defined(__clang__)
+#define DBCF_SVE_TARGET __attribute__((target("sve")))
+#else
+#define DBCF_SVE_TARGET __attribute__((target("+sve")))
+#endif
+#if DBC_FFT_SVE_FIXED_BITS==256
+#define DBCF_NO_SIMD16F
+#define DBCF_NO_SIMD8D
+#elif DBC_FFT_SVE_FIXED_BITS==512
+#define DBCF_NO_SIMD8F
+#define DBCF_NO_SIMD4D
+#else
+#error DBC_FFT_SVE_FIXED_BITS must be 256 or 512
+#endif
+#elif defined(DBCF_RISCV) && defined(DBC_FFT_RVV_FIXED_BITS)
+#define DBCF_RISCV_RVV
+#define DBCF_RVV_TARGET __attribute__((target("arch=+v")))
+#if DBC_FFT_RVV_FIXED_BITS==128
+#define DBCF_NO_SIMD8F
+#define DBCF_NO_SIMD4D
+#define DBCF_NO_SIMD16F
+#define DBCF_NO_SIMD8D
+#elif DBC_FFT_RVV_FIXED_BITS==256
+#define DBCF_NO_SIMD16F
+#define DBCF_NO_SIMD8D
+#elif DBC_FFT_RVV_FIXED_BITS!=512
+#error DBC_FFT_RVV_FIXED_BITS must be 128, 256 or 512
+#endif
+#endif
+#endif
+
+#if defined(__GNUC__) && (defined(__ARM_NEON)||defined(__ARM_NEON__)) && !defined(DBC_FFT_NO_SIMD) && !defined(DBC_FFT_FORCE_SIMD) && !defined(DBCF_ARM64_SVE)
+#define DBC_FFT_FORCE_SIMD (DBCF_HAS_SIMD4F|DBCF_HAS_SIMD2D)
+#endif
+
+#if !defined(DBCF_X86_OR_X64) && !defined(DBCF_ARM64_SVE) && !defined(DBCF_RISCV_RVV) && !defined(DBC_FFT_NO_SIMD) && !defined(DBC_FFT_FORCE_SIMD)
+#define DBC_FFT_NO_SIMD
+#endif
+
+#if !defined(DBCF_X86_OR_X64) && !defined(__GNUC__) && defined(DBC_FFT_FORCE_SIMD)
+/* DBC_FFT_FORCE_SIMD is only supported on x86/x64 or for __GNUC__ compilers. */
+#error DBC_FFT_FORCE_SIMD is not supported for this platform
+#endif
+
+#if !defined(DBCF_X86_OR_X64)
+#if defined(DBC_FFT_NO_AVX)
+#undef DBC_FFT_NO_AVX
+#endif
+#if defined(DBC_FFT_NO_AVX512)
+#undef DBC_FFT_NO_AVX512
+#endif
+#endif
+
+#if defined(DBCF_X86_OR_X64)
+#if defined(DBC_FFT_NO_AVX)
+#define DBCF_NO_SIMD8F
+#define DBCF_NO_SIMD4D
+#define DBCF_NO_F16C
+#define DBCF_NO_AVX2
+#define DBCF_NO_FMA
+#endif
+#if defined(DBC_FFT_NO_AVX512)
+#define DBCF_NO_SIMD16F
+#define DBCF_NO_SIMD8D
+#endif
+#endif /* defined(DBCF_X86_OR_X64) */
+
+#if defined(DBC_FFT_FORCE_SIMD)
+#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_SIMD4F)
+#define DBCF_NO_SIMD4F
+#endif
+#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_SIMD8F)
+#define DBCF_NO_SIMD8F
+#endif
+#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_SIMD16F)
+#define DBCF_NO_SIMD16F
+#endif
+#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_SIMD2D)
+#define DBCF_NO_SIMD2D
+#endif
+#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_SIMD4D)
+#define DBCF_NO_SIMD4D
+#endif
+#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_SIMD8D)
+#define DBCF_NO_SIMD8D
+#endif
+#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_F16C)
+#define DBCF_NO_F16C
+#endif
+#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_SSSE3)
+#define DBCF_NO_SSSE3
+#endif
+#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_AVX2)
+#define DBCF_NO_AVX2
+#endif
+#if !((DBC_FFT_FORCE_SIMD)&DBCF_HAS_FMA)
+#define DBCF_NO_FMA
+#endif
+#endif /* defined(DBC_FFT_FORCE_SIMD) */
+
+#if defined(DBC_FFT_USE_VECTOR_EXTENSIONS) && defined(DBC_FFT_USE_INTRINSICS)
+#error Both DBC_FFT_USE_VECTOR_EXTENSIONS and DBC_FFT_USE_INTRINSICS are specified
+#endif
+
+#if !defined(DBC_FFT_USE_VECTOR_EXTENSIONS) && !defined(DBC_FFT_USE_INTRINSICS)
+#if defined(__GNUC__) || !defined(DBCF_X86_OR_X64)
+#define DBC_FFT_USE_VECTOR_EXTENSIONS
+#else
+#define DBC_FFT_USE_INTRINSICS
+#endif
+#endif
+
+#if defined(DBC_FFT_CACHE_CPU_DETECTION) && defined(DBC_FFT_DONT_CACHE_CPU_DETECTION)
+#error Both DBC_FFT_CACHE_CPU_DETECTION and DBC_FFT_DONT_CACHE_CPU_DETECTION are specified
+#endif
+
+/* Alignment specifiers. */
+#if defined(__GNUC__)
+#define DBCF_ALIGNED(n) __attribute__((aligned(n)))
+#elif defined(_MSC_VER)
+#define DBCF_ALIGNED(n) __declspec(align(n))
+#else
+#define DBCF_NO_ALIGNMENT
+#define DBCF_ALIGNED(n)
+#endif
+
+/* Is this reliable? */
+#define DBCF_IS_ALIGNED(p,n) ((((dbcf_index)(p))&((dbcf_index)(n)-1))==0)
+
+/* SIMD stuff. */
+#if !defined(DBC_FFT_NO_SIMD)
+
+#if !defined(DBC_FFT_FORCE_SIMD) && !defined(dbcf_detect_simd) && defined(DBCF_X86_OR_X64) && !defined(_WIN16)
+/*
+    x86 runtime CPU detection.
+
+    We need to check both CPU-level support and OS-level support. This
+    is because the OS needs know to preserve SIMD state on context switch.
+    Generally, the corresponding instructions are disabled (cause exception
+    if used) on OSes that do not support them. XGETBV is used to check
+    OS-level support for AVX and AVX512. Some older OSes (Windows 95 and
+    earlier, Linux kernel before something like 2.4) may not have the
+    OS-level support for SSE (do not preserve the state on context switch).
+    The dbc_fft.h does not check for it. If you need to support them,
+    consider checking it yourself and providing a custom dbcf_detect_simd.
+
+    SSE2 is used as a minimum SIMD target on x86, even if SSE could
+    suffice for float. This is because SSE can result in slow code
+    with x86 GCC ( https://godbolt.org/z/4T7fx5b7o ), as well as in x64.
+*/
+#if !defined(__GNUC__) && (!defined(_MSC_VER) || (_MSC_VER>=1400))
+#include <intrin.h>
+#endif
+
+/* All Pentiums and later should have CPUID. Some later 486s have it as well. */
+static int dbcF_has_cpuid(void)
+{
+#if defined(DBCF_X64)
+    return 1; /* Always have CPUID on x64. */
+#elif defined(__GNUC__)
+    /* Check by trying to set the 21st bit in EFLAGS. */
+    unsigned a,b;
+    __asm__ __volatile__(
+        "pushfl\n\t"
+        "pushfl\n\t"
+        "popl %0\n\t"
+        "movl %0,%1\n\t"
+        "xorl $0x00200000,%0\n\t"
+        "pushl %0\n\t"
+        "popfl\n\t"
+        "pushfl\n\t"
+        "popl %0\n\t"
+        "popfl\n\t"
+	:"=&r"(a),"=&r"(b));
+    return !!((a^b)&0x00200000u);
+#else
+    return 1; /* Assume the CPU has CPUID. */
+#endif
+}
+
+static void dbcF_cpuid(int level,int sublevel,unsigned *eax,unsigned *ebx,unsigned *ecx,unsigned *edx)
+{
+#if defined(__GNUC__)
+    unsigned a,b,c,d;
+    __asm__ __volatile__(
+        "cpuid\n\t"
+        :"=a"(a),"=b"(b),"=c"(c),"=d"(d)
+        :"0"(level),"2"(sublevel));
+    *eax=a;
+    *ebx=b;
+    *ecx=c;
+    *edx=d;
+#elif defined(_MSC_VER) && !(_MSC_VER>=1400) /* VC6 */
+    int res;
+    __asm {
+        mov  eax,1
+        cpuid
+        mov  res,edx
+    }
+    /* Only check edx. */
+    *eax=0;
+    *ebx=0;
+    *ecx=0;
+    *edx=(unsigned)res;
+#else
+    int regs[4];
+    __cpuidex(regs,level,sublevel);
+    *eax=(unsigned)regs[0];
+    *ebx=(unsigned)regs[1];
+    *ecx=(unsigned)regs[2];
+    *edx=(unsigned)regs[3];
+#endif
+}
+
+/* Only return lower 32 bits of xgetbv. */
+static unsigned dbcF_xgetbv(unsigned level)
+{
+    unsigned ret=0;
+#if defined(__GNUC__)
+    /*
+        Using __builtin_ia32_xgetbv (or _xgetbv intrinsic) needs the function
+        to be compiled as AVX or higher, but using xgetbv from within the
+        inline assembly does not. Seems to cause no problems (as long as
+        the availability of XGETBV is checked at runtime).
+    */
+    unsigned eax,edx;
+    __asm__ __volatile__("xgetbv\n\t":"=a"(eax),"=d"(edx):"c"(level));
+    ret=eax; /* Full result: eax^((unsigned long long)edx<<32). */
+#elif defined(_MSC_VER) && !(_MSC_VER>=1400) /* VC6 */
+    /* Pretend that xgetbv always returns 0. */
+#else
+    ret=(unsigned)_xgetbv(level);
+#endif
+    return ret;
+}
+#endif /* !defined(DBC_FFT_FORCE_SIMD) && !defined(dbcf_detect_simd) && defined(DBCF_X86_OR_X64) && !defined(_WIN16) */
+
+#if !defined(dbcf_detect_simd) && (defined(DBCF_ARM64_SVE) || defined(DBCF_RISCV_RVV)) && defined(__linux__)
+#include <sys/auxv.h>
+#if defined(DBCF_ARM64_SVE)
+#include <sys/prctl.h>
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1UL<<22)
+#endif
+#ifndef PR_SVE_GET_VL
+#define PR_SVE_GET_VL 51
+#endif
+#ifndef PR_SVE_VL_LEN_MASK
+#define PR_SVE_VL_LEN_MASK 0xffff
+#endif
+#else
+/* The single-letter extensions are reported as bits of AT_HWCAP. */
+#define DBCF_HWCAP_RVV (1UL<<('V'-'A'))
+
+DBCF_RVV_TARGET static unsigned long dbcF_rvv_vlenb(void)
+{
+    unsigned long vlenb;
+    __asm__ __volatile__("csrr %0, vlenb":"=r"(vlenb));
+    return vlenb;
+}
+#endif /* defined(DBCF_ARM64_SVE) */
+#endif
+
+#ifndef dbcf_detect_simd
+static int dbcF_detect_simd(void)
+{
+    int ret=0;
+#if defined(DBC_FFT_FORCE_SIMD)
+    ret=(DBC_FFT_FORCE_SIMD);
+#elif defined(DBCF_ARM64_SVE)
+    /* NEON is mandatory in AArch64. */
+    ret=DBCF_HAS_SIMD4F|DBCF_HAS_SIMD2D;
+#if defined(__linux__)
+    /*
+        The SVE kernels are compiled for exactly DBC_FFT_SVE_FIXED_BITS
+        (-msve-vector-bits), so the vector length must match.
+    */
+    if(getauxval(AT_HWCAP)&HWCAP_SVE)
+    {
+        int vl=prctl(PR_SVE_GET_VL,0,0,0,0);
+        if(vl>=0&&(vl&PR_SVE_VL_LEN_MASK)==(DBC_FFT_SVE_FIXED_BITS)/8)
+            ret|=((DBC_FFT_SVE_FIXED_BITS)==256?DBCF_HAS_SIMD8F|DBCF_HAS_SIMD4D:DBCF_HAS_SIMD16F|DBCF_HAS_SIMD8D);
+    }
+#endif
+#elif defined(DBCF_RISCV_RVV)
+#if defined(__linux__)
+    /*
+        The kernels are compiled for exactly DBC_FFT_RVV_FIXED_BITS
+        (-mrvv-vector-bits=zvl), so VLEN must match. The widths up to VLEN
+        each fit a single vector register; wider ones would need register
+        groups, and are not compiled.
+    */
+    if((getauxval(AT_HWCAP)&DBCF_HWCAP_RVV)&&dbcF_rvv_vlenb()==(DBC_FFT_RVV_FIXED_BITS)/8)
+    {
+        ret|=DBCF_HAS_SIMD4F |DBCF_HAS_SIMD2D;
+        if((DBC_FFT_RVV_FIXED_BITS)>=256) ret|=DBCF_HAS_SIMD8F |DBCF_HAS_SIMD4D;
+        if((DBC_FFT_RVV_FIXED_BITS)>=512) ret|=DBCF_HAS_SIMD16F|DBCF_HAS_SIMD8D;
+    }
+#endif
+#elif defined(DBCF_X86_OR_X64)
+    /* Compile-time CPU detection. */
+#if defined(__SSE2__) || (_M_IX86_FP>=2) /* MSVC does not have __SSE2__ macro. */
+    ret|=DBCF_HAS_SIMD4F |DBCF_HAS_SIMD2D;
+#endif
+#if defined(__SSSE3__)
+    ret|=DBCF_HAS_SSSE3;
+#endif
+#if !defined(DBC_FFT_NO_AVX) && defined(__AVX__)
+    ret|=DBCF_HAS_SIMD8F |DBCF_HAS_SIMD4D;
+#endif
+#if !defined(DBC_FFT_NO_AVX) && defined(__F16C__)
+    ret|=DBCF_HAS_F16C;
+#endif
+#if !defined(DBC_FFT_NO_AVX) && defined(__AVX2__)
+    ret|=DBCF_HAS_AVX2;
+#endif
+#if !defined(DBC_FFT_NO_AVX) && defined(__FMA__)
+    ret|=DBCF_HAS_FMA;
+#endif
+#if !defined(DBC_FFT_NO_AVX512) && defined(__AVX512F__)
+    ret|=DBCF_HAS_SIMD16F|DBCF_HAS_SIMD8D;
+#endif
+#if !defined(_WIN16)
+    /* Runtime CPU detection. */
+    if(dbcF_has_cpuid())
+    {
+        unsigned eax,ebx,ecx,edx;
+        unsigned maxlevel;
+        dbcF_cpuid(0,0,&maxlevel,&ebx,&ecx,&edx);
+        if(maxlevel>0)
+        {
+            dbcF_cpuid(1,0,&eax,&ebx,&ecx,&edx);
+            if(edx&0x04000000u) ret|=DBCF_HAS_SIMD4F |DBCF_HAS_SIMD2D; /* SSE2 */
+            if(ecx&0x00000200u) ret|=DBCF_HAS_SSSE3; /* SSSE3 */
+#if !defined(DBC_FFT_NO_AVX)
+            if(ecx&0x18000000u) /* CPU has AVX & XGETBV. */
+            {
+                unsigned xcr0=dbcF_xgetbv(0);
+                if((xcr0&0x6)==0x6) /* OS-level support for AVX. */
+                {
+                    ret|=DBCF_HAS_SIMD8F |DBCF_HAS_SIMD4D; /* AVX */
+                    if(ecx&0x20000000u) ret|=DBCF_HAS_F16C; /* F16C */
+                    if(ecx&0x00001000u) ret|=DBCF_HAS_FMA; /* FMA */
+                    if(maxlevel>=7)
+                    {
+                        dbcF_cpuid(7,0,&eax,&ebx,&ecx,&edx);
+                        if(ebx&0x00000020u) ret|=DBCF_HAS_AVX2; /* AVX2 */
+#if !defined(DBC_FFT_NO_AVX512)
+                        if((xcr0&0xE6)==0xE6) /* OS-level support for AVX512. */
+                        {
+                            if(ebx&0x00010000u) ret|=DBCF_HAS_SIMD16F|DBCF_HAS_SIMD8D; /* AVX512 */
+                        }
+#endif
+                    }
+                }
+            }
+#endif
+        }
+
+    }
+#endif /* !defined(_WIN16) */
+#endif /* defined(DBC_FFT_FORCE_SIMD) */
+    return ret;
+}
+
+#if !defined(DBC_FFT_DONT_CACHE_CPU_DETECTION)
+/*
+    The detection result is cached, with DBCF_SIMD_DETECTED added, so
+    that 0 means "not detected yet". Threads making their first call
+    concurrently may each run the detection, but they all store the same
+    value, so no lock or once-flag is needed. The atomic load/store only
+    makes this well-defined (no ordering is required, as nothing else
+    is published through it).
+*/
+#define DBCF_SIMD_DETECTED 0x40000000
+#if defined(__ATOMIC_RELAXED)
+static int dbcF_simd_cache=0;
+#define DBCF_SIMD_CACHE_LOAD()   __atomic_load_n(&dbcF_simd_cache,__ATOMIC_RELAXED)
+#define DBCF_SIMD_CACHE_STORE(x) __atomic_store_n(&dbcF_simd_cache,(x),__ATOMIC_RELAXED)
+#elif defined(__cplusplus) && (__cplusplus>=201103L)
+#include <atomic>
+static std::atomic<int> dbcF_simd_cache(0);
+#define DBCF_SIMD_CACHE_LOAD()   dbcF_simd_cache.load(std::memory_order_relaxed)
+#define DBCF_SIMD_CACHE_STORE(x) dbcF_simd_cache.store((x),std::memory_order_relaxed)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__>=201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+static atomic_int dbcF_simd_cache=0;
+#define DBCF_SIMD_CACHE_LOAD()   atomic_load_explicit(&dbcF_simd_cache,memory_order_relaxed)
+#define DBCF_SIMD_CACHE_STORE(x) atomic_store_explicit(&dbcF_simd_cache,(x),memory_order_relaxed)
+#else
+/* Aligned int loads and stores are atomic on every platform with SIMD support (MSVC included). */
+static volatile int dbcF_simd_cache=0;
+#define DBCF_SIMD_CACHE_LOAD()   (dbcF_simd_cache)
+#define DBCF_SIMD_CACHE_STORE(x) (dbcF_simd_cache=(x))
+#endif
+#endif /* !defined(DBC_FFT_DONT_CACHE_CPU_DETECTION) */
+
+static int dbcf_detect_simd(void)
+{
+#if !defined(DBC_FFT_DONT_CACHE_CPU_DETECTION)
+    int ret=DBCF_SIMD_CACHE_LOAD();
+    if(!ret)
+    {
+        ret=dbcF_detect_simd()|DBCF_SIMD_DETECTED;
+        DBCF_SIMD_CACHE_STORE(ret);
+    }
+    return ret&~DBCF_SIMD_DETECTED;
+#else
+    return dbcF_detect_simd();
+#endif /* !defined(DBC_FFT_DONT_CACHE_CPU_DETECTION) */
+}
+#endif /* dbcf_detect_simd */
+
+#if defined(DBC_FFT_USE_VECTOR_EXTENSIONS)
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD4F)
+typedef float  dbcf_simd4f  __attribute__((vector_size(16)));
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD2D)
+typedef double dbcf_simd2d  __attribute__((vector_size(16)));
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD8F)
+typedef float  dbcf_simd8f  __attribute__((vector_size(32)));
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD4D)
+typedef double dbcf_simd4d  __attribute__((vector_size(32)));
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD16F)
+typedef float  dbcf_simd16f __attribute__((vector_size(64)));
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD8D)
+typedef double dbcf_simd8d  __attribute__((vector_size(64)));
+#endif
+#elif defined(DBCF_X86_OR_X64)
+#include <emmintrin.h>
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD4F)
+typedef __m128  dbcf_simd4f;
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD2D)
+typedef __m128d dbcf_simd2d;
+#endif
+#ifndef DBC_FFT_NO_AVX
+#include <immintrin.h>
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD8F)
+typedef __m256  dbcf_simd8f;
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD4D)
+typedef __m256d dbcf_simd4d;
+#endif
+#endif /* DBC_FFT_NO_AVX */
+#ifndef DBC_FFT_NO_AVX512
+#include <immintrin.h>
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD16F)
+typedef __m512  dbcf_simd16f;
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD8D)
+typedef __m512d dbcf_simd8d;
+#endif
+#endif /* DBC_FFT_NO_AVX512 */
+#endif /* defined(DBC_FFT_USE_VECTOR_EXTENSIONS) */
+
+/* SIMD functions attributes. */
+#ifdef DBCF_X86_OR_X64
+#if defined(__GNUC__)
+#if defined(__SSE2__)
+/*
+    SSE2 is already globally enabled. No need to specify it,
+    and possibly constrain the compiler from using better
+    instructions.
+*/
+#define DBCF_AUTODECL_SIMD4F
+#define DBCF_AUTODECL_SIMD2D
+#else
+/*
+    Note: stdcall is there to work around the problem, pointed by
+    "error: calling 'function' with SSE calling convention without SSE/SSE2 enabled"
+    diagnostic. Short version: GCC seems to see fit to use SSE
+    calling convention on static SSE functions, breaking the calls from
+    FPU functions. So does clang, except with no error message.
+    Using stdcall overrides that. Possibly unnecessary in this case,
+    since the behavior seems to be triggered only if the function
+    uses floating point arguments/returns.
+    Note: fpmath=sse is not used, as it is not needed (SSE is only used for SIMD),
+    and introduces additional hassle.
+*/
+#define DBCF_AUTODECL_SIMD4F __attribute__((target("sse2"),stdcall))
+#define DBCF_AUTODECL_SIMD2D __attribute__((target("sse2"),stdcall))
+#endif /* defined(__SSE2__) */
+#else
+#define DBCF_AUTODECL_SIMD4F
+#define DBCF_AUTODECL_SIMD2D
+#endif /* defined(__GNUC__) */
+
+#if defined(__GNUC__)
+#if defined(__AVX2__)
+/*
+    AVX2 is already globally enabled. No need to specify it,
+    and possibly constrain the compiler from using better
+    instructions.
+*/
+#define DBCF_AUTODECL_SIMD8F
+#define DBCF_AUTODECL_SIMD4D
+#else
+#ifdef DBCF_X64
+#define DBCF_AUTODECL_SIMD8F __attribute__((target("avx"))) /* No stdcall in x64. */
+#define DBCF_AUTODECL_SIMD4D __attribute__((target("avx"))) /* No stdcall in x64. */
+#else
+#define DBCF_AUTODECL_SIMD8F __attribute__((target("avx"),stdcall))
+#define DBCF_AUTODECL_SIMD4D __attribute__((target("avx"),stdcall))
+#endif /* DBCF_X64 */
+#endif /* defined(__AVX2__) */
+#else
+#define DBCF_AUTODECL_SIMD8F
+#define DBCF_AUTODECL_SIMD4D
+#endif /* defined(__GNUC__) */
+
+#if defined(__GNUC__)
+#if defined(__AVX512F__)
+/*
+    AVX512F is already globally enabled. No need to specify it,
+    and possibly constrain the compiler from using better
+    instructions.
+*/
+#define DBCF_AUTODECL_SIMD16F
+#define DBCF_AUTODECL_SIMD8D
+#else
+#ifdef DBCF_X64
+#define DBCF_AUTODECL_SIMD16F __attribute__((target("avx512f"))) /* No stdcall in x64. */
+#define DBCF_AUTODECL_SIMD8D  __attribute__((target("avx512f"))) /* No stdcall in x64. */
+#else
+#define DBCF_AUTODECL_SIMD16F __attribute__((target("avx512f"),stdcall))
+#define DBCF_AUTODECL_SIMD8D  __attribute__((target("avx512f"),stdcall))
+#endif /* DBCF_X64 */
+#endif /* defined(__AVX512F__) */
+#else
+#define DBCF_AUTODECL_SIMD16F
+#define DBCF_AUTODECL_SIMD8D
+#endif /* defined(__GNUC__) */
+
+#elif defined(DBCF_ARM64_SVE)
+/* NEON is the baseline, only the wider kernels are SVE. */
+#define DBCF_AUTODECL_SIMD4F
+#define DBCF_AUTODECL_SIMD2D
+#define DBCF_AUTODECL_SIMD8F  DBCF_SVE_TARGET
+#define DBCF_AUTODECL_SIMD4D  DBCF_SVE_TARGET
+#define DBCF_AUTODECL_SIMD16F DBCF_SVE_TARGET
+#define DBCF_AUTODECL_SIMD8D  DBCF_SVE_TARGET
+#elif defined(DBCF_RISCV_RVV)
+#define DBCF_AUTODECL_SIMD4F  DBCF_RVV_TARGET
+#define DBCF_AUTODECL_SIMD2D  DBCF_RVV_TARGET
+#define DBCF_AUTODECL_SIMD8F  DBCF_RVV_TARGET
+#define DBCF_AUTODECL_SIMD4D  DBCF_RVV_TARGET
+#define DBCF_AUTODECL_SIMD16F DBCF_RVV_TARGET
+#define DBCF_AUTODECL_SIMD8D  DBCF_RVV_TARGET
+#else
+#define DBCF_AUTODECL_SIMD4F
+#define DBCF_AUTODECL_SIMD2D
+#define DBCF_AUTODECL_SIMD8F
+#define DBCF_AUTODECL_SIMD4D
+#define DBCF_AUTODECL_SIMD16F
+#define DBCF_AUTODECL_SIMD8D
+#endif /* DBCF_X86_OR_X64 */
+
+/* Allow custom declarations. */
+#ifndef DBCF_DECL_SIMD4F
+#define DBCF_DECL_SIMD4F DBCF_AUTODECL_SIMD4F
+#endif
+#ifndef DBCF_DECL_SIMD2D
+#define DBCF_DECL_SIMD2D DBCF_AUTODECL_SIMD2D
+#endif
+#ifndef DBCF_DECL_SIMD8F
+#define DBCF_DECL_SIMD8F DBCF_AUTODECL_SIMD8F
+#endif
+#ifndef DBCF_DECL_SIMD4D
+#define DBCF_DECL_SIMD4D DBCF_AUTODECL_SIMD4D
+#endif
+#ifndef DBCF_DECL_SIMD16F
+#define DBCF_DECL_SIMD16F DBCF_AUTODECL_SIMD16F
+#endif
+#ifndef DBCF_DECL_SIMD8D
+#define DBCF_DECL_SIMD8D DBCF_AUTODECL_SIMD8D
+#endif
+
+#if defined(DBC_FFT_USE_VECTOR_EXTENSIONS)
+#define DBCF_DEF_SIMD_LOAD( name,type,alignment) static type name(const void *p) {type ret;__builtin_memcpy(&ret,__builtin_assume_aligned(p,alignment),sizeof(ret));return ret;}
+#define DBCF_DEF_SIMD_STORE(name,type,alignment) static void name(type v,void *p) {__builtin_memcpy(__builtin_assume_aligned(p,alignment),&v,sizeof(v));}
+
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD4F)
+DBCF_DECL_SIMD4F DBCF_DEF_SIMD_LOAD (dbcF_load4f ,dbcf_simd4f,1)
+DBCF_DECL_SIMD4F DBCF_DEF_SIMD_STORE(dbcF_store4f,dbcf_simd4f,1)
+DBCF_DECL_SIMD4F DBCF_DEF_SIMD_LOAD (dbcF_load4f_aligned ,dbcf_simd4f,16)
+DBCF_DECL_SIMD4F DBCF_DEF_SIMD_STORE(dbcF_store4f_aligned,dbcf_simd4f,16)
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_set4f(float v0,float v1,float v2,float v3) {return (__extension__ (dbcf_simd4f){v0,v1,v2,v3});}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_fill4f(float v) {return dbcF_set4f(v,v,v,v);}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_add4f(dbcf_simd4f l,dbcf_simd4f r) {return l+r;}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_sub4f(dbcf_simd4f l,dbcf_simd4f r) {return l-r;}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_mul4f(dbcf_simd4f l,dbcf_simd4f r) {return l*r;}
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD2D)
+DBCF_DECL_SIMD2D DBCF_DEF_SIMD_LOAD (dbcF_load2d ,dbcf_simd2d,1)
+DBCF_DECL_SIMD2D DBCF_DEF_SIMD_STORE(dbcF_store2d,dbcf_simd2d,1)
+DBCF_DECL_SIMD2D DBCF_DEF_SIMD_LOAD (dbcF_load2d_aligned ,dbcf_simd2d,16)
+DBCF_DECL_SIMD2D DBCF_DEF_SIMD_STORE(dbcF_store2d_aligned,dbcf_simd2d,16)
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_set2d(double v0,double v1) {return (__extension__ (dbcf_simd2d){v0,v1});}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_fill2d(double v) {return dbcF_set2d(v,v);}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_add2d(dbcf_simd2d l,dbcf_simd2d r) {return l+r;}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_sub2d(dbcf_simd2d l,dbcf_simd2d r) {return l-r;}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_mul2d(dbcf_simd2d l,dbcf_simd2d r) {return l*r;}
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD8F)
+DBCF_DECL_SIMD8F DBCF_DEF_SIMD_LOAD (dbcF_load8f ,dbcf_simd8f,1)
+DBCF_DECL_SIMD8F DBCF_DEF_SIMD_STORE(dbcF_store8f,dbcf_simd8f,1)
+DBCF_DECL_SIMD8F DBCF_DEF_SIMD_LOAD (dbcF_load8f_aligned ,dbcf_simd8f,32)
+DBCF_DECL_SIMD8F DBCF_DEF_SIMD_STORE(dbcF_store8f_aligned,dbcf_simd8f,32)
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_set8f(float v0,float v1,float v2,float v3,float v4,float v5,float v6,float v7) {return (__extension__ (dbcf_simd8f){v0,v1,v2,v3,v4,v5,v6,v7});}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_fill8f(float v) {return dbcF_set8f(v,v,v,v,v,v,v,v);}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_add8f(dbcf_simd8f l,dbcf_simd8f r) {return l+r;}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_sub8f(dbcf_simd8f l,dbcf_simd8f r) {return l-r;}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_mul8f(dbcf_simd8f l,dbcf_simd8f r) {return l*r;}
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD4D)
+DBCF_DECL_SIMD4D DBCF_DEF_SIMD_LOAD (dbcF_load4d ,dbcf_simd4d,1)
+DBCF_DECL_SIMD4D DBCF_DEF_SIMD_STORE(dbcF_store4d,dbcf_simd4d,1)
+DBCF_DECL_SIMD4D DBCF_DEF_SIMD_LOAD (dbcF_load4d_aligned ,dbcf_simd4d,32)
+DBCF_DECL_SIMD4D DBCF_DEF_SIMD_STORE(dbcF_store4d_aligned,dbcf_simd4d,32)
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_set4d(double v0,double v1,double v2,double v3) {return (__extension__ (dbcf_simd4d){v0,v1,v2,v3});}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_fill4d(double v) {return dbcF_set4d(v,v,v,v);}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_add4d(dbcf_simd4d l,dbcf_simd4d r) {return l+r;}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_sub4d(dbcf_simd4d l,dbcf_simd4d r) {return l-r;}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_mul4d(dbcf_simd4d l,dbcf_simd4d r) {return l*r;}
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD16F)
+DBCF_DECL_SIMD16F DBCF_DEF_SIMD_LOAD (dbcF_load16f ,dbcf_simd16f,1)
+DBCF_DECL_SIMD16F DBCF_DEF_SIMD_STORE(dbcF_store16f,dbcf_simd16f,1)
+DBCF_DECL_SIMD16F DBCF_DEF_SIMD_LOAD (dbcF_load16f_aligned ,dbcf_simd16f,64)
+DBCF_DECL_SIMD16F DBCF_DEF_SIMD_STORE(dbcF_store16f_aligned,dbcf_simd16f,64)
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_set16f(float v0,float v1,float v2,float v3,float v4,float v5,float v6,float v7,float v8,float v9,float v10,float v11,float v12,float v13,float v14,float v15) {return (__extension__ (dbcf_simd16f){v0,v1,v2,v3,v4,v5,v6,v7,v8,v9,v10,v11,v12,v13,v14,v15});}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_fill16f(float v) {return dbcF_set16f(v,v,v,v,v,v,v,v,v,v,v,v,v,v,v,v);}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_add16f(dbcf_simd16f l,dbcf_simd16f r) {return l+r;}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_sub16f(dbcf_simd16f l,dbcf_simd16f r) {return l-r;}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_mul16f(dbcf_simd16f l,dbcf_simd16f r) {return l*r;}
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD8D)
+DBCF_DECL_SIMD8D DBCF_DEF_SIMD_LOAD (dbcF_load8d ,dbcf_simd8d,1)
+DBCF_DECL_SIMD8D DBCF_DEF_SIMD_STORE(dbcF_store8d,dbcf_simd8d,1)
+DBCF_DECL_SIMD8D DBCF_DEF_SIMD_LOAD (dbcF_load8d_aligned ,dbcf_simd8d,64)
+DBCF_DECL_SIMD8D DBCF_DEF_SIMD_STORE(dbcF_store8d_aligned,dbcf_simd8d,64)
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_set8d(double v0,double v1,double v2,double v3,double v4,double v5,double v6,double v7) {return (__extension__ (dbcf_simd8d){v0,v1,v2,v3,v4,v5,v6,v7});}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_fill8d(double v) {return dbcF_set8d(v,v,v,v,v,v,v,v);}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_add8d(dbcf_simd8d l,dbcf_simd8d r) {return l+r;}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_sub8d(dbcf_simd8d l,dbcf_simd8d r) {return l-r;}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_mul8d(dbcf_simd8d l,dbcf_simd8d r) {return l*r;}
+#endif
+
+/*
+    (De)interleaving of complex numbers: unzip_re, unzip_im take the real
+    and imaginary parts of the interleaved vectors a, b (in order), zip_lo, zip_hi
+    are the inverse.
+*/
+#if defined(__clang__)
+#define DBCF_SHUFFLE2( itype,a,b,i0,i1)                                                             __builtin_shufflevector(a,b,i0,i1)
+#define DBCF_SHUFFLE4( itype,a,b,i0,i1,i2,i3)                                                       __builtin_shufflevector(a,b,i0,i1,i2,i3)
+#define DBCF_SHUFFLE8( itype,a,b,i0,i1,i2,i3,i4,i5,i6,i7)                                           __builtin_shufflevector(a,b,i0,i1,i2,i3,i4,i5,i6,i7)
+#define DBCF_SHUFFLE16(itype,a,b,i0,i1,i2,i3,i4,i5,i6,i7,i8,i9,i10,i11,i12,i13,i14,i15)             __builtin_shufflevector(a,b,i0,i1,i2,i3,i4,i5,i6,i7,i8,i9,i10,i11,i12,i13,i14,i15)
+#else
+#define DBCF_SHUFFLE2( itype,a,b,i0,i1)                                                             __builtin_shuffle(a,b,(__extension__ (itype){i0,i1}))
+#define DBCF_SHUFFLE4( itype,a,b,i0,i1,i2,i3)                                                       __builtin_shuffle(a,b,(__extension__ (itype){i0,i1,i2,i3}))
+#define DBCF_SHUFFLE8( itype,a,b,i0,i1,i2,i3,i4,i5,i6,i7)                                           __builtin_shuffle(a,b,(__extension__ (itype){i0,i1,i2,i3,i4,i5,i6,i7}))
+#define DBCF_SHUFFLE16(itype,a,b,i0,i1,i2,i3,i4,i5,i6,i7,i8,i9,i10,i11,i12,i13,i14,i15)             __builtin_shuffle(a,b,(__extension__ (itype){i0,i1,i2,i3,i4,i5,i6,i7,i8,i9,i10,i11,i12,i13,i14,i15}))
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD4F)
+#if !defined(__clang__)
+typedef int dbcf_simd4i __attribute__((vector_size(16)));
+#endif
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_unzip4f_re(dbcf_simd4f a,dbcf_simd4f b) {return DBCF_SHUFFLE4(dbcf_simd4i,a,b,0,2,4,6);}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_unzip4f_im(dbcf_simd4f a,dbcf_simd4f b) {return DBCF_SHUFFLE4(dbcf_simd4i,a,b,1,3,5,7);}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_zip4f_lo(dbcf_simd4f r,dbcf_simd4f i) {return DBCF_SHUFFLE4(dbcf_simd4i,r,i,0,4,1,5);}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_zip4f_hi(dbcf_simd4f r,dbcf_simd4f i) {return DBCF_SHUFFLE4(dbcf_simd4i,r,i,2,6,3,7);}
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD2D)
+#if !defined(__clang__)
+__extension__ typedef long long dbcf_simd2l __attribute__((vector_size(16)));
+#endif
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_unzip2d_re(dbcf_simd2d a,dbcf_simd2d b) {return DBCF_SHUFFLE2(dbcf_simd2l,a,b,0,2);}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_unzip2d_im(dbcf_simd2d a,dbcf_simd2d b) {return DBCF_SHUFFLE2(dbcf_simd2l,a,b,1,3);}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_zip2d_lo(dbcf_simd2d r,dbcf_simd2d i) {return DBCF_SHUFFLE2(dbcf_simd2l,r,i,0,2);}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_zip2d_hi(dbcf_simd2d r,dbcf_simd2d i) {return DBCF_SHUFFLE2(dbcf_simd2l,r,i,1,3);}
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD8F)
+#if !defined(__clang__)
+typedef int dbcf_simd8i __attribute__((vector_size(32)));
+#endif
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_unzip8f_re(dbcf_simd8f a,dbcf_simd8f b) {return DBCF_SHUFFLE8(dbcf_simd8i,a,b,0,2,4,6,8,10,12,14);}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_unzip8f_im(dbcf_simd8f a,dbcf_simd8f b) {return DBCF_SHUFFLE8(dbcf_simd8i,a,b,1,3,5,7,9,11,13,15);}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_zip8f_lo(dbcf_simd8f r,dbcf_simd8f i) {return DBCF_SHUFFLE8(dbcf_simd8i,r,i,0,8,1,9,2,10,3,11);}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_zip8f_hi(dbcf_simd8f r,dbcf_simd8f i) {return DBCF_SHUFFLE8(dbcf_simd8i,r,i,4,12,5,13,6,14,7,15);}
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD4D)
+#if !defined(__clang__)
+__extension__ typedef long long dbcf_simd4l __attribute__((vector_size(32)));
+#endif
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_unzip4d_re(dbcf_simd4d a,dbcf_simd4d b) {return DBCF_SHUFFLE4(dbcf_simd4l,a,b,0,2,4,6);}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_unzip4d_im(dbcf_simd4d a,dbcf_simd4d b) {return DBCF_SHUFFLE4(dbcf_simd4l,a,b,1,3,5,7);}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_zip4d_lo(dbcf_simd4d r,dbcf_simd4d i) {return DBCF_SHUFFLE4(dbcf_simd4l,r,i,0,4,1,5);}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_zip4d_hi(dbcf_simd4d r,dbcf_simd4d i) {return DBCF_SHUFFLE4(dbcf_simd4l,r,i,2,6,3,7);}
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD16F)
+#if !defined(__clang__)
+typedef int dbcf_simd16i __attribute__((vector_size(64)));
+#endif
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_unzip16f_re(dbcf_simd16f a,dbcf_simd16f b) {return DBCF_SHUFFLE16(dbcf_simd16i,a,b,0,2,4,6,8,10,12,14,16,18,20,22,24,26,28,30);}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_unzip16f_im(dbcf_simd16f a,dbcf_simd16f b) {return DBCF_SHUFFLE16(dbcf_simd16i,a,b,1,3,5,7,9,11,13,15,17,19,21,23,25,27,29,31);}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_zip16f_lo(dbcf_simd16f r,dbcf_simd16f i) {return DBCF_SHUFFLE16(dbcf_simd16i,r,i,0,16,1,17,2,18,3,19,4,20,5,21,6,22,7,23);}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_zip16f_hi(dbcf_simd16f r,dbcf_simd16f i) {return DBCF_SHUFFLE16(dbcf_simd16i,r,i,8,24,9,25,10,26,11,27,12,28,13,29,14,30,15,31);}
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD8D)
+#if !defined(__clang__)
+__extension__ typedef long long dbcf_simd8l __attribute__((vector_size(64)));
+#endif
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_unzip8d_re(dbcf_simd8d a,dbcf_simd8d b) {return DBCF_SHUFFLE8(dbcf_simd8l,a,b,0,2,4,6,8,10,12,14);}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_unzip8d_im(dbcf_simd8d a,dbcf_simd8d b) {return DBCF_SHUFFLE8(dbcf_simd8l,a,b,1,3,5,7,9,11,13,15);}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_zip8d_lo(dbcf_simd8d r,dbcf_simd8d i) {return DBCF_SHUFFLE8(dbcf_simd8l,r,i,0,8,1,9,2,10,3,11);}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_zip8d_hi(dbcf_simd8d r,dbcf_simd8d i) {return DBCF_SHUFFLE8(dbcf_simd8l,r,i,4,12,5,13,6,14,7,15);}
+#endif
+
+#elif defined(DBCF_X86_OR_X64)
+
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD4F)
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_load4f (const void *p) {return _mm_loadu_ps((const float*)p);}
+DBCF_DECL_SIMD4F static void        dbcF_store4f(dbcf_simd4f v,void *p) {_mm_storeu_ps((float*)p,v);}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_load4f_aligned (const void *p) {return _mm_load_ps((const float*)p);}
+DBCF_DECL_SIMD4F static void        dbcF_store4f_aligned(dbcf_simd4f v,void *p) {_mm_store_ps((float*)p,v);}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_set4f(float v0,float v1,float v2,float v3) {return _mm_setr_ps(v0,v1,v2,v3);}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_fill4f(float v) {return dbcF_set4f(v,v,v,v);}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_add4f(dbcf_simd4f l,dbcf_simd4f r) {return _mm_add_ps(l,r);}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_sub4f(dbcf_simd4f l,dbcf_simd4f r) {return _mm_sub_ps(l,r);}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_mul4f(dbcf_simd4f l,dbcf_simd4f r) {return _mm_mul_ps(l,r);}
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD2D)
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_load2d (const void *p) {return _mm_loadu_pd((const double*)p);}
+DBCF_DECL_SIMD2D static void        dbcF_store2d(dbcf_simd2d v,void *p) {_mm_storeu_pd((double*)p,v);}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_load2d_aligned (const void *p) {return _mm_load_pd((const double*)p);}
+DBCF_DECL_SIMD2D static void        dbcF_store2d_aligned(dbcf_simd2d v,void *p) {_mm_store_pd((double*)p,v);}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_set2d(double v0,double v1) {return _mm_setr_pd(v0,v1);}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_fill2d(double v) {return dbcF_set2d(v,v);}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_add2d(dbcf_simd2d l,dbcf_simd2d r) {return _mm_add_pd(l,r);}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_sub2d(dbcf_simd2d l,dbcf_simd2d r) {return _mm_sub_pd(l,r);}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_mul2d(dbcf_simd2d l,dbcf_simd2d r) {return _mm_mul_pd(l,r);}
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD8F)
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_load8f (const void *p) {return _mm256_loadu_ps((const float*)p);}
+DBCF_DECL_SIMD8F static void        dbcF_store8f(dbcf_simd8f v,void *p) {_mm256_storeu_ps((float*)p,v);}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_load8f_aligned (const void *p) {return _mm256_load_ps((const float*)p);}
+DBCF_DECL_SIMD8F static void        dbcF_store8f_aligned(dbcf_simd8f v,void *p) {_mm256_store_ps((float*)p,v);}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_set8f(float v0,float v1,float v2,float v3,float v4,float v5,float v6,float v7) {return _mm256_setr_ps(v0,v1,v2,v3,v4,v5,v6,v7);}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_fill8f(float v) {return dbcF_set8f(v,v,v,v,v,v,v,v);}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_add8f(dbcf_simd8f l,dbcf_simd8f r) {return _mm256_add_ps(l,r);}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_sub8f(dbcf_simd8f l,dbcf_simd8f r) {return _mm256_sub_ps(l,r);}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_mul8f(dbcf_simd8f l,dbcf_simd8f r) {return _mm256_mul_ps(l,r);}
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD4D)
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_load4d (const void *p) {return _mm256_loadu_pd((const double*)p);}
+DBCF_DECL_SIMD4D static void        dbcF_store4d(dbcf_simd4d v,void *p) {_mm256_storeu_pd((double*)p,v);}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_load4d_aligned (const void *p) {return _mm256_load_pd((const double*)p);}
+DBCF_DECL_SIMD4D static void        dbcF_store4d_aligned(dbcf_simd4d v,void *p) {_mm256_store_pd((double*)p,v);}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_set4d(double v0,double v1,double v2,double v3) {return _mm256_setr_pd(v0,v1,v2,v3);}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_fill4d(double v) {return dbcF_set4d(v,v,v,v);}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_add4d(dbcf_simd4d l,dbcf_simd4d r) {return _mm256_add_pd(l,r);}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_sub4d(dbcf_simd4d l,dbcf_simd4d r) {return _mm256_sub_pd(l,r);}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_mul4d(dbcf_simd4d l,dbcf_simd4d r) {return _mm256_mul_pd(l,r);}
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD16F)
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_load16f (const void *p) {return _mm512_loadu_ps((const float*)p);}
+DBCF_DECL_SIMD16F static void        dbcF_store16f(dbcf_simd16f v,void *p) {_mm512_storeu_ps((float*)p,v);}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_load16f_aligned (const void *p) {return _mm512_load_ps((const float*)p);}
+DBCF_DECL_SIMD16F static void        dbcF_store16f_aligned(dbcf_simd16f v,void *p) {_mm512_store_ps((float*)p,v);}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_set16f(float v0,float v1,float v2,float v3,float v4,float v5,float v6,float v7,float v8,float v9,float v10,float v11,float v12,float v13,float v14,float v15) {return _mm512_setr_ps(v0,v1,v2,v3,v4,v5,v6,v7,v8,v9,v10,v11,v12,v13,v14,v15);}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_fill16f(float v) {return dbcF_set16f(v,v,v,v,v,v,v,v,v,v,v,v,v,v,v,v);}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_add16f(dbcf_simd16f l,dbcf_simd16f r) {return _mm512_add_ps(l,r);}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_sub16f(dbcf_simd16f l,dbcf_simd16f r) {return _mm512_sub_ps(l,r);}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_mul16f(dbcf_simd16f l,dbcf_simd16f r) {return _mm512_mul_ps(l,r);}
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD8D)
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_load8d (const void *p) {return _mm512_loadu_pd((const double*)p);}
+DBCF_DECL_SIMD8D static void        dbcF_store8d(dbcf_simd8d v,void *p) {_mm512_storeu_pd((double*)p,v);}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_load8d_aligned (const void *p) {return _mm512_load_pd((const double*)p);}
+DBCF_DECL_SIMD8D static void        dbcF_store8d_aligned(dbcf_simd8d v,void *p) {_mm512_store_pd((double*)p,v);}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_set8d(double v0,double v1,double v2,double v3,double v4,double v5,double v6,double v7) {return _mm512_setr_pd(v0,v1,v2,v3,v4,v5,v6,v7);}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_fill8d(double v) {return dbcF_set8d(v,v,v,v,v,v,v,v);}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_add8d(dbcf_simd8d l,dbcf_simd8d r) {return _mm512_add_pd(l,r);}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_sub8d(dbcf_simd8d l,dbcf_simd8d r) {return _mm512_sub_pd(l,r);}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_mul8d(dbcf_simd8d l,dbcf_simd8d r) {return _mm512_mul_pd(l,r);}
+#endif
+
+/* (De)interleaving of complex numbers, see above. */
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD4F)
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_unzip4f_re(dbcf_simd4f a,dbcf_simd4f b) {return _mm_shuffle_ps(a,b,0x88);}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_unzip4f_im(dbcf_simd4f a,dbcf_simd4f b) {return _mm_shuffle_ps(a,b,0xDD);}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_zip4f_lo(dbcf_simd4f r,dbcf_simd4f i) {return _mm_unpacklo_ps(r,i);}
+DBCF_DECL_SIMD4F static dbcf_simd4f dbcF_zip4f_hi(dbcf_simd4f r,dbcf_simd4f i) {return _mm_unpackhi_ps(r,i);}
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD2D)
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_unzip2d_re(dbcf_simd2d a,dbcf_simd2d b) {return _mm_unpacklo_pd(a,b);}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_unzip2d_im(dbcf_simd2d a,dbcf_simd2d b) {return _mm_unpackhi_pd(a,b);}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_zip2d_lo(dbcf_simd2d r,dbcf_simd2d i) {return _mm_unpacklo_pd(r,i);}
+DBCF_DECL_SIMD2D static dbcf_simd2d dbcF_zip2d_hi(dbcf_simd2d r,dbcf_simd2d i) {return _mm_unpackhi_pd(r,i);}
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD8F)
+/* Lane-crossing is done first, so that in-lane shuffles produce elements in order. */
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_unzip8f_re(dbcf_simd8f a,dbcf_simd8f b) {return _mm256_shuffle_ps(_mm256_permute2f128_ps(a,b,0x20),_mm256_permute2f128_ps(a,b,0x31),0x88);}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_unzip8f_im(dbcf_simd8f a,dbcf_simd8f b) {return _mm256_shuffle_ps(_mm256_permute2f128_ps(a,b,0x20),_mm256_permute2f128_ps(a,b,0x31),0xDD);}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_zip8f_lo(dbcf_simd8f r,dbcf_simd8f i) {return _mm256_permute2f128_ps(_mm256_unpacklo_ps(r,i),_mm256_unpackhi_ps(r,i),0x20);}
+DBCF_DECL_SIMD8F static dbcf_simd8f dbcF_zip8f_hi(dbcf_simd8f r,dbcf_simd8f i) {return _mm256_permute2f128_ps(_mm256_unpacklo_ps(r,i),_mm256_unpackhi_ps(r,i),0x31);}
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD4D)
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_unzip4d_re(dbcf_simd4d a,dbcf_simd4d b) {return _mm256_unpacklo_pd(_mm256_permute2f128_pd(a,b,0x20),_mm256_permute2f128_pd(a,b,0x31));}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_unzip4d_im(dbcf_simd4d a,dbcf_simd4d b) {return _mm256_unpackhi_pd(_mm256_permute2f128_pd(a,b,0x20),_mm256_permute2f128_pd(a,b,0x31));}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_zip4d_lo(dbcf_simd4d r,dbcf_simd4d i) {return _mm256_permute2f128_pd(_mm256_unpacklo_pd(r,i),_mm256_unpackhi_pd(r,i),0x20);}
+DBCF_DECL_SIMD4D static dbcf_simd4d dbcF_zip4d_hi(dbcf_simd4d r,dbcf_simd4d i) {return _mm256_permute2f128_pd(_mm256_unpacklo_pd(r,i),_mm256_unpackhi_pd(r,i),0x31);}
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD16F)
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_unzip16f_re(dbcf_simd16f a,dbcf_simd16f b) {return _mm512_permutex2var_ps(a,_mm512_setr_epi32(0,2,4,6,8,10,12,14,16,18,20,22,24,26,28,30),b);}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_unzip16f_im(dbcf_simd16f a,dbcf_simd16f b) {return _mm512_permutex2var_ps(a,_mm512_setr_epi32(1,3,5,7,9,11,13,15,17,19,21,23,25,27,29,31),b);}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_zip16f_lo(dbcf_simd16f r,dbcf_simd16f i) {return _mm512_permutex2var_ps(r,_mm512_setr_epi32(0,16,1,17,2,18,3,19,4,20,5,21,6,22,7,23),i);}
+DBCF_DECL_SIMD16F static dbcf_simd16f dbcF_zip16f_hi(dbcf_simd16f r,dbcf_simd16f i) {return _mm512_permutex2var_ps(r,_mm512_setr_epi32(8,24,9,25,10,26,11,27,12,28,13,29,14,30,15,31),i);}
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD8D)
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_unzip8d_re(dbcf_simd8d a,dbcf_simd8d b) {return _mm512_permutex2var_pd(a,_mm512_setr_epi64(0,2,4,6,8,10,12,14),b);}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_unzip8d_im(dbcf_simd8d a,dbcf_simd8d b) {return _mm512_permutex2var_pd(a,_mm512_setr_epi64(1,3,5,7,9,11,13,15),b);}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_zip8d_lo(dbcf_simd8d r,dbcf_simd8d i) {return _mm512_permutex2var_pd(r,_mm512_setr_epi64(0,8,1,9,2,10,3,11),i);}
+DBCF_DECL_SIMD8D static dbcf_simd8d dbcF_zip8d_hi(dbcf_simd8d r,dbcf_simd8d i) {return _mm512_permutex2var_pd(r,_mm512_setr_epi64(4,12,5,13,6,14,7,15),i);}
+#endif
+
+#endif /* defined(DBC_FFT_USE_VECTOR_EXTENSIONS) */
+
+#define DBCF_DEF_SIMD_BLOCK(name,type,size,simd,load_t,load_d,store_d,fill,add,sub,mul,cexp)\
+static void name(                                                                             \
+    dbcf_index log2n,                                                                         \
+    dbcf_index log2b,                                                                         \
+    type *LR,type *LI,                                                                        \
+    type *HR,type *HI,                                                                        \
+    type C,type S,                                                                            \
+    int inverse,                                                                              \
+    const type *tr,const type *ti)                                                            \
+{                                                                                             \
+    dbcf_index b=DBCF_POW2(log2b),h=b>>1;                                                     \
+    if(log2b<=DBCF_TWIDDLES_BUF_LOG2)                                                         \
+    {                                                                                         \
+        /* The block is small, we have enough precomputed twiddles. */                        \
+        dbcf_index i;                                                                         \
+        simd CC=fill(C),SS=fill(S);                                                           \
+        for(i=0;i<b;i+=size)                                                                  \
+        {                                                                                     \
+            simd TR=load_t(tr+i),TI=load_t(ti+i);                                             \
+            simd c=sub(mul(CC,TR),mul(SS,TI)),s=add(mul(SS,TR),mul(CC,TI));                   \
+            simd xl=load_d(LR+i),yl=load_d(LI+i);                                             \
+            simd xr=load_d(HR+i),yr=load_d(HI+i);                                             \
+            simd x=sub(mul(c,xr),mul(s,yr)),y=add(mul(s,xr),mul(c,yr));                       \
+            store_d(add(xl,x),LR+i);store_d(add(yl,y),LI+i);                                  \
+            store_d(sub(xl,x),HR+i);store_d(sub(yl,y),HI+i);                                  \
+        }                                                                                     \
+    }                                                                                         \
+    else                                                                                      \
+    {                                                                                         \
+        type X,Y;                                                                             \
+        /* The block is large, we process it's halves recursively. */                         \
+        cexp(log2n-log2b+1,&X,&Y);                                                            \
+        if(!inverse) Y=-Y;                                                                    \
+        name(log2n,log2b-1,LR  ,LI  ,HR  ,HI  ,C      ,S      ,inverse,tr,ti);                \
+        name(log2n,log2b-1,LR+h,LI+h,HR+h,HI+h,C*X-S*Y,S*X+C*Y,inverse,tr,ti);                \
+    }                                                                                         \
+}
+
+#define DBCF_DEF_SIMD_PASS(name,type,size,simd,load_t,load_d,store_d,add,sub,mul,block)\
+static void name(                                                                             \
+    dbcf_index log2n,                                                                         \
+    dbcf_index log2c,                                                                         \
+    type *real,type *imag,                                                                    \
+    int inverse,                                                                              \
+	dbcf_index log2t,                                                                         \
+    const type *tr,const type *ti)                                                            \
+{                                                                                             \
+    dbcf_index n=DBCF_POW2(log2n),h=n>>1;                                                     \
+    dbcf_index c=DBCF_POW2(log2c);                                                            \
+    dbcf_index i;                                                                             \
+    type *LR=real;                                                                            \
+    type *HR=real+h;                                                                          \
+    type *LI=imag;                                                                            \
+    type *HI=imag+h;                                                                          \
+                                                                                              \
+    if(log2n-1<=log2t)                                                                        \
+    {                                                                                         \
+        /*  We have as much precomputed twiddles            */                                \
+        /*  as the block needs, so we supply them directly. */                                \
+        if(h>size) for(i=0;i<c;++i)                                                           \
+        {                                                                                     \
+            /* Unroll x2. Slightly faster. */                                                 \
+            dbcf_index d;                                                                     \
+            for(d=0;d<h;)                                                                     \
+            {                                                                                 \
+                simd c=load_t(tr+d),s=load_t(ti+d);                                           \
+                simd xl=load_d(LR+d),yl=load_d(LI+d);                                         \
+                simd xr=load_d(HR+d),yr=load_d(HI+d);                                         \
+                simd x=sub(mul(c,xr),mul(s,yr)),y=add(mul(s,xr),mul(c,yr));                   \
+                store_d(add(xl,x),LR+d);store_d(add(yl,y),LI+d);                              \
+                store_d(sub(xl,x),HR+d);store_d(sub(yl,y),HI+d);                              \
+                d+=size;                                                                      \
+                c=load_t(tr+d);s=load_t(ti+d);                                                \
+                xl=load_d(LR+d);yl=load_d(LI+d);                                              \
+                xr=load_d(HR+d);yr=load_d(HI+d);                                              \
+                x=sub(mul(c,xr),mul(s,yr));y=add(mul(s,xr),mul(c,yr));                        \
+                store_d(add(xl,x),LR+d);store_d(add(yl,y),LI+d);                              \
+                store_d(sub(xl,x),HR+d);store_d(sub(yl,y),HI+d);                              \
+                d+=size;                                                                      \
+            }                                                                                 \
+            LR+=n;LI+=n;                                                                      \
+            HR+=n;HI+=n;                                                                      \
+        }                                                                                     \
+        else for(i=0;i<c;++i)                                                                 \
+        {                                                                                     \
+            simd C=load_t(tr),S=load_t(ti);                                                   \
+            simd xl=load_d(LR),yl=load_d(LI);                                                 \
+            simd xr=load_d(HR),yr=load_d(HI);                                                 \
+            simd x=sub(mul(C,xr),mul(S,yr)),y=add(mul(S,xr),mul(C,yr));                       \
+            store_d(add(xl,x),LR);store_d(add(yl,y),LI);                                      \
+            store_d(sub(xl,x),HR);store_d(sub(yl,y),HI);                                      \
+            LR+=n;LI+=n;                                                                      \
+            HR+=n;HI+=n;                                                                      \
+        }                                                                                     \
+    }                                                                                         \
+    else                                                                                      \
+    {                                                                                         \
+        for(i=0;i<c;++i)                                                                      \
+        {                                                                                     \
+            block(log2n,log2n-1,LR,LI,HR,HI,1.0f,0.0f,inverse,tr,ti);                         \
+            LR+=n;LI+=n;                                                                      \
+            HR+=n;HI+=n;                                                                      \
+        }                                                                                     \
+    }                                                                                         \
+}
+
+/*
+    Radix-4 butterflies (2 radix-2 passes at once) on the chunk of size b of
+    the quarters of c blocks of size n, see dbcF_radix4_block.
+*/
+#define DBCF_DEF_SIMD_RADIX4(name,type,size,simd,load_t,load_d,store_d,add,sub,mul)\
+static void name(                                                                             \
+    dbcf_index log2n,                                                                         \
+    dbcf_index log2c,                                                                         \
+    dbcf_index b,                                                                             \
+    type *real,type *imag,                                                                    \
+    const type *t1r,const type *t1i,                                                          \
+    const type *t2r,const type *t2i,                                                          \
+    const type *t3r,const type *t3i,                                                          \
+    int inverse)                                                                              \
+{                                                                                             \
+    dbcf_index n=DBCF_POW2(log2n),q=n>>2;                                                     \
+    dbcf_index c=DBCF_POW2(log2c);                                                            \
+    dbcf_index o1=(inverse?3*q:q),o3=(inverse?q:3*q);                                         \
+    dbcf_index i,j;                                                                           \
+    for(i=0;i<c;++i)                                                                          \
+    {                                                                                         \
+        type *R=real+i*n,*I=imag+i*n;                                                         \
+        for(j=0;j<b;j+=size)                                                                  \
+        {                                                                                     \
+            simd ar=load_d(R+j),ai=load_d(I+j);                                               \
+            simd wr=load_t(t2r+j),wi=load_t(t2i+j);                                           \
+            simd xr=load_d(R+q+j),xi=load_d(I+q+j);                                           \
+            simd br=sub(mul(wr,xr),mul(wi,xi)),bi=add(mul(wi,xr),mul(wr,xi));                 \
+            simd cr,ci,er,ei,s0r,s0i,d0r,d0i,s1r,s1i,d1r,d1i;                                 \
+            wr=load_t(t1r+j);wi=load_t(t1i+j);                                                \
+            xr=load_d(R+2*q+j);xi=load_d(I+2*q+j);                                            \
+            cr=sub(mul(wr,xr),mul(wi,xi));ci=add(mul(wi,xr),mul(wr,xi));                      \
+            wr=load_t(t3r+j);wi=load_t(t3i+j);                                                \
+            xr=load_d(R+3*q+j);xi=load_d(I+3*q+j);                                            \
+            er=sub(mul(wr,xr),mul(wi,xi));ei=add(mul(wi,xr),mul(wr,xi));                      \
+            s0r=add(ar,br);s0i=add(ai,bi);                                                    \
+            d0r=sub(ar,br);d0i=sub(ai,bi);                                                    \
+            s1r=add(cr,er);s1i=add(ci,ei);                                                    \
+            d1r=sub(cr,er);d1i=sub(ci,ei);                                                    \
+            store_d(add(s0r,s1r),R+j);store_d(add(s0i,s1i),I+j);                              \
+            store_d(sub(s0r,s1r),R+2*q+j);store_d(sub(s0i,s1i),I+2*q+j);                      \
+            store_d(add(d0r,d1i),R+o1+j);store_d(sub(d0i,d1r),I+o1+j);                        \
+            store_d(sub(d0r,d1i),R+o3+j);store_d(add(d0i,d1r),I+o3+j);                        \
+        }                                                                                     \
+    }                                                                                         \
+}
+
+/*
+    Versions of the above for interleaved data (real and imaginary parts
+    alternate): the complex numbers are (de)interleaved in registers, so the
+    arithmetic is the same as in the split case, and the twiddles are
+    still split.
+*/
+#define DBCF_DEF_SIMD_BLOCK_INTERLEAVED(name,type,size,simd,load,store,fill,add,sub,mul,unzip_re,unzip_im,zip_lo,zip_hi,cexp)\
+static void name(                                                                             \
+    dbcf_index log2n,                                                                         \
+    dbcf_index log2b,                                                                         \
+    type *L,type *H,                                                                          \
+    type C,type S,                                                                            \
+    int inverse,                                                                              \
     const type *tr,const type *ti)                                                            \
 {                                                                                             \
     dbcf_index b=DBCF_POW2(log2b),h=b>>1;                                                     \
@@ -1148,13 +4751,17 @@ static void name(
         simd CC=fill(C),SS=fill(S);                                                           \
         for(i=0;i<b;i+=size)                                                                  \
         {                                                                                     \
-            simd TR=load_t(tr+i),TI=load_t(ti+i);                                             \
+            simd TR=load(tr+i),TI=load(ti+i);                                                 \
             simd c=sub(mul(CC,TR),mul(SS,TI)),s=add(mul(SS,TR),mul(CC,TI));                   \
-            simd xl=load_d(LR+i),yl=load_d(LI+i);                                             \
-            simd xr=load_d(HR+i),yr=load_d(HI+i);                                             \
+            simd l0=load(L+2*i),l1=load(L+2*i+size);                                          \
+            simd h0=load(H+2*i),h1=load(H+2*i+size);                                          \
+            simd xl=unzip_re(l0,l1),yl=unzip_im(l0,l1);                                       \
+            simd xr=unzip_re(h0,h1),yr=unzip_im(h0,h1);                                       \
             simd x=sub(mul(c,xr),mul(s,yr)),y=add(mul(s,xr),mul(c,yr));                       \
-            store_d(add(xl,x),LR+i);store_d(add(yl,y),LI+i);                                  \
-            store_d(sub(xl,x),HR+i);store_d(sub(yl,y),HI+i);                                  \
+            simd xo=add(xl,x),yo=add(yl,y);                                                   \
+            store(zip_lo(xo,yo),L+2*i);store(zip_hi(xo,yo),L+2*i+size);                       \
+            xo=sub(xl,x);yo=sub(yl,y);                                                        \
+            store(zip_lo(xo,yo),H+2*i);store(zip_hi(xo,yo),H+2*i+size);                       \
         }                                                                                     \
     }                                                                                         \
     else                                                                                      \
@@ -1163,1399 +4770,10934 @@ static void name(
         /* The block is large, we process it's halves recursively. */                         \
         cexp(log2n-log2b+1,&X,&Y);                                                            \
         if(!inverse) Y=-Y;                                                                    \
-        name(log2n,log2b-1,LR  ,LI  ,HR  ,HI  ,C      ,S      ,inverse,tr,ti);                \
-        name(log2n,log2b-1,LR+h,LI+h,HR+h,HI+h,C*X-S*Y,S*X+C*Y,inverse,tr,ti);                \
+        name(log2n,log2b-1,L    ,H    ,C      ,S      ,inverse,tr,ti);                        \
+        name(log2n,log2b-1,L+2*h,H+2*h,C*X-S*Y,S*X+C*Y,inverse,tr,ti);                        \
+    }                                                                                         \
+}
+
+#define DBCF_DEF_SIMD_PASS_INTERLEAVED(name,type,size,simd,load,store,add,sub,mul,unzip_re,unzip_im,zip_lo,zip_hi,block)\
+static void name(                                                                             \
+    dbcf_index log2n,                                                                         \
+    dbcf_index log2c,                                                                         \
+    type *data,                                                                               \
+    int inverse,                                                                              \
+    dbcf_index log2t,                                                                         \
+    const type *tr,const type *ti)                                                            \
+{                                                                                             \
+    dbcf_index n=DBCF_POW2(log2n),h=n>>1;                                                     \
+    dbcf_index c=DBCF_POW2(log2c);                                                            \
+    dbcf_index i,d;                                                                           \
+    type *L=data,*H=data+2*h;                                                                 \
+    for(i=0;i<c;++i)                                                                          \
+    {                                                                                         \
+        if(log2n-1<=log2t)                                                                    \
+        {                                                                                     \
+            /*  We have as much precomputed twiddles            */                            \
+            /*  as the block needs, so we supply them directly. */                            \
+            for(d=0;d<h;d+=size)                                                              \
+            {                                                                                 \
+                simd C=load(tr+d),S=load(ti+d);                                               \
+                simd l0=load(L+2*d),l1=load(L+2*d+size);                                      \
+                simd h0=load(H+2*d),h1=load(H+2*d+size);                                      \
+                simd xl=unzip_re(l0,l1),yl=unzip_im(l0,l1);                                   \
+                simd xr=unzip_re(h0,h1),yr=unzip_im(h0,h1);                                   \
+                simd x=sub(mul(C,xr),mul(S,yr)),y=add(mul(S,xr),mul(C,yr));                   \
+                simd xo=add(xl,x),yo=add(yl,y);                                               \
+                store(zip_lo(xo,yo),L+2*d);store(zip_hi(xo,yo),L+2*d+size);                   \
+                xo=sub(xl,x);yo=sub(yl,y);                                                    \
+                store(zip_lo(xo,yo),H+2*d);store(zip_hi(xo,yo),H+2*d+size);                   \
+            }                                                                                 \
+        }                                                                                     \
+        else                                                                                  \
+            block(log2n,log2n-1,L,H,1.0f,0.0f,inverse,tr,ti);                                 \
+        L+=2*n;H+=2*n;                                                                        \
+    }                                                                                         \
+}
+
+#define DBCF_DEF_SIMD_RADIX4_INTERLEAVED(name,type,size,simd,load,store,add,sub,mul,unzip_re,unzip_im,zip_lo,zip_hi)\
+static void name(                                                                             \
+    dbcf_index log2n,                                                                         \
+    dbcf_index log2c,                                                                         \
+    dbcf_index b,                                                                             \
+    type *data,                                                                               \
+    const type *t1r,const type *t1i,                                                          \
+    const type *t2r,const type *t2i,                                                          \
+    const type *t3r,const type *t3i,                                                          \
+    int inverse)                                                                              \
+{                                                                                             \
+    dbcf_index n=DBCF_POW2(log2n),q=n>>2;                                                     \
+    dbcf_index c=DBCF_POW2(log2c);                                                            \
+    dbcf_index o1=(inverse?6*q:2*q),o3=(inverse?2*q:6*q);                                     \
+    dbcf_index i,j;                                                                           \
+    for(i=0;i<c;++i)                                                                          \
+    {                                                                                         \
+        type *P=data+2*i*n;                                                                   \
+        for(j=0;j<b;j+=size)                                                                  \
+        {                                                                                     \
+            type *p=P+2*j;                                                                    \
+            simd v0=load(p),v1=load(p+size);                                                  \
+            simd ar=unzip_re(v0,v1),ai=unzip_im(v0,v1);                                       \
+            simd wr=load(t2r+j),wi=load(t2i+j);                                               \
+            simd xr,xi,br,bi,cr,ci,er,ei,s0r,s0i,d0r,d0i,s1r,s1i,d1r,d1i;                     \
+            v0=load(p+2*q);v1=load(p+2*q+size);                                               \
+            xr=unzip_re(v0,v1);xi=unzip_im(v0,v1);                                            \
+            br=sub(mul(wr,xr),mul(wi,xi));bi=add(mul(wi,xr),mul(wr,xi));                      \
+            wr=load(t1r+j);wi=load(t1i+j);                                                    \
+            v0=load(p+4*q);v1=load(p+4*q+size);                                               \
+            xr=unzip_re(v0,v1);xi=unzip_im(v0,v1);                                            \
+            cr=sub(mul(wr,xr),mul(wi,xi));ci=add(mul(wi,xr),mul(wr,xi));                      \
+            wr=load(t3r+j);wi=load(t3i+j);                                                    \
+            v0=load(p+6*q);v1=load(p+6*q+size);                                               \
+            xr=unzip_re(v0,v1);xi=unzip_im(v0,v1);                                            \
+            er=sub(mul(wr,xr),mul(wi,xi));ei=add(mul(wi,xr),mul(wr,xi));                      \
+            s0r=add(ar,br);s0i=add(ai,bi);                                                    \
+            d0r=sub(ar,br);d0i=sub(ai,bi);                                                    \
+            s1r=add(cr,er);s1i=add(ci,ei);                                                    \
+            d1r=sub(cr,er);d1i=sub(ci,ei);                                                    \
+            xr=add(s0r,s1r);xi=add(s0i,s1i);                                                  \
+            store(zip_lo(xr,xi),p);store(zip_hi(xr,xi),p+size);                               \
+            xr=sub(s0r,s1r);xi=sub(s0i,s1i);                                                  \
+            store(zip_lo(xr,xi),p+4*q);store(zip_hi(xr,xi),p+4*q+size);                       \
+            xr=add(d0r,d1i);xi=sub(d0i,d1r);                                                  \
+            store(zip_lo(xr,xi),p+o1);store(zip_hi(xr,xi),p+o1+size);                         \
+            xr=sub(d0r,d1i);xi=add(d0i,d1r);                                                  \
+            store(zip_lo(xr,xi),p+o3);store(zip_hi(xr,xi),p+o3+size);                         \
+        }                                                                                     \
+    }                                                                                         \
+}
+
+/*
+    Butterfly passes over a tile of size transforms (one per SIMD lane):
+    element k of the transform l is at [k*size+l]. The tile shall be
+    aligned, and already in bit-reversed order. tr, ti hold the twiddle
+    table (see dbcF_compute_twiddle_table).
+*/
+#define DBCF_DEF_SIMD_BATCH(name,type,size,simd,load,store,fill,add,sub,mul)\
+static void name(                                                                             \
+    dbcf_index log2n,                                                                         \
+    type *real,type *imag,                                                                    \
+    const type *tr,const type *ti)                                                            \
+{                                                                                             \
+    dbcf_index n=DBCF_POW2(log2n),log2d,i,j;                                                  \
+    for(i=0;i<n;i+=2)                                                                         \
+    {                                                                                         \
+        type *LR=real+i*size,*LI=imag+i*size;                                                 \
+        simd xl=load(LR),yl=load(LI);                                                         \
+        simd xr=load(LR+size),yr=load(LI+size);                                               \
+        store(add(xl,xr),LR);store(add(yl,yr),LI);                                            \
+        store(sub(xl,xr),LR+size);store(sub(yl,yr),LI+size);                                  \
+    }                                                                                         \
+    for(log2d=2;log2d<=log2n;++log2d)                                                         \
+    {                                                                                         \
+        dbcf_index d=DBCF_POW2(log2d),h=d>>1;                                                 \
+        for(j=0;j<h;++j)                                                                      \
+        {                                                                                     \
+            simd c=fill(tr[h+j]),s=fill(ti[h+j]);                                             \
+            for(i=j;i<n;i+=d)                                                                 \
+            {                                                                                 \
+                type *LR=real+i*size,*LI=imag+i*size;                                         \
+                type *HR=LR+h*size,*HI=LI+h*size;                                             \
+                simd xl=load(LR),yl=load(LI);                                                 \
+                simd xr=load(HR),yr=load(HI);                                                 \
+                simd x=sub(mul(c,xr),mul(s,yr)),y=add(mul(s,xr),mul(c,yr));                   \
+                store(add(xl,x),LR);store(add(yl,y),LI);                                      \
+                store(sub(xl,x),HR);store(sub(yl,y),HI);                                      \
+            }                                                                                 \
+        }                                                                                     \
+    }                                                                                         \
+}
+
+/*
+    Mixed-radix butterflies, see dbcF_radix_block. r is either a constant
+    (3, 5, 7), or R (for other primes), maxr is an upper bound for it.
+    Returns the number of butterflies computed (b rounded down to a
+    multiple of size).
+*/
+#define DBCF_DEF_SIMD_RADIX(name,type,size,simd,r,maxr,load,store,fill,add,sub,mul)\
+static dbcf_index name(                                                                       \
+    dbcf_index R,                                                                             \
+    dbcf_index M,                                                                             \
+    dbcf_index b,                                                                             \
+    type *real,type *imag,                                                                    \
+    const type *sr,const type *si,                                                            \
+    dbcf_index s_stride,                                                                      \
+    const type *cr,const type *ci,                                                            \
+    const type *ur,const type *ui)                                                            \
+{                                                                                             \
+    const dbcf_index radix=(r),L=radix>>1;                                                    \
+    dbcf_index j,k,q,t;                                                                       \
+    simd U[maxr],V[maxr],C[maxr],S[maxr];                                                     \
+    (void)R;                                                                                  \
+    for(q=1;q<radix;++q)                                                                      \
+    {                                                                                         \
+        U[q]=fill(ur[q]);V[q]=fill(ui[q]);                                                    \
+        C[q]=fill(cr[q-1]);S[q]=fill(ci[q-1]);                                                \
+    }                                                                                         \
+    for(j=0;j+size<=b;j+=size)                                                                \
+    {                                                                                         \
+        simd xr[maxr],xi[maxr],yr,yi;                                                         \
+        xr[0]=load(real+j);xi[0]=load(imag+j);                                                \
+        for(q=1;q<radix;++q)                                                                  \
+        {                                                                                     \
+            simd tr=load(sr+(q-1)*s_stride+j),ti=load(si+(q-1)*s_stride+j);                   \
+            simd c=sub(mul(C[q],tr),mul(S[q],ti)),s=add(mul(S[q],tr),mul(C[q],ti));           \
+            simd x=load(real+q*M+j),y=load(imag+q*M+j);                                       \
+            xr[q]=sub(mul(c,x),mul(s,y));                                                     \
+            xi[q]=add(mul(s,x),mul(c,y));                                                     \
+        }                                                                                     \
+        yr=xr[0];yi=xi[0];                                                                    \
+        for(q=1;q<=L;++q)                                                                     \
+        {                                                                                     \
+            simd ar=add(xr[q],xr[radix-q]),ai=add(xi[q],xi[radix-q]);                         \
+            simd dr=sub(xr[q],xr[radix-q]),di=sub(xi[q],xi[radix-q]);                         \
+            xr[q]=ar;xi[q]=ai;                                                                \
+            xr[radix-q]=dr;xi[radix-q]=di;                                                    \
+            yr=add(yr,ar);yi=add(yi,ai);                                                      \
+        }                                                                                     \
+        for(k=1;k<=L;++k)                                                                     \
+        {                                                                                     \
+            simd Ar=xr[0],Ai=xi[0],Br,Bi;                                                     \
+            Ar=add(Ar,mul(U[k],xr[1]));Ai=add(Ai,mul(U[k],xi[1]));                            \
+            Br=mul(V[k],xr[radix-1]);Bi=mul(V[k],xi[radix-1]);                                \
+            for(q=2,t=k+k;q<=L;++q,t+=k)                                                      \
+            {                                                                                 \
+                if(t>=radix) t-=radix;                                                        \
+                Ar=add(Ar,mul(U[t],xr[q]));Ai=add(Ai,mul(U[t],xi[q]));                        \
+                Br=add(Br,mul(V[t],xr[radix-q]));Bi=add(Bi,mul(V[t],xi[radix-q]));            \
+            }                                                                                 \
+            store(add(Ar,Bi),real+k*M+j);store(sub(Ai,Br),imag+k*M+j);                        \
+            store(sub(Ar,Bi),real+(radix-k)*M+j);store(add(Ai,Br),imag+(radix-k)*M+j);        \
+        }                                                                                     \
+        store(yr,real+j);store(yi,imag+j);                                                    \
+    }                                                                                         \
+    return j;                                                                                 \
+}
+
+/* Not actually SIMDified, but at least uses the right instruction level. */
+#define DBCF_DEF_SIMD_FFT8(name,type,suffix,lsuffix)\
+static void name(type *real,type *imag,int inverse) {dbcF_fft8_##suffix(real,imag,1,1,inverse,0.70710678118654752438##lsuffix);}
+
+#define DBCF_DEF_SIMD_FFT8_INTERLEAVED(name,type,suffix,lsuffix)\
+static void name(type *data,int inverse) {dbcF_fft8_##suffix(data,data+1,2,2,inverse,0.70710678118654752438##lsuffix);}
+
+#define DBCF_DEF_SIMD_COMPUTE_TWIDDLES(name,type,size,simd,lsuffix,load,store,fill,add,sub,mul,cexpm1)\
+static void name(dbcf_index log2n,dbcf_index log2b,type *real,type *imag,int inverse)         \
+{                                                                                             \
+    dbcf_index i;                                                                             \
+    real[0]=0.0##lsuffix;                                                                     \
+    imag[0]=0.0##lsuffix;                                                                     \
+    for(i=0;i<log2b;++i)                                                                      \
+    {                                                                                         \
+        dbcf_index j,k=DBCF_POW2(i);                                                          \
+        type x,y;                                                                             \
+        cexpm1(log2n-i,&x,&y);                                                                \
+        if(!inverse) y=-y;                                                                    \
+        if(k>=size)                                                                           \
+        {                                                                                     \
+            simd X=fill(x);                                                                   \
+            simd Y=fill(y);                                                                   \
+            for(j=0;j<k;j+=size)                                                              \
+            {                                                                                 \
+                simd R=load(real+j);                                                          \
+                simd I=load(imag+j);                                                          \
+                store(add(sub(mul(X,R),mul(Y,I)),add(X,R)),real+k+j);                         \
+                store(add(add(mul(Y,R),mul(X,I)),add(Y,I)),imag+k+j);                         \
+            }                                                                                 \
+        }                                                                                     \
+        else for(j=0;j<k;++j)                                                                 \
+        {                                                                                     \
+            real[k+j]=(x*real[j]-y*imag[j])+(x+real[j]);                                      \
+            imag[k+j]=(y*real[j]+x*imag[j])+(y+imag[j]);                                      \
+        }                                                                                     \
     }                                                                                         \
+    for(i=0;i<DBCF_POW2(log2b);++i)                                                           \
+        real[i]=1.0##lsuffix+real[i];                                                         \
+}
+
+#define DBCF_DEF_SIMD_FUNCTIONS(decl,type,size,suffix,lsuffix)\
+    decl DBCF_DEF_SIMD_BLOCK(dbcF_butterfly_block_##size##suffix##_uu,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix          ,dbcF_load##size##suffix          ,dbcF_store##size##suffix          ,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_cexp_##suffix)\
+    decl DBCF_DEF_SIMD_BLOCK(dbcF_butterfly_block_##size##suffix##_au,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix##_aligned,dbcF_load##size##suffix          ,dbcF_store##size##suffix          ,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_cexp_##suffix)\
+    decl DBCF_DEF_SIMD_BLOCK(dbcF_butterfly_block_##size##suffix##_ua,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix          ,dbcF_load##size##suffix##_aligned,dbcF_store##size##suffix##_aligned,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_cexp_##suffix)\
+    decl DBCF_DEF_SIMD_BLOCK(dbcF_butterfly_block_##size##suffix##_aa,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix##_aligned,dbcF_load##size##suffix##_aligned,dbcF_store##size##suffix##_aligned,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_cexp_##suffix)\
+    decl DBCF_DEF_SIMD_PASS(dbcF_butterfly_pass_##size##suffix##_uu,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix          ,dbcF_load##size##suffix          ,dbcF_store##size##suffix          ,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_butterfly_block_##size##suffix##_uu)\
+    decl DBCF_DEF_SIMD_PASS(dbcF_butterfly_pass_##size##suffix##_au,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix##_aligned,dbcF_load##size##suffix          ,dbcF_store##size##suffix          ,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_butterfly_block_##size##suffix##_au)\
+    decl DBCF_DEF_SIMD_PASS(dbcF_butterfly_pass_##size##suffix##_ua,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix          ,dbcF_load##size##suffix##_aligned,dbcF_store##size##suffix##_aligned,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_butterfly_block_##size##suffix##_ua)\
+    decl DBCF_DEF_SIMD_PASS(dbcF_butterfly_pass_##size##suffix##_aa,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix##_aligned,dbcF_load##size##suffix##_aligned,dbcF_store##size##suffix##_aligned,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_butterfly_block_##size##suffix##_aa)\
+    decl DBCF_DEF_SIMD_RADIX4(dbcF_radix4_block_##size##suffix##_uu,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix          ,dbcF_load##size##suffix          ,dbcF_store##size##suffix          ,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix)\
+    decl DBCF_DEF_SIMD_RADIX4(dbcF_radix4_block_##size##suffix##_au,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix##_aligned,dbcF_load##size##suffix          ,dbcF_store##size##suffix          ,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix)\
+    decl DBCF_DEF_SIMD_RADIX4(dbcF_radix4_block_##size##suffix##_ua,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix          ,dbcF_load##size##suffix##_aligned,dbcF_store##size##suffix##_aligned,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix)\
+    decl DBCF_DEF_SIMD_RADIX4(dbcF_radix4_block_##size##suffix##_aa,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix##_aligned,dbcF_load##size##suffix##_aligned,dbcF_store##size##suffix##_aligned,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix)\
+    decl DBCF_DEF_SIMD_BLOCK_INTERLEAVED(dbcF_butterfly_block_##size##suffix##_i,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix,dbcF_store##size##suffix,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_unzip##size##suffix##_re,dbcF_unzip##size##suffix##_im,dbcF_zip##size##suffix##_lo,dbcF_zip##size##suffix##_hi,dbcF_cexp_##suffix)\
+    decl DBCF_DEF_SIMD_PASS_INTERLEAVED(dbcF_butterfly_pass_##size##suffix##_i,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix,dbcF_store##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_unzip##size##suffix##_re,dbcF_unzip##size##suffix##_im,dbcF_zip##size##suffix##_lo,dbcF_zip##size##suffix##_hi,dbcF_butterfly_block_##size##suffix##_i)\
+    decl DBCF_DEF_SIMD_RADIX4_INTERLEAVED(dbcF_radix4_block_##size##suffix##_i,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix,dbcF_store##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_unzip##size##suffix##_re,dbcF_unzip##size##suffix##_im,dbcF_zip##size##suffix##_lo,dbcF_zip##size##suffix##_hi)\
+    decl DBCF_DEF_SIMD_COMPUTE_TWIDDLES(dbcF_compute_twiddles_##size##suffix##_u,type,size,dbcf_simd##size##suffix,lsuffix,dbcF_load##size##suffix          ,dbcF_store##size##suffix          ,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_cexpm1_##suffix)\
+    decl DBCF_DEF_SIMD_COMPUTE_TWIDDLES(dbcF_compute_twiddles_##size##suffix##_a,type,size,dbcf_simd##size##suffix,lsuffix,dbcF_load##size##suffix##_aligned,dbcF_store##size##suffix##_aligned,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_cexpm1_##suffix)\
+    decl DBCF_DEF_SIMD_FFT8(dbcF_fft8_##size##suffix,type,suffix,lsuffix)\
+    decl DBCF_DEF_SIMD_FFT8_INTERLEAVED(dbcF_fft8_##size##suffix##_i,type,suffix,lsuffix)\
+    decl DBCF_DEF_SIMD_BATCH(dbcF_butterfly_batch_##size##suffix,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix##_aligned,dbcF_store##size##suffix##_aligned,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix)
+
+#define DBCF_DEF_SIMD_RADIX_FUNCTIONS(decl,type,size,suffix)\
+    decl DBCF_DEF_SIMD_RADIX(dbcF_radix3_block_##size##suffix,type,size,dbcf_simd##size##suffix,3,3             ,dbcF_load##size##suffix,dbcF_store##size##suffix,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix)\
+    decl DBCF_DEF_SIMD_RADIX(dbcF_radix5_block_##size##suffix,type,size,dbcf_simd##size##suffix,5,5             ,dbcF_load##size##suffix,dbcF_store##size##suffix,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix)\
+    decl DBCF_DEF_SIMD_RADIX(dbcF_radix7_block_##size##suffix,type,size,dbcf_simd##size##suffix,7,7             ,dbcF_load##size##suffix,dbcF_store##size##suffix,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix)\
+    decl DBCF_DEF_SIMD_RADIX(dbcF_radix_block_##size##suffix ,type,size,dbcf_simd##size##suffix,R,DBCF_MAX_RADIX,dbcF_load##size##suffix,dbcF_store##size##suffix,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix)
+
+#ifndef DBC_FFT_NO_FLOAT
+static void dbcF_cexpm1_f(dbcf_index log2n,float  *real,float  *imag);
+static void dbcF_cexp_f(dbcf_index log2n,float  *real,float  *imag);
+static void dbcF_fft8_f(float *real,float *imag,dbcf_index real_stride,dbcf_index imag_stride,int inverse,float c);
+#endif
+#ifndef DBC_FFT_NO_DOUBLE
+static void dbcF_cexpm1_d(dbcf_index log2n,double *real,double *imag);
+static void dbcF_cexp_d(dbcf_index log2n,double *real,double *imag);
+static void dbcF_fft8_d(double *real,double *imag,dbcf_index real_stride,dbcf_index imag_stride,int inverse,double c);
+#endif
+
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD4F)
+DBCF_DEF_SIMD_FUNCTIONS(DBCF_DECL_SIMD4F ,float , 4,f,f)
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD2D)
+DBCF_DEF_SIMD_FUNCTIONS(DBCF_DECL_SIMD2D ,double, 2,d,e0)
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD8F)
+DBCF_DEF_SIMD_FUNCTIONS(DBCF_DECL_SIMD8F ,float , 8,f,f)
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD4D)
+DBCF_DEF_SIMD_FUNCTIONS(DBCF_DECL_SIMD4D ,double, 4,d,e0)
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD16F)
+DBCF_DEF_SIMD_FUNCTIONS(DBCF_DECL_SIMD16F,float ,16,f,f)
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD8D)
+DBCF_DEF_SIMD_FUNCTIONS(DBCF_DECL_SIMD8D ,double, 8,d,e0)
+#endif
+
+#ifndef DBC_FFT_NO_NPOT
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD4F)
+DBCF_DEF_SIMD_RADIX_FUNCTIONS(DBCF_DECL_SIMD4F ,float , 4,f)
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD2D)
+DBCF_DEF_SIMD_RADIX_FUNCTIONS(DBCF_DECL_SIMD2D ,double, 2,d)
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD8F)
+DBCF_DEF_SIMD_RADIX_FUNCTIONS(DBCF_DECL_SIMD8F ,float , 8,f)
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD4D)
+DBCF_DEF_SIMD_RADIX_FUNCTIONS(DBCF_DECL_SIMD4D ,double, 4,d)
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD16F)
+DBCF_DEF_SIMD_RADIX_FUNCTIONS(DBCF_DECL_SIMD16F,float ,16,f)
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD8D)
+DBCF_DEF_SIMD_RADIX_FUNCTIONS(DBCF_DECL_SIMD8D ,double, 8,d)
+#endif
+#endif /* DBC_FFT_NO_NPOT */
+
+/* Detected SIMD widths, except the ones not compiled in (see DBCF_NO_SIMD*). */
+static int dbcF_simd_flags(void)
+{
+    int mask=0;
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD4F)
+    mask|=DBCF_HAS_SIMD4F;
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD2D)
+    mask|=DBCF_HAS_SIMD2D;
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD8F)
+    mask|=DBCF_HAS_SIMD8F;
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD4D)
+    mask|=DBCF_HAS_SIMD4D;
+#endif
+#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD16F)
+    mask|=DBCF_HAS_SIMD16F;
+#endif
+#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD8D)
+    mask|=DBCF_HAS_SIMD8D;
+#endif
+    return dbcf_detect_simd()&mask;
+}
+
+/*
+    SIMD dispatch. The kernels of each SIMD width are collected into
+    a constant table, and dbcF_simd_levels_* return the tables of the
+    available widths, widest first, NULL-terminated. The hooks below
+    walk that list instead of calling dbcf_detect_simd() and testing
+    every width separately, and use the alignment of the data as an
+    index (0 for unaligned, 1 for aligned; 2*data+twiddles for passes).
+*/
+#ifndef DBC_FFT_NO_NPOT
+#define DBCF_SIMD_RADIX_KERNELS(type)\
+    dbcf_index (*radix[4])(dbcf_index,dbcf_index,dbcf_index,type*,type*,const type*,const type*,dbcf_index,const type*,const type*,const type*,const type*);
+#define DBCF_SIMD_RADIX_KERNEL_LIST(size,suffix)\
+    ,{dbcF_radix3_block_##size##suffix,dbcF_radix5_block_##size##suffix,dbcF_radix7_block_##size##suffix,dbcF_radix_block_##size##suffix}
+#else
+#define DBCF_SIMD_RADIX_KERNELS(type)
+#define DBCF_SIMD_RADIX_KERNEL_LIST(size,suffix)
+#endif /* DBC_FFT_NO_NPOT */
+
+#define DBCF_DEF_SIMD_KERNELS_TYPE(type)\
+typedef struct dbcF_simd_kernels_##type                                                                                                \
+{                                                                                                                                      \
+    dbcf_index size;                                                                                                                   \
+    void (*twiddles[2])(dbcf_index,dbcf_index,type*,type*,int);                                                                        \
+    void (*pass[4])(dbcf_index,dbcf_index,type*,type*,int,dbcf_index,const type*,const type*);                                         \
+    void (*pass_i)(dbcf_index,dbcf_index,type*,int,dbcf_index,const type*,const type*);                                                \
+    void (*radix4[4])(dbcf_index,dbcf_index,dbcf_index,type*,type*,const type*,const type*,const type*,const type*,const type*,const type*,int);\
+    void (*radix4_i)(dbcf_index,dbcf_index,dbcf_index,type*,const type*,const type*,const type*,const type*,const type*,const type*,int);\
+    void (*fft8)(type*,type*,int);                                                                                                     \
+    void (*fft8_i)(type*,int);                                                                                                         \
+    void (*batch)(dbcf_index,type*,type*,const type*,const type*);                                                                     \
+    DBCF_SIMD_RADIX_KERNELS(type)                                                                                                      \
+} dbcF_simd_kernels_##type;
+
+#define DBCF_DEF_SIMD_KERNELS(type,size,suffix)\
+static const dbcF_simd_kernels_##type dbcF_simd_kernels_##size##suffix={                                                               \
+    size,                                                                                                                              \
+    {dbcF_compute_twiddles_##size##suffix##_u,dbcF_compute_twiddles_##size##suffix##_a},                                               \
+    {dbcF_butterfly_pass_##size##suffix##_uu,dbcF_butterfly_pass_##size##suffix##_au,                                                  \
+     dbcF_butterfly_pass_##size##suffix##_ua,dbcF_butterfly_pass_##size##suffix##_aa},                                                 \
+    dbcF_butterfly_pass_##size##suffix##_i,                                                                                            \
+    {dbcF_radix4_block_##size##suffix##_uu,dbcF_radix4_block_##size##suffix##_au,                                                      \
+     dbcF_radix4_block_##size##suffix##_ua,dbcF_radix4_block_##size##suffix##_aa},                                                     \
+    dbcF_radix4_block_##size##suffix##_i,                                                                                              \
+    dbcF_fft8_##size##suffix,                                                                                                          \
+    dbcF_fft8_##size##suffix##_i,                                                                                                      \
+    dbcF_butterfly_batch_##size##suffix                                                                                                \
+    DBCF_SIMD_RADIX_KERNEL_LIST(size,suffix)                                                                                           \
+};
+
+/*
+    Lists of the kernel tables, indexed by the mask of available widths
+    (4 for the widest, A, down to 1 for the narrowest, C). The entries
+    of the widths not compiled in are 0, but dbcF_simd_flags() never
+    reports them, so the rows containing them are never selected.
+*/
+#define DBCF_SIMD_LEVELS(A,B,C) {{0},{C,0},{B,0},{B,C,0},{A,0},{A,C,0},{A,B,0},{A,B,C,0}}
+
+/*
+    If the twiddle table is supplied, the twiddles for the pass of size n
+    are read from it directly (see dbcF_compute_twiddle_table), instead of
+    being computed into tr, ti.
+    The fft8 kernels only run for depth>=3 (and 8 points fit each of the
+    SIMD widths), so they always use the widest width.
+*/
+#define DBCF_DEF_SIMD_DISPATCH(type,min_twiddles_log2)\
+/* Returns nonzero, if a radix-4 pass with quarter size 2^log2q has SIMD version. */                                                  \
+static int dbcF_simd_radix4_##type(dbcf_index log2q,const dbcF_simd_kernels_##type *const *levels)                                    \
+{                                                                                                                                      \
+    dbcf_index b;                                                                                                                      \
+    if(DBCF_RADIX4_CHUNK_LOG2<0||!levels[0]) return 0;                                                                                 \
+    b=DBCF_POW2(log2q<DBCF_RADIX4_CHUNK_LOG2?log2q:DBCF_RADIX4_CHUNK_LOG2);                                                            \
+    /* SIMD multipass leaves pairs of passes to dbcF_butterfly_pass4, if */                                                            \
+    /* the radix-4 pass can use the widest available SIMD width. */                                                                    \
+    return b>=levels[0]->size;                                                                                                         \
+}                                                                                                                                      \
+                                                                                                                                       \
+/* Radix-4 passes: the twiddles are prepared by dbcF_butterfly_pass4, the hook only chooses the SIMD width and alignment. */         \
+static int dbcF_radix4_block_optimized_##type(                                                                                         \
+    dbcf_index log2n,                                                                                                                  \
+    dbcf_index log2c,                                                                                                                  \
+    dbcf_index b,                                                                                                                      \
+    type *real,type *imag,                                                                                                             \
+    dbcf_index real_stride,dbcf_index imag_stride,                                                                                     \
+    const type *t1r,const type *t1i,                                                                                                   \
+    const type *t2r,const type *t2i,                                                                                                   \
+    const type *t3r,const type *t3i,                                                                                                   \
+    int inverse)                                                                                                                       \
+{                                                                                                                                      \
+    const dbcF_simd_kernels_##type *const *levels;                                                                                     \
+    const dbcF_simd_kernels_##type *k;                                                                                                 \
+    int interleaved=(real_stride==2&&imag_stride==2&&imag==real+1);                                                                    \
+    if(!interleaved&&(real_stride!=1||imag_stride!=1)) {DBCF_PROFILE_FALLBACK(DBCF_PROFILE_FALLBACK_STRIDE);return 0;}                 \
+    for(levels=dbcF_simd_levels_##type();(k=*levels)!=0;++levels)                                                                      \
+    {                                                                                                                                  \
+        dbcf_index bytes=k->size*(dbcf_index)sizeof(type);                                                                             \
+        int alignd,alignt;                                                                                                             \
+        if(b<k->size) continue;                                                                                                        \
+        if(interleaved)                                                                                                                \
+        {                                                                                                                              \
+            DBCF_PROFILE_KERNEL(k->size,DBCF_PROFILE_INTERLEAVED);                                                                     \
+            DBCF_PROFILE_ENTER(DBCF_PROFILE_SIMD);                                                                                     \
+            k->radix4_i(log2n,log2c,b,real,t1r,t1i,t2r,t2i,t3r,t3i,inverse);                                                           \
+            DBCF_PROFILE_LEAVE(DBCF_PROFILE_SIMD);                                                                                     \
+            return 1;                                                                                                                  \
+        }                                                                                                                              \
+        alignd=DBCF_IS_ALIGNED(real,bytes)&&DBCF_IS_ALIGNED(imag,bytes);                                                               \
+        alignt=DBCF_IS_ALIGNED(t1r,bytes)&&DBCF_IS_ALIGNED(t1i,bytes)&&DBCF_IS_ALIGNED(t2r,bytes)&&DBCF_IS_ALIGNED(t2i,bytes)&&        \
+               DBCF_IS_ALIGNED(t3r,bytes)&&DBCF_IS_ALIGNED(t3i,bytes);                                                                 \
+        DBCF_PROFILE_KERNEL(k->size,2*alignd+alignt);                                                                                  \
+        DBCF_PROFILE_ENTER(DBCF_PROFILE_SIMD);                                                                                         \
+        k->radix4[2*alignd+alignt](log2n,log2c,b,real,imag,t1r,t1i,t2r,t2i,t3r,t3i,inverse);                                           \
+        DBCF_PROFILE_LEAVE(DBCF_PROFILE_SIMD);                                                                                         \
+        return 1;                                                                                                                      \
+    }                                                                                                                                  \
+    DBCF_PROFILE_FALLBACK(DBCF_PROFILE_FALLBACK_SIZE);                                                                                 \
+    return 0;                                                                                                                          \
+}                                                                                                                                      \
+                                                                                                                                       \
+static dbcf_index dbcF_butterfly_pass_optimized_##type(                                                                                \
+    dbcf_index log2n,                                                                                                                  \
+    dbcf_index log2c,                                                                                                                  \
+    type *real,type *imag,                                                                                                             \
+    int interleaved,                                                                                                                   \
+    int inverse,                                                                                                                       \
+    dbcf_index log2t,                                                                                                                  \
+    type *tr,type *ti,                                                                                                                 \
+    const type *table_real,const type *table_imag,                                                                                     \
+    const dbcF_simd_kernels_##type *const *levels)                                                                                     \
+{                                                                                                                                      \
+    const dbcF_simd_kernels_##type *k;                                                                                                 \
+    for(;(k=*levels)!=0;++levels)                                                                                                      \
+    {                                                                                                                                  \
+        dbcf_index size=k->size,bytes=size*(dbcf_index)sizeof(type);                                                                   \
+        const type *twr=tr,*twi=ti;                                                                                                    \
+        int alignt,alignd=DBCF_IS_ALIGNED(real,bytes)&&DBCF_IS_ALIGNED(imag,bytes);                                                    \
+        if(((size<<2)>>log2n)>1||((size<<1)>>log2t)>1) continue;                                                                       \
+        if(table_real)                                                                                                                 \
+        {                                                                                                                              \
+            twr=table_real+DBCF_POW2(log2n-1);                                                                                         \
+            twi=table_imag+DBCF_POW2(log2n-1);                                                                                         \
+        }                                                                                                                              \
+        else                                                                                                                           \
+        {                                                                                                                              \
+            DBCF_PROFILE_ENTER(DBCF_PROFILE_TWIDDLES);                                                                                 \
+            k->twiddles[DBCF_IS_ALIGNED(tr,bytes)&&DBCF_IS_ALIGNED(ti,bytes)](log2n,log2t,tr,ti,inverse);                              \
+            DBCF_PROFILE_LEAVE(DBCF_PROFILE_TWIDDLES);                                                                                 \
+        }                                                                                                                              \
+        alignt=DBCF_IS_ALIGNED(twr,bytes)&&DBCF_IS_ALIGNED(twi,bytes);                                                                 \
+        DBCF_PROFILE_KERNEL(size,interleaved?DBCF_PROFILE_INTERLEAVED:2*alignd+alignt);                                                \
+        DBCF_PROFILE_ENTER(DBCF_PROFILE_SIMD);                                                                                         \
+        if(interleaved) k->pass_i(log2n,log2c,real,inverse,log2t,twr,twi);                                                             \
+        else            k->pass[2*alignd+alignt](log2n,log2c,real,imag,inverse,log2t,twr,twi);                                         \
+        DBCF_PROFILE_LEAVE(DBCF_PROFILE_SIMD);                                                                                         \
+        return 1;                                                                                                                      \
+    }                                                                                                                                  \
+    return 0;                                                                                                                          \
+}                                                                                                                                      \
+                                                                                                                                       \
+/* Returns the number of passes actually performed (always contiguous, starting from log2n-depth+1). */                              \
+static dbcf_index dbcF_butterfly_multipass_optimized_##type(                                                                           \
+    dbcf_index log2n,                                                                                                                  \
+    dbcf_index log2c,                                                                                                                  \
+    dbcf_index depth,                                                                                                                  \
+    type *real,type *imag,                                                                                                             \
+    dbcf_index real_stride,dbcf_index imag_stride,                                                                                     \
+    int inverse,                                                                                                                       \
+    type *tr,type *ti,                                                                                                                 \
+    const type *table_real,const type *table_imag)                                                                                     \
+{                                                                                                                                      \
+    dbcf_index ret=0;                                                                                                                  \
+    const dbcF_simd_kernels_##type *const *levels;                                                                                     \
+    int interleaved=(real_stride==2&&imag_stride==2&&imag==real+1);                                                                    \
+    if(!interleaved&&(real_stride!=1||imag_stride!=1)) {DBCF_PROFILE_FALLBACK(DBCF_PROFILE_FALLBACK_STRIDE);return 0;}                 \
+    levels=dbcF_simd_levels_##type();                                                                                                  \
+    if(!levels[0]||DBCF_TWIDDLES_BUF_LOG2<min_twiddles_log2) {DBCF_PROFILE_FALLBACK(DBCF_PROFILE_FALLBACK_NO_SIMD);return 0;}          \
+    if(depth==log2n&&depth>=3)                                                                                                         \
+    {                                                                                                                                  \
+        dbcf_index j,m=DBCF_POW2(log2n+log2c-3);                                                                                       \
+        DBCF_PROFILE_ENTER(DBCF_PROFILE_SIMD);                                                                                         \
+        if(interleaved) for(j=0;j<m;++j) levels[0]->fft8_i(real+16*j,inverse);                                                         \
+        else            for(j=0;j<m;++j) levels[0]->fft8(real+8*j,imag+8*j,inverse);                                                   \
+        DBCF_PROFILE_LEAVE(DBCF_PROFILE_SIMD);                                                                                         \
+        depth-=3;                                                                                                                      \
+        ret=3;                                                                                                                         \
+    }                                                                                                                                  \
+    if(log2n-depth+1>3)                                                                                                                \
+    {                                                                                                                                  \
+        dbcf_index log2d;                                                                                                              \
+        for(log2d=log2n-depth+1;log2d<=log2n;++log2d)                                                                                  \
+        {                                                                                                                              \
+            dbcf_index log2t=(log2d-1<DBCF_TWIDDLES_BUF_LOG2||table_real?log2d-1:DBCF_TWIDDLES_BUF_LOG2);                              \
+            /* 2 passes at once are left to dbcF_butterfly_pass4. */                                                                   \
+            if(log2d<log2n&&dbcF_simd_radix4_##type(log2d-1,levels)) break;                                                            \
+            if(dbcF_butterfly_pass_optimized_##type(log2d,log2c+log2n-log2d,real,imag,interleaved,inverse,log2t,tr,ti,table_real,table_imag,levels)) ++ret;\
+            else break;                                                                                                                \
+        }                                                                                                                              \
+        return ret;                                                                                                                    \
+    }                                                                                                                                  \
+    DBCF_PROFILE_FALLBACK(DBCF_PROFILE_FALLBACK_SIZE);                                                                                 \
+    return 0;                                                                                                                          \
+}                                                                                                                                      \
+                                                                                                                                       \
+/*                                                                                                                                     \
+    Batched transforms: returns the number of SIMD lanes (i.e. transforms                                                              \
+    processed at once) to use for transforms of size n, or 0 if the batched                                                           \
+    SIMD path is not available. The widest SIMD, such that the tile                                                                    \
+    fits into DBCF_BATCH_BUF_SIZE, is chosen. Sizes above                                                                              \
+    DBCF_BATCH_BUF_SIZE/16 are left to the regular path, which is faster                                                               \
+    there.                                                                                                                             \
+*/                                                                                                                                     \
+static dbcf_index dbcF_batch_lanes_optimized_##type(dbcf_index log2n)                                                                  \
+{                                                                                                                                      \
+    const dbcF_simd_kernels_##type *const *levels;                                                                                     \
+    if(16*DBCF_POW2(log2n)>DBCF_BATCH_BUF_SIZE) return 0;                                                                              \
+    for(levels=dbcF_simd_levels_##type();*levels;++levels)                                                                             \
+        if(2*(*levels)->size*DBCF_POW2(log2n)<=DBCF_BATCH_BUF_SIZE) return (*levels)->size;                                            \
+    return 0;                                                                                                                          \
+}                                                                                                                                      \
+                                                                                                                                       \
+static void dbcF_butterfly_batch_optimized_##type(dbcf_index lanes,dbcf_index log2n,type *real,type *imag,const type *tr,const type *ti)\
+{                                                                                                                                      \
+    const dbcF_simd_kernels_##type *const *levels;                                                                                     \
+    for(levels=dbcF_simd_levels_##type();*levels;++levels)                                                                             \
+        if((*levels)->size==lanes)                                                                                                     \
+        {                                                                                                                              \
+            DBCF_PROFILE_ENTER(DBCF_PROFILE_SIMD);                                                                                     \
+            (*levels)->batch(log2n,real,imag,tr,ti);                                                                                   \
+            DBCF_PROFILE_LEAVE(DBCF_PROFILE_SIMD);                                                                                     \
+            return;                                                                                                                    \
+        }                                                                                                                              \
+}                                                                                                                                      \
+DBCF_DEF_SIMD_RADIX_DISPATCH(type)
+
+#ifndef DBC_FFT_NO_NPOT
+/*
+    Mixed-radix butterflies: returns the number of butterflies computed
+    (the rest is left to the scalar code).
+*/
+#define DBCF_DEF_SIMD_RADIX_DISPATCH(type)\
+static dbcf_index dbcF_radix_block_optimized_##type(                                                                                   \
+    dbcf_index R,                                                                                                                      \
+    dbcf_index M,                                                                                                                      \
+    dbcf_index b,                                                                                                                      \
+    type *real,type *imag,                                                                                                             \
+    const type *sr,const type *si,                                                                                                     \
+    dbcf_index s_stride,                                                                                                               \
+    const type *cr,const type *ci,                                                                                                     \
+    const type *ur,const type *ui)                                                                                                     \
+{                                                                                                                                      \
+    const dbcF_simd_kernels_##type *const *levels;                                                                                     \
+    for(levels=dbcF_simd_levels_##type();*levels;++levels)                                                                             \
+        if(b>=(*levels)->size)                                                                                                         \
+        {                                                                                                                              \
+            dbcf_index ret;                                                                                                            \
+            DBCF_PROFILE_ENTER(DBCF_PROFILE_SIMD);                                                                                     \
+            ret=(*levels)->radix[R==3?0:R==5?1:R==7?2:3](R,M,b,real,imag,sr,si,s_stride,cr,ci,ur,ui);                                  \
+            DBCF_PROFILE_LEAVE(DBCF_PROFILE_SIMD);                                                                                     \
+            return ret;                                                                                                                \
+        }                                                                                                                              \
+    return 0;                                                                                                                          \
+}
+#else
+#define DBCF_DEF_SIMD_RADIX_DISPATCH(type)
+#endif /* DBC_FFT_NO_NPOT */
+
+#ifndef DBC_FFT_NO_FLOAT
+DBCF_DEF_SIMD_KERNELS_TYPE(float)
+#ifndef DBCF_NO_SIMD16F
+DBCF_DEF_SIMD_KERNELS(float,16,f)
+#define DBCF_SIMD_KERNELS_16F &dbcF_simd_kernels_16f
+#else
+#define DBCF_SIMD_KERNELS_16F 0
+#endif
+#ifndef DBCF_NO_SIMD8F
+DBCF_DEF_SIMD_KERNELS(float,8,f)
+#define DBCF_SIMD_KERNELS_8F &dbcF_simd_kernels_8f
+#else
+#define DBCF_SIMD_KERNELS_8F 0
+#endif
+#ifndef DBCF_NO_SIMD4F
+DBCF_DEF_SIMD_KERNELS(float,4,f)
+#define DBCF_SIMD_KERNELS_4F &dbcF_simd_kernels_4f
+#else
+#define DBCF_SIMD_KERNELS_4F 0
+#endif
+
+static const dbcF_simd_kernels_float *const dbcF_simd_levels_table_float[8][4]=
+    DBCF_SIMD_LEVELS(DBCF_SIMD_KERNELS_16F,DBCF_SIMD_KERNELS_8F,DBCF_SIMD_KERNELS_4F);
+
+static const dbcF_simd_kernels_float *const *dbcF_simd_levels_float(void)
+{
+    int flags=dbcF_simd_flags();
+    return dbcF_simd_levels_table_float[((flags&DBCF_HAS_SIMD16F)>>2)|((flags&DBCF_HAS_SIMD8F)>>1)|(flags&DBCF_HAS_SIMD4F)];
+}
+
+DBCF_DEF_SIMD_DISPATCH(float,3)
+#endif /* DBC_FFT_NO_FLOAT */
+
+#ifndef DBC_FFT_NO_DOUBLE
+DBCF_DEF_SIMD_KERNELS_TYPE(double)
+#ifndef DBCF_NO_SIMD8D
+DBCF_DEF_SIMD_KERNELS(double,8,d)
+#define DBCF_SIMD_KERNELS_8D &dbcF_simd_kernels_8d
+#else
+#define DBCF_SIMD_KERNELS_8D 0
+#endif
+#ifndef DBCF_NO_SIMD4D
+DBCF_DEF_SIMD_KERNELS(double,4,d)
+#define DBCF_SIMD_KERNELS_4D &dbcF_simd_kernels_4d
+#else
+#define DBCF_SIMD_KERNELS_4D 0
+#endif
+#ifndef DBCF_NO_SIMD2D
+DBCF_DEF_SIMD_KERNELS(double,2,d)
+#define DBCF_SIMD_KERNELS_2D &dbcF_simd_kernels_2d
+#else
+#define DBCF_SIMD_KERNELS_2D 0
+#endif
+
+static const dbcF_simd_kernels_double *const dbcF_simd_levels_table_double[8][4]=
+    DBCF_SIMD_LEVELS(DBCF_SIMD_KERNELS_8D,DBCF_SIMD_KERNELS_4D,DBCF_SIMD_KERNELS_2D);
+
+static const dbcF_simd_kernels_double *const *dbcF_simd_levels_double(void)
+{
+    int flags=dbcF_simd_flags();
+    return dbcF_simd_levels_table_double[((flags&DBCF_HAS_SIMD8D)>>3)|((flags&DBCF_HAS_SIMD4D)>>2)|((flags&DBCF_HAS_SIMD2D)>>1)];
+}
+
+DBCF_DEF_SIMD_DISPATCH(double,2)
+#endif /* DBC_FFT_NO_DOUBLE */
+
+/*
+    F16C conversions of IEEE binary16 (see dbc_fft_hc), rounding to
+    nearest-even. Each returns the number of elements it processed, the
+    rest is left to the scalar code. The *2 versions (de)interleave the
+    complex numbers at the same time.
+*/
+#if defined(DBCF_X86_OR_X64) && defined(__GNUC__) && !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_F16C)
+#define DBCF_F16C
+#include <immintrin.h>
+#if defined(__F16C__)
+#define DBCF_DECL_F16C
+#elif defined(DBCF_X64)
+#define DBCF_DECL_F16C __attribute__((target("f16c"))) /* No stdcall in x64. */
+#else
+#define DBCF_DECL_F16C __attribute__((target("f16c"),stdcall))
+#endif
+
+DBCF_DECL_F16C static dbcf_index dbcF_f16c_load(dbcf_index n,const unsigned short *src,float *dst)
+{
+    dbcf_index i;
+    for(i=0;i+8<=n;i+=8)
+        _mm256_storeu_ps(dst+i,_mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(src+i))));
+    return i;
+}
+
+DBCF_DECL_F16C static dbcf_index dbcF_f16c_load2(dbcf_index n,const unsigned short *src,float *re,float *im)
+{
+    dbcf_index i;
+    for(i=0;i+4<=n;i+=4)
+    {
+        __m128i h=_mm_loadu_si128((const __m128i*)(src+2*i));
+        __m128 a=_mm_cvtph_ps(h),b=_mm_cvtph_ps(_mm_unpackhi_epi64(h,h));
+        _mm_storeu_ps(re+i,_mm_shuffle_ps(a,b,0x88));
+        _mm_storeu_ps(im+i,_mm_shuffle_ps(a,b,0xDD));
+    }
+    return i;
+}
+
+DBCF_DECL_F16C static dbcf_index dbcF_f16c_store(dbcf_index n,const float *src,unsigned short *dst)
+{
+    dbcf_index i;
+    for(i=0;i+8<=n;i+=8)
+        _mm_storeu_si128((__m128i*)(dst+i),_mm256_cvtps_ph(_mm256_loadu_ps(src+i),0));
+    return i;
+}
+
+DBCF_DECL_F16C static dbcf_index dbcF_f16c_store2(dbcf_index n,const float *re,const float *im,unsigned short *dst)
+{
+    dbcf_index i;
+    for(i=0;i+4<=n;i+=4)
+    {
+        __m128 r=_mm_loadu_ps(re+i),m=_mm_loadu_ps(im+i);
+        __m128i lo=_mm_cvtps_ph(_mm_unpacklo_ps(r,m),0),hi=_mm_cvtps_ph(_mm_unpackhi_ps(r,m),0);
+        _mm_storeu_si128((__m128i*)(dst+2*i),_mm_unpacklo_epi64(lo,hi));
+    }
+    return i;
+}
+#endif
+
+/*
+    Q15 butterfly passes (see dbcF_q15_pass), 4 complex numbers at once
+    (8 for AVX2, from m>=8 on): pmulhrsw (vqrdmulh for NEON) is exactly
+    dbcF_q15_mulhrs for the arguments that occur (the twiddles and the
+    shift multipliers are never -32768), so the results are bitwise
+    identical to the scalar code.
+*/
+#if defined(DBCF_X86_OR_X64) && defined(__GNUC__) && !defined(DBCF_NO_SSSE3)
+#define DBCF_Q15_SSSE3
+#include <tmmintrin.h>
+#if defined(__SSSE3__)
+#define DBCF_DECL_SSSE3
+#elif defined(DBCF_X64)
+#define DBCF_DECL_SSSE3 __attribute__((target("ssse3"))) /* No stdcall in x64. */
+#else
+#define DBCF_DECL_SSSE3 __attribute__((target("ssse3"),stdcall))
+#endif
+
+DBCF_DECL_SSSE3 static int dbcF_q15_pass_ssse3(dbcf_index n,dbcf_index m,short *x,const short *w,int s,int inverse)
+{
+    dbcf_index j,k;
+    short hi[8],lo[8];
+    int i,ret=0;
+    __m128i mx=_mm_setzero_si128(),mn=_mm_setzero_si128();
+    __m128i sh=_mm_set1_epi16((short)(s?1<<(15-s):0));
+    if(m<4)
+    {
+        /* The first 2 passes, within each group of 4 complex numbers. */
+        __m128i sign=(m==1?_mm_set_epi16(-1,-1,1,1,-1,-1,1,1):_mm_set_epi16(-1,-1,-1,-1,1,1,1,1));
+        __m128i rot=(inverse?_mm_set_epi16(1,-1,1,1,1,1,1,1):_mm_set_epi16(-1,1,1,1,1,1,1,1));
+        for(j=0;j<n;j+=4)
+        {
+            __m128i v=_mm_loadu_si128((const __m128i*)(x+2*j)),a,b;
+            if(m==2) v=_mm_sign_epi16(_mm_shufflehi_epi16(v,0xB4),rot);
+            if(s) v=_mm_mulhrs_epi16(v,sh);
+            a=(m==1?_mm_shuffle_epi32(v,0xA0):_mm_shuffle_epi32(v,0x44));
+            b=(m==1?_mm_shuffle_epi32(v,0xF5):_mm_shuffle_epi32(v,0xEE));
+            v=_mm_add_epi16(a,_mm_sign_epi16(b,sign));
+            _mm_storeu_si128((__m128i*)(x+2*j),v);
+            mx=_mm_max_epi16(mx,v);
+            mn=_mm_min_epi16(mn,v);
+        }
+    }
+    else for(j=0;j<n;j+=2*m)
+        for(k=0;k<m;k+=4)
+        {
+            short *pa=x+2*(j+k),*pb=pa+2*m;
+            __m128i a=_mm_loadu_si128((const __m128i*)pa),b=_mm_loadu_si128((const __m128i*)pb),t,u,v;
+            if(s) {a=_mm_mulhrs_epi16(a,sh);b=_mm_mulhrs_epi16(b,sh);}
+            t=_mm_add_epi16(
+                _mm_mulhrs_epi16(b,_mm_loadu_si128((const __m128i*)(w+4*k))),
+                _mm_mulhrs_epi16(_mm_shufflehi_epi16(_mm_shufflelo_epi16(b,0xB1),0xB1),_mm_loadu_si128((const __m128i*)(w+4*k+8))));
+            u=_mm_add_epi16(a,t);
+            v=_mm_sub_epi16(a,t);
+            _mm_storeu_si128((__m128i*)pa,u);
+            _mm_storeu_si128((__m128i*)pb,v);
+            mx=_mm_max_epi16(mx,_mm_max_epi16(u,v));
+            mn=_mm_min_epi16(mn,_mm_min_epi16(u,v));
+        }
+    _mm_storeu_si128((__m128i*)hi,mx);
+    _mm_storeu_si128((__m128i*)lo,mn);
+    for(i=0;i<8;++i)
+    {
+        if(hi[i]>ret) ret=hi[i];
+        if(-lo[i]>ret) ret=-lo[i];
+    }
+    return ret;
+}
+
+#if !defined(DBCF_NO_AVX2)
+#define DBCF_Q15_AVX2
+#include <immintrin.h>
+#if defined(__AVX2__)
+#define DBCF_DECL_AVX2
+#elif defined(DBCF_X64)
+#define DBCF_DECL_AVX2 __attribute__((target("avx2"))) /* No stdcall in x64. */
+#else
+#define DBCF_DECL_AVX2 __attribute__((target("avx2"),stdcall))
+#endif
+
+/*
+    The twiddles come in groups of 4 (see dbcF_q15_table), so those of 8
+    consecutive k are gathered from 2 groups.
+*/
+DBCF_DECL_AVX2 static int dbcF_q15_pass_avx2(dbcf_index n,dbcf_index m,short *x,const short *w,int s)
+{
+    dbcf_index j,k;
+    short hi[16],lo[16];
+    int i,ret=0;
+    __m256i mx=_mm256_setzero_si256(),mn=_mm256_setzero_si256();
+    __m256i sh=_mm256_set1_epi16((short)(s?1<<(15-s):0));
+    for(j=0;j<n;j+=2*m)
+        for(k=0;k<m;k+=8)
+        {
+            short *pa=x+2*(j+k),*pb=pa+2*m;
+            __m256i a=_mm256_loadu_si256((const __m256i*)pa),b=_mm256_loadu_si256((const __m256i*)pb),t,u,v;
+            __m256i w0=_mm256_loadu_si256((const __m256i*)(w+4*k)),w1=_mm256_loadu_si256((const __m256i*)(w+4*k+16));
+            if(s) {a=_mm256_mulhrs_epi16(a,sh);b=_mm256_mulhrs_epi16(b,sh);}
+            t=_mm256_add_epi16(
+                _mm256_mulhrs_epi16(b,_mm256_permute2x128_si256(w0,w1,0x20)),
+                _mm256_mulhrs_epi16(_mm256_shufflehi_epi16(_mm256_shufflelo_epi16(b,0xB1),0xB1),_mm256_permute2x128_si256(w0,w1,0x31)));
+            u=_mm256_add_epi16(a,t);
+            v=_mm256_sub_epi16(a,t);
+            _mm256_storeu_si256((__m256i*)pa,u);
+            _mm256_storeu_si256((__m256i*)pb,v);
+            mx=_mm256_max_epi16(mx,_mm256_max_epi16(u,v));
+            mn=_mm256_min_epi16(mn,_mm256_min_epi16(u,v));
+        }
+    _mm256_storeu_si256((__m256i*)hi,mx);
+    _mm256_storeu_si256((__m256i*)lo,mn);
+    for(i=0;i<16;++i)
+    {
+        if(hi[i]>ret) ret=hi[i];
+        if(-lo[i]>ret) ret=-lo[i];
+    }
+    return ret;
+}
+#endif /* !defined(DBCF_NO_AVX2) */
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define DBCF_Q15_NEON
+#include <arm_neon.h>
+
+static int dbcF_q15_pass_neon(dbcf_index n,dbcf_index m,short *x,const short *w,int s)
+{
+    dbcf_index j,k;
+    int ret;
+    int16x8_t mx=vdupq_n_s16(0),mn=vdupq_n_s16(0);
+    int16x8_t sh=vdupq_n_s16((short)(s?1<<(15-s):0));
+    for(j=0;j<n;j+=2*m)
+        for(k=0;k<m;k+=4)
+        {
+            short *pa=x+2*(j+k),*pb=pa+2*m;
+            int16x8_t a=vld1q_s16(pa),b=vld1q_s16(pb),t,u,v;
+            if(s) {a=vqrdmulhq_s16(a,sh);b=vqrdmulhq_s16(b,sh);}
+            t=vaddq_s16(
+                vqrdmulhq_s16(b,vld1q_s16(w+4*k)),
+                vqrdmulhq_s16(vrev32q_s16(b),vld1q_s16(w+4*k+8)));
+            u=vaddq_s16(a,t);
+            v=vsubq_s16(a,t);
+            vst1q_s16(pa,u);
+            vst1q_s16(pb,v);
+            mx=vmaxq_s16(mx,vmaxq_s16(u,v));
+            mn=vminq_s16(mn,vminq_s16(u,v));
+        }
+    ret=vmaxvq_s16(mx);
+    if(-(int)vminvq_s16(mn)>ret) ret=-(int)vminvq_s16(mn);
+    return ret;
+}
+#endif
+#endif /* DBC_FFT_NO_SIMD */
+
+#ifdef DBC_FFT_THREADS
+/* Threading. */
+#ifndef DBCF_THREADS_MIN_LOG2
+#define DBCF_THREADS_MIN_LOG2 16
+#endif
+#ifndef DBCF_MAX_TASKS
+#define DBCF_MAX_TASKS 64
+#endif
+
+#ifndef DBC_FFT_NO_DEFAULT_THREADS
+#if defined(__cplusplus) && (__cplusplus>=201103L)
+#include <thread>
+static void *dbcF_default_spawn(void (*func)(void*),void *arg,void *user)
+{
+    (void)user;
+    try {return new std::thread(func,arg);}
+    catch(...) {return 0;}
+}
+
+static void dbcF_default_join(void *task,void *user)
+{
+    std::thread *thread=static_cast<std::thread*>(task);
+    (void)user;
+    thread->join();
+    delete thread;
+}
+#else
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+typedef struct dbcF_thread
+{
+#ifdef _WIN32
+    void *handle;
+#else
+    pthread_t handle;
+#endif
+    void (*func)(void*);
+    void *arg;
+} dbcF_thread;
+
+#ifdef _WIN32
+static unsigned long __stdcall dbcF_thread_start(void *p)
+#else
+static void *dbcF_thread_start(void *p)
+#endif
+{
+    dbcF_thread *thread=(dbcF_thread*)p;
+    thread->func(thread->arg);
+    return 0;
+}
+
+static void *dbcF_default_spawn(void (*func)(void*),void *arg,void *user)
+{
+    dbcF_thread *thread=(dbcF_thread*)dbcf_malloc((dbcf_index)sizeof(dbcF_thread));
+    (void)user;
+    if(!thread) return 0;
+    thread->func=func;
+    thread->arg=arg;
+#ifdef _WIN32
+    thread->handle=CreateThread(0,0,dbcF_thread_start,thread,0,0);
+    if(!thread->handle) {dbcf_free(thread);return 0;}
+#else
+    if(pthread_create(&thread->handle,0,dbcF_thread_start,thread)) {dbcf_free(thread);return 0;}
+#endif
+    return thread;
+}
+
+static void dbcF_default_join(void *task,void *user)
+{
+    dbcF_thread *thread=(dbcF_thread*)task;
+    (void)user;
+#ifdef _WIN32
+    WaitForSingleObject(thread->handle,INFINITE);
+    CloseHandle(thread->handle);
+#else
+    pthread_join(thread->handle,0);
+#endif
+    dbcf_free(thread);
+}
+#endif
+#define DBCF_DEFAULT_SPAWN dbcF_default_spawn
+#define DBCF_DEFAULT_JOIN  dbcF_default_join
+#else
+#define DBCF_DEFAULT_SPAWN 0
+#define DBCF_DEFAULT_JOIN  0
+#endif /* DBC_FFT_NO_DEFAULT_THREADS */
+
+static int dbcF_num_threads=1;
+static void *(*dbcF_spawn_callback)(void (*func)(void*),void *arg,void *user)=DBCF_DEFAULT_SPAWN;
+static void  (*dbcF_join_callback)(void *task,void *user)=DBCF_DEFAULT_JOIN;
+static void *dbcF_callback_user=0;
+
+DBCF_DEF void dbc_fft_set_threads(
+    int num_threads,
+    void *(*spawn)(void (*func)(void*),void *arg,void *user),
+    void (*join)(void *task,void *user),
+    void *user)
+{
+    dbcF_num_threads=(num_threads>1?num_threads:1);
+    if(spawn&&join)
+    {
+        dbcF_spawn_callback=spawn;
+        dbcF_join_callback=join;
+        dbcF_callback_user=user;
+    }
+    else
+    {
+        dbcF_spawn_callback=DBCF_DEFAULT_SPAWN;
+        dbcF_join_callback=DBCF_DEFAULT_JOIN;
+        dbcF_callback_user=0;
+    }
+}
+
+#ifdef DBC_FFT_PROFILE
+/*
+    Tasks spawned by this thread and not joined yet (func==NULL marks
+    a free slot). The task runs with its own thread's counters zeroed,
+    the counts it made go into the slot, and are added to the counters
+    of the joining thread.
+*/
+typedef struct dbcF_profile_task
+{
+    void *task;
+    void (*func)(void*);
+    void *arg;
+    dbcf_profile counters;
+} dbcF_profile_task;
+
+static DBCF_THREAD_LOCAL dbcF_profile_task dbcF_profile_tasks[DBCF_MAX_TASKS];
+
+static dbcF_profile_task *dbcF_profile_find(void *task)
+{
+    int i;
+    for(i=0;i<DBCF_MAX_TASKS;++i)
+        if(dbcF_profile_tasks[i].task==task&&(task||!dbcF_profile_tasks[i].func)) return dbcF_profile_tasks+i;
+    return 0;
+}
+
+static void dbcF_profile_run(void *arg)
+{
+    dbcF_profile_task *slot=(dbcF_profile_task*)arg;
+    dbcf_profile saved=dbcF_profile.counters;
+    dbcF_profile_clear(&dbcF_profile.counters);
+    slot->func(slot->arg);
+    slot->counters=dbcF_profile.counters;
+    dbcF_profile.counters=saved;
+}
+
+static void dbcF_profile_add(dbcf_profile *dst,const dbcf_profile *src)
+{
+    int i,j;
+    for(i=0;i<DBCF_PROFILE_STAGES;++i)
+    {
+        dst->calls[i]+=src->calls[i];
+        dst->ticks[i]+=src->ticks[i];
+    }
+    for(i=0;i<4;++i) for(j=0;j<DBCF_PROFILE_VARIANTS;++j) dst->simd[i][j]+=src->simd[i][j];
+    for(i=0;i<DBCF_PROFILE_FALLBACKS;++i) dst->fallbacks[i]+=src->fallbacks[i];
+}
+#endif /* DBC_FFT_PROFILE */
+
+/*
+    Start func(arg) as a separate task. If that fails (or there is no
+    way to spawn tasks), func(arg) is run immediately, and NULL is returned.
+*/
+static void *dbcF_spawn(void (*func)(void*),void *arg)
+{
+    void *task=0;
+#ifdef DBC_FFT_PROFILE
+    dbcF_profile_task *slot=dbcF_profile_find(0);
+    if(slot&&dbcF_spawn_callback)
+    {
+        slot->func=func;
+        slot->arg=arg;
+        task=dbcF_spawn_callback(dbcF_profile_run,slot,dbcF_callback_user);
+        if(task) {slot->task=task;return task;}
+        slot->func=0;
+    }
+    else
+#endif /* DBC_FFT_PROFILE */
+    if(dbcF_spawn_callback) task=dbcF_spawn_callback(func,arg,dbcF_callback_user);
+    if(!task) func(arg);
+    return task;
+}
+
+static void dbcF_join(void *task)
+{
+#ifdef DBC_FFT_PROFILE
+    dbcF_profile_task *slot;
+    if(!task) return;
+    DBCF_PROFILE_ENTER(DBCF_PROFILE_JOIN);
+    dbcF_join_callback(task,dbcF_callback_user);
+    DBCF_PROFILE_LEAVE(DBCF_PROFILE_JOIN);
+    if((slot=dbcF_profile_find(task))!=0)
+    {
+        dbcF_profile_add(&dbcF_profile.counters,&slot->counters);
+        slot->task=0;
+        slot->func=0;
+    }
+#else
+    if(task) dbcF_join_callback(task,dbcF_callback_user);
+#endif /* DBC_FFT_PROFILE */
+}
+
+#define DBCF_NUM_THREADS dbcF_num_threads
+#else
+#define DBCF_NUM_THREADS 1
+#endif /* DBC_FFT_THREADS */
+
+#ifndef DBC_FFT_NO_NPOT
+/*
+    Returns the radix of the outermost mixed-radix pass for n, i.e. the
+    smallest odd prime factor of n, if it does not exceed DBCF_MAX_RADIX,
+    and 0 otherwise.
+*/
+static dbcf_index dbcF_radix(dbcf_index n)
+{
+    dbcf_index p;
+    while(n>1&&!(n&1)) n>>=1;
+    for(p=3;p<=DBCF_MAX_RADIX&&p<=n;p+=2)
+        if(n%p==0) return p;
+    return 0;
+}
+
+/*
+    Returns nonzero, if n is a product of a power of 2 and primes not
+    exceeding DBCF_MAX_RADIX, i.e. can be computed by the mixed-radix
+    algorithm.
+*/
+static int dbcF_is_smooth(dbcf_index n)
+{
+    dbcf_index p;
+    while(n>1&&!(n&1)) n>>=1;
+    for(p=3;p<=DBCF_MAX_RADIX&&n>1;p+=2)
+        while(n%p==0) n/=p;
+    return n==1;
+}
+
+/*
+    Candidate inner size of Bluestein's algorithm for n with the odd part
+    s: the smallest s*2^k>=2*n-1, or 0 if s is not a product of 3 and 5
+    handled by the mixed-radix algorithm, or (for s>1) the size exceeds
+    3*n. The latter keeps the memory within the bounds of the power of 2
+    (see MEMORY USAGE), and loses nothing, since one of 3*2^k, 5*2^k,
+    9*2^k, 15*2^k, 2^k is always within 5/4 of 2*n-1.
+*/
+static dbcf_index dbcF_npot_candidate(dbcf_index n,dbcf_index s)
+{
+    dbcf_index t=s,m=s;
+    while(t%3==0) t/=3;
+    while(t%5==0) t/=5;
+    if(t!=1||!dbcF_is_smooth(s)) return 0;
+    while(m<2*n-1) m*=2;
+    return (s==1||m<=3*n?m:0);
+}
+
+/*
+    Estimated time of Bluestein's algorithm with the inner size m=s*2^k:
+    m times the cost of its inner FFT per element, in quarters of
+    a power-of-2 pass: 4 per factor of 2, DBCF_NPOT_COST3 and
+    DBCF_NPOT_COST5 per pass of radix 3 and 5, and DBCF_NPOT_COST0 for
+    the O(m) steps of the algorithm itself (the chirp, the product, and
+    the copies of the mixed-radix transforms).
+*/
+static double dbcF_npot_cost(dbcf_index m)
+{
+    dbcf_index t=m,c=DBCF_NPOT_COST0;
+    while(!(t&1)) {t>>=1;c+=4;}
+    while(t%3==0) {t/=3;c+=DBCF_NPOT_COST3;}
+    while(t%5==0) {t/=5;c+=DBCF_NPOT_COST5;}
+    return (double)m*(double)c;
+}
+
+/* Inner size of Bluestein's algorithm for n, chosen by dbcF_npot_cost. */
+static dbcf_index dbcF_npot_size(dbcf_index n)
+{
+    dbcf_index s,m,ret=0;
+    double best=0.0;
+    for(s=1;s<=DBCF_NPOT_MAX_ODD;s+=2)
+    {
+        double cost;
+        if(!(m=dbcF_npot_candidate(n,s))) continue;
+        cost=dbcF_npot_cost(m);
+        if(!ret||cost<best) {ret=m;best=cost;}
+    }
+    return ret;
+}
+#endif /* DBC_FFT_NO_NPOT */
+
+/* N1 of the out-of-core transforms: the largest divisor of n not above sqrt(n). */
+static dbcf_index dbcF_io_split(dbcf_index n)
+{
+    dbcf_index d,ret=1;
+    for(d=2;d<=n/d;++d) if(n%d==0) ret=d;
+    return ret;
+}
+
+/*
+    The wisdom (see dbc_fft_wisdom_export) is a header of
+    DBCF_WISDOM_HEADER bytes: the magic "DBCFWIS1", the 2 words of
+    dbcF_wisdom_signature and the number of entries (all 32-bit little
+    endian), and 4 zero bytes; followed by the entries, DBCF_WISDOM_ENTRY
+    bytes each: the type id ('f', 'd' or 'l'), the size of the type, the
+    odd part of the inner size (see dbcF_npot_candidate), 5 zero bytes,
+    and the size n (64-bit little endian).
+*/
+#define DBCF_WISDOM_HEADER 24
+#define DBCF_WISDOM_ENTRY  16
+
+static const char dbcF_wisdom_magic[8]={'D','B','C','F','W','I','S','1'};
+
+/*
+    CPU signature of the wisdom: the SIMD widths available (which decide
+    the kernels), and, if CPUID is used for them, the processor signature
+    (family, model and stepping, from EAX of leaf 1), else 0.
+*/
+static void dbcF_wisdom_signature(unsigned long sig[2])
+{
+    sig[0]=0;
+    sig[1]=0;
+#if !defined(DBC_FFT_NO_SIMD)
+    sig[0]=(unsigned long)dbcF_simd_flags();
+#if !defined(DBC_FFT_FORCE_SIMD) && !defined(dbcf_detect_simd) && defined(DBCF_X86_OR_X64) && !defined(_WIN16)
+    if(dbcF_has_cpuid())
+    {
+        unsigned eax,ebx,ecx,edx;
+        dbcF_cpuid(0,0,&eax,&ebx,&ecx,&edx);
+        if(eax>0)
+        {
+            dbcF_cpuid(1,0,&eax,&ebx,&ecx,&edx);
+            sig[1]=eax&0x0FFF3FFFu;
+        }
+    }
+#endif
+#endif /* !defined(DBC_FFT_NO_SIMD) */
+}
+
+/* Little-endian byte fields of the wisdom. */
+static void dbcF_wisdom_put(unsigned char *p,int bytes,unsigned long x)
+{
+    int i;
+    for(i=0;i<bytes;++i) {p[i]=(unsigned char)(x&255u);x>>=8;}
+}
+
+static unsigned long dbcF_wisdom_get(const unsigned char *p,int bytes)
+{
+    unsigned long x=0;
+    while(bytes-->0) x=(x<<8)|p[bytes];
+    return x;
+}
+
+/* The size n of the wisdom entry, or -1 if it does not fit into the cache (see dbcF_npot_store). */
+static dbcf_index dbcF_wisdom_entry_size(const unsigned char *p)
+{
+    dbcf_index n=0;
+    int i;
+    for(i=15;i>=8;--i)
+    {
+        if(n>(DBCF_POW2(8*sizeof(dbcf_index)-6)-1)/256) return -1;
+        n=n*256+p[i];
+    }
+    return (n>DBCF_POW2(8*sizeof(dbcf_index)-6)-1?-1:n);
+}
+
+#ifndef DBC_FFT_NO_NPOT
+/* Writes the wisdom entry for the size n of the type id, with the odd part s of the inner size. */
+static void dbcF_wisdom_put_entry(unsigned char *p,int id,dbcf_index type_size,dbcf_index n,dbcf_index s)
+{
+    int i;
+    p[0]=(unsigned char)id;
+    p[1]=(unsigned char)type_size;
+    p[2]=(unsigned char)s;
+    for(i=3;i<8;++i) p[i]=0;
+    for(i=8;i<16;++i) {p[i]=(unsigned char)(n&255);n>>=8;}
+}
+
+/*
+    Writes the entries of the cache of the inner sizes (see
+    dbcF_npot_measured) of the type id, type_size bytes, as wisdom, the
+    k-th of them (counting from first) at
+    dst+DBCF_WISDOM_HEADER+k*DBCF_WISDOM_ENTRY, if k<max. Returns first
+    plus the number of the cached entries.
+*/
+static dbcf_index dbcF_wisdom_entries(
+    const dbcF_atomic_index *cache,
+    unsigned char *dst,
+    dbcf_index first,
+    dbcf_index max,
+    int id,
+    dbcf_index type_size)
+{
+    dbcf_index j,k=first;
+    for(j=0;j<DBCF_MEASURE_CACHE_SIZE;++j)
+    {
+        dbcf_index e=DBCF_ATOMIC_LOAD(&cache[j]);
+        if(!e) continue;
+        if(k<max) dbcF_wisdom_put_entry(dst+DBCF_WISDOM_HEADER+k*DBCF_WISDOM_ENTRY,id,type_size,e/16,e%16);
+        ++k;
+    }
+    return k;
+}
+
+/* Empties the cache of the inner sizes. */
+static void dbcF_wisdom_forget(dbcF_atomic_index *cache)
+{
+    dbcf_index j;
+    for(j=0;j<DBCF_MEASURE_CACHE_SIZE;++j)
+        DBCF_ATOMIC_STORE(&cache[j],0);
+}
+#endif /* DBC_FFT_NO_NPOT */
+
+/*
+    The plan is allocated as a single block: the structure itself,
+    followed by the (aligned) buffers it owns.
+*/
+struct dbcf_plan
+{
+    const void *type_tag; /* Identifies the type the plan was created for. */
+    dbcf_index num_elements;
+    int flags;
+    /* Bluestein's algorithm (non-power-of-2 sizes only). */
+    dbcf_index inner; /* The inner size (see dbcF_npot_size). */
+    int permuted; /* The kernel spectrum is in bit-reversed order (see dbcF_use_dif). */
+    void *chirp_real,*chirp_imag;
+    void *kernel_real,*kernel_imag;
+    void *work_real,*work_imag;
+    void *scratch_real,*scratch_imag; /* Work buffer of the inner FFTs of non-power-of-2 inner size. */
+    /*
+        Twiddle tables (DBCF_PLAN_TWIDDLE_TABLE or DBCF_PLAN_PERMUTED only,
+        except the forward one of Bluestein's algorithm with dbcF_dif),
+        indexed by direction.
+    */
+    void *table_real[2],*table_imag[2];
+    /* Set by dbc_fft_plan_set_window, not owned by the plan. */
+    const void *window;
+};
+
+#define DBCF_PLAN_ALIGNMENT 64
+#define DBCF_PLAN_KNOWN_FLAGS (DBCF_PLAN_INVERSE|DBCF_PLAN_TWIDDLE_TABLE|DBCF_PLAN_PERMUTED|DBCF_PLAN_ALIGNED|DBCF_PLAN_MEASURE)
+
+DBCF_DEF void dbc_fft_plan_destroy(dbcf_plan *plan)
+{
+    if(plan) dbcf_free(plan);
+}
+
+/*
+    The byte before the returned pointer holds its offset (1 to
+    DBCF_ALIGNMENT) from the block dbcf_malloc returned.
+*/
+DBCF_DEF void *dbc_fft_alloc(dbcf_index size)
+{
+    unsigned char *mem,*ret;
+    if(size<0) return 0;
+    if(!(mem=(unsigned char*)dbcf_malloc(size+DBCF_ALIGNMENT))) return 0;
+    ret=mem+DBCF_ALIGNMENT-(((dbcf_index)mem)&(DBCF_ALIGNMENT-1));
+    ret[-1]=(unsigned char)(ret-mem);
+    return ret;
+}
+
+DBCF_DEF void dbc_fft_free(void *p)
+{
+    if(p) dbcf_free((unsigned char*)p-((unsigned char*)p)[-1]);
+}
+
+/*
+    The convolver is allocated the same way as the plan. The history is
+    the last kernel_length-1 inputs for overlap-save, and the pending tail
+    of the previous blocks for overlap-add.
+*/
+struct dbcf_conv
+{
+    const void *type_tag;
+    dbcf_index kernel_length;
+    dbcf_index block_length;
+    dbcf_index log2m;
+    int flags;
+    int permuted; /* The spectra are in bit-reversed order (see dbcF_use_dif). */
+    void *kernel_real,*kernel_imag; /* Transformed (padded) kernel. */
+    void *work_real,*work_imag;
+    void *history_real,*history_imag;
+    void *table_real[2],*table_imag[2];
+};
+
+#define DBCF_CONV_KNOWN_FLAGS (DBCF_CONV_OVERLAP_SAVE|DBCF_CONV_CORRELATE)
+
+DBCF_DEF void dbc_conv_destroy(dbcf_conv *conv)
+{
+    if(conv) dbcf_free(conv);
+}
+
+DBCF_DEF dbcf_index dbc_conv_block_length(const dbcf_conv *conv)
+{
+    return conv?conv->block_length:0;
+}
+
+/*
+    The STFT object is allocated the same way as well. The window is
+    copied (all ones for a rectangular one). The history is the inputs not
+    yet consumed by complete frames (fewer than fft_size of them) for the
+    forward transform, and the overlap-add accumulator of the next fft_size
+    outputs for the inverse. work is the workspace of dbcF_rfft/dbcF_irfft.
+*/
+struct dbcf_stft
+{
+    const void *type_tag;
+    dbcf_index fft_size;
+    dbcf_index hop;
+    dbcf_index fill;
+    int flags;
+    void *window;
+    void *frame;
+    void *history;
+    void *work;
+    dbcf_index work_size;
+};
+
+#define DBCF_STFT_KNOWN_FLAGS (DBCF_STFT_INVERSE)
+
+DBCF_DEF void dbc_stft_destroy(dbcf_stft *stft)
+{
+    if(stft) dbcf_free(stft);
+}
+
+DBCF_DEF dbcf_index dbc_stft_num_frames(const dbcf_stft *stft,dbcf_index src_length)
+{
+    dbcf_index total;
+    if(!stft||(stft->flags&DBCF_STFT_INVERSE)||src_length<0) return 0;
+    total=stft->fill+src_length;
+    return (total<stft->fft_size?0:(total-stft->fft_size)/stft->hop+1);
+}
+
+/*
+    Q15 transforms (see dbc_fft_plan_create_q15): radix-2 decimation in
+    time on interleaved int16, with block floating point. The input is
+    first shifted left (exactly) as far as the limit below allows, then
+    before each pass the data is shifted right (by 0..2 bits, rounding)
+    just enough for the largest magnitude M (tracked while writing the
+    previous pass) to stay below DBCF_Q15_LIMIT, so that
+    |a|+|b*w|<=M*(1+sqrt(2)) cannot overflow. The multiplications round
+    like pmulhrsw, and the shift is done the same way, so that the SIMD
+    kernels give identical results.
+*/
+#define DBCF_Q15_LIMIT 13000
+
+static const char dbcF_type_tag_q15=0;
+
+/* (a*b+2^14)>>15, rounded down, without relying on the signed right shift. */
+static int dbcF_q15_mulhrs(int a,int b)
+{
+    unsigned long u=(unsigned long)((long)a*(long)b)+0x40004000UL;
+    return (int)((u&0xFFFFFFFFUL)>>15)-32768;
+}
+
+static int dbcF_q15_abs(int x) {return x<0?-x:x;}
+
+/*
+    exp(-+2*pi*i*k/n). The angle is reduced to [0;pi/4] (octant
+    symmetry), where the Taylor series converges fast in double.
+*/
+static void dbcF_q_twiddle(dbcf_index k,dbcf_index n,int inverse,double *re,double *im)
+{
+    static const double cq[4]={1.0,0.0,-1.0,0.0},sq[4]={0.0,1.0,0.0,-1.0};
+    dbcf_index q=(8*k)/n,r=8*k-q*n;
+    double x,x2,c,s,C,S;
+    int j,odd=(int)(q&1);
+    if(odd) r=n-r;
+    x=0.78539816339744830962*(double)r/(double)n;
+    x2=x*x;
+    c=1.0;
+    s=1.0;
+    for(j=18;j>0;j-=2)
+    {
+        c=1.0-c*x2/(double)(j*(j-1));
+        s=1.0-s*x2/(double)((j+1)*j);
+    }
+    s*=x;
+    j=(int)((q+(dbcf_index)odd)/2)&3;
+    if(odd) {C=cq[j]*c+sq[j]*s;S=sq[j]*c-cq[j]*s;}
+    else    {C=cq[j]*c-sq[j]*s;S=sq[j]*c+cq[j]*s;}
+    *re=C;
+    *im=(inverse?S:-S);
+}
+
+/* Rounded to nearest, ties away from zero. */
+static long dbcF_q_round(double v)
+{
+    return (v<0.0?-(long)(0.5-v):(long)(v+0.5));
+}
+
+/* 32767*exp(-+2*pi*i*k/n), rounded. */
+static void dbcF_q15_twiddle(dbcf_index k,dbcf_index n,int inverse,short *re,short *im)
+{
+    double C,S;
+    dbcF_q_twiddle(k,n,inverse,&C,&S);
+    *re=(short)dbcF_q_round(32767.0*C);
+    *im=(short)dbcF_q_round(32767.0*S);
+}
+
+/*
+    The twiddles of the pass of half-size m (m>=4) start at table+4*m, in
+    groups of 4: re[k] twice each, then (-im[k],im[k]), matching the
+    interleaved layout of the data.
+*/
+static void dbcF_q15_table(dbcf_index n,int inverse,short *table)
+{
+    dbcf_index m,k;
+    for(m=4;m<n;m*=2)
+        for(k=0;k<m;++k)
+        {
+            short *t=table+4*m+4*(k&~(dbcf_index)3)+2*(k&3),re,im;
+            dbcF_q15_twiddle(k,2*m,inverse,&re,&im);
+            t[0]=t[1]=re;
+            t[8]=(short)-im;
+            t[9]=im;
+        }
+}
+
+/* Bit-reversed copy (or in-place permutation), returns the largest magnitude. */
+static int dbcF_q15_bitreverse(dbcf_index n,const short *src,short *dst)
+{
+    dbcf_index i,j=0,bit;
+    int ret=0;
+    for(i=0;i<n;++i)
+    {
+        if(dbcF_q15_abs(src[2*i  ])>ret) ret=dbcF_q15_abs(src[2*i  ]);
+        if(dbcF_q15_abs(src[2*i+1])>ret) ret=dbcF_q15_abs(src[2*i+1]);
+        if(src!=dst) {dst[2*j]=src[2*i];dst[2*j+1]=src[2*i+1];}
+        else if(i<j)
+        {
+            short re=dst[2*i],im=dst[2*i+1];
+            dst[2*i]=dst[2*j];dst[2*i+1]=dst[2*j+1];
+            dst[2*j]=re;dst[2*j+1]=im;
+        }
+        for(bit=n>>1;j&bit;bit>>=1) j^=bit;
+        j|=bit;
+    }
+    return ret;
+}
+
+/*
+    Butterfly a+=t, b=a-t, for t=b*w, after the shift; w is
+    (re,re,-im,im) as in dbcF_q15_table, or NULL for w=1. Updates *M.
+*/
+static void dbcF_q15_butterfly(short *a,short *b,const short *w,int sh,int *M)
+{
+    int ar=a[0],ai=a[1],br=b[0],bi=b[1],tr=br,ti=bi;
+    if(sh)
+    {
+        ar=dbcF_q15_mulhrs(ar,sh);ai=dbcF_q15_mulhrs(ai,sh);
+        tr=br=dbcF_q15_mulhrs(br,sh);ti=bi=dbcF_q15_mulhrs(bi,sh);
+    }
+    if(w)
+    {
+        tr=dbcF_q15_mulhrs(br,w[0])+dbcF_q15_mulhrs(bi,w[8]);
+        ti=dbcF_q15_mulhrs(bi,w[1])+dbcF_q15_mulhrs(br,w[9]);
+    }
+    a[0]=(short)(ar+tr);a[1]=(short)(ai+ti);
+    b[0]=(short)(ar-tr);b[1]=(short)(ai-ti);
+    if(dbcF_q15_abs(a[0])>*M) *M=dbcF_q15_abs(a[0]);
+    if(dbcF_q15_abs(a[1])>*M) *M=dbcF_q15_abs(a[1]);
+    if(dbcF_q15_abs(b[0])>*M) *M=dbcF_q15_abs(b[0]);
+    if(dbcF_q15_abs(b[1])>*M) *M=dbcF_q15_abs(b[1]);
+}
+
+/*
+    The pass of half-size m, with the shift s. The first two passes
+    have twiddles 1 and -+i, which are applied exactly.
+*/
+static int dbcF_q15_pass(dbcf_index n,dbcf_index m,short *x,const short *w,int s,int inverse)
+{
+    dbcf_index j,k;
+    int M=0,sh=(s?1<<(15-s):0);
+    for(j=0;j<n;j+=2*m)
+    {
+        if(m==1) {dbcF_q15_butterfly(x+2*j,x+2*j+2,0,sh,&M);continue;}
+        if(m==2)
+        {
+            short *b=x+2*j+6;
+            dbcF_q15_butterfly(x+2*j,x+2*j+4,0,sh,&M);
+            /* b*(-+i), exact (before the shift, which only changes the rounding of ties). */
+            if(inverse) {short t=b[0];b[0]=(short)-b[1];b[1]=t;}
+            else        {short t=b[0];b[0]=b[1];b[1]=(short)-t;}
+            dbcF_q15_butterfly(x+2*j+2,b,0,sh,&M);
+            continue;
+        }
+        for(k=0;k<m;++k)
+            dbcF_q15_butterfly(x+2*(j+k),x+2*(j+k+m),w+4*(k&~(dbcf_index)3)+2*(k&3),sh,&M);
+    }
+    return M;
+}
+
+static int dbcF_q15_pass_optimized(dbcf_index n,dbcf_index m,short *x,const short *w,int s,int inverse)
+{
+#if defined(DBCF_Q15_SSSE3)
+#if defined(DBCF_Q15_AVX2)
+    if(m>=8&&(dbcf_detect_simd()&DBCF_HAS_AVX2)) return dbcF_q15_pass_avx2(n,m,x,w,s);
+#endif
+    if(n>=4&&(dbcf_detect_simd()&DBCF_HAS_SSSE3)) return dbcF_q15_pass_ssse3(n,m,x,w,s,inverse);
+#elif defined(DBCF_Q15_NEON)
+    if(m>=4) return dbcF_q15_pass_neon(n,m,x,w,s);
+#endif
+    return dbcF_q15_pass(n,m,x,w,s,inverse);
+}
+
+/*
+    A fixed-point plan (Q15 or Q31, told apart by the tag), with
+    table_size bytes for the twiddles at table_real[0], left for the
+    caller to fill.
+*/
+static dbcf_plan *dbcF_q_plan_create(dbcf_index num_elements,int flags,const char *tag,dbcf_index table_size)
+{
+    dbcf_plan *plan;
+    dbcf_index size;
+    unsigned char *buf;
+    if(num_elements<0||(num_elements&(num_elements-1))) return 0;
+    if(flags&~(DBCF_PLAN_KNOWN_FLAGS&~(DBCF_PLAN_PERMUTED|DBCF_PLAN_ALIGNED))) return 0;
+    size=(dbcf_index)sizeof(dbcf_plan)+DBCF_PLAN_ALIGNMENT+table_size;
+    if(!(plan=(dbcf_plan*)dbcf_malloc(size))) return 0;
+    plan->type_tag=(const void*)tag;
+    plan->num_elements=num_elements;
+    plan->flags=flags;
+    plan->inner=0;
+    plan->permuted=0;
+    plan->chirp_real  =plan->chirp_imag  =0;
+    plan->kernel_real =plan->kernel_imag =0;
+    plan->work_real   =plan->work_imag   =0;
+    plan->scratch_real=plan->scratch_imag=0;
+    plan->table_real[0]=plan->table_imag[0]=0;
+    plan->table_real[1]=plan->table_imag[1]=0;
+    plan->window=0;
+    buf=(unsigned char*)(plan+1);
+    size=((dbcf_index)buf)&(DBCF_PLAN_ALIGNMENT-1);
+    if(size) buf+=DBCF_PLAN_ALIGNMENT-size;
+    plan->table_real[0]=buf;
+    return plan;
+}
+
+DBCF_DEF dbcf_plan *dbc_fft_plan_create_q15(
+    dbcf_index num_elements,
+    int flags)
+{
+    dbcf_plan *plan=dbcF_q_plan_create(num_elements,flags,&dbcF_type_tag_q15,4*num_elements*(dbcf_index)sizeof(short));
+    if(plan) dbcF_q15_table(num_elements,flags&DBCF_PLAN_INVERSE,(short*)plan->table_real[0]);
+    return plan;
+}
+
+DBCF_DEF int dbc_fft_execute_q15i(
+    dbcf_plan *plan,
+    const dbcf_q15 *src,
+          dbcf_q15 *dst,
+    int *exponent)
+{
+    dbcf_index n,m,i;
+    const short *table;
+    int M,s,inverse;
+    if(!plan||plan->type_tag!=(const void*)&dbcF_type_tag_q15) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(!dst||!exponent) return DBCF_ERROR_INVALID_ARGUMENT;
+    n=plan->num_elements;
+    table=(const short*)plan->table_real[0];
+    inverse=plan->flags&DBCF_PLAN_INVERSE;
+    *exponent=0;
+    if(!src)
+    {
+        for(i=0;i<2*n;++i) dst[i]=0;
+        return 0;
+    }
+    M=dbcF_q15_bitreverse(n,src,dst);
+    /* Small inputs are first shifted left (exactly), to use the full range. */
+    if(M>0&&n>1)
+    {
+        for(s=0;(M<<(s+1))<DBCF_Q15_LIMIT;++s) {}
+        if(s)
+        {
+            for(i=0;i<2*n;++i) dst[i]=(dbcf_q15)(dst[i]*(1<<s));
+            M<<=s;
+            *exponent=-s;
+        }
+    }
+    for(m=1;m<n;m*=2)
+    {
+        for(s=0;(M>>s)>=DBCF_Q15_LIMIT;++s) {}
+        *exponent+=s;
+        M=dbcF_q15_pass_optimized(n,m,dst,table+4*m,s,inverse);
+    }
+    return 0;
+}
+
+/*
+    Q31 transforms (see dbc_fft_plan_create_q31): the same as the Q15
+    ones, scalar only. The magnitudes are kept in unsigned long, as
+    |-2^31| does not fit, and DBCF_Q31_LIMIT*(1+sqrt(2)) is below 2^31.
+*/
+#define DBCF_Q31_LIMIT 851968000UL
+
+static const char dbcF_type_tag_q31=0;
+
+/*
+    (a*b+2^30)>>31, rounded down, from products of 16-bit halves (without
+    long long, except for GCC). The result must fit, i.e. not both a and b
+    are -2^31.
+*/
+static dbcf_q31 dbcF_q31_mulhrs(dbcf_q31 a,dbcf_q31 b)
+{
+#if defined(__GNUC__)
+    return (dbcf_q31)(__extension__ (((long long)a*(long long)b+(1LL<<30))>>31));
+#else
+    unsigned long al=(unsigned long)a&0xFFFFUL,bl=(unsigned long)b&0xFFFFUL,lo=al*bl,u;
+    long ah=((long)a-(long)al)/65536,bh=((long)b-(long)bl)/65536;
+    long m1=ah*(long)bl,m2=(long)al*bh;
+    long r1=(long)((unsigned long)m1&0x7FFFUL),r2=(long)((unsigned long)m2&0x7FFFUL);
+    /* a*b+2^30 = (2*ah*bh+(m1-r1)/2^15+(m2-r2)/2^15+(lo>>31))*2^31 + (r1+r2)*2^16+(lo&(2^31-1))+2^30. */
+    u=2UL*(unsigned long)(ah*bh)+(unsigned long)((m1-r1)/32768)+(unsigned long)((m2-r2)/32768)+(lo>>31)
+        +(((unsigned long)(2*(r1+r2))+(((lo&0x7FFFFFFFUL)+0x40000000UL)>>15))>>16);
+    u&=0xFFFFFFFFUL;
+    return (dbcf_q31)(u<0x80000000UL?(long)u:-(long)(0xFFFFFFFFUL-u)-1);
+#endif
+}
+
+static unsigned long dbcF_q31_abs(dbcf_q31 x) {return (x<0?0UL-(unsigned long)x:(unsigned long)x);}
+
+/* The twiddles of the pass of half-size m (m>=4) are (re,im) at table+2*m. */
+static void dbcF_q31_table(dbcf_index n,int inverse,dbcf_q31 *table)
+{
+    dbcf_index m,k;
+    for(m=4;m<n;m*=2)
+        for(k=0;k<m;++k)
+        {
+            double C,S;
+            dbcF_q_twiddle(k,2*m,inverse,&C,&S);
+            table[2*m+2*k  ]=(dbcf_q31)dbcF_q_round(2147483647.0*C);
+            table[2*m+2*k+1]=(dbcf_q31)dbcF_q_round(2147483647.0*S);
+        }
+}
+
+static unsigned long dbcF_q31_bitreverse(dbcf_index n,const dbcf_q31 *src,dbcf_q31 *dst)
+{
+    dbcf_index i,j=0,bit;
+    unsigned long ret=0;
+    for(i=0;i<n;++i)
+    {
+        if(dbcF_q31_abs(src[2*i  ])>ret) ret=dbcF_q31_abs(src[2*i  ]);
+        if(dbcF_q31_abs(src[2*i+1])>ret) ret=dbcF_q31_abs(src[2*i+1]);
+        if(src!=dst) {dst[2*j]=src[2*i];dst[2*j+1]=src[2*i+1];}
+        else if(i<j)
+        {
+            dbcf_q31 re=dst[2*i],im=dst[2*i+1];
+            dst[2*i]=dst[2*j];dst[2*i+1]=dst[2*j+1];
+            dst[2*j]=re;dst[2*j+1]=im;
+        }
+        for(bit=n>>1;j&bit;bit>>=1) j^=bit;
+        j|=bit;
+    }
+    return ret;
+}
+
+/* See dbcF_q15_butterfly, w is (re,im) or NULL. */
+static void dbcF_q31_butterfly(dbcf_q31 *a,dbcf_q31 *b,const dbcf_q31 *w,dbcf_q31 sh,unsigned long *M)
+{
+    dbcf_q31 ar=a[0],ai=a[1],br=b[0],bi=b[1],tr,ti;
+    if(sh)
+    {
+        ar=dbcF_q31_mulhrs(ar,sh);ai=dbcF_q31_mulhrs(ai,sh);
+        br=dbcF_q31_mulhrs(br,sh);bi=dbcF_q31_mulhrs(bi,sh);
+    }
+    tr=br;
+    ti=bi;
+    if(w)
+    {
+        tr=dbcF_q31_mulhrs(br,w[0])-dbcF_q31_mulhrs(bi,w[1]);
+        ti=dbcF_q31_mulhrs(bi,w[0])+dbcF_q31_mulhrs(br,w[1]);
+    }
+    a[0]=ar+tr;a[1]=ai+ti;
+    b[0]=ar-tr;b[1]=ai-ti;
+    if(dbcF_q31_abs(a[0])>*M) *M=dbcF_q31_abs(a[0]);
+    if(dbcF_q31_abs(a[1])>*M) *M=dbcF_q31_abs(a[1]);
+    if(dbcF_q31_abs(b[0])>*M) *M=dbcF_q31_abs(b[0]);
+    if(dbcF_q31_abs(b[1])>*M) *M=dbcF_q31_abs(b[1]);
+}
+
+/* See dbcF_q15_pass. */
+static unsigned long dbcF_q31_pass(dbcf_index n,dbcf_index m,dbcf_q31 *x,const dbcf_q31 *w,int s,int inverse)
+{
+    dbcf_index j,k;
+    unsigned long M=0;
+    dbcf_q31 sh=(dbcf_q31)(s?1L<<(31-s):0);
+    for(j=0;j<n;j+=2*m)
+    {
+        if(m==1) {dbcF_q31_butterfly(x+2*j,x+2*j+2,0,sh,&M);continue;}
+        if(m==2)
+        {
+            dbcf_q31 *b=x+2*j+6,t=b[0];
+            dbcF_q31_butterfly(x+2*j,x+2*j+4,0,sh,&M);
+            if(inverse) {b[0]=-b[1];b[1]=t;}
+            else        {b[0]=b[1];b[1]=-t;}
+            dbcF_q31_butterfly(x+2*j+2,b,0,sh,&M);
+            continue;
+        }
+        for(k=0;k<m;++k)
+            dbcF_q31_butterfly(x+2*(j+k),x+2*(j+k+m),w+2*k,sh,&M);
+    }
+    return M;
+}
+
+DBCF_DEF dbcf_plan *dbc_fft_plan_create_q31(
+    dbcf_index num_elements,
+    int flags)
+{
+    dbcf_plan *plan=dbcF_q_plan_create(num_elements,flags,&dbcF_type_tag_q31,2*num_elements*(dbcf_index)sizeof(dbcf_q31));
+    if(plan) dbcF_q31_table(num_elements,flags&DBCF_PLAN_INVERSE,(dbcf_q31*)plan->table_real[0]);
+    return plan;
+}
+
+DBCF_DEF int dbc_fft_execute_q31i(
+    dbcf_plan *plan,
+    const dbcf_q31 *src,
+          dbcf_q31 *dst,
+    int *exponent)
+{
+    dbcf_index n,m,i;
+    const dbcf_q31 *table;
+    unsigned long M;
+    int s,inverse;
+    if(!plan||plan->type_tag!=(const void*)&dbcF_type_tag_q31) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(!dst||!exponent) return DBCF_ERROR_INVALID_ARGUMENT;
+    n=plan->num_elements;
+    table=(const dbcf_q31*)plan->table_real[0];
+    inverse=plan->flags&DBCF_PLAN_INVERSE;
+    *exponent=0;
+    if(!src)
+    {
+        for(i=0;i<2*n;++i) dst[i]=0;
+        return 0;
+    }
+    M=dbcF_q31_bitreverse(n,src,dst);
+    if(M>0&&n>1)
+    {
+        for(s=0;(M<<(s+1))<DBCF_Q31_LIMIT;++s) {}
+        if(s)
+        {
+            for(i=0;i<2*n;++i) dst[i]=(dbcf_q31)((long)dst[i]*(1L<<s));
+            M<<=s;
+            *exponent=-s;
+        }
+    }
+    for(m=1;m<n;m*=2)
+    {
+        for(s=0;(M>>s)>=DBCF_Q31_LIMIT;++s) {}
+        *exponent+=s;
+        M=dbcF_q31_pass(n,m,dst,table+2*m,s,inverse);
+    }
+    return 0;
+}
+
+/*
+    Scratch memory of a transform: either the heap (dbcf_malloc/dbcf_free),
+    or the caller-supplied workspace of the _w functions, from which the
+    buffers are taken in order. It is passed by value, so that the buffers
+    of a callee (taken after those of the caller) never overlap them.
+*/
+typedef struct dbcF_workspace
+{
+    unsigned char *ptr;
+    dbcf_index size;
+    int heap;
+} dbcF_workspace;
+
+static const dbcF_workspace dbcF_heap={0,0,1};
+
+#define DBCF_WORKSPACE_ALIGNMENT 64
+/* Workspace bytes for a buffer of the given size (room for the alignment). */
+#define DBCF_WORKSPACE_CHUNK(size) ((size)+DBCF_WORKSPACE_ALIGNMENT)
+
+/* Returns NULL when out of memory (or of workspace). */
+static void *dbcF_alloc(dbcF_workspace *ws,dbcf_index size)
+{
+    unsigned char *ret;
+    dbcf_index offset;
+    if(ws->heap)
+    {
+        DBCF_PROFILE_ENTER(DBCF_PROFILE_HEAP);
+        ret=(unsigned char*)dbcf_malloc(size);
+        DBCF_PROFILE_LEAVE(DBCF_PROFILE_HEAP);
+        return ret;
+    }
+    offset=((dbcf_index)ws->ptr)&(DBCF_WORKSPACE_ALIGNMENT-1);
+    if(offset) offset=DBCF_WORKSPACE_ALIGNMENT-offset;
+    if(offset+size>ws->size) return 0;
+    ret=ws->ptr+offset;
+    ws->ptr+=offset+size;
+    ws->size-=offset+size;
+    return ret;
+}
+
+static void dbcF_release(const dbcF_workspace *ws,void *p)
+{
+    if(!ws->heap) return;
+    DBCF_PROFILE_ENTER(DBCF_PROFILE_HEAP);
+    dbcf_free(p);
+    DBCF_PROFILE_LEAVE(DBCF_PROFILE_HEAP);
+}
+
+/* Workspace of a _w function, which needs at least required bytes. */
+static int dbcF_workspace_init(dbcF_workspace *ws,void *work,dbcf_index work_size,dbcf_index required)
+{
+    ws->ptr=(unsigned char*)work;
+    ws->size=work_size;
+    ws->heap=0;
+    if(work_size<required||(required>0&&!work)) return DBCF_ERROR_INVALID_ARGUMENT;
+    return 0;
+}
+
+/* Real-to-real transform kinds (see dbcF_r2r). */
+#define DBCF_R2R_DCT2  0
+#define DBCF_R2R_DCT3  1
+#define DBCF_R2R_DCT4  2
+#define DBCF_R2R_DST2  3
+#define DBCF_R2R_DST3  4
+#define DBCF_R2R_DST4  5
+#define DBCF_R2R_MDCT  6
+#define DBCF_R2R_IMDCT 7
+
+/* Instantiations */
+#define DBC_FFT_INSTANTIATION
+
+#ifndef DBC_FFT_NO_FLOAT
+
+#define DBCF_Type float
+#define DBCF_Id f
+#define DBCF_LITERAL(x) DBCF_CONCAT(x,f)
+#ifndef DBC_FFT_NO_SIMD
+#define DBCF_butterfly_multipass_optimized dbcF_butterfly_multipass_optimized_float
+#define DBCF_batch_lanes_optimized dbcF_batch_lanes_optimized_float
+#define DBCF_butterfly_batch_optimized dbcF_butterfly_batch_optimized_float
+#define DBCF_radix4_block_optimized dbcF_radix4_block_optimized_float
+#ifndef DBC_FFT_NO_NPOT
+#define DBCF_radix_block_optimized dbcF_radix_block_optimized_float
+#endif
+#endif
+#include __FILE__
+#undef DBCF_Type
+#undef DBCF_Id
+#undef DBCF_LITERAL
+#ifndef DBC_FFT_NO_SIMD
+#undef DBCF_butterfly_multipass_optimized
+#undef DBCF_batch_lanes_optimized
+#undef DBCF_butterfly_batch_optimized
+#undef DBCF_radix4_block_optimized
+#ifndef DBC_FFT_NO_NPOT
+#undef DBCF_radix_block_optimized
+#endif
+#endif
+
+
+/*
+    Mixed-precision transforms (see dbc_fft_hc). The conversions are
+    fused into the staging of the data into (and out of) a contiguous
+    float buffer, on which the float transform runs in place, so the
+    interleaved versions are as fast as the split ones.
+*/
+#define DBCF_FORMAT_F16  0
+#define DBCF_FORMAT_BF16 1
+
+/* The scalar conversions assume 32-bit unsigned, and IEEE float. */
+typedef union dbcF_float_bits {float f;unsigned u;} dbcF_float_bits;
+typedef char dbcF_check_float_bits[sizeof(unsigned)==sizeof(float)?1:-1];
+
+static float dbcF_f16_to_float(unsigned h)
+{
+    dbcF_float_bits v;
+    unsigned e=(h>>10)&0x1Fu,m=h&0x3FFu;
+    if(e==0x1Fu) v.u=0x7F800000u|(m<<13); /* Inf, NaN. */
+    else if(e) v.u=((e+112u)<<23)|(m<<13);
+    else v.f=(float)m*5.9604644775390625e-8f; /* Subnormal: m*2^-24. */
+    v.u|=(h&0x8000u)<<16;
+    return v.f;
+}
+
+static unsigned short dbcF_float_to_f16(float x)
+{
+    dbcF_float_bits v;
+    unsigned s,u;
+    v.f=x;
+    s=(v.u>>16)&0x8000u;
+    u=v.u&0x7FFFFFFFu;
+    if(u>0x7F800000u) u=0x7E00u; /* NaN. */
+    else if(u>=0x47800000u) u=0x7C00u; /* Above the range (2^16) or Inf. */
+    else if(u<0x38800000u)
+    {
+        /* Subnormal (below 2^-14): the addition of 0.5 does the rounding. */
+        v.u=u;
+        v.f+=0.5f;
+        u=v.u-0x3F000000u;
+    }
+    else u=(u+0xC8000FFFu+((u>>13)&1u))>>13;
+    return (unsigned short)(s|u);
+}
+
+static float dbcF_bf16_to_float(unsigned h)
+{
+    dbcF_float_bits v;
+    v.u=h<<16;
+    return v.f;
+}
+
+static unsigned short dbcF_float_to_bf16(float x)
+{
+    dbcF_float_bits v;
+    v.f=x;
+    if((v.u&0x7FFFFFFFu)>0x7F800000u) return (unsigned short)((v.u>>16)|0x40u); /* NaN (quiet). */
+    return (unsigned short)((v.u+0x7FFFu+((v.u>>16)&1u))>>16);
+}
+
+/*
+    Convert n elements of src to float: re[k]=src[k], or re[k]=src[2*k],
+    im[k]=src[2*k+1] for interleaved.
+*/
+static void dbcF_half_load(int format,dbcf_index n,const unsigned short *src,int interleaved,float *re,float *im)
+{
+    dbcf_index i=0;
+#ifdef DBCF_F16C
+    if(format==DBCF_FORMAT_F16&&(dbcf_detect_simd()&DBCF_HAS_F16C))
+        i=(interleaved?dbcF_f16c_load2(n,src,re,im):dbcF_f16c_load(n,src,re));
+#endif
+    if(format==DBCF_FORMAT_F16)
+    {
+        if(interleaved)
+            for(;i<n;++i) {re[i]=dbcF_f16_to_float(src[2*i]);im[i]=dbcF_f16_to_float(src[2*i+1]);}
+        else
+            for(;i<n;++i) re[i]=dbcF_f16_to_float(src[i]);
+    }
+    else
+    {
+        if(interleaved)
+            for(;i<n;++i) {re[i]=dbcF_bf16_to_float(src[2*i]);im[i]=dbcF_bf16_to_float(src[2*i+1]);}
+        else
+            for(;i<n;++i) re[i]=dbcF_bf16_to_float(src[i]);
+    }
+}
+
+/* The inverse of dbcF_half_load, rounding to nearest-even. */
+static void dbcF_half_store(int format,dbcf_index n,const float *re,const float *im,int interleaved,unsigned short *dst)
+{
+    dbcf_index i=0;
+#ifdef DBCF_F16C
+    if(format==DBCF_FORMAT_F16&&(dbcf_detect_simd()&DBCF_HAS_F16C))
+        i=(interleaved?dbcF_f16c_store2(n,re,im,dst):dbcF_f16c_store(n,re,dst));
+#endif
+    if(format==DBCF_FORMAT_F16)
+    {
+        if(interleaved)
+            for(;i<n;++i) {dst[2*i]=dbcF_float_to_f16(re[i]);dst[2*i+1]=dbcF_float_to_f16(im[i]);}
+        else
+            for(;i<n;++i) dst[i]=dbcF_float_to_f16(re[i]);
+    }
+    else
+    {
+        if(interleaved)
+            for(;i<n;++i) {dst[2*i]=dbcF_float_to_bf16(re[i]);dst[2*i+1]=dbcF_float_to_bf16(im[i]);}
+        else
+            for(;i<n;++i) dst[i]=dbcF_float_to_bf16(re[i]);
+    }
+}
+
+/*
+    src_imag, dst_imag are ignored for interleaved (src_real, dst_real
+    then hold both parts), except that src_imag==NULL means zeros.
+*/
+static int dbcF_fft_half(
+    int format,
+    dbcf_index num_elements,
+    const unsigned short *src_real,const unsigned short *src_imag,
+          unsigned short *dst_real,      unsigned short *dst_imag,
+    int interleaved,
+    int inverse,
+    float scale,
+    dbcF_workspace ws)
+{
+    dbcf_index n=num_elements;
+    float *buf;
+    int ret;
+    if(n<1) return 0;
+    if(!dst_real||!dst_imag) return DBCF_ERROR_INVALID_ARGUMENT;
+    buf=(float*)dbcF_alloc(&ws,2*n*(dbcf_index)sizeof(float));
+    if(!buf) return DBCF_ERROR_OUT_OF_MEMORY;
+    if(interleaved)
+    {
+        if(src_real) dbcF_half_load(format,n,src_real,1,buf,buf+n);
+    }
+    else
+    {
+        if(src_real) dbcF_half_load(format,n,src_real,0,buf,0);
+        if(src_imag) dbcF_half_load(format,n,src_imag,0,buf+n,0);
+    }
+    ret=dbcF_fft_f(n,
+        (src_real?buf:0),(src_imag?buf+n:0),
+        1,1,
+        buf,buf+n,
+        1,1,
+        inverse,
+        scale,
+        ws);
+    if(!ret)
+    {
+        if(interleaved) dbcF_half_store(format,n,buf,buf+n,1,dst_real);
+        else
+        {
+            dbcF_half_store(format,n,buf,0,0,dst_real);
+            dbcF_half_store(format,n,buf+n,0,0,dst_imag);
+        }
+    }
+    dbcF_release(&ws,buf);
+    return ret;
+}
+
+DBCF_DEF dbcf_index dbc_fft_workspace_size_h(
+    dbcf_index num_elements)
+{
+    if(num_elements<1) return 0;
+    return DBCF_WORKSPACE_CHUNK(2*num_elements*(dbcf_index)sizeof(float))+dbcF_fft_workspace_f(num_elements);
+}
+
+DBCF_DEF int dbc_fft_hc(
+    dbcf_index num_elements,
+    const dbcf_f16 *src_real,const dbcf_f16 *src_imag,
+          dbcf_f16 *dst_real,      dbcf_f16 *dst_imag,
+    float scale)
+{
+    return dbcF_fft_half(DBCF_FORMAT_F16,num_elements,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        0,
+        0,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int dbc_fft_hc_w(
+    dbcf_index num_elements,
+    const dbcf_f16 *src_real,const dbcf_f16 *src_imag,
+          dbcf_f16 *dst_real,      dbcf_f16 *dst_imag,
+    float scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,dbc_fft_workspace_size_h(num_elements));
+    if(ret) return ret;
+    return dbcF_fft_half(DBCF_FORMAT_F16,num_elements,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        0,
+        0,
+        scale,
+        ws);
+}
+
+DBCF_DEF int dbc_fft_hi(
+    dbcf_index num_elements,
+    const dbcf_f16 *src,
+          dbcf_f16 *dst,
+    float scale)
+{
+    return dbcF_fft_half(DBCF_FORMAT_F16,num_elements,
+        src,src,
+        dst,dst,
+        1,
+        0,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int dbc_fft_hi_w(
+    dbcf_index num_elements,
+    const dbcf_f16 *src,
+          dbcf_f16 *dst,
+    float scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,dbc_fft_workspace_size_h(num_elements));
+    if(ret) return ret;
+    return dbcF_fft_half(DBCF_FORMAT_F16,num_elements,
+        src,src,
+        dst,dst,
+        1,
+        0,
+        scale,
+        ws);
+}
+
+DBCF_DEF int dbc_ifft_hc(
+    dbcf_index num_elements,
+    const dbcf_f16 *src_real,const dbcf_f16 *src_imag,
+          dbcf_f16 *dst_real,      dbcf_f16 *dst_imag,
+    float scale)
+{
+    return dbcF_fft_half(DBCF_FORMAT_F16,num_elements,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        0,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int dbc_ifft_hc_w(
+    dbcf_index num_elements,
+    const dbcf_f16 *src_real,const dbcf_f16 *src_imag,
+          dbcf_f16 *dst_real,      dbcf_f16 *dst_imag,
+    float scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,dbc_fft_workspace_size_h(num_elements));
+    if(ret) return ret;
+    return dbcF_fft_half(DBCF_FORMAT_F16,num_elements,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        0,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int dbc_ifft_hi(
+    dbcf_index num_elements,
+    const dbcf_f16 *src,
+          dbcf_f16 *dst,
+    float scale)
+{
+    return dbcF_fft_half(DBCF_FORMAT_F16,num_elements,
+        src,src,
+        dst,dst,
+        1,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int dbc_ifft_hi_w(
+    dbcf_index num_elements,
+    const dbcf_f16 *src,
+          dbcf_f16 *dst,
+    float scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,dbc_fft_workspace_size_h(num_elements));
+    if(ret) return ret;
+    return dbcF_fft_half(DBCF_FORMAT_F16,num_elements,
+        src,src,
+        dst,dst,
+        1,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int dbc_fft_bc(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src_real,const dbcf_bf16 *src_imag,
+          dbcf_bf16 *dst_real,      dbcf_bf16 *dst_imag,
+    float scale)
+{
+    return dbcF_fft_half(DBCF_FORMAT_BF16,num_elements,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        0,
+        0,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int dbc_fft_bc_w(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src_real,const dbcf_bf16 *src_imag,
+          dbcf_bf16 *dst_real,      dbcf_bf16 *dst_imag,
+    float scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,dbc_fft_workspace_size_h(num_elements));
+    if(ret) return ret;
+    return dbcF_fft_half(DBCF_FORMAT_BF16,num_elements,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        0,
+        0,
+        scale,
+        ws);
+}
+
+DBCF_DEF int dbc_fft_bi(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src,
+          dbcf_bf16 *dst,
+    float scale)
+{
+    return dbcF_fft_half(DBCF_FORMAT_BF16,num_elements,
+        src,src,
+        dst,dst,
+        1,
+        0,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int dbc_fft_bi_w(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src,
+          dbcf_bf16 *dst,
+    float scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,dbc_fft_workspace_size_h(num_elements));
+    if(ret) return ret;
+    return dbcF_fft_half(DBCF_FORMAT_BF16,num_elements,
+        src,src,
+        dst,dst,
+        1,
+        0,
+        scale,
+        ws);
+}
+
+DBCF_DEF int dbc_ifft_bc(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src_real,const dbcf_bf16 *src_imag,
+          dbcf_bf16 *dst_real,      dbcf_bf16 *dst_imag,
+    float scale)
+{
+    return dbcF_fft_half(DBCF_FORMAT_BF16,num_elements,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        0,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int dbc_ifft_bc_w(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src_real,const dbcf_bf16 *src_imag,
+          dbcf_bf16 *dst_real,      dbcf_bf16 *dst_imag,
+    float scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,dbc_fft_workspace_size_h(num_elements));
+    if(ret) return ret;
+    return dbcF_fft_half(DBCF_FORMAT_BF16,num_elements,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        0,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int dbc_ifft_bi(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src,
+          dbcf_bf16 *dst,
+    float scale)
+{
+    return dbcF_fft_half(DBCF_FORMAT_BF16,num_elements,
+        src,src,
+        dst,dst,
+        1,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int dbc_ifft_bi_w(
+    dbcf_index num_elements,
+    const dbcf_bf16 *src,
+          dbcf_bf16 *dst,
+    float scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,dbc_fft_workspace_size_h(num_elements));
+    if(ret) return ret;
+    return dbcF_fft_half(DBCF_FORMAT_BF16,num_elements,
+        src,src,
+        dst,dst,
+        1,
+        1,
+        scale,
+        ws);
+}
+#endif /* DBC_FFT_NO_FLOAT */
+
+#ifndef DBC_FFT_NO_DOUBLE
+
+#define DBCF_Type double
+#define DBCF_Id d
+#define DBCF_LITERAL(x) (x)
+#ifndef DBC_FFT_NO_SIMD
+#define DBCF_butterfly_multipass_optimized dbcF_butterfly_multipass_optimized_double
+#define DBCF_batch_lanes_optimized dbcF_batch_lanes_optimized_double
+#define DBCF_butterfly_batch_optimized dbcF_butterfly_batch_optimized_double
+#define DBCF_radix4_block_optimized dbcF_radix4_block_optimized_double
+#ifndef DBC_FFT_NO_NPOT
+#define DBCF_radix_block_optimized dbcF_radix_block_optimized_double
+#endif
+#endif
+#include __FILE__
+#undef DBCF_Type
+#undef DBCF_Id
+#undef DBCF_LITERAL
+#ifndef DBC_FFT_NO_SIMD
+#undef DBCF_butterfly_multipass_optimized
+#undef DBCF_batch_lanes_optimized
+#undef DBCF_butterfly_batch_optimized
+#undef DBCF_radix4_block_optimized
+#ifndef DBC_FFT_NO_NPOT
+#undef DBCF_radix_block_optimized
+#endif
+#endif
+
+#endif /* DBC_FFT_NO_DOUBLE */
+
+#ifndef DBC_FFT_NO_LONGDOUBLE
+
+#define DBCF_Type long double
+#define DBCF_Id l
+#define DBCF_LITERAL(x) DBCF_CONCAT(x,l)
+#include __FILE__
+#undef DBCF_Type
+#undef DBCF_Id
+#undef DBCF_LITERAL
+
+#endif /* DBC_FFT_NO_LONGDOUBLE */
+
+#if defined(__cplusplus) && defined(DBC_FFT_DOUBLE_DOUBLE)
+
+/*
+    The default dbcF_cexpm1* would round 2*pi (and the table) to double,
+    so double-double has its own: the table, as pairs (hi,lo), and the
+    same series, with 2*pi in double-double. The only other literals are
+    exact in double.
+*/
+static void dbcF_dd_cexpm1_npot(dbcf_index p,dbcf_index q,dbcf_dd *real,dbcf_dd *imag)
+{
+    const dbcf_dd two_pi(6.283185307179586,2.4492935982947064e-16);
+    dbcf_dd x=two_pi*dbcf_dd((double)p)/dbcf_dd((double)q),x2=x*x;
+    dbcf_dd C(1.0),S(1.0);
+    double t=x2.hi*x2.hi/120.0;
+    int i=0;
+    /*
+        cos(x)-1=-(x^2/2)*C, sin(x)=x*S by Horner's scheme, stopping when
+        the first term left out of S (x^(2*i+4)/(2*i+5)!, the larger one)
+        is below 2^-110 (at most i=16, for |x|<=pi/2).
+    */
+    while(i<16&&t>7.703719777548943e-34) {++i;t*=x2.hi/(double)((2*i+4)*(2*i+5));}
+    for(;i>=0;--i)
+    {
+        double K=(double)(2*i+3);
+        C=dbcf_dd(1.0)-x2*C/dbcf_dd(K*(K+1.0));
+        S=dbcf_dd(1.0)-x2*S/dbcf_dd(K*(K-1.0));
+    }
+    *real=-(C*x2*dbcf_dd(0.5));
+    *imag=S*x;
+}
+
+static void dbcF_dd_cexpm1(dbcf_index log2n,dbcf_dd *real,dbcf_dd *imag)
+{
+    static const double table[][2][2]={
+        {{0.0,0.0},{0.0,0.0}},
+        {{-2.0,0.0},{0.0,0.0}},
+        {{-1.0,0.0},{1.0,0.0}},
+        {{-0.2928932188134525,7.174684663993261e-18},{0.7071067811865476,-4.833646656726457e-17}},
+        {{-0.07612046748871325,3.7672592765222195e-18},{0.3826834323650898,-1.0050772696461588e-17}},
+        {{-0.019214719596769552,1.1997052380569336e-18},{0.19509032201612828,-7.991079068461731e-18}},
+        {{-0.004815273327803114,1.3811483127365547e-20},{0.0980171403295606,-1.634582362244256e-18}},
+        {{-0.0012045437948276074,6.821142925928599e-20},{0.049067674327418015,-6.79610372051828e-19}},
+        {{-0.0003011813037957799,1.8283448175892335e-20},{0.024541228522912288,-9.186849012577878e-20}},
+        {{-7.529816085545908e-05,-2.440997168574241e-21},{0.012271538285719925,6.919790764028317e-19}},
+        {{-1.882471739885734e-05,-1.5062426868464877e-21},{0.006135884649154475,9.054525748247493e-20}},
+        {{-4.7061904238284885e-06,4.074992266455884e-23},{0.003067956762965976,1.2690279085455925e-19}},
+        {{-1.1765482980900709e-06,-8.091357924172706e-23},{0.0015339801862847657,-1.0467712971596958e-19}},
+        {{-2.941371177808398e-07,2.1869220992243457e-23},{0.0007669903187427045,4.143899556056848e-20}},
+        {{-7.353428214885527e-08,4.502416251919494e-24},{0.00038349518757139556,2.5865284466133177e-20}},
+        {{-1.8383570706191654e-08,4.404243576030345e-25},{0.00019174759731070332,-1.119359730219912e-20}},
+        {{-4.595892687109028e-09,-1.8805054552510984e-25},{9.587379909597734e-05,1.2012875748338165e-21}}
+    };
+    if(log2n<(dbcf_index)(sizeof(table)/(sizeof(table[0]))))
+    {
+        *real=dbcf_dd(table[log2n][0][0],table[log2n][0][1]);
+        *imag=dbcf_dd(table[log2n][1][0],table[log2n][1][1]);
+    }
+    else dbcF_dd_cexpm1_npot(1,DBCF_POW2(log2n),real,imag);
+}
+
+/*
+    SIMD passes for double-double: 4 lanes with AVX and FMA, 8 with
+    AVX512. The hi and lo parts of the lanes are held in separate
+    registers; loads and stores (de)interleave them, possibly permuting
+    the lanes, but the same way for all the operands. The operations are
+    those of dbcf_dd, in the same order, so that the results are the same
+    as those of the scalar passes: two_prod is exact either way (FMA or
+    Dekker's), and the other products are fma(x,y,+0), which rounds like
+    x*y, but is never contracted.
+    The radix-4 blocks run under dbcF_butterfly_pass4 (as
+    DBCF_radix4_block_optimized), the radix-2 passes (and the leaves of
+    dbcF_butterfly_block) only for the passes it leaves over, e.g. the
+    outer passes of dbcF_butterfly. The first 3 passes are left to
+    dbcF_fft8.
+*/
+#if defined(DBCF_X86_OR_X64) && defined(__GNUC__) && !defined(DBC_FFT_NO_SIMD)
+#if !defined(DBCF_NO_SIMD4D) && !defined(DBCF_NO_FMA)
+#define DBCF_DD_SIMD4
+#endif
+#if !defined(DBCF_NO_SIMD8D)
+#define DBCF_DD_SIMD8
+#endif
+#endif
+
+#if defined(DBCF_DD_SIMD4) || defined(DBCF_DD_SIMD8)
+#define DBCF_DD_SIMD
+#include <immintrin.h>
+
+#define DBCF_DEF_DD_KERNELS(decl,vec,mm,lanes)\
+decl static dbcF_dd##lanes dbcF_dd_make##lanes(vec hi,vec lo) {dbcF_dd##lanes ret;ret.hi=hi;ret.lo=lo;return ret;}                     \
+decl static dbcF_dd##lanes dbcF_dd_two_sum##lanes(vec a,vec b)                                                                         \
+{                                                                                                                                      \
+    vec s=a+b,v=s-a;                                                                                                                   \
+    return dbcF_dd_make##lanes(s,(a-(s-v))+(b-v));                                                                                     \
+}                                                                                                                                      \
+decl static dbcF_dd##lanes dbcF_dd_quick_two_sum##lanes(vec a,vec b)                                                                   \
+{                                                                                                                                      \
+    vec s=a+b;                                                                                                                         \
+    return dbcF_dd_make##lanes(s,b-(s-a));                                                                                             \
+}                                                                                                                                      \
+decl static dbcF_dd##lanes dbcF_dd_add##lanes(dbcF_dd##lanes l,dbcF_dd##lanes r)                                                       \
+{                                                                                                                                      \
+    dbcF_dd##lanes s=dbcF_dd_two_sum##lanes(l.hi,r.hi),t=dbcF_dd_two_sum##lanes(l.lo,r.lo);                                            \
+    s=dbcF_dd_quick_two_sum##lanes(s.hi,s.lo+t.hi);                                                                                    \
+    return dbcF_dd_quick_two_sum##lanes(s.hi,s.lo+t.lo);                                                                               \
+}                                                                                                                                      \
+decl static dbcF_dd##lanes dbcF_dd_sub##lanes(dbcF_dd##lanes l,dbcF_dd##lanes r)                                                       \
+{                                                                                                                                      \
+    return dbcF_dd_add##lanes(l,dbcF_dd_make##lanes(-r.hi,-r.lo));                                                                     \
+}                                                                                                                                      \
+decl static dbcF_dd##lanes dbcF_dd_mul##lanes(dbcF_dd##lanes l,dbcF_dd##lanes r)                                                       \
+{                                                                                                                                      \
+    vec z=mm##_setzero_pd(),p=mm##_fmadd_pd(l.hi,r.hi,z),e=mm##_fmsub_pd(l.hi,r.hi,p);                                                 \
+    return dbcF_dd_quick_two_sum##lanes(p,e+(mm##_fmadd_pd(l.hi,r.lo,z)+mm##_fmadd_pd(l.lo,r.hi,z)));                                  \
+}                                                                                                                                      \
+/* (yr,yi)=(c,s)*(xr,xi). */                                                                                                           \
+decl static void dbcF_dd_cmul##lanes(                                                                                                  \
+    dbcF_dd##lanes c,dbcF_dd##lanes s,dbcF_dd##lanes xr,dbcF_dd##lanes xi,dbcF_dd##lanes *yr,dbcF_dd##lanes *yi)                      \
+{                                                                                                                                      \
+    *yr=dbcF_dd_sub##lanes(dbcF_dd_mul##lanes(c,xr),dbcF_dd_mul##lanes(s,xi));                                                         \
+    *yi=dbcF_dd_add##lanes(dbcF_dd_mul##lanes(s,xr),dbcF_dd_mul##lanes(c,xi));                                                         \
+}                                                                                                                                      \
+/* Complex elements j..j+lanes-1, split or interleaved (then I is unused). */                                                         \
+decl static void dbcF_dd_loadc##lanes(const dbcf_dd *R,const dbcf_dd *I,dbcf_index j,int interleaved,dbcF_dd##lanes *re,dbcF_dd##lanes *im)\
+{                                                                                                                                      \
+    if(interleaved) dbcF_dd_loadi##lanes(R+2*j,re,im);                                                                                 \
+    else {*re=dbcF_dd_load##lanes(R+j);*im=dbcF_dd_load##lanes(I+j);}                                                                  \
+}                                                                                                                                      \
+decl static void dbcF_dd_storec##lanes(dbcf_dd *R,dbcf_dd *I,dbcf_index j,int interleaved,dbcF_dd##lanes re,dbcF_dd##lanes im)       \
+{                                                                                                                                      \
+    if(interleaved) dbcF_dd_storei##lanes(R+2*j,re,im);                                                                                \
+    else {dbcF_dd_store##lanes(R+j,re);dbcF_dd_store##lanes(I+j,im);}                                                                  \
+}                                                                                                                                      \
+                                                                                                                                       \
+/* As dbcF_radix4_block (with b a multiple of lanes). */                                                                               \
+decl static void dbcF_radix4_block_dd##lanes(                                                                                          \
+    dbcf_index log2n,                                                                                                                  \
+    dbcf_index log2c,                                                                                                                  \
+    dbcf_index b,                                                                                                                      \
+    dbcf_dd *real,dbcf_dd *imag,                                                                                                       \
+    int interleaved,                                                                                                                   \
+    const dbcf_dd *t1r,const dbcf_dd *t1i,                                                                                             \
+    const dbcf_dd *t2r,const dbcf_dd *t2i,                                                                                             \
+    const dbcf_dd *t3r,const dbcf_dd *t3i,                                                                                             \
+    int inverse)                                                                                                                       \
+{                                                                                                                                      \
+    dbcf_index n=DBCF_POW2(log2n),q=n>>2,s=(interleaved?2:1);                                                                          \
+    dbcf_index c=DBCF_POW2(log2c);                                                                                                     \
+    dbcf_index o1=(inverse?3*q:q),o3=(inverse?q:3*q);                                                                                  \
+    dbcf_index i,j;                                                                                                                    \
+    for(i=0;i<c;++i)                                                                                                                   \
+    {                                                                                                                                  \
+        dbcf_dd *R=real+i*n*s,*I=imag+i*n*s;                                                                                           \
+        for(j=0;j<b;j+=lanes)                                                                                                          \
+        {                                                                                                                              \
+            dbcF_dd##lanes ar,ai,xr,xi,br,bi,cr,ci,er,ei,s0r,s0i,d0r,d0i,s1r,s1i,d1r,d1i;                                              \
+            dbcF_dd_loadc##lanes(R,I,j,interleaved,&ar,&ai);                                                                           \
+            dbcF_dd_loadc##lanes(R,I,j+q,interleaved,&xr,&xi);                                                                         \
+            dbcF_dd_cmul##lanes(dbcF_dd_load##lanes(t2r+j),dbcF_dd_load##lanes(t2i+j),xr,xi,&br,&bi);                                  \
+            dbcF_dd_loadc##lanes(R,I,j+2*q,interleaved,&xr,&xi);                                                                       \
+            dbcF_dd_cmul##lanes(dbcF_dd_load##lanes(t1r+j),dbcF_dd_load##lanes(t1i+j),xr,xi,&cr,&ci);                                  \
+            dbcF_dd_loadc##lanes(R,I,j+3*q,interleaved,&xr,&xi);                                                                       \
+            dbcF_dd_cmul##lanes(dbcF_dd_load##lanes(t3r+j),dbcF_dd_load##lanes(t3i+j),xr,xi,&er,&ei);                                  \
+            s0r=dbcF_dd_add##lanes(ar,br);s0i=dbcF_dd_add##lanes(ai,bi);                                                               \
+            d0r=dbcF_dd_sub##lanes(ar,br);d0i=dbcF_dd_sub##lanes(ai,bi);                                                               \
+            s1r=dbcF_dd_add##lanes(cr,er);s1i=dbcF_dd_add##lanes(ci,ei);                                                               \
+            d1r=dbcF_dd_sub##lanes(cr,er);d1i=dbcF_dd_sub##lanes(ci,ei);                                                               \
+            dbcF_dd_storec##lanes(R,I,j,interleaved,dbcF_dd_add##lanes(s0r,s1r),dbcF_dd_add##lanes(s0i,s1i));                          \
+            dbcF_dd_storec##lanes(R,I,j+2*q,interleaved,dbcF_dd_sub##lanes(s0r,s1r),dbcF_dd_sub##lanes(s0i,s1i));                      \
+            dbcF_dd_storec##lanes(R,I,j+o1,interleaved,dbcF_dd_add##lanes(d0r,d1i),dbcF_dd_sub##lanes(d0i,d1r));                       \
+            dbcF_dd_storec##lanes(R,I,j+o3,interleaved,dbcF_dd_sub##lanes(d0r,d1i),dbcF_dd_add##lanes(d0i,d1r));                       \
+        }                                                                                                                              \
+    }                                                                                                                                  \
+}                                                                                                                                      \
+                                                                                                                                       \
+/* As dbcF_butterfly_pass, with all the twiddles supplied (and n/2 a multiple of lanes). */                                           \
+decl static void dbcF_butterfly_pass_dd##lanes(                                                                                        \
+    dbcf_index log2n,                                                                                                                  \
+    dbcf_index log2c,                                                                                                                  \
+    dbcf_dd *real,dbcf_dd *imag,                                                                                                       \
+    int interleaved,                                                                                                                   \
+    const dbcf_dd *tr,const dbcf_dd *ti)                                                                                               \
+{                                                                                                                                      \
+    dbcf_index n=DBCF_POW2(log2n),h=n>>1,s=(interleaved?2:1);                                                                          \
+    dbcf_index c=DBCF_POW2(log2c);                                                                                                     \
+    dbcf_index i,d;                                                                                                                    \
+    for(i=0;i<c;++i)                                                                                                                   \
+    {                                                                                                                                  \
+        dbcf_dd *R=real+i*n*s,*I=imag+i*n*s;                                                                                           \
+        for(d=0;d<h;d+=lanes)                                                                                                          \
+        {                                                                                                                              \
+            dbcF_dd##lanes xl,yl,xr,yr,x,y;                                                                                            \
+            dbcF_dd_loadc##lanes(R,I,d,interleaved,&xl,&yl);                                                                           \
+            dbcF_dd_loadc##lanes(R,I,d+h,interleaved,&xr,&yr);                                                                         \
+            dbcF_dd_cmul##lanes(dbcF_dd_load##lanes(tr+d),dbcF_dd_load##lanes(ti+d),xr,yr,&x,&y);                                      \
+            dbcF_dd_storec##lanes(R,I,d,interleaved,dbcF_dd_add##lanes(xl,x),dbcF_dd_add##lanes(yl,y));                                \
+            dbcF_dd_storec##lanes(R,I,d+h,interleaved,dbcF_dd_sub##lanes(xl,x),dbcF_dd_sub##lanes(yl,y));                              \
+        }                                                                                                                              \
+    }                                                                                                                                  \
+}                                                                                                                                      \
+                                                                                                                                       \
+/* The leaves of dbcF_butterfly_block: b elements, with the twiddles (C,S)*(tr,ti). */                                                \
+decl static void dbcF_butterfly_leaf_dd##lanes(                                                                                        \
+    dbcf_index b,                                                                                                                      \
+    dbcf_dd *LR,dbcf_dd *LI,                                                                                                           \
+    dbcf_dd *HR,dbcf_dd *HI,                                                                                                           \
+    int interleaved,                                                                                                                   \
+    dbcf_dd C,dbcf_dd S,                                                                                                               \
+    const dbcf_dd *tr,const dbcf_dd *ti)                                                                                               \
+{                                                                                                                                      \
+    dbcF_dd##lanes CC=dbcF_dd_make##lanes(mm##_set1_pd(C.hi),mm##_set1_pd(C.lo));                                                      \
+    dbcF_dd##lanes SS=dbcF_dd_make##lanes(mm##_set1_pd(S.hi),mm##_set1_pd(S.lo));                                                      \
+    dbcf_index i;                                                                                                                      \
+    for(i=0;i<b;i+=lanes)                                                                                                              \
+    {                                                                                                                                  \
+        dbcF_dd##lanes c,s,xl,yl,xr,yr,x,y;                                                                                            \
+        dbcF_dd_cmul##lanes(CC,SS,dbcF_dd_load##lanes(tr+i),dbcF_dd_load##lanes(ti+i),&c,&s);                                          \
+        dbcF_dd_loadc##lanes(LR,LI,i,interleaved,&xl,&yl);                                                                             \
+        dbcF_dd_loadc##lanes(HR,HI,i,interleaved,&xr,&yr);                                                                             \
+        dbcF_dd_cmul##lanes(c,s,xr,yr,&x,&y);                                                                                          \
+        dbcF_dd_storec##lanes(LR,LI,i,interleaved,dbcF_dd_add##lanes(xl,x),dbcF_dd_add##lanes(yl,y));                                  \
+        dbcF_dd_storec##lanes(HR,HI,i,interleaved,dbcF_dd_sub##lanes(xl,x),dbcF_dd_sub##lanes(yl,y));                                  \
+    }                                                                                                                                  \
+}
+
+#if defined(DBCF_DD_SIMD4)
+#if defined(__AVX__) && defined(__FMA__)
+#define DBCF_DECL_DD4
+#elif defined(DBCF_X64)
+#define DBCF_DECL_DD4 __attribute__((target("avx,fma"))) /* No stdcall in x64. */
+#else
+#define DBCF_DECL_DD4 __attribute__((target("avx,fma"),stdcall))
+#endif
+
+typedef struct dbcF_dd4 {__m256d hi,lo;} dbcF_dd4;
+
+/* The lanes are in the order 0,2,1,3 (unpacklo/unpackhi work within 128-bit halves). */
+DBCF_DECL_DD4 static dbcF_dd4 dbcF_dd_load4(const dbcf_dd *p)
+{
+    const double *d=(const double*)p;
+    __m256d a=_mm256_loadu_pd(d),b=_mm256_loadu_pd(d+4);
+    dbcF_dd4 ret;
+    ret.hi=_mm256_unpacklo_pd(a,b);
+    ret.lo=_mm256_unpackhi_pd(a,b);
+    return ret;
+}
+DBCF_DECL_DD4 static void dbcF_dd_store4(dbcf_dd *p,dbcF_dd4 v)
+{
+    double *d=(double*)p;
+    _mm256_storeu_pd(d  ,_mm256_unpacklo_pd(v.hi,v.lo));
+    _mm256_storeu_pd(d+4,_mm256_unpackhi_pd(v.hi,v.lo));
+}
+/* Interleaved complex elements (re.hi,re.lo,im.hi,im.lo), one per register. */
+DBCF_DECL_DD4 static void dbcF_dd_loadi4(const dbcf_dd *p,dbcF_dd4 *re,dbcF_dd4 *im)
+{
+    const double *d=(const double*)p;
+    __m256d c0=_mm256_loadu_pd(d),c1=_mm256_loadu_pd(d+4),c2=_mm256_loadu_pd(d+8),c3=_mm256_loadu_pd(d+12);
+    __m256d p0=_mm256_unpacklo_pd(c0,c2),p1=_mm256_unpacklo_pd(c1,c3);
+    __m256d q0=_mm256_unpackhi_pd(c0,c2),q1=_mm256_unpackhi_pd(c1,c3);
+    re->hi=_mm256_permute2f128_pd(p0,p1,0x20);
+    im->hi=_mm256_permute2f128_pd(p0,p1,0x31);
+    re->lo=_mm256_permute2f128_pd(q0,q1,0x20);
+    im->lo=_mm256_permute2f128_pd(q0,q1,0x31);
+}
+DBCF_DECL_DD4 static void dbcF_dd_storei4(dbcf_dd *p,dbcF_dd4 re,dbcF_dd4 im)
+{
+    double *d=(double*)p;
+    __m256d p0=_mm256_permute2f128_pd(re.hi,im.hi,0x20),p1=_mm256_permute2f128_pd(re.hi,im.hi,0x31);
+    __m256d q0=_mm256_permute2f128_pd(re.lo,im.lo,0x20),q1=_mm256_permute2f128_pd(re.lo,im.lo,0x31);
+    _mm256_storeu_pd(d   ,_mm256_unpacklo_pd(p0,q0));
+    _mm256_storeu_pd(d+4 ,_mm256_unpacklo_pd(p1,q1));
+    _mm256_storeu_pd(d+8 ,_mm256_unpackhi_pd(p0,q0));
+    _mm256_storeu_pd(d+12,_mm256_unpackhi_pd(p1,q1));
+}
+
+DBCF_DEF_DD_KERNELS(DBCF_DECL_DD4,__m256d,_mm256,4)
+#endif /* defined(DBCF_DD_SIMD4) */
+
+#if defined(DBCF_DD_SIMD8)
+#if defined(__AVX512F__)
+#define DBCF_DECL_DD8
+#elif defined(DBCF_X64)
+#define DBCF_DECL_DD8 __attribute__((target("avx512f"))) /* No stdcall in x64. */
+#else
+#define DBCF_DECL_DD8 __attribute__((target("avx512f"),stdcall))
+#endif
+
+typedef struct dbcF_dd8 {__m512d hi,lo;} dbcF_dd8;
+
+/* The lanes are in the original order. */
+DBCF_DECL_DD8 static dbcF_dd8 dbcF_dd_load8(const dbcf_dd *p)
+{
+    const double *d=(const double*)p;
+    __m512d a=_mm512_loadu_pd(d),b=_mm512_loadu_pd(d+8);
+    dbcF_dd8 ret;
+    ret.hi=_mm512_permutex2var_pd(a,_mm512_set_epi64(14,12,10,8,6,4,2,0),b);
+    ret.lo=_mm512_permutex2var_pd(a,_mm512_set_epi64(15,13,11,9,7,5,3,1),b);
+    return ret;
+}
+DBCF_DECL_DD8 static void dbcF_dd_store8(dbcf_dd *p,dbcF_dd8 v)
+{
+    double *d=(double*)p;
+    _mm512_storeu_pd(d  ,_mm512_permutex2var_pd(v.hi,_mm512_set_epi64(11,3,10,2,9,1,8,0),v.lo));
+    _mm512_storeu_pd(d+8,_mm512_permutex2var_pd(v.hi,_mm512_set_epi64(15,7,14,6,13,5,12,4),v.lo));
+}
+/* Interleaved complex elements (re.hi,re.lo,im.hi,im.lo), 2 per register. */
+DBCF_DECL_DD8 static void dbcF_dd_loadi8(const dbcf_dd *p,dbcF_dd8 *re,dbcF_dd8 *im)
+{
+    const double *d=(const double*)p;
+    __m512d c0=_mm512_loadu_pd(d),c1=_mm512_loadu_pd(d+8),c2=_mm512_loadu_pd(d+16),c3=_mm512_loadu_pd(d+24);
+    __m512i h=_mm512_set_epi64(14,10,6,2,12,8,4,0),l=_mm512_set_epi64(15,11,7,3,13,9,5,1);
+    __m512i a=_mm512_set_epi64(11,10,9,8,3,2,1,0),b=_mm512_set_epi64(15,14,13,12,7,6,5,4);
+    /* (re0..3,im0..3) and (re4..7,im4..7). */
+    __m512d h0=_mm512_permutex2var_pd(c0,h,c1),h1=_mm512_permutex2var_pd(c2,h,c3);
+    __m512d l0=_mm512_permutex2var_pd(c0,l,c1),l1=_mm512_permutex2var_pd(c2,l,c3);
+    re->hi=_mm512_permutex2var_pd(h0,a,h1);
+    im->hi=_mm512_permutex2var_pd(h0,b,h1);
+    re->lo=_mm512_permutex2var_pd(l0,a,l1);
+    im->lo=_mm512_permutex2var_pd(l0,b,l1);
+}
+DBCF_DECL_DD8 static void dbcF_dd_storei8(dbcf_dd *p,dbcF_dd8 re,dbcF_dd8 im)
+{
+    double *d=(double*)p;
+    __m512i a=_mm512_set_epi64(11,10,9,8,3,2,1,0),b=_mm512_set_epi64(15,14,13,12,7,6,5,4);
+    __m512i x=_mm512_set_epi64(13,5,9,1,12,4,8,0),y=_mm512_set_epi64(15,7,11,3,14,6,10,2);
+    __m512d h0=_mm512_permutex2var_pd(re.hi,a,im.hi),h1=_mm512_permutex2var_pd(re.hi,b,im.hi);
+    __m512d l0=_mm512_permutex2var_pd(re.lo,a,im.lo),l1=_mm512_permutex2var_pd(re.lo,b,im.lo);
+    _mm512_storeu_pd(d   ,_mm512_permutex2var_pd(h0,x,l0));
+    _mm512_storeu_pd(d+8 ,_mm512_permutex2var_pd(h0,y,l0));
+    _mm512_storeu_pd(d+16,_mm512_permutex2var_pd(h1,x,l1));
+    _mm512_storeu_pd(d+24,_mm512_permutex2var_pd(h1,y,l1));
+}
+
+DBCF_DEF_DD_KERNELS(DBCF_DECL_DD8,__m512d,_mm512,8)
+#endif /* defined(DBCF_DD_SIMD8) */
+
+/* The widest of the kernels above available for blocks of b elements, or 0. */
+static dbcf_index dbcF_dd_lanes(dbcf_index b)
+{
+    int flags=dbcf_detect_simd();
+#if defined(DBCF_DD_SIMD8)
+    if(b>=8&&(flags&DBCF_HAS_SIMD8D)) return 8;
+#endif
+#if defined(DBCF_DD_SIMD4)
+    if(b>=4&&(flags&DBCF_HAS_SIMD4D)&&(flags&DBCF_HAS_FMA)) return 4;
+#endif
+    (void)flags;
+    return 0;
+}
+
+static int dbcF_radix4_block_optimized_dd(
+    dbcf_index log2n,
+    dbcf_index log2c,
+    dbcf_index b,
+    dbcf_dd *real,dbcf_dd *imag,
+    dbcf_index real_stride,dbcf_index imag_stride,
+    const dbcf_dd *t1r,const dbcf_dd *t1i,
+    const dbcf_dd *t2r,const dbcf_dd *t2i,
+    const dbcf_dd *t3r,const dbcf_dd *t3i,
+    int inverse)
+{
+    int interleaved=(real_stride==2&&imag_stride==2&&imag==real+1);
+    dbcf_index lanes;
+    if(!interleaved&&(real_stride!=1||imag_stride!=1)) {DBCF_PROFILE_FALLBACK(DBCF_PROFILE_FALLBACK_STRIDE);return 0;}
+    if(!(lanes=dbcF_dd_lanes(b))) {DBCF_PROFILE_FALLBACK(DBCF_PROFILE_FALLBACK_SIZE);return 0;}
+    DBCF_PROFILE_KERNEL(lanes,interleaved?DBCF_PROFILE_INTERLEAVED:0);
+    DBCF_PROFILE_ENTER(DBCF_PROFILE_SIMD);
+#if defined(DBCF_DD_SIMD8)
+    if(lanes==8) dbcF_radix4_block_dd8(log2n,log2c,b,real,imag,interleaved,t1r,t1i,t2r,t2i,t3r,t3i,inverse);
+#endif
+#if defined(DBCF_DD_SIMD4)
+    if(lanes==4) dbcF_radix4_block_dd4(log2n,log2c,b,real,imag,interleaved,t1r,t1i,t2r,t2i,t3r,t3i,inverse);
+#endif
+    DBCF_PROFILE_LEAVE(DBCF_PROFILE_SIMD);
+    return 1;
+}
+
+static void dbcF_cexp_dd(dbcf_index log2n,dbcf_dd *real,dbcf_dd *imag);
+static void dbcF_compute_twiddles_dd(dbcf_index log2n,dbcf_index log2b,dbcf_dd *real,dbcf_dd *imag,int inverse);
+
+/*
+    As dbcF_butterfly_block, with the leaves above. The recursion (and its
+    scalar products) stays outside of the SIMD kernels, whose target
+    would allow contracting them.
+*/
+static void dbcF_butterfly_block_optimized_dd(
+    dbcf_index lanes,
+    dbcf_index log2n,
+    dbcf_index log2b,
+    dbcf_dd *LR,dbcf_dd *LI,
+    dbcf_dd *HR,dbcf_dd *HI,
+    int interleaved,
+    dbcf_dd C,dbcf_dd S,
+    int inverse,
+    const dbcf_dd *tr,const dbcf_dd *ti)
+{
+    dbcf_index b=DBCF_POW2(log2b),h=(b>>1)*(interleaved?2:1);
+    if(log2b<=DBCF_TWIDDLES_BUF_LOG2)
+    {
+#if defined(DBCF_DD_SIMD8)
+        if(lanes==8) dbcF_butterfly_leaf_dd8(b,LR,LI,HR,HI,interleaved,C,S,tr,ti);
+#endif
+#if defined(DBCF_DD_SIMD4)
+        if(lanes==4) dbcF_butterfly_leaf_dd4(b,LR,LI,HR,HI,interleaved,C,S,tr,ti);
+#endif
+    }
+    else
+    {
+        dbcf_dd X,Y;
+        dbcF_cexp_dd(log2n-log2b+1,&X,&Y);
+        if(!inverse) Y=-Y;
+        dbcF_butterfly_block_optimized_dd(lanes,log2n,log2b-1,LR  ,LI  ,HR  ,HI  ,interleaved,C      ,S      ,inverse,tr,ti);
+        dbcF_butterfly_block_optimized_dd(lanes,log2n,log2b-1,LR+h,LI+h,HR+h,HI+h,interleaved,C*X-S*Y,S*X+C*Y,inverse,tr,ti);
+    }
+}
+
+/* Returns the number of passes actually performed (always contiguous, starting from log2n-depth+1). */
+static dbcf_index dbcF_butterfly_multipass_optimized_dd(
+    dbcf_index log2n,
+    dbcf_index log2c,
+    dbcf_index depth,
+    dbcf_dd *real,dbcf_dd *imag,
+    dbcf_index real_stride,dbcf_index imag_stride,
+    int inverse,
+    dbcf_dd *tr,dbcf_dd *ti,
+    const dbcf_dd *table_real,const dbcf_dd *table_imag)
+{
+    dbcf_index log2d,ret=0;
+    int interleaved=(real_stride==2&&imag_stride==2&&imag==real+1);
+    if(!interleaved&&(real_stride!=1||imag_stride!=1)) {DBCF_PROFILE_FALLBACK(DBCF_PROFILE_FALLBACK_STRIDE);return 0;}
+    if(depth==log2n&&depth>=3) return 0;
+    for(log2d=log2n-depth+1;log2d<=log2n;++log2d)
+    {
+        dbcf_index log2t=(log2d-1<DBCF_TWIDDLES_BUF_LOG2||table_real?log2d-1:DBCF_TWIDDLES_BUF_LOG2),lanes;
+        const dbcf_dd *twr=tr,*twi=ti;
+        /* 2 passes at once are left to dbcF_butterfly_pass4. */
+        if(log2d<log2n&&DBCF_RADIX4_CHUNK_LOG2>=0&&dbcF_dd_lanes(DBCF_POW2(log2d-1<DBCF_RADIX4_CHUNK_LOG2?log2d-1:DBCF_RADIX4_CHUNK_LOG2))) break;
+        if(!(lanes=dbcF_dd_lanes(DBCF_POW2(log2d-1)))) break;
+        if(table_real)
+        {
+            twr=table_real+DBCF_POW2(log2d-1);
+            twi=table_imag+DBCF_POW2(log2d-1);
+        }
+        else
+        {
+            DBCF_PROFILE_ENTER(DBCF_PROFILE_TWIDDLES);
+            dbcF_compute_twiddles_dd(log2d,log2t,tr,ti,inverse);
+            DBCF_PROFILE_LEAVE(DBCF_PROFILE_TWIDDLES);
+        }
+        DBCF_PROFILE_KERNEL(lanes,interleaved?DBCF_PROFILE_INTERLEAVED:0);
+        DBCF_PROFILE_ENTER(DBCF_PROFILE_SIMD);
+        if(log2d-1<=log2t)
+        {
+#if defined(DBCF_DD_SIMD8)
+            if(lanes==8) dbcF_butterfly_pass_dd8(log2d,log2c+log2n-log2d,real,imag,interleaved,twr,twi);
+#endif
+#if defined(DBCF_DD_SIMD4)
+            if(lanes==4) dbcF_butterfly_pass_dd4(log2d,log2c+log2n-log2d,real,imag,interleaved,twr,twi);
+#endif
+        }
+        else
+        {
+            /* Only without the table, so as in dbcF_butterfly_pass. */
+            dbcf_index i,n=DBCF_POW2(log2d)*(interleaved?2:1),h=n>>1;
+            for(i=0;i<DBCF_POW2(log2c+log2n-log2d);++i)
+                dbcF_butterfly_block_optimized_dd(lanes,log2d,log2d-1,real+i*n,imag+i*n,real+i*n+h,imag+i*n+h,interleaved,dbcf_dd(1.0),dbcf_dd(0.0),inverse,tr,ti);
+        }
+        DBCF_PROFILE_LEAVE(DBCF_PROFILE_SIMD);
+        ++ret;
+    }
+    return ret;
+}
+#endif /* defined(DBCF_DD_SIMD4) || defined(DBCF_DD_SIMD8) */
+
+#define DBCF_Type dbcf_dd
+#define DBCF_Id dd
+#define DBCF_LITERAL(x) (dbcf_dd(x))
+#define DBCF_cexpm1      dbcF_dd_cexpm1
+#if defined(DBCF_DD_SIMD)
+#define DBCF_butterfly_multipass_optimized dbcF_butterfly_multipass_optimized_dd
+#define DBCF_radix4_block_optimized dbcF_radix4_block_optimized_dd
+#endif
+#define DBCF_cexpm1_npot dbcF_dd_cexpm1_npot
+#include __FILE__
+#undef DBCF_Type
+#undef DBCF_Id
+#undef DBCF_LITERAL
+#undef DBCF_cexpm1
+#undef DBCF_cexpm1_npot
+#if defined(DBCF_DD_SIMD)
+#undef DBCF_butterfly_multipass_optimized
+#undef DBCF_radix4_block_optimized
+#endif
+
+#endif /* defined(__cplusplus) && defined(DBC_FFT_DOUBLE_DOUBLE) */
+
+#undef DBC_FFT_INSTANTIATION
+
+/* Wisdom (see DBCF_WISDOM_HEADER for the format). */
+DBCF_DEF dbcf_index dbc_fft_wisdom_export(void *dst,dbcf_index size)
+{
+    unsigned char *p=(unsigned char*)dst;
+    unsigned long sig[2];
+    dbcf_index count=0,max=0;
+    int i,pass;
+    /* Count, then write (the entries added in between are left out). */
+    for(pass=0;pass<2;++pass)
+    {
+        count=0;
+#ifndef DBC_FFT_NO_NPOT
+#ifndef DBC_FFT_NO_FLOAT
+        count=dbcF_wisdom_entries(dbcF_npot_measured_f,p,count,max,'f',(dbcf_index)sizeof(float));
+#endif
+#ifndef DBC_FFT_NO_DOUBLE
+        count=dbcF_wisdom_entries(dbcF_npot_measured_d,p,count,max,'d',(dbcf_index)sizeof(double));
+#endif
+#ifndef DBC_FFT_NO_LONGDOUBLE
+        count=dbcF_wisdom_entries(dbcF_npot_measured_l,p,count,max,'l',(dbcf_index)sizeof(long double));
+#endif
+#endif /* DBC_FFT_NO_NPOT */
+        if(pass==0)
+        {
+            if(!dst||size<DBCF_WISDOM_HEADER+count*DBCF_WISDOM_ENTRY)
+                return DBCF_WISDOM_HEADER+count*DBCF_WISDOM_ENTRY;
+            max=count;
+        }
+        else if(count>max) count=max;
+    }
+    dbcF_wisdom_signature(sig);
+    for(i=0;i<8;++i) p[i]=(unsigned char)dbcF_wisdom_magic[i];
+    dbcF_wisdom_put(p+8,4,sig[0]);
+    dbcF_wisdom_put(p+12,4,sig[1]);
+    dbcF_wisdom_put(p+16,4,(unsigned long)count);
+    dbcF_wisdom_put(p+20,4,0);
+    return DBCF_WISDOM_HEADER+count*DBCF_WISDOM_ENTRY;
+}
+
+DBCF_DEF int dbc_fft_wisdom_import(const void *src,dbcf_index size)
+{
+    const unsigned char *p=(const unsigned char*)src;
+    unsigned long sig[2];
+    dbcf_index count,i;
+    int k,pass;
+    if(!src||size<DBCF_WISDOM_HEADER) return DBCF_ERROR_INVALID_ARGUMENT;
+    for(k=0;k<8;++k)
+        if(p[k]!=(unsigned char)dbcF_wisdom_magic[k]) return DBCF_ERROR_INVALID_ARGUMENT;
+    dbcF_wisdom_signature(sig);
+    if(dbcF_wisdom_get(p+8,4)!=sig[0]||dbcF_wisdom_get(p+12,4)!=sig[1]) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(dbcF_wisdom_get(p+20,4)!=0) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(dbcF_wisdom_get(p+16,4)>(unsigned long)((size-DBCF_WISDOM_HEADER)/DBCF_WISDOM_ENTRY)) return DBCF_ERROR_INVALID_ARGUMENT;
+    count=(dbcf_index)dbcF_wisdom_get(p+16,4);
+    /* Check all the entries first, so that nothing is imported from malformed wisdom. */
+    for(pass=0;pass<2;++pass)
+        for(i=0;i<count;++i)
+        {
+            const unsigned char *e=p+DBCF_WISDOM_HEADER+i*DBCF_WISDOM_ENTRY;
+            dbcf_index n=dbcF_wisdom_entry_size(e),s=e[2],type_size=0;
+#ifndef DBC_FFT_NO_FLOAT
+            if(e[0]=='f') type_size=(dbcf_index)sizeof(float);
+#endif
+#ifndef DBC_FFT_NO_DOUBLE
+            if(e[0]=='d') type_size=(dbcf_index)sizeof(double);
+#endif
+#ifndef DBC_FFT_NO_LONGDOUBLE
+            if(e[0]=='l') type_size=(dbcf_index)sizeof(long double);
+#endif
+            if(pass==0)
+            {
+                if(e[0]!='f'&&e[0]!='d'&&e[0]!='l') return DBCF_ERROR_INVALID_ARGUMENT;
+                if(type_size&&e[1]!=type_size) return DBCF_ERROR_INVALID_ARGUMENT;
+                for(k=3;k<8;++k) if(e[k]) return DBCF_ERROR_INVALID_ARGUMENT;
+                if(n<1||!(s&1)||s>DBCF_NPOT_MAX_ODD) return DBCF_ERROR_INVALID_ARGUMENT;
+#ifndef DBC_FFT_NO_NPOT
+                /* Only the sizes that use Bluestein's algorithm, and only its candidates. */
+                if(!(n&(n-1))||dbcF_is_smooth(n)||!dbcF_npot_candidate(n,s)) return DBCF_ERROR_INVALID_ARGUMENT;
+#endif
+            }
+#ifndef DBC_FFT_NO_NPOT
+#ifndef DBC_FFT_NO_FLOAT
+            else if(e[0]=='f') dbcF_npot_store_f(n,s);
+#endif
+#ifndef DBC_FFT_NO_DOUBLE
+            else if(e[0]=='d') dbcF_npot_store_d(n,s);
+#endif
+#ifndef DBC_FFT_NO_LONGDOUBLE
+            else if(e[0]=='l') dbcF_npot_store_l(n,s);
+#endif
+#endif /* DBC_FFT_NO_NPOT */
+        }
+    return 0;
+}
+
+DBCF_DEF void dbc_fft_wisdom_forget(void)
+{
+#ifndef DBC_FFT_NO_NPOT
+#ifndef DBC_FFT_NO_FLOAT
+    dbcF_wisdom_forget(dbcF_npot_measured_f);
+#endif
+#ifndef DBC_FFT_NO_DOUBLE
+    dbcF_wisdom_forget(dbcF_npot_measured_d);
+#endif
+#ifndef DBC_FFT_NO_LONGDOUBLE
+    dbcF_wisdom_forget(dbcF_npot_measured_l);
+#endif
+#endif /* DBC_FFT_NO_NPOT */
+}
+
+#endif /* defined(DBC_FFT_IMPLEMENTATION) && !defined(DBC_FFT_DECLARATION) && !defined(DBC_FFT_INSTANTIATION) */
+
+/*============================================================================*/
+/* Instantiation section. */
+
+#ifdef DBC_FFT_INSTANTIATION
+
+#ifndef DBCF_ZERO
+#define DBCF_ZERO DBCF_LITERAL(0.0)
+#endif
+#ifndef DBCF_ONE
+#define DBCF_ONE  DBCF_LITERAL(1.0)
+#endif
+
+/*
+    Compute exp(2*pi*i/n)-1.
+    We don't actually need to depend on <math.h>.
+*/
+static void DBCF_NAME(dbcF_cexpm1)(dbcf_index log2n,DBCF_Type *real,DBCF_Type *imag)
+{
+#ifdef DBCF_cexpm1
+    DBCF_cexpm1(log2n,real,imag);
+#else
+    /* All coefficients are entered with sub-ULP precision, even for float128. */
+    static DBCF_Type table[][2]={
+        { DBCF_LITERAL(0.0e0)                                       ,DBCF_LITERAL(0.0e0)                                       },
+        {-DBCF_LITERAL(2.0e0)                                       ,DBCF_LITERAL(0.0e0)                                       },
+        {-DBCF_LITERAL(1.0e0)                                       ,DBCF_LITERAL(1.0e0)                                       },
+        {-DBCF_LITERAL(2.928932188134524755991556378951509607151e-1),DBCF_LITERAL(7.071067811865475244008443621048490392848e-1)},
+        {-DBCF_LITERAL(7.612046748871324387181681060321171317758e-2),DBCF_LITERAL(3.826834323650897717284599840303988667613e-1)},
+        {-DBCF_LITERAL(1.921471959676955087381776386576096302606e-2),DBCF_LITERAL(1.950903220161282678482848684770222409276e-1)},
+        {-DBCF_LITERAL(4.815273327803113755163046890520078424525e-3),DBCF_LITERAL(9.801714032956060199419556388864184586113e-2)},
+        {-DBCF_LITERAL(1.204543794827607285228395240899305556796e-3),DBCF_LITERAL(4.906767432741801425495497694268265831474e-2)},
+        {-DBCF_LITERAL(3.011813037957798842343503338278031499389e-4),DBCF_LITERAL(2.454122852291228803173452945928292506546e-2)},
+        {-DBCF_LITERAL(7.529816085545907835350880361677564939353e-5),DBCF_LITERAL(1.227153828571992607940826195100321214037e-2)},
+        {-DBCF_LITERAL(1.882471739885734300956227143228382608274e-5),DBCF_LITERAL(6.135884649154475359640234590372580917057e-3)},
+        {-DBCF_LITERAL(4.706190423828488419874299880100447012366e-6),DBCF_LITERAL(3.067956762965976270145365490919842518944e-3)},
+        {-DBCF_LITERAL(1.176548298090070974289828473980951732077e-6),DBCF_LITERAL(1.533980186284765612303697150264079079954e-3)},
+        {-DBCF_LITERAL(2.941371177808397717822612343228837361006e-7),DBCF_LITERAL(7.669903187427045269385683579485766431409e-4)},
+        {-DBCF_LITERAL(7.353428214885526851929261214305179884431e-8),DBCF_LITERAL(3.834951875713955890724616811813812633950e-4)},
+        {-DBCF_LITERAL(1.838357070619165308459709028549492394875e-8),DBCF_LITERAL(1.917475973107033074399095619890009334688e-4)},
+        {-DBCF_LITERAL(4.595892687109028066860393851041105696810e-9),DBCF_LITERAL(9.587379909597734587051721097647635118706e-5)}
+    };
+    if(log2n<(dbcf_index)(sizeof(table)/(sizeof(table[0]))))
+    {
+        *real=table[log2n][0];
+        *imag=table[log2n][1];
+    }
+    else
+    {
+        /* For small x Taylor series is accurate to couple of ULPs, even for float128. */
+        dbcf_index n=((dbcf_index)1)<<log2n;
+        const DBCF_Type C1=DBCF_LITERAL(1.0e0);
+        const DBCF_Type C2=DBCF_LITERAL(5.0e-1);
+        const DBCF_Type C3=DBCF_LITERAL(1.666666666666666666666666666666666666666e-1);
+        const DBCF_Type C4=DBCF_LITERAL(4.166666666666666666666666666666666666666e-2);
+        const DBCF_Type C5=DBCF_LITERAL(8.333333333333333333333333333333333333333e-3);
+        const DBCF_Type C6=DBCF_LITERAL(1.388888888888888888888888888888888888888e-3);
+        const DBCF_Type C7=DBCF_LITERAL(1.984126984126984126984126984126984126984e-4);
+        const DBCF_Type C8=DBCF_LITERAL(2.480158730158730158730158730158730158730e-5);
+        DBCF_Type x=DBCF_LITERAL(6.283185307179586476925286766559005768)/(DBCF_Type)n;
+        DBCF_Type x2=x*x;
+        *real=-x2*(C2-x2*(C4-x2*(C6-x2*C8)));
+        *imag=x*(C1-x2*(C3-x2*(C5-x2*C7)));
+    }
+#endif
+}
+
+static void DBCF_NAME(dbcF_cexp)(dbcf_index log2n,DBCF_Type *real,DBCF_Type *imag)
+{
+    DBCF_NAME(dbcF_cexpm1)(log2n,real,imag);
+    *real=DBCF_ONE+*real;
+}
+
+/*
+    Compute exp(2*pi*i*k/n), for 0<=k<b.
+    At most O(log(n)) arithmetic operations (and, therefore, roundoff errors)
+    are involved in calculating any given twiddle.
+*/
+static void DBCF_NAME(dbcF_compute_twiddles)(dbcf_index log2n,dbcf_index log2b,DBCF_Type *real,DBCF_Type *imag,int inverse)
+{
+    dbcf_index i;
+    DBCF_PROFILE_ENTER(DBCF_PROFILE_TWIDDLES);
+    real[0]=DBCF_ZERO;
+    imag[0]=DBCF_ZERO;
+    for(i=0;i<log2b;++i)
+    {
+        dbcf_index j,k=DBCF_POW2(i);
+        /*
+            Note: accuracy seems to be slightly better when working
+            with (cos-1,sin), rather than (cos,sin).
+        */
+        DBCF_Type x,y;
+        DBCF_NAME(dbcF_cexpm1)(log2n-i,&x,&y);
+        if(!inverse) y=-y;
+        for(j=0;j<k;++j)
+        {
+            real[k+j]=(x*real[j]-y*imag[j])+(x+real[j]);
+            imag[k+j]=(y*real[j]+x*imag[j])+(y+imag[j]);
+        }
+    }
+    for(i=0;i<DBCF_POW2(log2b);++i)
+        real[i]=DBCF_ONE+real[i];
+    DBCF_PROFILE_LEAVE(DBCF_PROFILE_TWIDDLES);
+}
+
+/*
+    Compute the twiddle table for all butterfly passes of size up to n:
+    twiddles for the pass of size d=2^k (k>=1) are stored at [d/2,d),
+    so the whole table takes n elements (element 0 is unused).
+    Each entry is computed by dbcF_compute_twiddles, so the accuracy
+    is the same as when computing them on the fly.
+*/
+static void DBCF_NAME(dbcF_compute_twiddle_table)(dbcf_index log2n,DBCF_Type *real,DBCF_Type *imag,int inverse)
+{
+    dbcf_index k;
+    DBCF_PROFILE_ENTER(DBCF_PROFILE_TWIDDLES);
+    real[0]=DBCF_ZERO;
+    imag[0]=DBCF_ZERO;
+    for(k=1;k<=log2n;++k)
+        DBCF_NAME(dbcF_compute_twiddles)(k,k-1,real+DBCF_POW2(k-1),imag+DBCF_POW2(k-1),inverse);
+    DBCF_PROFILE_LEAVE(DBCF_PROFILE_TWIDDLES);
+}
+
+/*
+    Compute exp(2*pi*i*(p/q))-1.
+    We don't actually need to depend on <math.h>.
+*/
+static void DBCF_NAME(dbcF_cexpm1_npot)(dbcf_index p,dbcf_index q,DBCF_Type *real,DBCF_Type *imag)
+{
+#ifdef DBCF_cexpm1_npot
+    DBCF_cexpm1_npot(p,q,real,imag);
+#else
+    dbcf_index i;
+    DBCF_Type C=DBCF_ONE,S=DBCF_ONE;
+    DBCF_Type x=DBCF_LITERAL(6.283185307179586476925286766559005768)*(DBCF_Type)p/(DBCF_Type)q,x2=x*x;
+    DBCF_Type I=DBCF_LITERAL(32.0);
+    for(i=32;i>=0;--i)
+    {
+        DBCF_Type J=(DBCF_LITERAL(2.0)*I+DBCF_LITERAL(3.0)),K=I+I+DBCF_LITERAL(3.0);
+        J=J*J;
+        C=DBCF_LITERAL(1.0)-x2*C/(J+K);
+        S=DBCF_LITERAL(1.0)-x2*S/(J-K);
+        I=I-DBCF_LITERAL(1.0);
+    }
+    C=-C*DBCF_LITERAL(0.5)*x2;
+    S=S*x;
+    *real=C;
+    *imag=S;
+#endif
+}
+
+/*
+    Compute exp(+-2*pi*i*(p/q))-1 (minus for forward transform), for any p.
+    The argument is reduced to at most pi/2.
+*/
+static void DBCF_NAME(dbcF_cexpm1_root)(dbcf_index p,dbcf_index q,int inverse,DBCF_Type *real,DBCF_Type *imag)
+{
+    DBCF_Type x,y;
+    p%=q;
+    if(2*p>q) {p=q-p;inverse=!inverse;}
+    if(4*p>q)
+    {
+        /* exp(2*pi*i*(p/q))=i*exp(2*pi*i*((4*p-q)/(4*q))). */
+        DBCF_NAME(dbcF_cexpm1_npot)(4*p-q,4*q,&x,&y);
+        *real=-y-DBCF_ONE;
+        *imag=DBCF_ONE+x;
+    }
+    else DBCF_NAME(dbcF_cexpm1_npot)(p,q,real,imag);
+    if(!inverse) *imag=-*imag;
+}
+
+#ifndef DBC_FFT_NO_NPOT
+static void DBCF_NAME(dbcF_compute_twiddles_npot)(dbcf_index n,DBCF_Type *real,DBCF_Type *imag,int inverse)
+{
+    /* Note: always gets called with even n. */
+    dbcf_index i,j,k,m=n>>1,h=(m+2)>>1;
+    if(n<1) return;
+    real[0]=DBCF_ZERO;
+    imag[0]=DBCF_ZERO;
+    /*
+        Note: accuracy is somewhat better when working with (cos-1,sin),
+        rather than (cos,sin).
+    */
+    for(i=1;i<h;i*=2)
+    {
+        DBCF_Type X,Y;
+        DBCF_NAME(dbcF_cexpm1_npot)(i,n,&X,&Y);
+        if(!inverse) Y=-Y;
+        j=(h<i*2?h-i:i);
+        for(k=0;k<j;++k)
+        {
+            real[i+k]=(X*real[k]-Y*imag[k])+(X+real[k]);
+            imag[i+k]=(Y*real[k]+X*imag[k])+(Y+imag[k]);
+        }
+    }
+    for(i=0;i<h;++i) real[i]=DBCF_ONE+real[i];
+    for(i=h;i<m;++i)
+    {
+        real[i]=-real[m-i];
+        imag[i]= imag[m-i];
+    }
+    for(i=0;i<m;++i)
+    {
+        real[m+i]=-real[i];
+        imag[m+i]=-imag[i];
+    }
+}
+#endif
+
+/*
+    Bit-reversal permutations.
+    All of them optionally multiply each element by the window (a real
+    factor per source index, see dbc_fft_plan_set_window_f) on the way,
+    i.e. dst[rev(i)]=src[i]*window[i]. window is either NULL, or indexed
+    with its own stride, which follows the source through the recursion.
+*/
+static void DBCF_NAME(dbcF_bitreversal_swap)(
+    dbcf_index log2n,
+    DBCF_Type *src,dbcf_index src_stride,
+    DBCF_Type *dst,dbcf_index dst_stride,
+    const DBCF_Type *src_window,dbcf_index src_window_stride,
+    const DBCF_Type *dst_window,dbcf_index dst_window_stride)
+{
+    dbcf_index i,n=DBCF_POW2(log2n),h=n>>1;
+    if(log2n<=8)
+    {
+#ifndef DBC_FFT_NO_BITREVERSE_TABLE
+        const unsigned char *idx=dbcF_bitreverse_table+DBCF_POW2(log2n);
+#endif
+        for(i=0;i<n;++i)
+        {
+#ifndef DBC_FFT_NO_BITREVERSE_TABLE
+            dbcf_index j=(dbcf_index)(idx[i]);
+#else
+            dbcf_index j=dbcF_bitreverse(i,log2n);
+#endif
+            DBCF_Type x=src[i*src_stride];
+            DBCF_Type y=dst[j*dst_stride];
+            if(src_window)
+            {
+                x=x*src_window[i*src_window_stride];
+                y=y*dst_window[j*dst_window_stride];
+            }
+            src[i*src_stride]=y;
+            dst[j*dst_stride]=x;
+        }
+    }
+    else
+    {
+        DBCF_NAME(dbcF_bitreversal_swap)(log2n-1,
+            src           ,2*src_stride,
+            dst             ,dst_stride,
+            src_window,2*src_window_stride,
+            dst_window,dst_window_stride);
+        DBCF_NAME(dbcF_bitreversal_swap)(log2n-1,
+            src+src_stride,2*src_stride,
+            dst+h*dst_stride,dst_stride,
+            (src_window?src_window+src_window_stride:src_window),2*src_window_stride,
+            (dst_window?dst_window+h*dst_window_stride:dst_window),dst_window_stride);
+    }
+}
+
+/*
+    The in-place permutation of large inputs, based on
+    "Towards an Optimal Bit-Reversal Permutation Program"
+    by Larry Carter and Kang Su Gatlin. Only processes the blocks b0<=b<b1
+    (out of 2^(log2n-2*Q)); different blocks can be processed in parallel.
+    The window is applied as the elements are read into tmp (each element
+    goes through tmp exactly once on its way to its final place).
+*/
+static void DBCF_NAME(dbcF_bitreversal_blocks)(
+    dbcf_index log2n,
+    DBCF_Type *dst,dbcf_index dst_stride,
+    const DBCF_Type *window,dbcf_index window_stride,
+    dbcf_index b0,dbcf_index b1,
+    DBCF_Type *tmp)
+{
+    dbcf_index i,a,b,c,log2m=log2n-2*(DBCF_Q);
+    dbcf_index pow2q=DBCF_POW2(DBCF_Q);
+    for(b=b0;b<b1;++b)
+    {
+        dbcf_index ib=dbcF_bitreverse(b,log2m);
+        if(ib<b) continue;
+        for(a=0;a<pow2q;++a)
+            for(c=0;c<pow2q;++c)
+            {
+                i=(a<<(log2n-(DBCF_Q)))^(b<<(DBCF_Q))^c;
+                tmp[(a<<(DBCF_Q))^c]=(window?dst[i*dst_stride]*window[i*window_stride]:dst[i*dst_stride]);
+            }
+        for(c=0;c<pow2q;++c)
+        {
+            dbcf_index ic=dbcF_bitreverse(c,(DBCF_Q));
+            for(a=0;a<pow2q;++a)
+            {
+
+                dbcf_index ia=dbcF_bitreverse(a,(DBCF_Q));
+                DBCF_Type t;
+                i=(ic<<(log2n-(DBCF_Q)))^(ib<<(DBCF_Q))^ia;
+                t=dst[i*dst_stride];
+                if(window&&b!=ib) t=t*window[i*window_stride];
+                dst[i*dst_stride]=tmp[(a<<(DBCF_Q))^c];
+                tmp[(a<<(DBCF_Q))^c]=t;
+            }
+        }
+        if(b!=ib)
+            for(a=0;a<pow2q;++a)
+                for(c=0;c<pow2q;++c)
+                    dst[((a<<(log2n-(DBCF_Q)))^(b<<(DBCF_Q))^c)*dst_stride]=tmp[(a<<(DBCF_Q))^c];
+    }
+}
+
+#ifdef DBC_FFT_THREADS
+typedef struct DBCF_NAME(dbcF_bitreversal_args)
+{
+    dbcf_index log2n;
+    DBCF_Type *dst;
+    dbcf_index dst_stride;
+    const DBCF_Type *window;
+    dbcf_index window_stride;
+    dbcf_index b0,b1;
+} DBCF_NAME(dbcF_bitreversal_args);
+
+static void DBCF_NAME(dbcF_bitreversal_task)(void *arg)
+{
+    const DBCF_NAME(dbcF_bitreversal_args) *args=(const DBCF_NAME(dbcF_bitreversal_args)*)arg;
+    DBCF_Type tmp[DBCF_TMP_BUF_SIZE];
+    DBCF_NAME(dbcF_bitreversal_blocks)(args->log2n,args->dst,args->dst_stride,args->window,args->window_stride,args->b0,args->b1,tmp);
+}
+
+/* Split the m blocks between (at most) threads tasks. */
+static void DBCF_NAME(dbcF_bitreversal_blocks_threaded)(
+    dbcf_index log2n,
+    DBCF_Type *dst,dbcf_index dst_stride,
+    const DBCF_Type *window,dbcf_index window_stride,
+    dbcf_index m,
+    int threads,
+    DBCF_Type *tmp)
+{
+    DBCF_NAME(dbcF_bitreversal_args) args[DBCF_MAX_TASKS];
+    void *tasks[DBCF_MAX_TASKS];
+    dbcf_index t,num_tasks=(dbcf_index)(threads<(DBCF_MAX_TASKS)?threads:(DBCF_MAX_TASKS));
+    if(num_tasks>m) num_tasks=m;
+    for(t=0;t<num_tasks;++t)
+    {
+        args[t].log2n=log2n;
+        args[t].dst=dst;
+        args[t].dst_stride=dst_stride;
+        args[t].window=window;
+        args[t].window_stride=window_stride;
+        args[t].b0=(m*t)/num_tasks;
+        args[t].b1=(m*(t+1))/num_tasks;
+    }
+    for(t=1;t<num_tasks;++t) tasks[t]=dbcF_spawn(DBCF_NAME(dbcF_bitreversal_task),&args[t]);
+    DBCF_NAME(dbcF_bitreversal_blocks)(log2n,dst,dst_stride,window,window_stride,args[0].b0,args[0].b1,tmp);
+    for(t=1;t<num_tasks;++t) dbcF_join(tasks[t]);
+}
+#endif /* DBC_FFT_THREADS */
+
+static void DBCF_NAME(dbcF_bitreversal_permutation)(
+    dbcf_index log2n,
+    const DBCF_Type *src,dbcf_index src_stride,
+    DBCF_Type *dst,dbcf_index dst_stride,
+    const DBCF_Type *window,dbcf_index window_stride,
+    DBCF_Type *tmp,
+    int threads)
+{
+    dbcf_index i,n=DBCF_POW2(log2n),h=n>>1;
+    DBCF_PROFILE_ENTER(DBCF_PROFILE_BITREVERSAL);
+    if(src_stride==0)
+    {
+        DBCF_Type x=src[0];
+        if(window)
+            for(i=0;i<n;++i)
+                dst[dbcF_bitreverse(i,log2n)*dst_stride]=x*window[i*window_stride];
+        else
+            for(i=0;i<n;++i)
+                dst[i*dst_stride]=x;
+    }
+    else if(src==dst)
+    {
+        /* In-place case. */
+        if(log2n<=8)
+        {
+#ifndef DBC_FFT_NO_BITREVERSE_TABLE
+            const unsigned char *idx=dbcF_bitreverse_table+DBCF_POW2(log2n);
+#endif
+            for(i=0;i<n;++i)
+            {
+#ifndef DBC_FFT_NO_BITREVERSE_TABLE
+                dbcf_index j=(dbcf_index)(idx[i]);
+#else
+                dbcf_index j=dbcF_bitreverse(i,log2n);
+#endif
+                if(i<j)
+                {
+                    DBCF_Type x=dst[i*dst_stride];
+                    DBCF_Type y=dst[j*dst_stride];
+                    if(window)
+                    {
+                        x=x*window[i*window_stride];
+                        y=y*window[j*window_stride];
+                    }
+                    dst[i*dst_stride]=y;
+                    dst[j*dst_stride]=x;
+                }
+                else if(i==j&&window) dst[i*dst_stride]=dst[i*dst_stride]*window[i*window_stride];
+            }
+        }
+        else if(log2n<=2*(DBCF_Q)+2||log2n<=16)
+        {
+            const DBCF_Type *w1=(window?window+window_stride:window);
+            const DBCF_Type *wh=(window?window+h*window_stride:window);
+            const DBCF_Type *wh1=(window?window+(h+1)*window_stride:window);
+            /* Exchange 0X...X1's and 1X...X0's */
+            DBCF_NAME(dbcF_bitreversal_swap)(log2n-2,
+                dst+dst_stride,2*dst_stride,
+                dst+h*dst_stride,2*dst_stride,
+                w1,2*window_stride,
+                wh,2*window_stride);
+            /* Reverse 0X...X0's */
+            DBCF_NAME(dbcF_bitreversal_permutation)(log2n-2,dst                 ,2*dst_stride,dst                 ,2*dst_stride,window,2*window_stride,tmp,threads);
+            /* Reverse 1X...X1's */
+            DBCF_NAME(dbcF_bitreversal_permutation)(log2n-2,dst+(h+1)*dst_stride,2*dst_stride,dst+(h+1)*dst_stride,2*dst_stride,wh1   ,2*window_stride,tmp,threads);
+        }
+        else
+        {
+            dbcf_index m=DBCF_POW2(log2n-2*(DBCF_Q));
+#ifdef DBC_FFT_THREADS
+            if(threads>1&&log2n>=DBCF_THREADS_MIN_LOG2)
+                DBCF_NAME(dbcF_bitreversal_blocks_threaded)(log2n,dst,dst_stride,window,window_stride,m,threads,tmp);
+            else
+#endif /* DBC_FFT_THREADS */
+            DBCF_NAME(dbcF_bitreversal_blocks)(log2n,dst,dst_stride,window,window_stride,0,m,tmp);
+        }
+    }
+    else
+    {
+        if(log2n<=8)
+        {
+#ifndef DBC_FFT_NO_BITREVERSE_TABLE
+            const unsigned char *idx=dbcF_bitreverse_table+DBCF_POW2(log2n);
+#endif
+            if(window) for(i=0;i<n;++i)
+            {
+#ifndef DBC_FFT_NO_BITREVERSE_TABLE
+                dbcf_index j=(dbcf_index)(idx[i]);
+#else
+                dbcf_index j=dbcF_bitreverse(i,log2n);
+#endif
+                dst[j*dst_stride]=src[i*src_stride]*window[i*window_stride];
+            }
+            else for(i=0;i<n;++i)
+            {
+#ifndef DBC_FFT_NO_BITREVERSE_TABLE
+                dbcf_index j=(dbcf_index)(idx[i]);
+#else
+                dbcf_index j=dbcF_bitreverse(i,log2n);
+#endif
+                dst[j*dst_stride]=src[i*src_stride];
+            }
+        }
+        else if(log2n<=16)
+        {
+            DBCF_NAME(dbcF_bitreversal_permutation)(log2n-1,src           ,2*src_stride,dst             ,dst_stride,window,2*window_stride,tmp,threads);
+            DBCF_NAME(dbcF_bitreversal_permutation)(log2n-1,src+src_stride,2*src_stride,dst+h*dst_stride,dst_stride,(window?window+window_stride:window),2*window_stride,tmp,threads);
+        }
+        else
+        {
+            /*
+                Do one pass, and call the in-place case. This turns out to be faster,
+                especially for smaller Q. The window is applied in this pass.
+            */
+            if(window) for(i=0;i<h;++i)
+            {
+                dst[ i   *dst_stride]=src[(2*i  )*src_stride]*window[(2*i  )*window_stride];
+                dst[(i+h)*dst_stride]=src[(2*i+1)*src_stride]*window[(2*i+1)*window_stride];
+            }
+            else for(i=0;i<h;++i)
+            {
+                dst[ i   *dst_stride]=src[(2*i  )*src_stride];
+                dst[(i+h)*dst_stride]=src[(2*i+1)*src_stride];
+            }
+            DBCF_NAME(dbcF_bitreversal_permutation)(log2n-1,dst             ,dst_stride,dst             ,dst_stride,0,0,tmp,threads);
+            DBCF_NAME(dbcF_bitreversal_permutation)(log2n-1,dst+h*dst_stride,dst_stride,dst+h*dst_stride,dst_stride,0,0,tmp,threads);
+        }
+    }
+    DBCF_PROFILE_LEAVE(DBCF_PROFILE_BITREVERSAL);
+}
+
+/* Hand-coded (I)FFT for size 8. */
+static void DBCF_NAME(dbcF_fft8)(
+    DBCF_Type *real,DBCF_Type *imag,
+    dbcf_index real_stride,dbcf_index imag_stride,
+    int inverse,DBCF_Type c)
+{
+    DBCF_Type r0,r1,r2,r3,r4,r5,r6,r7;
+    DBCF_Type i0,i1,i2,i3,i4,i5,i6,i7;
+    DBCF_Type R0,R1,R2,R3,R4,R5,R6,R7;
+    DBCF_Type I0,I1,I2,I3,I4,I5,I6,I7;
+    DBCF_Type p5,m5,p7,m7;
+    r0=real[0*real_stride];i0=imag[0*imag_stride];
+    r1=real[1*real_stride];i1=imag[1*imag_stride];
+    r2=real[2*real_stride];i2=imag[2*imag_stride];
+    r3=real[3*real_stride];i3=imag[3*imag_stride];
+    r4=real[4*real_stride];i4=imag[4*imag_stride];
+    r5=real[5*real_stride];i5=imag[5*imag_stride];
+    r6=real[6*real_stride];i6=imag[6*imag_stride];
+    r7=real[7*real_stride];i7=imag[7*imag_stride];
+    R0=r0+r1;R1=r0-r1;I0=i0+i1;I1=i0-i1;
+    R2=r2+r3;R3=r2-r3;I2=i2+i3;I3=i2-i3;
+    R4=r4+r5;R5=r4-r5;I4=i4+i5;I5=i4-i5;
+    R6=r6+r7;R7=r6-r7;I6=i6+i7;I7=i6-i7;
+    if(!inverse)
+    {
+        r0=R0+R2;i0=I0+I2;
+        r1=R1+I3;i1=I1-R3;
+        r2=R0-R2;i2=I0-I2;
+        r3=R1-I3;i3=I1+R3;
+        r4=R4+R6;i4=I4+I6;
+        r5=R5+I7;i5=I5-R7;
+        r6=R4-R6;i6=I4-I6;
+        r7=R5-I7;i7=I5+R7;
+        p5=c*(r5+i5);m5=c*(r5-i5);
+        p7=c*(r7+i7);m7=c*(r7-i7);
+        real[0*real_stride]=r0+r4;imag[0*imag_stride]=i0+i4;
+        real[1*real_stride]=r1+p5;imag[1*imag_stride]=i1-m5;
+        real[2*real_stride]=r2+i6;imag[2*imag_stride]=i2-r6;
+        real[3*real_stride]=r3-m7;imag[3*imag_stride]=i3-p7;
+        real[4*real_stride]=r0-r4;imag[4*imag_stride]=i0-i4;
+        real[5*real_stride]=r1-p5;imag[5*imag_stride]=i1+m5;
+        real[6*real_stride]=r2-i6;imag[6*imag_stride]=i2+r6;
+        real[7*real_stride]=r3+m7;imag[7*imag_stride]=i3+p7;
+    }
+    else
+    {
+        r0=R0+R2;i0=I0+I2;
+        r1=R1-I3;i1=I1+R3;
+        r2=R0-R2;i2=I0-I2;
+        r3=R1+I3;i3=I1-R3;
+        r4=R4+R6;i4=I4+I6;
+        r5=R5-I7;i5=I5+R7;
+        r6=R4-R6;i6=I4-I6;
+        r7=R5+I7;i7=I5-R7;
+        p5=c*(r5+i5);m5=c*(r5-i5);
+        p7=c*(r7+i7);m7=c*(r7-i7);
+        real[0*real_stride]=r0+r4;imag[0*imag_stride]=i0+i4;
+        real[1*real_stride]=r1+m5;imag[1*imag_stride]=i1+p5;
+        real[2*real_stride]=r2-i6;imag[2*imag_stride]=i2+r6;
+        real[3*real_stride]=r3-p7;imag[3*imag_stride]=i3+m7;
+        real[4*real_stride]=r0-r4;imag[4*imag_stride]=i0-i4;
+        real[5*real_stride]=r1-m5;imag[5*imag_stride]=i1-p5;
+        real[6*real_stride]=r2+i6;imag[6*imag_stride]=i2-r6;
+        real[7*real_stride]=r3+p7;imag[7*imag_stride]=i3-m7;
+    }
+}
+
+/*
+    Compute a part of a butterfly of size n, on a block of size b,
+    ensuring that each computed twiddle is touched by
+    at most O(log(n)) arithmetic operations, to improve accuracy.
+    The individual computed twiddles are products of precomputed
+    twiddles (tr, ti) with recursively passed multipliers (C, S).
+*/
+static void DBCF_NAME(dbcF_butterfly_block)(
+    dbcf_index log2n,
+    dbcf_index log2b,
+    DBCF_Type *LR,DBCF_Type *LI,
+    DBCF_Type *HR,DBCF_Type *HI,
+    dbcf_index real_stride,dbcf_index imag_stride,
+    DBCF_Type C,DBCF_Type S,
+    int inverse,
+    const DBCF_Type *tr,const DBCF_Type *ti)
+{
+    dbcf_index b=DBCF_POW2(log2b),h=b>>1;
+    DBCF_Type X,Y;
+    if(log2b<=DBCF_TWIDDLES_BUF_LOG2)
+    {
+        /* The block is small, we have enough precomputed twiddles. */
+        dbcf_index i,j=0,k=0;
+        for(i=0;i<b;++i)
+        {
+            DBCF_Type c=C*tr[i]-S*ti[i];
+            DBCF_Type s=S*tr[i]+C*ti[i];
+            DBCF_Type xl=LR[j],yl=LI[k];
+            DBCF_Type xr=HR[j],yr=HI[k];
+            DBCF_Type x=c*xr-s*yr;
+            DBCF_Type y=s*xr+c*yr;
+            LR[j]=xl+x;
+            LI[k]=yl+y;
+            HR[j]=xl-x;
+            HI[k]=yl-y;
+            j+=real_stride;
+            k+=imag_stride;
+        }
+    }
+    else
+    {
+        /* The block is large, we process it's halves recursively. */
+        DBCF_NAME(dbcF_cexp)(log2n-log2b+1,&X,&Y);
+        if(!inverse) Y=-Y;
+        DBCF_NAME(dbcF_butterfly_block)(log2n,log2b-1,LR              ,LI              ,HR              ,HI              ,real_stride,imag_stride,C      ,S      ,inverse,tr,ti);
+        DBCF_NAME(dbcF_butterfly_block)(log2n,log2b-1,LR+h*real_stride,LI+h*imag_stride,HR+h*real_stride,HI+h*imag_stride,real_stride,imag_stride,C*X-S*Y,S*X+C*Y,inverse,tr,ti);
+    }
+}
+
+/* Compute a butterfly pass over c blocks of size n. */
+static void DBCF_NAME(dbcF_butterfly_pass)(
+    dbcf_index log2n,
+    dbcf_index log2c,
+    DBCF_Type *real,DBCF_Type *imag,
+    dbcf_index real_stride,dbcf_index imag_stride,
+    int inverse,
+	dbcf_index log2t,
+    const DBCF_Type *tr,const DBCF_Type *ti)
+{
+    dbcf_index n=DBCF_POW2(log2n),h=n>>1;
+    dbcf_index c=DBCF_POW2(log2c);
+    dbcf_index i;
+    DBCF_Type *LR=real,*HR=real+h*real_stride;
+    DBCF_Type *LI=imag,*HI=imag+h*imag_stride;
+    if(log2n==0) return;
+    if(log2n-1<=log2t)
+    {
+        /*
+            We have as much precomputed twiddles
+            as the block needs, so we supply them directly.
+        */
+        if(h>1)
+        {
+            for(i=0;i<c;++i)
+            {
+                dbcf_index d,j=0,k=0;
+                for(d=0;d<h;d+=2)
+                {
+                    /* Unroll x2. Slightly faster. */
+                    DBCF_Type C,S,xl,yl,xr,yr,x,y;
+                    C=tr[d];S=ti[d];
+                    xl=LR[j];yl=LI[k];
+                    xr=HR[j];yr=HI[k];
+                    x=C*xr-S*yr;y=S*xr+C*yr;
+                    LR[j]=xl+x;LI[k]=yl+y;
+                    HR[j]=xl-x;HI[k]=yl-y;
+                    j+=real_stride;k+=imag_stride;
+                    C=tr[d+1];S=ti[d+1];
+                    xl=LR[j];yl=LI[k];
+                    xr=HR[j];yr=HI[k];
+                    x=C*xr-S*yr;y=S*xr+C*yr;
+                    LR[j]=xl+x;LI[k]=yl+y;
+                    HR[j]=xl-x;HI[k]=yl-y;
+                    j+=real_stride;k+=imag_stride;
+                }
+                LR+=n*real_stride;LI+=n*imag_stride;
+                HR+=n*real_stride;HI+=n*imag_stride;
+            }
+        }
+        else
+        {
+            for(i=0;i<c;++i)
+            {
+                DBCF_Type xl,yl,xr,yr;
+                xl=LR[0];yl=LI[0];
+                xr=HR[0];yr=HI[0];
+                LR[0]=xl+xr;LI[0]=yl+yr;
+                HR[0]=xl-xr;HI[0]=yl-yr;
+                LR+=n*real_stride;LI+=n*imag_stride;
+                HR+=n*real_stride;HI+=n*imag_stride;
+            }
+        }
+    }
+    else
+    {
+        /* We compute butterfly recursively, supplying only t precomputed twiddles. */
+        for(i=0;i<c;++i)
+        {
+            DBCF_NAME(dbcF_butterfly_block)(log2n,log2n-1,LR,LI,HR,HI,real_stride,imag_stride,DBCF_ONE,DBCF_ZERO,inverse,tr,ti);
+            LR+=n*real_stride;LI+=n*imag_stride;
+            HR+=n*real_stride;HI+=n*imag_stride;
+        }
+    }
+}
+
+/*
+    Radix-4 butterflies over the quarters of c blocks of size n, for
+    0<=j<b. Twiddles (t1r,t1i), (t2r,t2i), (t3r,t3i), indexed by j, are
+    w^j, w^(2j), w^(3j) for the n-th root of unity w.
+*/
+static void DBCF_NAME(dbcF_radix4_block)(
+    dbcf_index log2n,
+    dbcf_index log2c,
+    dbcf_index b,
+    DBCF_Type *real,DBCF_Type *imag,
+    dbcf_index real_stride,dbcf_index imag_stride,
+    const DBCF_Type *t1r,const DBCF_Type *t1i,
+    const DBCF_Type *t2r,const DBCF_Type *t2i,
+    const DBCF_Type *t3r,const DBCF_Type *t3i,
+    int inverse)
+{
+    dbcf_index n=DBCF_POW2(log2n),q=n>>2;
+    dbcf_index c=DBCF_POW2(log2c);
+    dbcf_index o1=(inverse?3*q:q),o3=(inverse?q:3*q);
+    dbcf_index i,j;
+    for(i=0;i<c;++i)
+    {
+        DBCF_Type *R=real+i*n*real_stride,*I=imag+i*n*imag_stride;
+        for(j=0;j<b;++j)
+        {
+            dbcf_index jr=j*real_stride,ji=j*imag_stride;
+            DBCF_Type ar=R[jr],ai=I[ji];
+            DBCF_Type xr=R[jr+q*real_stride],xi=I[ji+q*imag_stride];
+            DBCF_Type br=t2r[j]*xr-t2i[j]*xi,bi=t2i[j]*xr+t2r[j]*xi;
+            DBCF_Type cr,ci,er,ei,s0r,s0i,d0r,d0i,s1r,s1i,d1r,d1i;
+            xr=R[jr+2*q*real_stride];xi=I[ji+2*q*imag_stride];
+            cr=t1r[j]*xr-t1i[j]*xi;ci=t1i[j]*xr+t1r[j]*xi;
+            xr=R[jr+3*q*real_stride];xi=I[ji+3*q*imag_stride];
+            er=t3r[j]*xr-t3i[j]*xi;ei=t3i[j]*xr+t3r[j]*xi;
+            s0r=ar+br;s0i=ai+bi;
+            d0r=ar-br;d0i=ai-bi;
+            s1r=cr+er;s1i=ci+ei;
+            d1r=cr-er;d1i=ci-ei;
+            R[jr]=s0r+s1r;I[ji]=s0i+s1i;
+            R[jr+2*q*real_stride]=s0r-s1r;I[ji+2*q*imag_stride]=s0i-s1i;
+            R[jr+o1*real_stride]=d0r+d1i;I[ji+o1*imag_stride]=d0i-d1r;
+            R[jr+o3*real_stride]=d0r-d1i;I[ji+o3*imag_stride]=d0i+d1r;
+        }
+    }
+}
+
+/*
+    Compute 2 butterfly passes (of sizes n/2 and n) at once over c blocks
+    of size n, as a radix-4 pass. The quarters are processed in chunks
+    of b elements, twiddles for which are prepared in tr, ti (5 chunks):
+    taken from the table if available, otherwise the twiddles of the
+    first chunk are computed, and those of the subsequent chunks are
+    obtained by multiplying them by w^j0, computed (like dbcF_compute_twiddles)
+    from (cos-1,sin) of power-of-2 angles.
+*/
+static void DBCF_NAME(dbcF_butterfly_pass4)(
+    dbcf_index log2n,
+    dbcf_index log2c,
+    DBCF_Type *real,DBCF_Type *imag,
+    dbcf_index real_stride,dbcf_index imag_stride,
+    int inverse,
+    DBCF_Type *tr,DBCF_Type *ti,
+    const DBCF_Type *table_real,const DBCF_Type *table_imag)
+{
+    dbcf_index n=DBCF_POW2(log2n),q=n>>2;
+    dbcf_index log2b=(log2n-2<DBCF_RADIX4_CHUNK_LOG2?log2n-2:DBCF_RADIX4_CHUNK_LOG2),b=DBCF_POW2(log2b);
+    DBCF_Type *ur=tr,*ui=ti;          /* w^i, 0<=i<b. */
+    DBCF_Type *vr=tr+b,*vi=ti+b;      /* w^(2i), 0<=i<b. */
+    DBCF_Type *w1r=tr+2*b,*w1i=ti+2*b;
+    DBCF_Type *w2r=tr+3*b,*w2i=ti+3*b;
+    DBCF_Type *w3r=tr+4*b,*w3i=ti+4*b;
+    DBCF_Type pr[8*sizeof(dbcf_index)],pi[8*sizeof(dbcf_index)];
+    dbcf_index i,j0;
+    if(!table_real)
+    {
+        DBCF_NAME(dbcF_compute_twiddles)(log2n,log2b,ur,ui,inverse);
+        DBCF_NAME(dbcF_compute_twiddles)(log2n-1,log2b,vr,vi,inverse);
+        /* pr[k], pi[k] hold w^(2^k)-1. */
+        for(i=log2b;i<=log2n-2;++i)
+        {
+            DBCF_NAME(dbcF_cexpm1)(log2n-i,pr+i,pi+i);
+            if(!inverse) pi[i]=-pi[i];
+        }
+    }
+    for(j0=0;j0<q;j0+=b)
+    {
+        const DBCF_Type *t1r,*t1i,*t2r,*t2i;
+        if(table_real)
+        {
+            t1r=table_real+n/2+j0;t1i=table_imag+n/2+j0;
+            t2r=table_real+n/4+j0;t2i=table_imag+n/4+j0;
+        }
+        else if(j0==0)
+        {
+            t1r=ur;t1i=ui;
+            t2r=vr;t2i=vi;
+        }
+        else
+        {
+            /* (x1,y1)=w^j0-1, (x2,y2)=w^(2*j0)-1. */
+            DBCF_Type x1=DBCF_ZERO,y1=DBCF_ZERO,x2=DBCF_ZERO,y2=DBCF_ZERO;
+            for(i=log2b;i<=log2n-2;++i)
+            {
+                if(j0&DBCF_POW2(i))
+                {
+                    DBCF_Type x=(pr[i]*x1-pi[i]*y1)+(pr[i]+x1);
+                    DBCF_Type y=(pi[i]*x1+pr[i]*y1)+(pi[i]+y1);
+                    x1=x;y1=y;
+                }
+                if(i>log2b&&(j0&DBCF_POW2(i-1)))
+                {
+                    DBCF_Type x=(pr[i]*x2-pi[i]*y2)+(pr[i]+x2);
+                    DBCF_Type y=(pi[i]*x2+pr[i]*y2)+(pi[i]+y2);
+                    x2=x;y2=y;
+                }
+            }
+            x1=DBCF_ONE+x1;
+            x2=DBCF_ONE+x2;
+            for(i=0;i<b;++i)
+            {
+                w1r[i]=x1*ur[i]-y1*ui[i];w1i[i]=y1*ur[i]+x1*ui[i];
+                w2r[i]=x2*vr[i]-y2*vi[i];w2i[i]=y2*vr[i]+x2*vi[i];
+            }
+            t1r=w1r;t1i=w1i;
+            t2r=w2r;t2i=w2i;
+        }
+        for(i=0;i<b;++i)
+        {
+            w3r[i]=t1r[i]*t2r[i]-t1i[i]*t2i[i];
+            w3i[i]=t1i[i]*t2r[i]+t1r[i]*t2i[i];
+        }
+#if defined(DBCF_radix4_block_optimized)
+        if(DBCF_radix4_block_optimized(log2n,log2c,b,real+j0*real_stride,imag+j0*imag_stride,real_stride,imag_stride,t1r,t1i,t2r,t2i,w3r,w3i,inverse))
+            continue;
+#endif
+        DBCF_PROFILE_ENTER(DBCF_PROFILE_SCALAR);
+        DBCF_NAME(dbcF_radix4_block)(log2n,log2c,b,real+j0*real_stride,imag+j0*imag_stride,real_stride,imag_stride,t1r,t1i,t2r,t2i,w3r,w3i,inverse);
+        DBCF_PROFILE_LEAVE(DBCF_PROFILE_SCALAR);
+    }
+}
+
+/*
+    Compute a series of butterfly passes from (log2n-depth+1,log2c+depth+1) to (log2n,log2c).
+    If table_real, table_imag are not NULL, they hold the twiddle table
+    (see dbcF_compute_twiddle_table), otherwise twiddles are computed into tr, ti.
+*/
+static void DBCF_NAME(dbcF_butterfly_multipass)(
+    dbcf_index log2n,
+    dbcf_index log2c,
+    dbcf_index depth,
+    DBCF_Type *real,DBCF_Type *imag,
+    dbcf_index real_stride,dbcf_index imag_stride,
+    int inverse,
+    DBCF_Type *tr,DBCF_Type *ti,
+    const DBCF_Type *table_real,const DBCF_Type *table_imag)
+{
+    while(depth>0)
+    {
+        dbcf_index log2d,log2t;
+#if defined(DBCF_butterfly_multipass_optimized)
+        dbcf_index d=DBCF_butterfly_multipass_optimized(
+            log2n,log2c,depth,
+            real,imag,
+            real_stride,imag_stride,
+            inverse,
+            tr,ti,
+            table_real,table_imag);
+        if(d>0) {depth-=d;continue;}
+#endif
+        if(depth==log2n&&depth>=3)
+        {
+            dbcf_index j,m=DBCF_POW2(log2n+log2c-3);
+            DBCF_NAME(dbcF_cexp)(3,tr,ti);
+            DBCF_PROFILE_ENTER(DBCF_PROFILE_SCALAR);
+            for(j=0;j<m;++j)
+                DBCF_NAME(dbcF_fft8)(real+8*real_stride*j,imag+8*imag_stride*j,real_stride,imag_stride,inverse,tr[0]);
+            DBCF_PROFILE_LEAVE(DBCF_PROFILE_SCALAR);
+            depth-=3;
+            continue;
+        }
+        log2d=log2n-depth+1;
+        if(depth>=2&&log2d>=1&&DBCF_RADIX4_CHUNK_LOG2>=0)
+        {
+            DBCF_NAME(dbcF_butterfly_pass4)(
+                log2d+1,
+                log2c+log2n-log2d-1,
+                real,imag,
+                real_stride,imag_stride,
+                inverse,
+                tr,ti,
+                table_real,table_imag);
+            depth-=2;
+            continue;
+        }
+        if(table_real)
+        {
+            DBCF_PROFILE_ENTER(DBCF_PROFILE_SCALAR);
+            DBCF_NAME(dbcF_butterfly_pass)(
+                log2d,
+                log2c+log2n-log2d,
+                real,imag,
+                real_stride,imag_stride,
+                inverse,
+                log2d-1,
+                table_real+DBCF_POW2(log2d-1),table_imag+DBCF_POW2(log2d-1));
+            DBCF_PROFILE_LEAVE(DBCF_PROFILE_SCALAR);
+            depth-=1;
+            continue;
+        }
+        log2t=(log2d-1<DBCF_TWIDDLES_BUF_LOG2?log2d-1:DBCF_TWIDDLES_BUF_LOG2);
+        DBCF_NAME(dbcF_compute_twiddles)(log2d,log2t,tr,ti,inverse);
+        DBCF_PROFILE_ENTER(DBCF_PROFILE_SCALAR);
+        DBCF_NAME(dbcF_butterfly_pass)(
+            log2d,
+            log2c+log2n-log2d,
+            real,imag,
+            real_stride,imag_stride,
+            inverse,
+            log2t,
+            tr,ti);
+        DBCF_PROFILE_LEAVE(DBCF_PROFILE_SCALAR);
+        depth-=1;
+    }
+}
+
+#ifdef DBC_FFT_THREADS
+typedef struct DBCF_NAME(dbcF_butterfly_args)
+{
+    dbcf_index log2n;
+    DBCF_Type *real,*imag;
+    dbcf_index real_stride,imag_stride;
+    int inverse;
+    const DBCF_Type *table_real,*table_imag;
+    DBCF_Type scale;
+    int threads;
+} DBCF_NAME(dbcF_butterfly_args);
+
+static void DBCF_NAME(dbcF_butterfly_task)(void *arg);
+#endif /* DBC_FFT_THREADS */
+
+/*
+    Larger inputs are done recursively on two halves. With threads>1
+    the first half is computed as a separate task.
+    The output is multiplied by scale. This is done at the end of the
+    (at most 2^12 elements) leaves, while they are still in cache, so
+    that it never takes a separate pass over memory; the outer passes
+    are linear, so the result is the same up to roundoff.
+*/
+static void DBCF_NAME(dbcF_butterfly)(
+    dbcf_index log2n,
+    DBCF_Type *real,DBCF_Type *imag,
+    dbcf_index real_stride,dbcf_index imag_stride,
+    int inverse,
+    const DBCF_Type *table_real,const DBCF_Type *table_imag,
+    DBCF_Type scale,
+    DBCF_Type *tmp,
+    int threads)
+{
+    DBCF_Type *tr=tmp;
+    DBCF_Type *ti=tmp+DBCF_TWIDDLES_BUF_SIZE;
+    if(log2n>12)
+    {
+#ifdef DBC_FFT_THREADS
+        if(threads>1&&log2n>=DBCF_THREADS_MIN_LOG2)
+        {
+            DBCF_NAME(dbcF_butterfly_args) args;
+            void *task;
+            args.log2n=log2n-1;
+            args.real=real;
+            args.imag=imag;
+            args.real_stride=real_stride;
+            args.imag_stride=imag_stride;
+            args.inverse=inverse;
+            args.table_real=table_real;
+            args.table_imag=table_imag;
+            args.scale=scale;
+            args.threads=threads/2;
+            task=dbcF_spawn(DBCF_NAME(dbcF_butterfly_task),&args);
+            DBCF_NAME(dbcF_butterfly)(
+                log2n-1,
+                real+DBCF_POW2(log2n-1)*real_stride,imag+DBCF_POW2(log2n-1)*imag_stride,
+                real_stride,imag_stride,
+                inverse,
+                table_real,table_imag,
+                scale,
+                tmp,
+                threads-threads/2);
+            dbcF_join(task);
+        }
+        else
+#endif /* DBC_FFT_THREADS */
+        {
+            DBCF_NAME(dbcF_butterfly)(
+                log2n-1,
+                real,imag,
+                real_stride,imag_stride,
+                inverse,
+                table_real,table_imag,
+                scale,
+                tmp,
+                1);
+            DBCF_NAME(dbcF_butterfly)(
+                log2n-1,
+                real+DBCF_POW2(log2n-1)*real_stride,imag+DBCF_POW2(log2n-1)*imag_stride,
+                real_stride,imag_stride,
+                inverse,
+                table_real,table_imag,
+                scale,
+                tmp,
+                1);
+        }
+        DBCF_NAME(dbcF_butterfly_multipass)(
+            log2n,0,1,
+            real,imag,
+            real_stride,imag_stride,
+            inverse,
+            tr,ti,
+            table_real,table_imag);
+    }
+    else
+    {
+        dbcf_index i,n=DBCF_POW2(log2n);
+        DBCF_NAME(dbcF_butterfly_multipass)(
+            log2n,0,log2n,
+            real,imag,
+            real_stride,imag_stride,
+            inverse,
+            tr,ti,
+            table_real,table_imag);
+        if(scale!=DBCF_ONE) for(i=0;i<n;++i)
+        {
+            real[i*real_stride]=real[i*real_stride]*scale;
+            imag[i*imag_stride]=imag[i*imag_stride]*scale;
+        }
+    }
+    (void)threads;
+}
+
+#ifdef DBC_FFT_THREADS
+static void DBCF_NAME(dbcF_butterfly_task)(void *arg)
+{
+    const DBCF_NAME(dbcF_butterfly_args) *args=(const DBCF_NAME(dbcF_butterfly_args)*)arg;
+#ifndef DBC_FFT_NO_SIMD
+    DBCF_ALIGNED(64) DBCF_Type tmp[DBCF_TMP_BUF_SIZE];
+#else
+    DBCF_Type tmp[DBCF_TMP_BUF_SIZE];
+#endif
+    DBCF_NAME(dbcF_butterfly)(
+        args->log2n,
+        args->real,args->imag,
+        args->real_stride,args->imag_stride,
+        args->inverse,
+        args->table_real,args->table_imag,
+        args->scale,
+        tmp,
+        args->threads);
+}
+#endif /* DBC_FFT_THREADS */
+
+/*
+    Power-of-2 case.
+    table_real, table_imag are either NULL, or the twiddle table
+    for num_elements and this direction (see dbcF_compute_twiddle_table).
+    threads is the number of threads to use (at most).
+    window is either NULL, or the factors src is multiplied by (applied
+    during the bit-reversal permutation), window_stride apart.
+*/
+static int DBCF_NAME(dbcF_fft_pot_windowed)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+    const DBCF_Type *window,dbcf_index window_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    int inverse,
+    const DBCF_Type *table_real,const DBCF_Type *table_imag,
+    int threads,
+    DBCF_Type scale)
+{
+#ifndef DBC_FFT_NO_SIMD
+    DBCF_ALIGNED(32) DBCF_Type dummy[2]={DBCF_ZERO,DBCF_ZERO};
+    DBCF_ALIGNED(64) DBCF_Type tmp[DBCF_TMP_BUF_SIZE];
+#else
+    DBCF_Type dummy[2]={DBCF_ZERO,DBCF_ZERO};
+    DBCF_Type tmp[DBCF_TMP_BUF_SIZE];
+#endif
+    dbcf_index n=num_elements;
+    dbcf_index log2n=(dbcf_index)-1;
+    while(n) {n>>=1;++log2n;}
+    if(!src_real) {src_real=dummy  ;src_real_stride=0;}
+    if(!src_imag) {src_imag=dummy+1;src_imag_stride=0;}
+    DBCF_NAME(dbcF_bitreversal_permutation)(log2n,src_real,src_real_stride,dst_real,dst_real_stride,window,window_stride,tmp,threads);
+    DBCF_NAME(dbcF_bitreversal_permutation)(log2n,src_imag,src_imag_stride,dst_imag,dst_imag_stride,window,window_stride,tmp,threads);
+    DBCF_NAME(dbcF_butterfly)(
+        log2n,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        inverse,
+        table_real,table_imag,
+        scale,
+        tmp,
+        threads);
+    return 0;
+}
+
+static int DBCF_NAME(dbcF_fft_pot)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    int inverse,
+    const DBCF_Type *table_real,const DBCF_Type *table_imag,
+    int threads,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_pot_windowed)(
+        num_elements,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        0,0,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        inverse,
+        table_real,table_imag,
+        threads,
+        scale);
+}
+
+/*
+    Decimation-in-frequency passes, the mirror image of the
+    decimation-in-time ones above: the radix-2 pass of size n=2^log2n
+    replaces (a,b) by (a+b,(a-b)*w^i), the radix-4 pass combines two of
+    them (sizes n and n/2), for each of the c consecutive blocks. The
+    twiddles come from the table (see dbcF_compute_twiddle_table), which
+    is required here; inverse only selects the sign of the trivial
+    twiddle of the radix-4 pass.
+*/
+static void DBCF_NAME(dbcF_dif_pass2)(
+    dbcf_index log2n,dbcf_index c,
+    DBCF_Type *real,DBCF_Type *imag,
+    const DBCF_Type *table_real,const DBCF_Type *table_imag)
+{
+    dbcf_index i,j,n=DBCF_POW2(log2n),h=n/2;
+    const DBCF_Type *wr=table_real+h,*wi=table_imag+h;
+    DBCF_PROFILE_ENTER(DBCF_PROFILE_SCALAR);
+    for(j=0;j<c;++j,real+=n,imag+=n)
+        for(i=0;i<h;++i)
+        {
+            DBCF_Type ar=real[i],ai=imag[i],br=real[i+h],bi=imag[i+h];
+            DBCF_Type dr=ar-br,di=ai-bi;
+            real[i]=ar+br;
+            imag[i]=ai+bi;
+            real[i+h]=dr*wr[i]-di*wi[i];
+            imag[i+h]=dr*wi[i]+di*wr[i];
+        }
+    DBCF_PROFILE_LEAVE(DBCF_PROFILE_SCALAR);
+}
+
+static void DBCF_NAME(dbcF_dif_pass4)(
+    dbcf_index log2n,dbcf_index c,
+    DBCF_Type *real,DBCF_Type *imag,
+    int inverse,
+    const DBCF_Type *table_real,const DBCF_Type *table_imag)
+{
+    dbcf_index i,j,n=DBCF_POW2(log2n),q=n/4;
+    const DBCF_Type *w1r=table_real+2*q,*w1i=table_imag+2*q;
+    const DBCF_Type *w2r=table_real+q,*w2i=table_imag+q;
+    DBCF_PROFILE_ENTER(DBCF_PROFILE_SCALAR);
+    for(j=0;j<c;++j,real+=n,imag+=n)
+        for(i=0;i<q;++i)
+        {
+            DBCF_Type a0r=real[i    ],a0i=imag[i    ];
+            DBCF_Type a1r=real[i+  q],a1i=imag[i+  q];
+            DBCF_Type a2r=real[i+2*q],a2i=imag[i+2*q];
+            DBCF_Type a3r=real[i+3*q],a3i=imag[i+3*q];
+            DBCF_Type b0r=a0r+a2r,b0i=a0i+a2i,b1r=a1r+a3r,b1i=a1i+a3i;
+            DBCF_Type d0r=a0r-a2r,d0i=a0i-a2i,d1r=a1r-a3r,d1i=a1i-a3i;
+            /* d1*(-i) for forward, d1*i for inverse. */
+            DBCF_Type er=(inverse?-d1i:d1i),ei=(inverse?d1r:-d1r);
+            DBCF_Type fr=b0r-b1r,fi=b0i-b1i;
+            DBCF_Type xr=d0r+er,xi=d0i+ei,yr=d0r-er,yi=d0i-ei;
+            DBCF_Type ur=xr*w1r[i]-xi*w1i[i],ui=xr*w1i[i]+xi*w1r[i];
+            DBCF_Type vr=yr*w1r[i]-yi*w1i[i],vi=yr*w1i[i]+yi*w1r[i];
+            real[i    ]=b0r+b1r;
+            imag[i    ]=b0i+b1i;
+            real[i+  q]=fr*w2r[i]-fi*w2i[i];
+            imag[i+  q]=fr*w2i[i]+fi*w2r[i];
+            real[i+2*q]=ur;
+            imag[i+2*q]=ui;
+            real[i+3*q]=vr*w2r[i]-vi*w2i[i];
+            imag[i+3*q]=vr*w2i[i]+vi*w2r[i];
+        }
+    DBCF_PROFILE_LEAVE(DBCF_PROFILE_SCALAR);
+}
+
+#ifdef DBC_FFT_THREADS
+typedef struct DBCF_NAME(dbcF_dif_args)
+{
+    dbcf_index log2n;
+    DBCF_Type *real,*imag;
+    int inverse;
+    const DBCF_Type *table_real,*table_imag;
+    int threads;
+} DBCF_NAME(dbcF_dif_args);
+
+static void DBCF_NAME(dbcF_dif_task)(void *arg);
+#endif /* DBC_FFT_THREADS */
+
+/*
+    In-place power-of-2 transform by decimation in frequency, which takes
+    the input in natural order and leaves the output in bit-reversed
+    order (dst[bitreverse(k)]=X[k]), so that no bit-reversal permutation
+    is done at all. The other half of the pair is dbcF_butterfly, which
+    takes bit-reversed input. Like dbcF_butterfly, this recurses down to
+    cache-resident leaves of (at most) 2^12 elements, but the outer passes
+    come first, and take 2 levels per pass over memory. With threads>1
+    the first two quarters are computed as a separate task.
+*/
+static void DBCF_NAME(dbcF_dif)(
+    dbcf_index log2n,
+    DBCF_Type *real,DBCF_Type *imag,
+    int inverse,
+    const DBCF_Type *table_real,const DBCF_Type *table_imag,
+    int threads)
+{
+    dbcf_index i,l;
+    if(log2n>13)
+    {
+        dbcf_index q=DBCF_POW2(log2n-2);
+        DBCF_NAME(dbcF_dif_pass4)(log2n,1,real,imag,inverse,table_real,table_imag);
+#ifdef DBC_FFT_THREADS
+        if(threads>1&&log2n>=DBCF_THREADS_MIN_LOG2)
+        {
+            DBCF_NAME(dbcF_dif_args) args;
+            void *task;
+            args.log2n=log2n-2;
+            args.real=real;
+            args.imag=imag;
+            args.inverse=inverse;
+            args.table_real=table_real;
+            args.table_imag=table_imag;
+            args.threads=threads/2;
+            task=dbcF_spawn(DBCF_NAME(dbcF_dif_task),&args);
+            for(i=2;i<4;++i)
+                DBCF_NAME(dbcF_dif)(log2n-2,real+i*q,imag+i*q,inverse,table_real,table_imag,threads-threads/2);
+            dbcF_join(task);
+            return;
+        }
+#endif /* DBC_FFT_THREADS */
+        for(i=0;i<4;++i)
+            DBCF_NAME(dbcF_dif)(log2n-2,real+i*q,imag+i*q,inverse,table_real,table_imag,1);
+        return;
+    }
+    if(log2n>12)
+    {
+        dbcf_index h=DBCF_POW2(log2n-1);
+        DBCF_NAME(dbcF_dif_pass2)(log2n,1,real,imag,table_real,table_imag);
+        DBCF_NAME(dbcF_dif)(log2n-1,real  ,imag  ,inverse,table_real,table_imag,1);
+        DBCF_NAME(dbcF_dif)(log2n-1,real+h,imag+h,inverse,table_real,table_imag,1);
+        return;
+    }
+    for(l=log2n;l>=2;l-=2)
+        DBCF_NAME(dbcF_dif_pass4)(l,DBCF_POW2(log2n-l),real,imag,inverse,table_real,table_imag);
+    if(l==1) DBCF_NAME(dbcF_dif_pass2)(1,DBCF_POW2(log2n-1),real,imag,table_real,table_imag);
+    (void)threads;
+}
+
+#ifdef DBC_FFT_THREADS
+static void DBCF_NAME(dbcF_dif_task)(void *arg)
+{
+    const DBCF_NAME(dbcF_dif_args) *args=(const DBCF_NAME(dbcF_dif_args)*)arg;
+    dbcf_index i,q=DBCF_POW2(args->log2n);
+    for(i=0;i<2;++i)
+        DBCF_NAME(dbcF_dif)(
+            args->log2n,
+            args->real+i*q,args->imag+i*q,
+            args->inverse,
+            args->table_real,args->table_imag,
+            args->threads);
+}
+#endif /* DBC_FFT_THREADS */
+
+/*
+    Whether the convolutions of size 2^log2m use dbcF_dif for the forward
+    transforms (with the spectra kept in bit-reversed order), and
+    dbcF_butterfly directly for the inverse one. Below 2^DBCF_DIF_MIN_LOG2
+    the permutations are cheap, and the SIMD leaves of dbcF_butterfly win.
+    This only depends on the size, so that the results do not depend on
+    the number of threads.
+*/
+static int DBCF_NAME(dbcF_use_dif)(dbcf_index log2m)
+{
+    return log2m>=DBCF_DIF_MIN_LOG2;
+}
+
+/*
+    Inverse transform of bit-reversed (as left by dbcF_dif) contiguous
+    input, in place, to natural order, multiplied by scale.
+*/
+static void DBCF_NAME(dbcF_dit)(
+    dbcf_index log2n,
+    DBCF_Type *real,DBCF_Type *imag,
+    int inverse,
+    const DBCF_Type *table_real,const DBCF_Type *table_imag,
+    int threads,
+    DBCF_Type scale)
+{
+#ifndef DBC_FFT_NO_SIMD
+    DBCF_ALIGNED(64) DBCF_Type tmp[DBCF_TMP_BUF_SIZE];
+#else
+    DBCF_Type tmp[DBCF_TMP_BUF_SIZE];
+#endif
+    DBCF_NAME(dbcF_butterfly)(
+        log2n,
+        real,imag,
+        1,1,
+        inverse,
+        table_real,table_imag,
+        scale,
+        tmp,
+        threads);
+}
+
+/*
+    Power-of-2 transform without the bit-reversal permutation (see
+    DBCF_PLAN_PERMUTED): the forward transform takes natural order,
+    and leaves dst in bit-reversed order (by dbcF_dif), the inverse one
+    takes bit-reversed order (by dbcF_butterfly alone), and leaves dst
+    in natural order. The table is required. src is copied to dst first
+    (multiplied by the window, and, for dbcF_dif, which has no scale, by
+    scale), unless there is nothing to do. dbcF_dif only handles
+    contiguous arrays, so the forward transform to strided dst is the
+    natural-order one followed by the permutation. So it is for sizes
+    from 2^9 to 2^13, which dbcF_dif does entirely in its (scalar)
+    leaves, while the permutation stays in cache, and the SIMD leaves
+    of dbcF_butterfly are faster.
+*/
+static int DBCF_NAME(dbcF_fft_permuted)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+    const DBCF_Type *window,dbcf_index window_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    int inverse,
+    const DBCF_Type *table_real,const DBCF_Type *table_imag,
+    int threads,
+    DBCF_Type scale)
+{
+#ifndef DBC_FFT_NO_SIMD
+    DBCF_ALIGNED(32) DBCF_Type dummy[2]={DBCF_ZERO,DBCF_ZERO};
+    DBCF_ALIGNED(64) DBCF_Type tmp[DBCF_TMP_BUF_SIZE];
+#else
+    DBCF_Type dummy[2]={DBCF_ZERO,DBCF_ZERO};
+    DBCF_Type tmp[DBCF_TMP_BUF_SIZE];
+#endif
+    dbcf_index i,n=num_elements;
+    dbcf_index log2n=(dbcf_index)-1;
+    while(n) {n>>=1;++log2n;}
+    if(!inverse&&(dst_real_stride!=1||dst_imag_stride!=1||(log2n>8&&log2n<14)))
+    {
+        DBCF_NAME(dbcF_fft_pot_windowed)(
+            num_elements,
+            src_real,src_imag,
+            src_real_stride,src_imag_stride,
+            window,window_stride,
+            dst_real,dst_imag,
+            dst_real_stride,dst_imag_stride,
+            0,
+            table_real,table_imag,
+            threads,
+            scale);
+        DBCF_NAME(dbcF_bitreversal_permutation)(log2n,dst_real,dst_real_stride,dst_real,dst_real_stride,0,0,tmp,threads);
+        DBCF_NAME(dbcF_bitreversal_permutation)(log2n,dst_imag,dst_imag_stride,dst_imag,dst_imag_stride,0,0,tmp,threads);
+        return 0;
+    }
+    if(!src_real) {src_real=dummy  ;src_real_stride=0;}
+    if(!src_imag) {src_imag=dummy+1;src_imag_stride=0;}
+    if(src_real!=dst_real||src_imag!=dst_imag||
+        src_real_stride!=dst_real_stride||src_imag_stride!=dst_imag_stride||
+        window||(!inverse&&scale!=DBCF_ONE))
+        for(i=0;i<num_elements;++i)
+        {
+            DBCF_Type x=src_real[i*src_real_stride],y=src_imag[i*src_imag_stride];
+            if(window)
+            {
+                x=x*window[i*window_stride];
+                y=y*window[i*window_stride];
+            }
+            if(!inverse)
+            {
+                x=x*scale;
+                y=y*scale;
+            }
+            dst_real[i*dst_real_stride]=x;
+            dst_imag[i*dst_imag_stride]=y;
+        }
+    if(!inverse)
+    {
+        DBCF_NAME(dbcF_dif)(log2n,dst_real,dst_imag,0,table_real,table_imag,threads);
+        return 0;
+    }
+    DBCF_NAME(dbcF_butterfly)(
+        log2n,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        1,
+        table_real,table_imag,
+        scale,
+        tmp,
+        threads);
+    return 0;
+}
+
+/*
+    Pointwise product a*=b of m complex values (the spectrum of a
+    circular convolution). Contiguous SoA arrays, so this loop is
+    vectorized by the compiler.
+*/
+static void DBCF_NAME(dbcF_pointwise_multiply)(
+    dbcf_index m,
+    const DBCF_Type *br,const DBCF_Type *bi,
+    DBCF_Type *ar,DBCF_Type *ai)
+{
+    dbcf_index i;
+    for(i=0;i<m;++i)
+    {
+        DBCF_Type c=br[i],s=bi[i],x=ar[i],y=ai[i];
+        ar[i]=c*x-s*y;
+        ai[i]=c*y+s*x;
+    }
+}
+
+#ifndef DBC_FFT_NO_NPOT
+/* Non-power-of-2 case. */
+
+static int DBCF_NAME(dbcF_fft_mixed)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+    const DBCF_Type *window,dbcf_index window_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    int inverse,
+    const DBCF_Type *table_real,const DBCF_Type *table_imag,
+    DBCF_Type *work_real,DBCF_Type *work_imag,
+    int threads,
+    DBCF_Type scale,
+    dbcF_workspace ws);
+
+/*
+    Inner FFT of Bluestein's algorithm, of size m, in place on ar, ai.
+    For power-of-2 m, tr, ti are either NULL, or the twiddle table for
+    this direction, and, if permuted is set, the forward transform is
+    dbcF_dif (which has no scale, and needs the table), and the inverse
+    one is dbcF_dit. Other sizes are computed by the mixed-radix
+    algorithm: tr, ti are either NULL, or the table for the power-of-2
+    part of m, and wr, wi (m elements each) are its work buffer.
+*/
+static void DBCF_NAME(dbcF_npot_fft)(
+    dbcf_index m,
+    DBCF_Type *ar,DBCF_Type *ai,
+    DBCF_Type *wr,DBCF_Type *wi,
+    int inverse,
+    const DBCF_Type *tr,const DBCF_Type *ti,
+    int permuted,
+    int threads,
+    DBCF_Type scale)
+{
+    if(m&(m-1))
+        (void)DBCF_NAME(dbcF_fft_mixed)(
+            m,
+            ar,ai,
+            1,1,
+            0,0,
+            ar,ai,
+            1,1,
+            inverse,
+            tr,ti,
+            wr,wi,
+            threads,
+            scale,
+            dbcF_heap);
+    else if(permuted)
+    {
+        dbcf_index log2m=0;
+        while(DBCF_POW2(log2m)<m) ++log2m;
+        if(inverse) DBCF_NAME(dbcF_dit)(log2m,ar,ai,1,tr,ti,threads,scale);
+        else DBCF_NAME(dbcF_dif)(log2m,ar,ai,0,tr,ti,threads);
+    }
+    else DBCF_NAME(dbcF_fft_pot)(m,ar,ai,1,1,ar,ai,1,1,inverse,tr,ti,threads,scale);
+}
+
+/*
+    Compute the part of Bluestein's algorithm, that only depends on the
+    size and direction: the chirp (cr, ci; n elements), and the FFT of the
+    kernel (br, bi; m elements). ar, ai (m elements each) are used as
+    temporary storage, and wr, wi are the work buffer of dbcF_npot_fft.
+    tfr, tfi are either NULL, or the forward twiddle table for the inner FFT.
+    If permuted is set, the FFT of the kernel is left in bit-reversed
+    order by dbcF_dif (which needs the table), and so is the first inner
+    FFT of dbcF_npot_forward; the product does not care about the order,
+    and the inverse FFT of dbcF_npot_finish takes it as it is. This skips
+    all bit-reversal permutations (see dbcF_use_dif).
+    dbcF_npot_chirp does everything except the FFT of the kernel.
+*/
+static void DBCF_NAME(dbcF_npot_chirp)(
+    dbcf_index n,
+    dbcf_index m,
+    int inverse,
+    DBCF_Type *cr,DBCF_Type *ci,
+    DBCF_Type *br,DBCF_Type *bi,
+    DBCF_Type *ar,DBCF_Type *ai)
+{
+    dbcf_index i,j;
+    /* Note: m>=2*n-1, so the two halves of the kernel do not overlap. */
+    DBCF_NAME(dbcF_compute_twiddles_npot)(2*n,ar,ai,inverse);
+    for(i=0,j=0;i<n;++i)
+    {
+        DBCF_Type c=ar[j],s=ai[j];
+        cr[i]=c;
+        ci[i]=s;
+        br[i]= c;
+        bi[i]=-s;
+        if(i>0)
+        {
+            br[m-i]= c;
+            bi[m-i]=-s;
+        }
+        j+=(2*i+1);
+        if(j>=2*n) j-=2*n;
+    }
+    for(i=n;i<=m-n;++i)
+    {
+        br[i]=DBCF_ZERO;
+        bi[i]=DBCF_ZERO;
+    }
+}
+
+static void DBCF_NAME(dbcF_npot_prepare)(
+    dbcf_index n,
+    dbcf_index m,
+    int inverse,
+    DBCF_Type *cr,DBCF_Type *ci,
+    DBCF_Type *br,DBCF_Type *bi,
+    DBCF_Type *ar,DBCF_Type *ai,
+    DBCF_Type *wr,DBCF_Type *wi,
+    const DBCF_Type *tfr,const DBCF_Type *tfi,
+    int permuted,
+    int threads)
+{
+    DBCF_NAME(dbcF_npot_chirp)(n,m,inverse,cr,ci,br,bi,ar,ai);
+    DBCF_NAME(dbcF_npot_fft)(m,br,bi,wr,wi,0,tfr,tfi,permuted,threads,DBCF_ONE);
+}
+
+/*
+    Compute the transform, using the data from dbcF_npot_prepare.
+    tfr, tfi, tir, tii are either NULL, or the forward and inverse
+    twiddle tables for the inner FFTs.
+    dbcF_npot_forward does the first inner FFT (which does not need
+    br, bi), and dbcF_npot_finish does the rest.
+    window is either NULL, or the factors src is multiplied by, and is
+    applied together with the chirp.
+*/
+static void DBCF_NAME(dbcF_npot_forward)(
+    dbcf_index n,
+    dbcf_index m,
+    const DBCF_Type *cr,const DBCF_Type *ci,
+    DBCF_Type *ar,DBCF_Type *ai,
+    DBCF_Type *wr,DBCF_Type *wi,
+    const DBCF_Type *tfr,const DBCF_Type *tfi,
+    int permuted,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+    const DBCF_Type *window,dbcf_index window_stride,
+    int threads)
+{
+    DBCF_Type dummy[2]={DBCF_ZERO,DBCF_ZERO};
+    /*
+        M has the same value as m, but different type. This avoids
+        dbcf_index->DBCF_Type cast, in case the custom type does
+        not provide it.
+    */
+    DBCF_Type M=DBCF_ZERO;
+    dbcf_index i;
+    for(i=1;2*i<=m;i*=2) {}
+    for(;i>0;i>>=1)
+    {
+        M=M+M;
+        if(m&i) M=M+DBCF_ONE;
+    }
+    if(!src_real) {src_real=dummy  ;src_real_stride=0;}
+    if(!src_imag) {src_imag=dummy+1;src_imag_stride=0;}
+    for(i=0;i<n;++i)
+    {
+        DBCF_Type c=cr[i],s=ci[i];
+        DBCF_Type x=src_real[i*src_real_stride],y=src_imag[i*src_imag_stride];
+        if(window)
+        {
+            DBCF_Type w=window[i*window_stride];
+            c=c*w;
+            s=s*w;
+        }
+        if(permuted)
+        {
+            c=c/M;
+            s=s/M;
+        }
+        ar[i]=x*c-y*s;
+        ai[i]=x*s+y*c;
+    }
+    for(i=n;i<m;++i)
+    {
+        ar[i]=DBCF_ZERO;
+        ai[i]=DBCF_ZERO;
+    }
+    /*
+        Note: the scale factors for FFTs are (1/M,1,scale), rather than, say,
+        (1,1,scale/M). This helps to keep intermediate results from
+        overflowing/underflowing, when the range is limited (fixed-point,
+        maybe half-floats). dbcF_dif has no scale, so it is applied
+        to the chirp above.
+    */
+    DBCF_NAME(dbcF_npot_fft)(m,ar,ai,wr,wi,0,tfr,tfi,permuted,threads,(permuted?DBCF_ONE:DBCF_ONE/M));
+}
+
+static void DBCF_NAME(dbcF_npot_finish)(
+    dbcf_index n,
+    dbcf_index m,
+    const DBCF_Type *cr,const DBCF_Type *ci,
+    const DBCF_Type *br,const DBCF_Type *bi,
+    DBCF_Type *ar,DBCF_Type *ai,
+    DBCF_Type *wr,DBCF_Type *wi,
+    const DBCF_Type *tir,const DBCF_Type *tii,
+    int permuted,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    int threads,
+    DBCF_Type scale)
+{
+    dbcf_index i;
+    DBCF_NAME(dbcF_pointwise_multiply)(m,br,bi,ar,ai);
+    DBCF_NAME(dbcF_npot_fft)(m,ar,ai,wr,wi,1,tir,tii,permuted,threads,scale);
+    for(i=0;i<n;++i)
+    {
+        DBCF_Type c=cr[i],s=ci[i],x=ar[i],y=ai[i];
+        dst_real[i*dst_real_stride]=c*x-s*y;
+        dst_imag[i*dst_imag_stride]=c*y+s*x;
+    }
+}
+
+static void DBCF_NAME(dbcF_npot_run)(
+    dbcf_index n,
+    dbcf_index m,
+    const DBCF_Type *cr,const DBCF_Type *ci,
+    const DBCF_Type *br,const DBCF_Type *bi,
+    DBCF_Type *ar,DBCF_Type *ai,
+    DBCF_Type *wr,DBCF_Type *wi,
+    const DBCF_Type *tfr,const DBCF_Type *tfi,
+    const DBCF_Type *tir,const DBCF_Type *tii,
+    int permuted,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+    const DBCF_Type *window,dbcf_index window_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    int threads,
+    DBCF_Type scale)
+{
+    DBCF_NAME(dbcF_npot_forward)(
+        n,m,
+        cr,ci,
+        ar,ai,
+        wr,wi,
+        tfr,tfi,
+        permuted,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        window,window_stride,
+        threads);
+    DBCF_NAME(dbcF_npot_finish)(
+        n,m,
+        cr,ci,
+        br,bi,
+        ar,ai,
+        wr,wi,
+        tir,tii,
+        permuted,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        threads,
+        scale);
+}
+
+#ifdef DBC_FFT_THREADS
+typedef struct DBCF_NAME(dbcF_npot_kernel_args)
+{
+    dbcf_index m;
+    DBCF_Type *br,*bi;
+    const DBCF_Type *tfr,*tfi;
+    int permuted;
+    int threads;
+} DBCF_NAME(dbcF_npot_kernel_args);
+
+static void DBCF_NAME(dbcF_npot_kernel_task)(void *arg)
+{
+    const DBCF_NAME(dbcF_npot_kernel_args) *args=(const DBCF_NAME(dbcF_npot_kernel_args)*)arg;
+    DBCF_NAME(dbcF_npot_fft)(args->m,args->br,args->bi,0,0,0,args->tfr,args->tfi,args->permuted,args->threads,DBCF_ONE);
+}
+#endif /* DBC_FFT_THREADS */
+
+/*
+    The buffers of dbcF_fft_npot and of the plans: 4 of m elements (ar, ai,
+    br, bi), 2 of n (the chirp), and 2 more of m for the table of dbcF_dif
+    (power-of-2 m of at least 2^DBCF_DIF_MIN_LOG2), or the work buffer of
+    the mixed-radix inner FFTs (other m), in elements.
+*/
+static dbcf_index DBCF_NAME(dbcF_npot_buffers)(dbcf_index n,dbcf_index m)
+{
+    return ((m&(m-1))||m>=DBCF_POW2(DBCF_DIF_MIN_LOG2)?6:4)*m+2*n;
+}
+
+static int DBCF_NAME(dbcF_fft_npot)(
+    dbcf_index n,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    int inverse,
+    DBCF_Type scale,
+    dbcF_workspace ws)
+{
+    unsigned char *buf,*mem=0;
+    DBCF_Type *ar,*ai,*br,*bi,*cr,*ci,*tr=0,*ti=0,*wr=0,*wi=0;
+    dbcf_index m=dbcF_npot_size(n),log2m=0;
+    int permuted;
+#ifdef DBCF_butterfly_multipass_optimized
+    dbcf_index alignment=64;
+#else
+    dbcf_index alignment=0;
+#endif
+    while(DBCF_POW2(log2m)<m) ++log2m;
+    permuted=!(m&(m-1))&&DBCF_NAME(dbcF_use_dif)(log2m);
+    /* dbcF_dif needs the forward twiddle table (and mixed-radix m the work buffer), which goes after the chirp. */
+    if(!(mem=(unsigned char*)dbcF_alloc(&ws,DBCF_NAME(dbcF_npot_buffers)(n,m)*(dbcf_index)sizeof(DBCF_Type)+alignment))) return DBCF_ERROR_OUT_OF_MEMORY;
+    buf=mem;
+    if(alignment)
+    {
+        dbcf_index offset=((dbcf_index)buf)&(alignment-1);
+        if(offset) buf+=alignment-offset;
+    }
+    ar=(DBCF_Type*)buf+0*m;
+    ai=(DBCF_Type*)buf+1*m;
+    br=(DBCF_Type*)buf+2*m;
+    bi=(DBCF_Type*)buf+3*m;
+    cr=(DBCF_Type*)buf+4*m+0*n;
+    ci=(DBCF_Type*)buf+4*m+1*n;
+    if(permuted)
+    {
+        tr=(DBCF_Type*)buf+4*m+2*n;
+        ti=(DBCF_Type*)buf+5*m+2*n;
+        DBCF_NAME(dbcF_compute_twiddle_table)(log2m,tr,ti,0);
+    }
+    else if(m&(m-1))
+    {
+        wr=(DBCF_Type*)buf+4*m+2*n;
+        wi=(DBCF_Type*)buf+5*m+2*n;
+    }
+#ifdef DBC_FFT_THREADS
+    if(DBCF_NUM_THREADS>1&&!(m&(m-1))&&log2m>=DBCF_THREADS_MIN_LOG2)
+    {
+        /*
+            The FFTs of the kernel and of the (chirped) input are independent
+            (only for power-of-2 m, whose FFTs need no work buffer).
+        */
+        DBCF_NAME(dbcF_npot_kernel_args) args;
+        void *task;
+        int threads=DBCF_NUM_THREADS;
+        DBCF_NAME(dbcF_npot_chirp)(n,m,inverse,cr,ci,br,bi,ar,ai);
+        args.m=m;
+        args.br=br;
+        args.bi=bi;
+        args.tfr=tr;
+        args.tfi=ti;
+        args.permuted=permuted;
+        args.threads=threads/2;
+        task=dbcF_spawn(DBCF_NAME(dbcF_npot_kernel_task),&args);
+        DBCF_NAME(dbcF_npot_forward)(
+            n,m,
+            cr,ci,
+            ar,ai,
+            0,0,
+            tr,ti,
+            permuted,
+            src_real,src_imag,
+            src_real_stride,src_imag_stride,
+            0,0,
+            threads-threads/2);
+        dbcF_join(task);
+        DBCF_NAME(dbcF_npot_finish)(
+            n,m,
+            cr,ci,
+            br,bi,
+            ar,ai,
+            0,0,
+            0,0,
+            permuted,
+            dst_real,dst_imag,
+            dst_real_stride,dst_imag_stride,
+            threads,
+            scale);
+        dbcF_release(&ws,mem);
+        return 0;
+    }
+#endif /* DBC_FFT_THREADS */
+    DBCF_NAME(dbcF_npot_prepare)(n,m,inverse,cr,ci,br,bi,ar,ai,wr,wi,tr,ti,permuted,DBCF_NUM_THREADS);
+    DBCF_NAME(dbcF_npot_run)(
+        n,m,
+        cr,ci,
+        br,bi,
+        ar,ai,
+        wr,wi,
+        tr,ti,
+        0,0,
+        permuted,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        0,0,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        DBCF_NUM_THREADS,
+        scale);
+    dbcF_release(&ws,mem);
+    return 0;
+}
+
+/*
+    Inner sizes chosen by DBCF_PLAN_MEASURE: n*16+s, where s is the odd
+    part of the inner size (see dbcF_npot_candidate), or 0 for an empty
+    slot; open addressing by n. Each entry is a single word, written once
+    (or, on a race, by several threads measuring the same n, which is
+    harmless, since every measured choice is valid), so no lock is needed.
+*/
+static dbcF_atomic_index DBCF_NAME(dbcF_npot_measured)[DBCF_MEASURE_CACHE_SIZE];
+
+/* Odd part of the cached inner size for n, or 0 if not cached. */
+static dbcf_index DBCF_NAME(dbcF_npot_lookup)(dbcf_index n)
+{
+    dbcf_index i,j=n%DBCF_MEASURE_CACHE_SIZE;
+    for(i=0;i<DBCF_MEASURE_CACHE_SIZE;++i)
+    {
+        dbcf_index e=DBCF_ATOMIC_LOAD(&DBCF_NAME(dbcF_npot_measured)[j]);
+        if(!e) return 0;
+        if(e/16==n) return e%16;
+        if(++j==DBCF_MEASURE_CACHE_SIZE) j=0;
+    }
+    return 0;
+}
+
+/* Caches the odd part s of the inner size for n, unless the cache is full. */
+static void DBCF_NAME(dbcF_npot_store)(dbcf_index n,dbcf_index s)
+{
+    dbcf_index i,j=n%DBCF_MEASURE_CACHE_SIZE;
+    if(n>(DBCF_POW2(8*sizeof(dbcf_index)-6)-1)) return;
+    for(i=0;i<DBCF_MEASURE_CACHE_SIZE;++i)
+    {
+        dbcf_index e=DBCF_ATOMIC_LOAD(&DBCF_NAME(dbcF_npot_measured)[j]);
+        if(!e||e/16==n)
+        {
+            DBCF_ATOMIC_STORE(&DBCF_NAME(dbcF_npot_measured)[j],n*16+s);
+            return;
+        }
+        if(++j==DBCF_MEASURE_CACHE_SIZE) j=0;
+    }
+}
+
+/*
+    Inner size of Bluestein's algorithm for n, chosen by timing (see
+    DBCF_PLAN_MEASURE): the inner FFTs (forward, then inverse) of each
+    candidate are run DBCF_MEASURE_TRIALS times, in turns, each time
+    on at least DBCF_MEASURE_ELEMENTS elements in total, and the best
+    time of each candidate counts. Ties (e.g. with a coarse clock) go
+    to dbcF_npot_size. The choice is cached, and taken from the cache
+    without timing next time. If out of memory, dbcF_npot_size is
+    returned (and not cached).
+*/
+static dbcf_index DBCF_NAME(dbcF_npot_measure)(dbcf_index n)
+{
+    dbcf_index sizes[DBCF_NPOT_MAX_ODD/2+1],odd[DBCF_NPOT_MAX_ODD/2+1];
+    double times[DBCF_NPOT_MAX_ODD/2+1];
+    dbcF_workspace ws=dbcF_heap;
+    DBCF_Type *buf;
+    dbcf_index s,i,m,max_m=0,model=dbcF_npot_size(n);
+    int trial,k,count=0,best=0;
+    if((s=DBCF_NAME(dbcF_npot_lookup)(n))) return dbcF_npot_candidate(n,s);
+    for(s=1;s<=DBCF_NPOT_MAX_ODD;s+=2)
+    {
+        if(!(m=dbcF_npot_candidate(n,s))) continue;
+        if(m==model) best=count;
+        if(m>max_m) max_m=m;
+        sizes[count]=m;
+        odd[count]=s;
+        ++count;
+    }
+    if(!(buf=(DBCF_Type*)dbcF_alloc(&ws,4*max_m*(dbcf_index)sizeof(DBCF_Type)))) return model;
+    for(i=0;i<2*max_m;++i) buf[i]=DBCF_ZERO;
+    for(trial=0;trial<DBCF_MEASURE_TRIALS;++trial)
+        for(k=0;k<count;++k)
+        {
+            dbcf_index reps=1+DBCF_MEASURE_ELEMENTS/sizes[k];
+            double t;
+            m=sizes[k];
+            t=dbcf_profile_clock();
+            for(i=0;i<reps;++i)
+            {
+                DBCF_NAME(dbcF_npot_fft)(m,buf,buf+m,buf+2*m,buf+3*m,0,0,0,0,DBCF_NUM_THREADS,DBCF_ONE);
+                DBCF_NAME(dbcF_npot_fft)(m,buf,buf+m,buf+2*m,buf+3*m,1,0,0,0,DBCF_NUM_THREADS,DBCF_ONE);
+            }
+            t=(dbcf_profile_clock()-t)/(double)reps;
+            if(trial==0||t<times[k]) times[k]=t;
+        }
+    dbcF_release(&ws,buf);
+    for(k=0;k<count;++k)
+        if(times[k]<times[best]) best=k;
+    DBCF_NAME(dbcF_npot_store)(n,odd[best]);
+    return sizes[best];
+}
+
+/*
+    Mixed-radix case (sizes n=2^a*p1*...*pk, with all pi<=DBCF_MAX_RADIX).
+    n is split (decimation in time) into odd prime factors, outermost first,
+    and the power-of-2 part, which is computed by dbcF_fft_pot. The prime
+    factor passes are then done iteratively, innermost first: a pass
+    of radix R computes n/(R*M) transforms of size R*M from R transforms
+    of size M each.
+*/
+
+/*
+    Scalar butterflies of a single radix R pass: for 0<=j<b, takes
+    x[q]=real[q*M+j]..., multiplies x[q] (q>0) by (cr,ci)[q-1]*(sr,si)[(q-1)*s_stride+j],
+    and writes DFT of size R of x to the same places.
+    (ur,ui) is the DFT matrix, in the form ur[t]=Re w^t, ui[t]=-Im w^t:
+    the terms x[q]+x[R-q] and x[q]-x[R-q] are only multiplied by the real
+    and imaginary parts respectively. r is either a constant (3, 5, 7),
+    or R (for other primes), maxr is an upper bound for it.
+*/
+#ifndef DBCF_DEF_RADIX_BLOCK
+#define DBCF_DEF_RADIX_BLOCK(name,r,maxr)\
+static void name(                                                                              \
+    dbcf_index R,                                                                              \
+    dbcf_index M,                                                                              \
+    dbcf_index b,                                                                              \
+    DBCF_Type *real,DBCF_Type *imag,                                                           \
+    dbcf_index real_stride,dbcf_index imag_stride,                                             \
+    const DBCF_Type *sr,const DBCF_Type *si,                                                   \
+    dbcf_index s_stride,                                                                       \
+    const DBCF_Type *cr,const DBCF_Type *ci,                                                   \
+    const DBCF_Type *ur,const DBCF_Type *ui)                                                   \
+{                                                                                              \
+    const dbcf_index radix=(r),L=radix>>1;                                                     \
+    dbcf_index j,k,q,t;                                                                        \
+    (void)R;                                                                                   \
+    for(j=0;j<b;++j)                                                                           \
+    {                                                                                          \
+        DBCF_Type xr[maxr],xi[maxr],yr,yi;                                                     \
+        DBCF_Type *pr=real+j*real_stride,*pi=imag+j*imag_stride;                               \
+        dbcf_index rs=M*real_stride,is=M*imag_stride;                                          \
+        xr[0]=pr[0];xi[0]=pi[0];                                                               \
+        for(q=1;q<radix;++q)                                                                   \
+        {                                                                                      \
+            DBCF_Type tr=sr[(q-1)*s_stride+j],ti=si[(q-1)*s_stride+j];                         \
+            DBCF_Type c=cr[q-1]*tr-ci[q-1]*ti,s=ci[q-1]*tr+cr[q-1]*ti;                         \
+            DBCF_Type x=pr[q*rs],y=pi[q*is];                                                   \
+            xr[q]=c*x-s*y;                                                                     \
+            xi[q]=s*x+c*y;                                                                     \
+        }                                                                                      \
+        yr=xr[0];yi=xi[0];                                                                     \
+        for(q=1;q<=L;++q)                                                                      \
+        {                                                                                      \
+            DBCF_Type ar=xr[q]+xr[radix-q],ai=xi[q]+xi[radix-q];                               \
+            DBCF_Type dr=xr[q]-xr[radix-q],di=xi[q]-xi[radix-q];                               \
+            xr[q]=ar;xi[q]=ai;                                                                 \
+            xr[radix-q]=dr;xi[radix-q]=di;                                                     \
+            yr=yr+ar;yi=yi+ai;                                                                 \
+        }                                                                                      \
+        for(k=1;k<=L;++k)                                                                      \
+        {                                                                                      \
+            DBCF_Type Ar=xr[0]+ur[k]*xr[1],Ai=xi[0]+ur[k]*xi[1];                               \
+            DBCF_Type Br=ui[k]*xr[radix-1],Bi=ui[k]*xi[radix-1];                               \
+            for(q=2,t=k+k;q<=L;++q,t+=k)                                                       \
+            {                                                                                  \
+                if(t>=radix) t-=radix;                                                         \
+                Ar=Ar+ur[t]*xr[q];Ai=Ai+ur[t]*xi[q];                                           \
+                Br=Br+ui[t]*xr[radix-q];Bi=Bi+ui[t]*xi[radix-q];                               \
+            }                                                                                  \
+            pr[k*rs]=Ar+Bi;pi[k*is]=Ai-Br;                                                     \
+            pr[(radix-k)*rs]=Ar-Bi;pi[(radix-k)*is]=Ai+Br;                                     \
+        }                                                                                      \
+        pr[0]=yr;pi[0]=yi;                                                                     \
+    }                                                                                          \
+}
+#endif /* DBCF_DEF_RADIX_BLOCK */
+
+DBCF_DEF_RADIX_BLOCK(DBCF_NAME(dbcF_radix3_block),3,3)
+DBCF_DEF_RADIX_BLOCK(DBCF_NAME(dbcF_radix5_block),5,5)
+DBCF_DEF_RADIX_BLOCK(DBCF_NAME(dbcF_radix7_block),7,7)
+DBCF_DEF_RADIX_BLOCK(DBCF_NAME(dbcF_radix_block) ,R,DBCF_MAX_RADIX)
+
+/* DFT matrix of size R for dbcF_radix_block: ur[t]=Re w^t, ui[t]=-Im w^t. */
+static void DBCF_NAME(dbcF_radix_constants)(dbcf_index R,int inverse,DBCF_Type *ur,DBCF_Type *ui)
+{
+    dbcf_index k;
+#ifndef DBCF_cexpm1_npot
+    /* cos(2*pi*k/R), sin(2*pi*k/R), 1<=k<=R/2, for R=3,5,7. */
+    static DBCF_Type table[][2]={
+        {-DBCF_LITERAL(5.0e-1)                                  ,DBCF_LITERAL(8.660254037844386467637231707529361834e-1)},
+        { DBCF_LITERAL(3.090169943749474241022934171828190588e-1),DBCF_LITERAL(9.510565162951535721164393333793821434e-1)},
+        {-DBCF_LITERAL(8.090169943749474241022934171828190588e-1),DBCF_LITERAL(5.877852522924731291687059546390727685e-1)},
+        { DBCF_LITERAL(6.234898018587335305250048840042398106e-1),DBCF_LITERAL(7.818314824680298087084445266740577502e-1)},
+        {-DBCF_LITERAL(2.225209339563144042889025644967947594e-1),DBCF_LITERAL(9.749279121818236070181316829939312172e-1)},
+        {-DBCF_LITERAL(9.009688679024191262361023195074450511e-1),DBCF_LITERAL(4.338837391175581204757683328483587546e-1)}
+    };
+    if(R==3||R==5||R==7)
+    {
+        dbcf_index offset=(R==3?0:(R==5?1:3));
+        for(k=1;k+k<R;++k)
+        {
+            DBCF_Type c=table[offset+k-1][0],s=table[offset+k-1][1];
+            ur[k]=c;
+            ur[R-k]=c;
+            ui[k]=(inverse?-s:s);
+            ui[R-k]=(inverse?s:-s);
+        }
+        return;
+    }
+#endif
+    for(k=1;k+k<R;++k)
+    {
+        DBCF_Type x,y;
+        DBCF_NAME(dbcF_cexpm1_root)(k,R,inverse,&x,&y);
+        ur[k]=DBCF_ONE+x;
+        ur[R-k]=ur[k];
+        ui[k]=-y;
+        ui[R-k]=y;
+    }
+}
+
+/*
+    Radix R pass: computes the transforms of size D=R*M of groups
+    [g*D,(g+1)*D) for 0<=g<groups, where the elements [g*D+q*M,g*D+(q+1)*M)
+    already contain the transform of size M of the q-th decimated
+    subsequence of the group.
+    k=k0+j (0<=j<B, B<=M) are processed at once, with the twiddles
+    w^(q*k)=w^(q*k0)*w^(q*j). Twiddles w^(q*j) are taken from the table of
+    w^e, 0<=e<(R-1)*(B-1)+1, w^(q*k0) are computed directly from
+    w^(2^i), as in dbcF_compute_twiddles.
+*/
+static void DBCF_NAME(dbcF_radix_pass)(
+    dbcf_index R,
+    dbcf_index M,
+    dbcf_index groups,
+    DBCF_Type *real,DBCF_Type *imag,
+    dbcf_index real_stride,dbcf_index imag_stride,
+    int inverse)
+{
+    DBCF_Type pr[8*sizeof(dbcf_index)],pi[8*sizeof(dbcf_index)];
+    DBCF_Type tr[DBCF_RADIX_BUF_SIZE],ti[DBCF_RADIX_BUF_SIZE];
+    DBCF_Type sr[DBCF_RADIX_BUF_SIZE],si[DBCF_RADIX_BUF_SIZE];
+    DBCF_Type ur[DBCF_MAX_RADIX],ui[DBCF_MAX_RADIX];
+    DBCF_Type cr[DBCF_MAX_RADIX],ci[DBCF_MAX_RADIX];
+    dbcf_index D=R*M,B=DBCF_RADIX_BUF_SIZE/(R-1),E,i,j,q,g,k0,log2e=0;
+    if(B>M) B=M;
+    E=(R-1)*(B-1)+1;
+    /* Only the powers needed for the exponents used. */
+    while(DBCF_POW2(log2e)<(B<M?D:E)) ++log2e;
+    for(i=0;i<log2e;++i)
+        DBCF_NAME(dbcF_cexpm1_root)(DBCF_POW2(i),D,inverse,pr+i,pi+i);
+    /* (w^e-1), 0<=e<E. */
+    tr[0]=DBCF_ZERO;
+    ti[0]=DBCF_ZERO;
+    for(i=0;DBCF_POW2(i)<E;++i)
+    {
+        dbcf_index h=DBCF_POW2(i);
+        DBCF_Type x=pr[i],y=pi[i];
+        for(j=0;j<h&&h+j<E;++j)
+        {
+            tr[h+j]=(x*tr[j]-y*ti[j])+(x+tr[j]);
+            ti[h+j]=(y*tr[j]+x*ti[j])+(y+ti[j]);
+        }
+    }
+    for(q=1;q<R;++q)
+        for(j=0;j<B;++j)
+        {
+            sr[(q-1)*B+j]=DBCF_ONE+tr[q*j];
+            si[(q-1)*B+j]=ti[q*j];
+        }
+    DBCF_NAME(dbcF_radix_constants)(R,inverse,ur,ui);
+    for(k0=0;k0<M;k0+=B)
+    {
+        dbcf_index b=(M-k0<B?M-k0:B);
+        for(q=1;q<R;++q)
+        {
+            dbcf_index e=(q*k0)%D;
+            DBCF_Type c=DBCF_ZERO,s=DBCF_ZERO;
+            for(i=0;e;++i,e>>=1)
+                if(e&1)
+                {
+                    DBCF_Type x=pr[i],y=pi[i],t=(x*c-y*s)+(x+c);
+                    s=(y*c+x*s)+(y+s);
+                    c=t;
+                }
+            cr[q-1]=DBCF_ONE+c;
+            ci[q-1]=s;
+        }
+        for(g=0;g<groups;++g)
+        {
+            DBCF_Type *xr=real+(g*D+k0)*real_stride,*xi=imag+(g*D+k0)*imag_stride;
+            dbcf_index done=0;
+#ifdef DBCF_radix_block_optimized
+            if(real_stride==1&&imag_stride==1)
+                done=DBCF_radix_block_optimized(R,M,b,xr,xi,sr,si,B,cr,ci,ur,ui);
+#endif
+            DBCF_PROFILE_ENTER(DBCF_PROFILE_SCALAR);
+            if(done<b) switch(R)
+            {
+                case 3:  DBCF_NAME(dbcF_radix3_block)(R,M,b-done,xr+done*real_stride,xi+done*imag_stride,real_stride,imag_stride,sr+done,si+done,B,cr,ci,ur,ui); break;
+                case 5:  DBCF_NAME(dbcF_radix5_block)(R,M,b-done,xr+done*real_stride,xi+done*imag_stride,real_stride,imag_stride,sr+done,si+done,B,cr,ci,ur,ui); break;
+                case 7:  DBCF_NAME(dbcF_radix7_block)(R,M,b-done,xr+done*real_stride,xi+done*imag_stride,real_stride,imag_stride,sr+done,si+done,B,cr,ci,ur,ui); break;
+                default: DBCF_NAME(dbcF_radix_block) (R,M,b-done,xr+done*real_stride,xi+done*imag_stride,real_stride,imag_stride,sr+done,si+done,B,cr,ci,ur,ui); break;
+            }
+            DBCF_PROFILE_LEAVE(DBCF_PROFILE_SCALAR);
+        }
+    }
+}
+
+/*
+    Power-of-2 transforms of size L of the decimated subsequences of src,
+    placed in dst in the order expected by the radix passes.
+    window is either NULL, or the factors src is multiplied by.
+*/
+static void DBCF_NAME(dbcF_mixed_leaves)(
+    dbcf_index n,
+    dbcf_index L,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+    const DBCF_Type *window,dbcf_index window_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    int inverse,
+    const DBCF_Type *table_real,const DBCF_Type *table_imag,
+    int threads)
+{
+    dbcf_index q,R,M;
+    if(n==L)
+    {
+        if(L==1)
+        {
+            dst_real[0]=src_real[0];
+            dst_imag[0]=src_imag[0];
+            if(window)
+            {
+                dst_real[0]=dst_real[0]*window[0];
+                dst_imag[0]=dst_imag[0]*window[0];
+            }
+        }
+        else DBCF_NAME(dbcF_fft_pot_windowed)(
+            L,
+            src_real,src_imag,
+            src_real_stride,src_imag_stride,
+            window,window_stride,
+            dst_real,dst_imag,
+            dst_real_stride,dst_imag_stride,
+            inverse,
+            table_real,table_imag,
+            threads,
+            DBCF_ONE);
+        return;
+    }
+    R=dbcF_radix(n);
+    M=n/R;
+    for(q=0;q<R;++q)
+        DBCF_NAME(dbcF_mixed_leaves)(
+            M,L,
+            src_real+q*src_real_stride,src_imag+q*src_imag_stride,
+            R*src_real_stride,R*src_imag_stride,
+            (window?window+q*window_stride:window),R*window_stride,
+            dst_real+q*M*dst_real_stride,dst_imag+q*M*dst_imag_stride,
+            dst_real_stride,dst_imag_stride,
+            inverse,
+            table_real,table_imag,
+            threads);
+}
+
+/*
+    table_real, table_imag are either NULL, or the twiddle table for the
+    power-of-2 part of num_elements and this direction. work_real, work_imag
+    are either NULL, or num_elements elements each, and are only used
+    (allocated from ws, if NULL) for in-place transforms.
+    window is either NULL, or the factors src is multiplied by (applied
+    by the leaves).
+*/
+static int DBCF_NAME(dbcF_fft_mixed)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+    const DBCF_Type *window,dbcf_index window_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    int inverse,
+    const DBCF_Type *table_real,const DBCF_Type *table_imag,
+    DBCF_Type *work_real,DBCF_Type *work_imag,
+    int threads,
+    DBCF_Type scale,
+    dbcF_workspace ws)
+{
+    DBCF_Type dummy[2]={DBCF_ZERO,DBCF_ZERO};
+    dbcf_index radices[8*sizeof(dbcf_index)];
+    dbcf_index n=num_elements,L=1,M,i,k=0;
+    DBCF_Type *mem=0,*xr=dst_real,*xi=dst_imag;
+    dbcf_index rs=dst_real_stride,is=dst_imag_stride;
+    while(!(n&1)) {n>>=1;L*=2;}
+    for(n=num_elements;n>L;n/=radices[k++]) radices[k]=dbcF_radix(n);
+    if(!src_real) {src_real=dummy  ;src_real_stride=0;}
+    if(!src_imag) {src_imag=dummy+1;src_imag_stride=0;}
+    if(src_real==dst_real||src_imag==dst_imag)
+    {
+        if(!work_real)
+        {
+            if(!(mem=(DBCF_Type*)dbcF_alloc(&ws,2*num_elements*(dbcf_index)sizeof(DBCF_Type)))) return DBCF_ERROR_OUT_OF_MEMORY;
+            work_real=mem;
+            work_imag=mem+num_elements;
+        }
+        xr=work_real;
+        xi=work_imag;
+        rs=is=1;
+    }
+    DBCF_NAME(dbcF_mixed_leaves)(
+        num_elements,L,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        window,window_stride,
+        xr,xi,
+        rs,is,
+        inverse,
+        table_real,table_imag,
+        threads);
+    for(M=L;k>0;M*=radices[k])
+    {
+        --k;
+        DBCF_NAME(dbcF_radix_pass)(radices[k],M,num_elements/(radices[k]*M),xr,xi,rs,is,inverse);
+    }
+    if(xr!=dst_real||scale!=DBCF_ONE)
+    {
+        for(i=0;i<num_elements;++i)
+        {
+            DBCF_Type x=xr[i*rs],y=xi[i*is];
+            if(scale!=DBCF_ONE) {x=x*scale;y=y*scale;}
+            dst_real[i*dst_real_stride]=x;
+            dst_imag[i*dst_imag_stride]=y;
+        }
+    }
+    if(mem) dbcF_release(&ws,mem);
+    return 0;
+}
+#endif /* DBC_FFT_NO_NPOT */
+
+/*
+    Strided destinations (other than interleaved) only get the scalar
+    butterflies. So with SIMD, transforms of DBCF_STAGE_MIN or more
+    elements are computed into a contiguous buffer instead, and then
+    scattered to dst in a single pass. This excludes Bluestein's algorithm
+    (whose last step writes dst once anyway), and, for batches, the sizes
+    computed one per SIMD lane (which are gathered into a tile already).
+*/
+static int DBCF_NAME(dbcF_staged)(dbcf_index n,int batch)
+{
+#ifdef DBCF_butterfly_multipass_optimized
+    if(n<DBCF_STAGE_MIN) return 0;
+    if(!(n&(n-1))) return !batch||2*n>DBCF_TMP_BUF_SIZE;
+#ifndef DBC_FFT_NO_NPOT
+    return dbcF_is_smooth(n);
+#else
+    return 0;
+#endif /* DBC_FFT_NO_NPOT */
+#else
+    (void)n;
+    (void)batch;
+    return 0;
+#endif /* DBCF_butterfly_multipass_optimized */
+}
+
+static int DBCF_NAME(dbcF_strided)(
+    const DBCF_Type *real,const DBCF_Type *imag,
+    dbcf_index real_stride,dbcf_index imag_stride)
+{
+    if(real_stride==1&&imag_stride==1) return 0;
+    return !(real_stride==2&&imag_stride==2&&imag==real+1);
+}
+
+/* Number of transforms of a batch staged at once. */
+static dbcf_index DBCF_NAME(dbcF_stage_block)(dbcf_index n)
+{
+    dbcf_index b=DBCF_STAGE_SIZE/n;
+    return (b<1?1:b>DBCF_ND_BLOCK?DBCF_ND_BLOCK:b);
+}
+
+static int DBCF_NAME(dbcF_check_arguments)(
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+    const DBCF_Type *dst_real,const DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride)
+{
+    if(src_real==dst_real&&src_real_stride!=dst_real_stride) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(src_imag==dst_imag&&src_imag_stride!=dst_imag_stride) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(src_imag==dst_real) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(src_real==dst_imag) return DBCF_ERROR_INVALID_ARGUMENT;
+    return 0;
+}
+
+static int DBCF_NAME(dbcF_fft)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    int inverse,
+    DBCF_Type scale,
+    dbcF_workspace ws)
+{
+    int ret;
+    (void)ws;
+    if(num_elements<1) return 0;
+    ret=DBCF_NAME(dbcF_check_arguments)(
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride);
+    if(ret) return ret;
+    if(DBCF_NAME(dbcF_staged)(num_elements,0)&&DBCF_NAME(dbcF_strided)(dst_real,dst_imag,dst_real_stride,dst_imag_stride))
+    {
+        DBCF_Type *mem=(DBCF_Type*)dbcF_alloc(&ws,2*num_elements*(dbcf_index)sizeof(DBCF_Type));
+        if(mem)
+        {
+            dbcf_index i;
+            ret=DBCF_NAME(dbcF_fft)(
+                num_elements,
+                src_real,src_imag,
+                src_real_stride,src_imag_stride,
+                mem,mem+num_elements,
+                1,1,
+                inverse,
+                scale,
+                ws);
+            DBCF_PROFILE_ENTER(DBCF_PROFILE_COPY);
+            for(i=0;i<num_elements;++i)
+            {
+                dst_real[i*dst_real_stride]=mem[i];
+                dst_imag[i*dst_imag_stride]=mem[num_elements+i];
+            }
+            DBCF_PROFILE_LEAVE(DBCF_PROFILE_COPY);
+            dbcF_release(&ws,mem);
+            return ret;
+        }
+    }
+#ifndef DBC_FFT_NO_NPOT
+    if((num_elements&(num_elements-1))&&dbcF_is_smooth(num_elements))
+        return DBCF_NAME(dbcF_fft_mixed)(
+            num_elements,
+            src_real,src_imag,
+            src_real_stride,src_imag_stride,
+            0,0,
+            dst_real,dst_imag,
+            dst_real_stride,dst_imag_stride,
+            inverse,
+            0,0,
+            0,0,
+            DBCF_NUM_THREADS,
+            scale,
+            ws);
+#endif /* DBC_FFT_NO_NPOT*/
+    if(num_elements&(num_elements-1))
+#ifndef DBC_FFT_NO_NPOT
+        return DBCF_NAME(dbcF_fft_npot)(
+            num_elements,
+            src_real,src_imag,
+            src_real_stride,src_imag_stride,
+            dst_real,dst_imag,
+            dst_real_stride,dst_imag_stride,
+            inverse,
+            scale,
+            ws);
+#else
+        return DBCF_ERROR_INVALID_ARGUMENT;
+#endif /* DBC_FFT_NO_NPOT*/
+    return DBCF_NAME(dbcF_fft_pot)(
+        num_elements,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        inverse,
+        0,0,
+        DBCF_NUM_THREADS,
+        scale);
+}
+
+/*
+    Real-input transforms.
+    A real sequence x of even length n=2*h is packed into the complex
+    sequence z[k]=x[2*k]+i*x[2*k+1] of length h, whose FFT Z is then
+    split into the spectrum of x:
+        X[k]=(Z[k]+conj(Z[h-k]))/2+w^k*(Z[k]-conj(Z[h-k]))/(2*i),
+    where w=exp(-2*pi*i/n). The inverse transform does the same steps in
+    reverse order. This needs a single complex FFT of length h, and
+    h additional complex multiplications.
+*/
+
+/*
+    Process the pair of bins (k, j=h-k) of the post- (pre- for inverse)
+    processing step, with (c,s)=w^k. src may be the same as dst.
+*/
+static void DBCF_NAME(dbcF_rfft_step)(
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    dbcf_index k,dbcf_index j,
+    DBCF_Type c,DBCF_Type s,
+    int inverse,
+    DBCF_Type half)
+{
+    DBCF_Type ar=src_real[k*src_real_stride],ai= src_imag[k*src_imag_stride];
+    DBCF_Type br=src_real[j*src_real_stride],bi=-src_imag[j*src_imag_stride];
+    DBCF_Type er,ei,pr,pi,qr,qi;
+    if(!inverse)
+    {
+        /* X[k]=E+w^k*O, X[j]=conj(E-w^k*O), with E=(A+B)/2, O=-i*(A-B)/2. */
+        er=(ar+br)*half;
+        ei=(ai+bi)*half;
+        pr=(ai-bi)*half;
+        pi=(br-ar)*half;
+        qr=c*pr-s*pi;
+        qi=c*pi+s*pr;
+        dst_real[k*dst_real_stride]=er+qr;
+        dst_imag[k*dst_imag_stride]=ei+qi;
+        dst_real[j*dst_real_stride]=er-qr;
+        dst_imag[j*dst_imag_stride]=qi-ei;
+    }
+    else
+    {
+        /* Z[k]=E+i*O, Z[j]=conj(E)+i*conj(O), with E=A+B, O=(A-B)*w^k. */
+        er=ar+br;
+        ei=ai+bi;
+        qr=ar-br;
+        qi=ai-bi;
+        pr=c*qr-s*qi;
+        pi=c*qi+s*qr;
+        dst_real[k*dst_real_stride]=er-pi;
+        dst_imag[k*dst_imag_stride]=ei+pr;
+        dst_real[j*dst_real_stride]=er+pi;
+        dst_imag[j*dst_imag_stride]=pr-ei;
+    }
+}
+
+/*
+    Process bins k0<=k<k0+b (b=2^log2b) for power-of-2 n, with
+    (C,S)=w^k0. Same recursive scheme as dbcF_butterfly_block.
+*/
+static void DBCF_NAME(dbcF_rfft_block)(
+    dbcf_index log2n,
+    dbcf_index log2b,
+    dbcf_index k0,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type C,DBCF_Type S,
+    int inverse,
+    DBCF_Type half,
+    const DBCF_Type *tr,const DBCF_Type *ti)
+{
+    dbcf_index b=DBCF_POW2(log2b),h=DBCF_POW2(log2n-1);
+    DBCF_Type X,Y;
+    if(log2b<=DBCF_TWIDDLES_BUF_LOG2)
+    {
+        dbcf_index i;
+        for(i=(k0==0?1:0);i<b;++i)
+            DBCF_NAME(dbcF_rfft_step)(
+                src_real,src_imag,
+                src_real_stride,src_imag_stride,
+                dst_real,dst_imag,
+                dst_real_stride,dst_imag_stride,
+                k0+i,h-(k0+i),
+                C*tr[i]-S*ti[i],S*tr[i]+C*ti[i],
+                inverse,half);
+    }
+    else
+    {
+        DBCF_NAME(dbcF_cexp)(log2n-log2b+1,&X,&Y);
+        if(!inverse) Y=-Y;
+        DBCF_NAME(dbcF_rfft_block)(log2n,log2b-1,k0,
+            src_real,src_imag,src_real_stride,src_imag_stride,
+            dst_real,dst_imag,dst_real_stride,dst_imag_stride,
+            C,S,inverse,half,tr,ti);
+        DBCF_NAME(dbcF_rfft_block)(log2n,log2b-1,k0+(b>>1),
+            src_real,src_imag,src_real_stride,src_imag_stride,
+            dst_real,dst_imag,dst_real_stride,dst_imag_stride,
+            C*X-S*Y,S*X+C*Y,inverse,half,tr,ti);
+    }
+}
+
+/*
+    Post- (pre- for inverse) processing step for even n: the bins
+    0<k<h-k, plus the middle bin k=h/2 (if h is even); bins 0 and h
+    are handled by the caller.
+*/
+static int DBCF_NAME(dbcF_rfft_split)(
+    dbcf_index n,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    int inverse,
+    dbcF_workspace ws)
+{
+    dbcf_index h=n>>1;
+    DBCF_Type half=(inverse?DBCF_ONE:DBCF_ONE/(DBCF_ONE+DBCF_ONE));
+    (void)ws;
+    if(!(h&1))
+    {
+        /* X[h/2]=conj(Z[h/2]), Z[h/2]=2*conj(X[h/2]). */
+        dbcf_index k=h>>1;
+        DBCF_Type x=src_real[k*src_real_stride],y=src_imag[k*src_imag_stride];
+        if(inverse) {x=x+x;y=y+y;}
+        dst_real[k*dst_real_stride]= x;
+        dst_imag[k*dst_imag_stride]=-y;
+    }
+    if(!(n&(n-1)))
+    {
+        DBCF_Type tmp[DBCF_TMP_BUF_SIZE];
+        DBCF_Type *tr=tmp,*ti=tmp+DBCF_TWIDDLES_BUF_SIZE;
+        dbcf_index log2n=(dbcf_index)-1,m=n;
+        if(n<8) return 0;
+        while(m) {m>>=1;++log2n;}
+        DBCF_NAME(dbcF_compute_twiddles)(log2n,(log2n-2<DBCF_TWIDDLES_BUF_LOG2?log2n-2:DBCF_TWIDDLES_BUF_LOG2),tr,ti,inverse);
+        DBCF_NAME(dbcF_rfft_block)(log2n,log2n-2,0,
+            src_real,src_imag,src_real_stride,src_imag_stride,
+            dst_real,dst_imag,dst_real_stride,dst_imag_stride,
+            DBCF_ONE,DBCF_ZERO,inverse,half,tr,ti);
+        return 0;
+    }
+#ifndef DBC_FFT_NO_NPOT
+    {
+        dbcf_index k;
+        DBCF_Type *wr,*wi;
+        if(!(wr=(DBCF_Type*)dbcF_alloc(&ws,2*n*(dbcf_index)sizeof(DBCF_Type)))) return DBCF_ERROR_OUT_OF_MEMORY;
+        wi=wr+n;
+        DBCF_NAME(dbcF_compute_twiddles_npot)(n,wr,wi,inverse);
+        for(k=1;2*k<h;++k)
+            DBCF_NAME(dbcF_rfft_step)(
+                src_real,src_imag,
+                src_real_stride,src_imag_stride,
+                dst_real,dst_imag,
+                dst_real_stride,dst_imag_stride,
+                k,h-k,
+                wr[k],wi[k],
+                inverse,half);
+        dbcF_release(&ws,wr);
+    }
+#endif /* DBC_FFT_NO_NPOT */
+    return 0;
+}
+
+static int DBCF_NAME(dbcF_rfft)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+    dbcf_index src_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale,
+    dbcF_workspace ws)
+{
+    dbcf_index n=num_elements,h=n>>1;
+    DBCF_Type zr,zi;
+    int ret;
+    if(n<1) return 0;
+    if(n&1)
+    {
+        /* Odd sizes: full complex transform (mixed-radix or Bluestein's algorithm). */
+        dbcf_index k;
+        DBCF_Type *tr,*ti;
+        if(n==1)
+        {
+            dst_real[0]=(src?src[0]*scale:DBCF_ZERO);
+            dst_imag[0]=DBCF_ZERO;
+            return 0;
+        }
+        if(!(tr=(DBCF_Type*)dbcF_alloc(&ws,2*n*(dbcf_index)sizeof(DBCF_Type)))) return DBCF_ERROR_OUT_OF_MEMORY;
+        ti=tr+n;
+        ret=DBCF_NAME(dbcF_fft)(n,src,0,src_stride,0,tr,ti,1,1,0,scale,ws);
+        if(!ret)
+        {
+            for(k=0;k<=h;++k)
+            {
+                dst_real[k*dst_real_stride]=tr[k];
+                dst_imag[k*dst_imag_stride]=ti[k];
+            }
+        }
+        dbcF_release(&ws,tr);
+        return ret;
+    }
+    ret=DBCF_NAME(dbcF_fft)(h,
+        src,(src?src+src_stride:src),
+        2*src_stride,2*src_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        0,
+        scale,
+        ws);
+    if(ret) return ret;
+    zr=dst_real[0];
+    zi=dst_imag[0];
+    dst_real[0]=zr+zi;
+    dst_imag[0]=DBCF_ZERO;
+    dst_real[h*dst_real_stride]=zr-zi;
+    dst_imag[h*dst_imag_stride]=DBCF_ZERO;
+    return DBCF_NAME(dbcF_rfft_split)(n,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        0,
+        ws);
+}
+
+static int DBCF_NAME(dbcF_irfft)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,
+    DBCF_Type scale,
+    dbcF_workspace ws)
+{
+    DBCF_Type dummy[2]={DBCF_ZERO,DBCF_ZERO};
+    dbcf_index n=num_elements,h=n>>1;
+    DBCF_Type *zr=dst,*zi=dst+dst_stride,xr,yr;
+    int ret;
+    if(n<1) return 0;
+    if(!src_real) {src_real=dummy  ;src_real_stride=0;}
+    if(!src_imag) {src_imag=dummy+1;src_imag_stride=0;}
+    if(n&1)
+    {
+        /* Odd sizes: unpack to the full spectrum, and transform it as complex. */
+        dbcf_index k;
+        DBCF_Type *tr,*ti;
+        if(n==1)
+        {
+            dst[0]=src_real[0]*scale;
+            return 0;
+        }
+        if(!(tr=(DBCF_Type*)dbcF_alloc(&ws,3*n*(dbcf_index)sizeof(DBCF_Type)))) return DBCF_ERROR_OUT_OF_MEMORY;
+        ti=tr+n;
+        tr[0]=src_real[0];
+        ti[0]=DBCF_ZERO;
+        for(k=1;k<=h;++k)
+        {
+            tr[k]=src_real[k*src_real_stride];
+            ti[k]=src_imag[k*src_imag_stride];
+            tr[n-k]= tr[k];
+            ti[n-k]=-ti[k];
+        }
+        ret=DBCF_NAME(dbcF_fft)(n,tr,ti,1,1,dst,ti+n,dst_stride,1,1,scale,ws);
+        dbcF_release(&ws,tr);
+        return ret;
+    }
+    ret=DBCF_NAME(dbcF_check_arguments)(
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        zr,zi,
+        2*dst_stride,2*dst_stride);
+    if(ret) return ret;
+    /* Imaginary parts of X[0] and X[h] are ignored (they are 0 for the spectrum of a real sequence). */
+    xr=src_real[0];
+    yr=src_real[h*src_real_stride];
+    zr[0]=xr+yr;
+    zi[0]=xr-yr;
+    ret=DBCF_NAME(dbcF_rfft_split)(n,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        zr,zi,
+        2*dst_stride,2*dst_stride,
+        1,
+        ws);
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft)(h,
+        zr,zi,
+        2*dst_stride,2*dst_stride,
+        zr,zi,
+        2*dst_stride,2*dst_stride,
+        1,
+        scale,
+        ws);
+}
+
+/* Workspace bytes dbcF_fft needs (for any placement). */
+static dbcf_index DBCF_NAME(dbcF_fft_workspace)(dbcf_index n)
+{
+    if(n<1) return 0;
+    if(!(n&(n-1))) return (DBCF_NAME(dbcF_staged)(n,0)?DBCF_WORKSPACE_CHUNK(2*n*(dbcf_index)sizeof(DBCF_Type)):0);
+#ifndef DBC_FFT_NO_NPOT
+    if(dbcF_is_smooth(n)) return DBCF_WORKSPACE_CHUNK(2*n*(dbcf_index)sizeof(DBCF_Type));
+    /* Room for the table of dbcF_dif, whatever the number of threads. */
+    return DBCF_WORKSPACE_CHUNK(DBCF_NAME(dbcF_npot_buffers)(n,dbcF_npot_size(n))*(dbcf_index)sizeof(DBCF_Type)+64);
+#else
+    return 0;
+#endif /* DBC_FFT_NO_NPOT */
+}
+
+/* Workspace bytes dbcF_rfft and dbcF_irfft need. */
+static dbcf_index DBCF_NAME(dbcF_rfft_workspace)(dbcf_index n)
+{
+    dbcf_index inner,split;
+    if(n<2) return 0;
+    if(n&1) return DBCF_WORKSPACE_CHUNK(3*n*(dbcf_index)sizeof(DBCF_Type))+DBCF_NAME(dbcF_fft_workspace)(n);
+    inner=DBCF_NAME(dbcF_fft_workspace)(n>>1);
+    split=((n&(n-1))?DBCF_WORKSPACE_CHUNK(2*n*(dbcf_index)sizeof(DBCF_Type)):0);
+    return (inner>split?inner:split);
+}
+
+/* Plans. */
+static const char DBCF_NAME(dbcF_type_tag)=0;
+
+/*
+    The arrays a DBCF_PLAN_ALIGNED plan is executed on: an interleaved
+    pair (imag==real+1) only needs real to be aligned, NULL src is zeros.
+*/
+static int DBCF_NAME(dbcF_plan_aligned)(const DBCF_Type *real,const DBCF_Type *imag)
+{
+    if(real&&!DBCF_IS_ALIGNED(real,DBCF_ALIGNMENT)) return 0;
+    return !imag||(real&&imag==real+1)||DBCF_IS_ALIGNED(imag,DBCF_ALIGNMENT);
+}
+
+static int DBCF_NAME(dbcF_execute)(
+    dbcf_plan *plan,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale)
+{
+    const DBCF_Type *window;
+    dbcf_index n;
+    int ret;
+    if(!plan||plan->type_tag!=(const void*)&DBCF_NAME(dbcF_type_tag)) return DBCF_ERROR_INVALID_ARGUMENT;
+    window=(const DBCF_Type*)plan->window;
+    n=plan->num_elements;
+    if(n<1) return 0;
+    ret=DBCF_NAME(dbcF_check_arguments)(
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride);
+    if(ret) return ret;
+    if((plan->flags&DBCF_PLAN_ALIGNED)&&!(DBCF_NAME(dbcF_plan_aligned)(src_real,src_imag)&&DBCF_NAME(dbcF_plan_aligned)(dst_real,dst_imag)))
+        return DBCF_ERROR_INVALID_ARGUMENT;
+    if(plan->flags&DBCF_PLAN_PERMUTED)
+        return DBCF_NAME(dbcF_fft_permuted)(
+            n,
+            src_real,src_imag,
+            src_real_stride,src_imag_stride,
+            window,1,
+            dst_real,dst_imag,
+            dst_real_stride,dst_imag_stride,
+            plan->flags&DBCF_PLAN_INVERSE,
+            (const DBCF_Type*)plan->table_real[plan->flags&DBCF_PLAN_INVERSE],
+            (const DBCF_Type*)plan->table_imag[plan->flags&DBCF_PLAN_INVERSE],
+            DBCF_NUM_THREADS,
+            scale);
+#ifndef DBC_FFT_NO_NPOT
+    if((n&(n-1))&&dbcF_is_smooth(n))
+        return DBCF_NAME(dbcF_fft_mixed)(
+            n,
+            src_real,src_imag,
+            src_real_stride,src_imag_stride,
+            window,1,
+            dst_real,dst_imag,
+            dst_real_stride,dst_imag_stride,
+            plan->flags&DBCF_PLAN_INVERSE,
+            (const DBCF_Type*)plan->table_real[plan->flags&DBCF_PLAN_INVERSE],
+            (const DBCF_Type*)plan->table_imag[plan->flags&DBCF_PLAN_INVERSE],
+            (DBCF_Type*)plan->work_real,(DBCF_Type*)plan->work_imag,
+            DBCF_NUM_THREADS,
+            scale,
+            dbcF_heap);
+    if(n&(n-1))
+    {
+        DBCF_NAME(dbcF_npot_run)(
+            n,plan->inner,
+            (const DBCF_Type*)plan->chirp_real ,(const DBCF_Type*)plan->chirp_imag,
+            (const DBCF_Type*)plan->kernel_real,(const DBCF_Type*)plan->kernel_imag,
+            (DBCF_Type*)plan->work_real,(DBCF_Type*)plan->work_imag,
+            (DBCF_Type*)plan->scratch_real,(DBCF_Type*)plan->scratch_imag,
+            (const DBCF_Type*)plan->table_real[0],(const DBCF_Type*)plan->table_imag[0],
+            (const DBCF_Type*)plan->table_real[1],(const DBCF_Type*)plan->table_imag[1],
+            plan->permuted,
+            src_real,src_imag,
+            src_real_stride,src_imag_stride,
+            window,1,
+            dst_real,dst_imag,
+            dst_real_stride,dst_imag_stride,
+            DBCF_NUM_THREADS,
+            scale);
+        return 0;
+    }
+#endif /* DBC_FFT_NO_NPOT */
+    return DBCF_NAME(dbcF_fft_pot_windowed)(
+        n,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        window,1,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        plan->flags&DBCF_PLAN_INVERSE,
+        (const DBCF_Type*)plan->table_real[plan->flags&DBCF_PLAN_INVERSE],
+        (const DBCF_Type*)plan->table_imag[plan->flags&DBCF_PLAN_INVERSE],
+        DBCF_NUM_THREADS,
+        scale);
+}
+
+#ifndef DBC_FFT_NO_NPOT
+static dbcf_index DBCF_NAME(dbcF_npot_measure)(dbcf_index n);
+#endif /* DBC_FFT_NO_NPOT */
+
+/*
+    Inner size of Bluestein's algorithm for the plan (0 for the other
+    algorithms, and for the flags dbcF_plan_size rejects): measured (or
+    taken from the cache) with DBCF_PLAN_MEASURE, otherwise dbcF_npot_size.
+    The plan is sized and set up for it by dbcF_plan_size and dbcF_plan_init.
+*/
+static dbcf_index DBCF_NAME(dbcF_plan_inner)(
+    dbcf_index num_elements,
+    int flags)
+{
+#ifndef DBC_FFT_NO_NPOT
+    if(num_elements<1||!(num_elements&(num_elements-1))||dbcF_is_smooth(num_elements)) return 0;
+    if(flags&(DBCF_PLAN_PERMUTED|~DBCF_PLAN_KNOWN_FLAGS)) return 0;
+    if(flags&DBCF_PLAN_MEASURE) return DBCF_NAME(dbcF_npot_measure)(num_elements);
+    return dbcF_npot_size(num_elements);
+#else
+    (void)num_elements;
+    (void)flags;
+    return 0;
+#endif /* DBC_FFT_NO_NPOT */
+}
+
+/* Size of the plan, in bytes, or -1 if the arguments are invalid. */
+static dbcf_index DBCF_NAME(dbcF_plan_size)(
+    dbcf_index num_elements,
+    int flags,
+    dbcf_index inner)
+{
+    dbcf_index size=0;
+    if(num_elements<0) return -1;
+    if(flags&~(DBCF_PLAN_KNOWN_FLAGS)) return -1;
+    if(num_elements&(num_elements-1))
+    {
+        if(flags&DBCF_PLAN_PERMUTED) return -1;
+#ifndef DBC_FFT_NO_NPOT
+        if(dbcF_is_smooth(num_elements))
+        {
+            /* Work buffer, and the twiddle table for the power-of-2 part. */
+            size=2*num_elements;
+            if(flags&DBCF_PLAN_TWIDDLE_TABLE) size+=2*(num_elements&(0-num_elements));
+        }
+        else if(inner&(inner-1))
+        {
+            /* The work buffer of the inner FFTs, and the tables for their power-of-2 part. */
+            size=6*inner+2*num_elements;
+            if(flags&DBCF_PLAN_TWIDDLE_TABLE) size+=4*(inner&(0-inner));
+        }
+        else
+        {
+            size=4*inner+2*num_elements;
+            /* Both directions are needed for the inner FFTs. */
+            if(flags&DBCF_PLAN_TWIDDLE_TABLE) size+=4*inner;
+            /* dbcF_dif needs the forward one in any case. */
+            else if(inner>=DBCF_POW2(DBCF_DIF_MIN_LOG2)) size+=2*inner;
+        }
+#else
+        (void)inner;
+        return -1;
+#endif /* DBC_FFT_NO_NPOT */
+    }
+    else if(flags&(DBCF_PLAN_TWIDDLE_TABLE|DBCF_PLAN_PERMUTED)) size=2*num_elements;
+    return (dbcf_index)sizeof(dbcf_plan)+DBCF_PLAN_ALIGNMENT+size*(dbcf_index)sizeof(DBCF_Type);
+}
+
+/* Set up the plan in mem, which has room for dbcF_plan_size bytes. */
+static dbcf_plan *DBCF_NAME(dbcF_plan_init)(
+    void *mem,
+    dbcf_index num_elements,
+    int flags,
+    dbcf_index inner)
+{
+    dbcf_plan *plan=(dbcf_plan*)mem;
+    unsigned char *buf;
+    dbcf_index offset;
+    int inverse=flags&DBCF_PLAN_INVERSE;
+    plan->type_tag=(const void*)&DBCF_NAME(dbcF_type_tag);
+    plan->num_elements=num_elements;
+    plan->flags=flags;
+    plan->inner=inner;
+    plan->permuted=0;
+    plan->chirp_real  =plan->chirp_imag  =0;
+    plan->kernel_real =plan->kernel_imag =0;
+    plan->work_real   =plan->work_imag   =0;
+    plan->scratch_real=plan->scratch_imag=0;
+    plan->table_real[0]=plan->table_imag[0]=0;
+    plan->table_real[1]=plan->table_imag[1]=0;
+    plan->window=0;
+    buf=(unsigned char*)(plan+1);
+    offset=((dbcf_index)buf)&(DBCF_PLAN_ALIGNMENT-1);
+    if(offset) buf+=DBCF_PLAN_ALIGNMENT-offset;
+#ifndef DBC_FFT_NO_NPOT
+    if((num_elements&(num_elements-1))&&dbcF_is_smooth(num_elements))
+    {
+        DBCF_Type *b=(DBCF_Type*)buf;
+        dbcf_index L=1,log2l=0;
+        while(!(num_elements&L)) {L*=2;++log2l;}
+        plan->work_real=b;
+        plan->work_imag=b+num_elements;
+        if((flags&DBCF_PLAN_TWIDDLE_TABLE)&&L>1)
+        {
+            plan->table_real[inverse]=b+2*num_elements;
+            plan->table_imag[inverse]=b+2*num_elements+L;
+            DBCF_NAME(dbcF_compute_twiddle_table)(log2l,b+2*num_elements,b+2*num_elements+L,inverse);
+        }
+        return plan;
+    }
+    if(num_elements&(num_elements-1))
+    {
+        dbcf_index m=inner,log2m=0;
+        DBCF_Type *b=(DBCF_Type*)buf;
+        plan->work_real  =b+0*m;
+        plan->work_imag  =b+1*m;
+        plan->kernel_real=b+2*m;
+        plan->kernel_imag=b+3*m;
+        if(m&(m-1))
+        {
+            /* Mixed-radix inner size: the tables are for its power-of-2 part. */
+            dbcf_index L=m&(0-m);
+            while(DBCF_POW2(log2m)<L) ++log2m;
+            if(flags&DBCF_PLAN_TWIDDLE_TABLE)
+            {
+                plan->table_real[0]=b+4*m+0*L;
+                plan->table_imag[0]=b+4*m+1*L;
+                plan->table_real[1]=b+4*m+2*L;
+                plan->table_imag[1]=b+4*m+3*L;
+                DBCF_NAME(dbcF_compute_twiddle_table)(log2m,b+4*m+0*L,b+4*m+1*L,0);
+                DBCF_NAME(dbcF_compute_twiddle_table)(log2m,b+4*m+2*L,b+4*m+3*L,1);
+                b+=4*L;
+            }
+            plan->scratch_real=b+4*m;
+            plan->scratch_imag=b+5*m;
+            b+=2*m;
+        }
+        else
+        {
+            while(DBCF_POW2(log2m)<m) ++log2m;
+            if(flags&DBCF_PLAN_TWIDDLE_TABLE)
+            {
+                plan->table_real[0]=b+4*m;
+                plan->table_imag[0]=b+5*m;
+                plan->table_real[1]=b+6*m;
+                plan->table_imag[1]=b+7*m;
+                DBCF_NAME(dbcF_compute_twiddle_table)(log2m,b+4*m,b+5*m,0);
+                DBCF_NAME(dbcF_compute_twiddle_table)(log2m,b+6*m,b+7*m,1);
+                b+=4*m;
+            }
+            else if(log2m>=DBCF_DIF_MIN_LOG2)
+            {
+                plan->table_real[0]=b+4*m;
+                plan->table_imag[0]=b+5*m;
+                DBCF_NAME(dbcF_compute_twiddle_table)(log2m,b+4*m,b+5*m,0);
+                b+=2*m;
+            }
+        }
+        /* Decided once, since the kernel spectrum is stored in that order. */
+        plan->permuted=(!(m&(m-1))&&plan->table_real[0]!=0&&DBCF_NAME(dbcF_use_dif)(log2m));
+        plan->chirp_real =b+4*m+0*num_elements;
+        plan->chirp_imag =b+4*m+1*num_elements;
+        DBCF_NAME(dbcF_npot_prepare)(
+            num_elements,m,
+            inverse,
+            (DBCF_Type*)plan->chirp_real  ,(DBCF_Type*)plan->chirp_imag,
+            (DBCF_Type*)plan->kernel_real ,(DBCF_Type*)plan->kernel_imag,
+            (DBCF_Type*)plan->work_real   ,(DBCF_Type*)plan->work_imag,
+            (DBCF_Type*)plan->scratch_real,(DBCF_Type*)plan->scratch_imag,
+            (const DBCF_Type*)plan->table_real[0],(const DBCF_Type*)plan->table_imag[0],
+            plan->permuted,
+            DBCF_NUM_THREADS);
+        return plan;
+    }
+#endif /* DBC_FFT_NO_NPOT */
+    if((flags&(DBCF_PLAN_TWIDDLE_TABLE|DBCF_PLAN_PERMUTED))&&num_elements>0)
+    {
+        DBCF_Type *b=(DBCF_Type*)buf;
+        dbcf_index n=num_elements,log2n=(dbcf_index)-1;
+        while(n) {n>>=1;++log2n;}
+        plan->table_real[inverse]=b;
+        plan->table_imag[inverse]=b+num_elements;
+        DBCF_NAME(dbcF_compute_twiddle_table)(log2n,b,b+num_elements,inverse);
+    }
+    return plan;
+}
+
+DBCF_DEF dbcf_plan *DBCF_NAME(dbc_fft_plan_create)(
+    dbcf_index num_elements,
+    int flags)
+{
+    void *mem;
+    dbcf_index size,inner;
+    inner=DBCF_NAME(dbcF_plan_inner)(num_elements,flags);
+    size=DBCF_NAME(dbcF_plan_size)(num_elements,flags,inner);
+    if(size<0) return 0;
+    if(!(mem=dbcf_malloc(size))) return 0;
+    return DBCF_NAME(dbcF_plan_init)(mem,num_elements,flags,inner);
+}
+
+/*
+    Convolution and correlation.
+    These follow the scheme of Bluestein's algorithm (see dbcF_npot_forward,
+    dbcF_npot_finish): power-of-2 FFTs of the zero-padded inputs, the
+    pointwise product, and the inverse FFT, with the scale factors
+    (1/M,1,scale).
+*/
+
+/* Smallest log2m, such that 2^log2m>=n. */
+static dbcf_index DBCF_NAME(dbcF_conv_log2m)(dbcf_index n)
+{
+    dbcf_index log2m=0;
+    while(DBCF_POW2(log2m)<n) ++log2m;
+    return log2m;
+}
+
+/*
+    Copy n elements of src to dst (reversed and conjugated if reverse
+    is set), and zero the rest of the m elements. src may be NULL.
+*/
+static void DBCF_NAME(dbcF_conv_stage)(
+    dbcf_index n,dbcf_index m,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+    int reverse,
+    DBCF_Type *dst_real,DBCF_Type *dst_imag)
+{
+    DBCF_Type dummy[2]={DBCF_ZERO,DBCF_ZERO};
+    dbcf_index i;
+    if(!src_real) {src_real=dummy  ;src_real_stride=0;}
+    if(!src_imag) {src_imag=dummy+1;src_imag_stride=0;}
+    if(reverse) for(i=0;i<n;++i)
+    {
+        dst_real[i]= src_real[(n-1-i)*src_real_stride];
+        dst_imag[i]=-src_imag[(n-1-i)*src_imag_stride];
+    }
+    else for(i=0;i<n;++i)
+    {
+        dst_real[i]=src_real[i*src_real_stride];
+        dst_imag[i]=src_imag[i*src_imag_stride];
+    }
+    for(i=n;i<m;++i)
+    {
+        dst_real[i]=DBCF_ZERO;
+        dst_imag[i]=DBCF_ZERO;
+    }
+}
+
+/*
+    Full linear convolution (or correlation, with the kernel reversed and
+    conjugated) of the signal and the kernel, signal_length+kernel_length-1
+    outputs.
+*/
+static int DBCF_NAME(dbcF_convolve)(
+    dbcf_index signal_length,
+    const DBCF_Type *signal_real,const DBCF_Type *signal_imag,
+    dbcf_index signal_real_stride,dbcf_index signal_imag_stride,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel_real,const DBCF_Type *kernel_imag,
+    dbcf_index kernel_real_stride,dbcf_index kernel_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    int correlate,
+    DBCF_Type scale)
+{
+    DBCF_Type M=DBCF_ONE;
+    DBCF_Type *ar,*ai,*br,*bi;
+    dbcf_index i,n,m,log2m;
+    int dif;
+    if(signal_length<0||kernel_length<0) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(signal_length==0||kernel_length==0) return 0;
+    if(!dst_real||!dst_imag) return DBCF_ERROR_INVALID_ARGUMENT;
+    n=signal_length+kernel_length-1;
+    log2m=DBCF_NAME(dbcF_conv_log2m)(n);
+    m=DBCF_POW2(log2m);
+    for(i=0;i<log2m;++i) M=M+M;
+    dif=DBCF_NAME(dbcF_use_dif)(log2m);
+    /* dbcF_dif needs the twiddle table, which goes after the spectra. */
+    ar=(DBCF_Type*)dbcf_malloc((dif?6:4)*m*(dbcf_index)sizeof(DBCF_Type));
+    if(!ar) return DBCF_ERROR_OUT_OF_MEMORY;
+    ai=ar+1*m;
+    br=ar+2*m;
+    bi=ar+3*m;
+    /* Everything is staged first, so dst may overlap the inputs. */
+    DBCF_NAME(dbcF_conv_stage)(signal_length,m,
+        signal_real,signal_imag,
+        signal_real_stride,signal_imag_stride,
+        0,
+        ar,ai);
+    DBCF_NAME(dbcF_conv_stage)(kernel_length,m,
+        kernel_real,kernel_imag,
+        kernel_real_stride,kernel_imag_stride,
+        correlate,
+        br,bi);
+    if(dif)
+    {
+        /* The product does not care about the order of the spectra. */
+        DBCF_NAME(dbcF_compute_twiddle_table)(log2m,ar+4*m,ar+5*m,0);
+        DBCF_NAME(dbcF_dif)(log2m,ar,ai,0,ar+4*m,ar+5*m,DBCF_NUM_THREADS);
+        DBCF_NAME(dbcF_dif)(log2m,br,bi,0,ar+4*m,ar+5*m,DBCF_NUM_THREADS);
+        DBCF_NAME(dbcF_pointwise_multiply)(m,br,bi,ar,ai);
+        DBCF_NAME(dbcF_dit)(log2m,ar,ai,1,0,0,DBCF_NUM_THREADS,scale/M);
+    }
+    else
+    {
+        DBCF_NAME(dbcF_fft_pot)(m,ar,ai,1,1,ar,ai,1,1,0,0,0,DBCF_NUM_THREADS,DBCF_ONE/M);
+        DBCF_NAME(dbcF_fft_pot)(m,br,bi,1,1,br,bi,1,1,0,0,0,DBCF_NUM_THREADS,DBCF_ONE);
+        DBCF_NAME(dbcF_pointwise_multiply)(m,br,bi,ar,ai);
+        DBCF_NAME(dbcF_fft_pot)(m,ar,ai,1,1,ar,ai,1,1,1,0,0,DBCF_NUM_THREADS,scale);
+    }
+    for(i=0;i<n;++i)
+    {
+        dst_real[i*dst_real_stride]=ar[i];
+        dst_imag[i*dst_imag_stride]=ai[i];
+    }
+    dbcf_free(ar);
+    return 0;
+}
+
+static dbcf_conv *DBCF_NAME(dbcF_conv_create)(
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel_real,const DBCF_Type *kernel_imag,
+    dbcf_index kernel_real_stride,dbcf_index kernel_imag_stride,
+    dbcf_index block_length,
+    int flags)
+{
+    dbcf_conv *conv;
+    unsigned char *buf;
+    DBCF_Type *b;
+    dbcf_index i,k=kernel_length-1,m,log2m,offset;
+    if(kernel_length<1||block_length<0) return 0;
+    if(flags&~(DBCF_CONV_KNOWN_FLAGS)) return 0;
+    if(block_length==0)
+    {
+        /*
+            Inner FFT of about 4 times the kernel: larger sizes cost
+            log2(M) per output anyway, smaller ones waste most of each
+            block on the overlap.
+        */
+        log2m=DBCF_NAME(dbcF_conv_log2m)(4*kernel_length);
+        if(log2m<6) log2m=6;
+        block_length=DBCF_POW2(log2m)-k;
+    }
+    else log2m=DBCF_NAME(dbcF_conv_log2m)(block_length+k);
+    m=DBCF_POW2(log2m);
+    buf=(unsigned char*)dbcf_malloc((dbcf_index)sizeof(dbcf_conv)+DBCF_PLAN_ALIGNMENT+(8*m+2*k)*(dbcf_index)sizeof(DBCF_Type));
+    if(!buf) return 0;
+    conv=(dbcf_conv*)buf;
+    conv->type_tag=(const void*)&DBCF_NAME(dbcF_type_tag);
+    conv->kernel_length=kernel_length;
+    conv->block_length=block_length;
+    conv->log2m=log2m;
+    conv->flags=flags;
+    /* Decided once, since the kernel spectrum is stored in that order. */
+    conv->permuted=DBCF_NAME(dbcF_use_dif)(log2m);
+    buf=(unsigned char*)(conv+1);
+    offset=((dbcf_index)buf)&(DBCF_PLAN_ALIGNMENT-1);
+    if(offset) buf+=DBCF_PLAN_ALIGNMENT-offset;
+    b=(DBCF_Type*)buf;
+    conv->kernel_real  =b+0*m;
+    conv->kernel_imag  =b+1*m;
+    conv->work_real    =b+2*m;
+    conv->work_imag    =b+3*m;
+    conv->table_real[0]=b+4*m;
+    conv->table_imag[0]=b+5*m;
+    conv->table_real[1]=b+6*m;
+    conv->table_imag[1]=b+7*m;
+    conv->history_real =b+8*m;
+    conv->history_imag =b+8*m+k;
+    DBCF_NAME(dbcF_compute_twiddle_table)(log2m,b+4*m,b+5*m,0);
+    DBCF_NAME(dbcF_compute_twiddle_table)(log2m,b+6*m,b+7*m,1);
+    DBCF_NAME(dbcF_conv_stage)(kernel_length,m,
+        kernel_real,kernel_imag,
+        kernel_real_stride,kernel_imag_stride,
+        flags&DBCF_CONV_CORRELATE,
+        b+0*m,b+1*m);
+    if(conv->permuted)
+        DBCF_NAME(dbcF_dif)(log2m,b+0*m,b+1*m,0,b+4*m,b+5*m,DBCF_NUM_THREADS);
+    else
+        DBCF_NAME(dbcF_fft_pot)(m,b+0*m,b+1*m,1,1,b+0*m,b+1*m,1,1,0,b+4*m,b+5*m,DBCF_NUM_THREADS,DBCF_ONE);
+    for(i=0;i<2*k;++i) b[8*m+i]=DBCF_ZERO;
+    return conv;
+}
+
+/*
+    One block of block_length inputs and outputs: one forward FFT, the
+    pointwise product, and one inverse FFT of size M. The overlap is
+    combined while staging the inputs (overlap-save) or storing the
+    outputs (overlap-add), together with the scaling.
+*/
+static int DBCF_NAME(dbcF_conv_execute)(
+    dbcf_conv *conv,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale)
+{
+    DBCF_Type M=DBCF_ONE;
+    DBCF_Type *wr,*wi,*hr,*hi;
+    dbcf_index i,b,k,m;
+    if(!conv||conv->type_tag!=(const void*)&DBCF_NAME(dbcF_type_tag)) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(!dst_real||!dst_imag) return DBCF_ERROR_INVALID_ARGUMENT;
+    b=conv->block_length;
+    k=conv->kernel_length-1;
+    m=DBCF_POW2(conv->log2m);
+    for(i=0;i<conv->log2m;++i) M=M+M;
+    wr=(DBCF_Type*)conv->work_real;
+    wi=(DBCF_Type*)conv->work_imag;
+    hr=(DBCF_Type*)conv->history_real;
+    hi=(DBCF_Type*)conv->history_imag;
+    if(conv->flags&DBCF_CONV_OVERLAP_SAVE)
+    {
+        for(i=0;i<k;++i)
+        {
+            wr[i]=hr[i];
+            wi[i]=hi[i];
+        }
+        DBCF_NAME(dbcF_conv_stage)(b,m-k,
+            src_real,src_imag,
+            src_real_stride,src_imag_stride,
+            0,
+            wr+k,wi+k);
+        for(i=0;i<k;++i)
+        {
+            hr[i]=wr[b+i];
+            hi[i]=wi[b+i];
+        }
+    }
+    else DBCF_NAME(dbcF_conv_stage)(b,m,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        0,
+        wr,wi);
+    if(conv->permuted)
+    {
+        DBCF_NAME(dbcF_dif)(conv->log2m,wr,wi,0,
+            (const DBCF_Type*)conv->table_real[0],(const DBCF_Type*)conv->table_imag[0],
+            DBCF_NUM_THREADS);
+        DBCF_NAME(dbcF_pointwise_multiply)(m,
+            (const DBCF_Type*)conv->kernel_real,(const DBCF_Type*)conv->kernel_imag,
+            wr,wi);
+        DBCF_NAME(dbcF_dit)(conv->log2m,wr,wi,1,
+            (const DBCF_Type*)conv->table_real[1],(const DBCF_Type*)conv->table_imag[1],
+            DBCF_NUM_THREADS,
+            DBCF_ONE/M);
+    }
+    else
+    {
+        DBCF_NAME(dbcF_fft_pot)(m,wr,wi,1,1,wr,wi,1,1,0,
+            (const DBCF_Type*)conv->table_real[0],(const DBCF_Type*)conv->table_imag[0],
+            DBCF_NUM_THREADS,DBCF_ONE/M);
+        DBCF_NAME(dbcF_pointwise_multiply)(m,
+            (const DBCF_Type*)conv->kernel_real,(const DBCF_Type*)conv->kernel_imag,
+            wr,wi);
+        DBCF_NAME(dbcF_fft_pot)(m,wr,wi,1,1,wr,wi,1,1,1,
+            (const DBCF_Type*)conv->table_real[1],(const DBCF_Type*)conv->table_imag[1],
+            DBCF_NUM_THREADS,DBCF_ONE);
+    }
+    if(conv->flags&DBCF_CONV_OVERLAP_SAVE)
+    {
+        /* The first k outputs are wrapped around, and discarded. */
+        for(i=0;i<b;++i)
+        {
+            dst_real[i*dst_real_stride]=wr[k+i]*scale;
+            dst_imag[i*dst_imag_stride]=wi[k+i]*scale;
+        }
+        return 0;
+    }
+    /* The tail (k outputs past the block) is kept unscaled. */
+    for(i=0;i<b;++i)
+    {
+        DBCF_Type x=wr[i],y=wi[i];
+        if(i<k)
+        {
+            x=x+hr[i];
+            y=y+hi[i];
+        }
+        dst_real[i*dst_real_stride]=x*scale;
+        dst_imag[i*dst_imag_stride]=y*scale;
+    }
+    for(i=0;i<k;++i)
+    {
+        DBCF_Type x=wr[b+i],y=wi[b+i];
+        if(b+i<k)
+        {
+            x=x+hr[b+i];
+            y=y+hi[b+i];
+        }
+        hr[i]=x;
+        hi[i]=y;
+    }
+    return 0;
+}
+
+/*
+    Short-time Fourier transform: real transforms of size n of the frames
+    src[s..s+n), s=0,hop,2*hop,... of the stream, multiplied by the window.
+*/
+static dbcf_stft *DBCF_NAME(dbcF_stft_create)(
+    dbcf_index fft_size,
+    dbcf_index hop,
+    const DBCF_Type *window,
+    int flags)
+{
+    dbcf_stft *stft;
+    unsigned char *buf;
+    DBCF_Type *b;
+    dbcf_index i,n=fft_size,work_size,offset;
+    if(n<1||hop<1||hop>n) return 0;
+    if(flags&~(DBCF_STFT_KNOWN_FLAGS)) return 0;
+    work_size=DBCF_NAME(dbcF_rfft_workspace)(n);
+    buf=(unsigned char*)dbcf_malloc((dbcf_index)sizeof(dbcf_stft)+DBCF_PLAN_ALIGNMENT+3*n*(dbcf_index)sizeof(DBCF_Type)+work_size);
+    if(!buf) return 0;
+    stft=(dbcf_stft*)buf;
+    stft->type_tag=(const void*)&DBCF_NAME(dbcF_type_tag);
+    stft->fft_size=n;
+    stft->hop=hop;
+    stft->fill=0;
+    stft->flags=flags;
+    buf=(unsigned char*)(stft+1);
+    offset=((dbcf_index)buf)&(DBCF_PLAN_ALIGNMENT-1);
+    if(offset) buf+=DBCF_PLAN_ALIGNMENT-offset;
+    b=(DBCF_Type*)buf;
+    stft->window =b+0*n;
+    stft->frame  =b+1*n;
+    stft->history=b+2*n;
+    stft->work   =b+3*n;
+    stft->work_size=work_size;
+    for(i=0;i<n;++i) b[i]=(window?window[i]:DBCF_ONE);
+    for(i=0;i<n;++i) b[2*n+i]=DBCF_ZERO;
+    return stft;
+}
+
+/*
+    Each frame is gathered from the history and src, and windowed, in one
+    pass, into the frame buffer, which is then transformed (out-of-place)
+    directly into dst. Frame j of the call is at dst+j*(n/2+1)*dst_stride.
+*/
+static int DBCF_NAME(dbcF_stft_execute)(
+    dbcf_stft *stft,
+    dbcf_index src_length,
+    const DBCF_Type *src,
+          DBCF_Type *dst_real,DBCF_Type *dst_imag,
+    dbcf_index dst_stride,
+    DBCF_Type scale)
+{
+    const DBCF_Type *w;
+    DBCF_Type *x,*h;
+    dbcf_index i,m,s,n,hop,fill,total,bins;
+    dbcF_workspace ws;
+    int ret;
+    if(!stft||stft->type_tag!=(const void*)&DBCF_NAME(dbcF_type_tag)) return DBCF_ERROR_INVALID_ARGUMENT;
+    if((stft->flags&DBCF_STFT_INVERSE)||src_length<0) return DBCF_ERROR_INVALID_ARGUMENT;
+    n=stft->fft_size;
+    hop=stft->hop;
+    fill=stft->fill;
+    total=fill+src_length;
+    bins=n/2+1;
+    if(total>=n&&(!dst_real||!dst_imag)) return DBCF_ERROR_INVALID_ARGUMENT;
+    w=(const DBCF_Type*)stft->window;
+    x=(DBCF_Type*)stft->frame;
+    h=(DBCF_Type*)stft->history;
+    for(s=0;s+n<=total;s+=hop)
+    {
+        m=(s<fill?fill-s:0);
+        for(i=0;i<m;++i) x[i]=h[s+i]*w[i];
+        if(src) for(;i<n;++i) x[i]=src[s+i-fill]*w[i];
+        else    for(;i<n;++i) x[i]=DBCF_ZERO;
+        ws.ptr=(unsigned char*)stft->work;
+        ws.size=stft->work_size;
+        ws.heap=0;
+        ret=DBCF_NAME(dbcF_rfft)(n,x,1,dst_real,dst_imag,dst_stride,dst_stride,scale,ws);
+        if(ret) return ret;
+        dst_real+=bins*dst_stride;
+        dst_imag+=bins*dst_stride;
+    }
+    /* Keep the rest (s<=total, since hop<=n) for the next call. */
+    m=(s<fill?fill-s:0);
+    for(i=0;i<m;++i) h[i]=h[s+i];
+    if(src) for(;s+i<total;++i) h[i]=src[s+i-fill];
+    else    for(;s+i<total;++i) h[i]=DBCF_ZERO;
+    stft->fill=total-s;
+    return 0;
+}
+
+/*
+    Inverse: each frame is transformed into the frame buffer, multiplied
+    by the (synthesis) window and added to the accumulator, the first hop
+    elements of which are then complete, and go to dst.
+*/
+static int DBCF_NAME(dbcF_istft_execute)(
+    dbcf_stft *stft,
+    dbcf_index num_frames,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    const DBCF_Type *w;
+    DBCF_Type *x,*h;
+    dbcf_index i,j,n,hop,bins;
+    dbcF_workspace ws;
+    int ret;
+    if(!stft||stft->type_tag!=(const void*)&DBCF_NAME(dbcF_type_tag)) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(!(stft->flags&DBCF_STFT_INVERSE)||num_frames<0) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(num_frames>0&&!dst) return DBCF_ERROR_INVALID_ARGUMENT;
+    n=stft->fft_size;
+    hop=stft->hop;
+    bins=n/2+1;
+    w=(const DBCF_Type*)stft->window;
+    x=(DBCF_Type*)stft->frame;
+    h=(DBCF_Type*)stft->history;
+    for(j=0;j<num_frames;++j)
+    {
+        ws.ptr=(unsigned char*)stft->work;
+        ws.size=stft->work_size;
+        ws.heap=0;
+        ret=DBCF_NAME(dbcF_irfft)(n,src_real,src_imag,src_stride,src_stride,x,1,scale,ws);
+        if(ret) return ret;
+        for(i=0;i<hop;++i) dst[i]=h[i]+x[i]*w[i];
+        for(   ;i<n  ;++i) h[i-hop]=h[i]+x[i]*w[i];
+        for(i=n-hop;i<n;++i) h[i]=DBCF_ZERO;
+        if(src_real) src_real+=bins*src_stride;
+        if(src_imag) src_imag+=bins*src_stride;
+        dst+=hop;
+    }
+    return 0;
+}
+
+/*
+    Batched transforms.
+    Transform j reads src_*[j*src_dist+k*src_stride], and writes
+    dst_*[j*dst_dist+k*dst_stride]. The size-dependent setup (twiddle table,
+    Bluestein's chirp and kernel) is done once for the whole batch.
+    For small power-of-2 sizes with SIMD, several transforms are computed
+    at once, one per SIMD lane (see DBCF_butterfly_batch_optimized).
+    The arguments are assumed to be valid, and for non-power-of-2
+    sizes plan shall be a plan for num_elements and this direction
+    (it is not used otherwise).
+*/
+static void DBCF_NAME(dbcF_fft_many_run)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    int inverse,
+    dbcf_plan *plan,
+    DBCF_Type scale)
+{
+#ifndef DBC_FFT_NO_SIMD
+    DBCF_ALIGNED(64) DBCF_Type table[DBCF_TMP_BUF_SIZE];
+#else
+    DBCF_Type table[DBCF_TMP_BUF_SIZE];
+#endif
+    const DBCF_Type *tr=0,*ti=0;
+    dbcf_index n=num_elements,log2n=(dbcf_index)-1,j=0;
+    if(num_elements&(num_elements-1))
+    {
+        for(j=0;j<howmany;++j)
+            DBCF_NAME(dbcF_execute)(plan,
+                (src_real?src_real+j*src_dist:src_real),(src_imag?src_imag+j*src_dist:src_imag),
+                src_stride,src_stride,
+                dst_real+j*dst_dist,dst_imag+j*dst_dist,
+                dst_stride,dst_stride,
+                scale);
+        return;
+    }
+    while(n) {n>>=1;++log2n;}
+    if(2*num_elements<=DBCF_TMP_BUF_SIZE)
+    {
+        DBCF_NAME(dbcF_compute_twiddle_table)(log2n,table,table+num_elements,inverse);
+        tr=table;
+        ti=table+num_elements;
+    }
+#ifdef DBCF_batch_lanes_optimized
+    if(tr&&log2n>0)
+    {
+        dbcf_index lanes=DBCF_batch_lanes_optimized(log2n);
+        if(lanes>0&&howmany>=lanes)
+        {
+            DBCF_ALIGNED(64) DBCF_Type tile[DBCF_BATCH_BUF_SIZE];
+            DBCF_Type *xr=tile,*xi=tile+lanes*num_elements;
+            for(;j+lanes<=howmany;j+=lanes)
+            {
+                dbcf_index k,l,r=0;
+                /* Gather, in bit-reversed order. */
+                for(k=0;k<num_elements;++k)
+                {
+                    dbcf_index b=num_elements>>1;
+                    for(l=0;l<lanes;++l)
+                    {
+                        xr[r*lanes+l]=(src_real?src_real[(j+l)*src_dist+k*src_stride]:DBCF_ZERO);
+                        xi[r*lanes+l]=(src_imag?src_imag[(j+l)*src_dist+k*src_stride]:DBCF_ZERO);
+                    }
+                    while(r&b) {r^=b;b>>=1;}
+                    r|=b;
+                }
+                DBCF_butterfly_batch_optimized(lanes,log2n,xr,xi,tr,ti);
+                /* Scatter. */
+                for(k=0;k<num_elements;++k)
+                    for(l=0;l<lanes;++l)
+                    {
+                        DBCF_Type x=xr[k*lanes+l],y=xi[k*lanes+l];
+                        if(scale!=DBCF_ONE) {x=x*scale;y=y*scale;}
+                        dst_real[(j+l)*dst_dist+k*dst_stride]=x;
+                        dst_imag[(j+l)*dst_dist+k*dst_stride]=y;
+                    }
+            }
+        }
+    }
+#endif /* DBCF_batch_lanes_optimized */
+    for(;j<howmany;++j)
+        DBCF_NAME(dbcF_fft_pot)(
+            num_elements,
+            (src_real?src_real+j*src_dist:src_real),(src_imag?src_imag+j*src_dist:src_imag),
+            src_stride,src_stride,
+            dst_real+j*dst_dist,dst_imag+j*dst_dist,
+            dst_stride,dst_stride,
+            inverse,
+            tr,ti,
+            DBCF_NUM_THREADS,
+            scale);
+}
+
+/*
+    Plan for the inner transforms of dbcF_fft_many_run: NULL for power-of-2
+    sizes (and *ret=0), otherwise a new plan, allocated from ws (or NULL
+    and *ret set on error). Released by dbcF_release(ws,plan).
+*/
+static dbcf_plan *DBCF_NAME(dbcF_many_plan)(dbcf_index num_elements,int inverse,dbcF_workspace *ws,int *ret)
+{
+    dbcf_plan *plan=0;
+    *ret=0;
+    if(num_elements&(num_elements-1))
+    {
+#ifndef DBC_FFT_NO_NPOT
+        int flags=(inverse?DBCF_PLAN_INVERSE:DBCF_PLAN_FORWARD)|DBCF_PLAN_TWIDDLE_TABLE;
+        dbcf_index inner=DBCF_NAME(dbcF_plan_inner)(num_elements,flags);
+        void *mem=dbcF_alloc(ws,DBCF_NAME(dbcF_plan_size)(num_elements,flags,inner));
+        if(mem) plan=DBCF_NAME(dbcF_plan_init)(mem,num_elements,flags,inner);
+        else    *ret=DBCF_ERROR_OUT_OF_MEMORY;
+#else
+        (void)inverse;
+        (void)ws;
+        *ret=DBCF_ERROR_INVALID_ARGUMENT;
+#endif /* DBC_FFT_NO_NPOT */
+    }
+    return plan;
+}
+
+/* Workspace bytes dbcF_many_plan needs. */
+static dbcf_index DBCF_NAME(dbcF_many_plan_workspace)(dbcf_index num_elements)
+{
+    dbcf_index size;
+    if(!(num_elements&(num_elements-1))) return 0;
+    size=DBCF_NAME(dbcF_plan_size)(num_elements,DBCF_PLAN_TWIDDLE_TABLE,DBCF_NAME(dbcF_plan_inner)(num_elements,DBCF_PLAN_TWIDDLE_TABLE));
+    return (size<0?0:DBCF_WORKSPACE_CHUNK(size));
+}
+
+/*
+    dbcF_fft_many_run for strided dst (see dbcF_staged): blocks of b
+    transforms are gathered into the contiguous work_real, work_imag
+    (b rows of n+DBCF_STAGE_PAD elements each), transformed there, and
+    scattered back. Both copies go over the elements of all b transforms
+    at once, so the strided accesses of e.g. adjacent columns (dist 1)
+    touch whole cache lines, and the padding keeps the rows (typically
+    a power of 2 apart otherwise) from competing for the same cache sets.
+*/
+static void DBCF_NAME(dbcF_fft_many_staged)(
+    dbcf_index n,
+    dbcf_index howmany,
+    dbcf_index b,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type *work_real,DBCF_Type *work_imag,
+    int inverse,
+    dbcf_plan *plan,
+    DBCF_Type scale)
+{
+    dbcf_index j,k,l,p=n+DBCF_STAGE_PAD;
+    for(j=0;j<howmany;j+=b)
+    {
+        if(b>howmany-j) b=howmany-j;
+        DBCF_PROFILE_ENTER(DBCF_PROFILE_COPY);
+        for(k=0;k<n;++k)
+            for(l=0;l<b;++l)
+            {
+                work_real[l*p+k]=(src_real?src_real[(j+l)*src_dist+k*src_stride]:DBCF_ZERO);
+                work_imag[l*p+k]=(src_imag?src_imag[(j+l)*src_dist+k*src_stride]:DBCF_ZERO);
+            }
+        DBCF_PROFILE_LEAVE(DBCF_PROFILE_COPY);
+        DBCF_NAME(dbcF_fft_many_run)(n,b,
+            work_real,work_imag,
+            1,p,
+            work_real,work_imag,
+            1,p,
+            inverse,
+            plan,
+            scale);
+        DBCF_PROFILE_ENTER(DBCF_PROFILE_COPY);
+        for(k=0;k<n;++k)
+            for(l=0;l<b;++l)
+            {
+                dst_real[(j+l)*dst_dist+k*dst_stride]=work_real[l*p+k];
+                dst_imag[(j+l)*dst_dist+k*dst_stride]=work_imag[l*p+k];
+            }
+        DBCF_PROFILE_LEAVE(DBCF_PROFILE_COPY);
+    }
+}
+
+/* Workspace bytes of the buffer of dbcF_fft_many_staged. */
+static dbcf_index DBCF_NAME(dbcF_many_stage_workspace)(dbcf_index num_elements)
+{
+    if(!DBCF_NAME(dbcF_staged)(num_elements,1)) return 0;
+    return DBCF_WORKSPACE_CHUNK(2*(num_elements+DBCF_STAGE_PAD)*DBCF_NAME(dbcF_stage_block)(num_elements)*(dbcf_index)sizeof(DBCF_Type));
+}
+
+static int DBCF_NAME(dbcF_fft_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    int inverse,
+    DBCF_Type scale,
+    dbcF_workspace ws)
+{
+    dbcf_plan *plan;
+    DBCF_Type *work;
+    int ret;
+    if(num_elements<1||howmany<1) return 0;
+    ret=DBCF_NAME(dbcF_check_arguments)(
+        src_real,src_imag,
+        src_stride,src_stride,
+        dst_real,dst_imag,
+        dst_stride,dst_stride);
+    if(ret) return ret;
+    if(src_real==dst_real&&src_dist!=dst_dist) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(src_imag==dst_imag&&src_dist!=dst_dist) return DBCF_ERROR_INVALID_ARGUMENT;
+    plan=DBCF_NAME(dbcF_many_plan)(num_elements,inverse,&ws,&ret);
+    if(ret) return ret;
+    if(DBCF_NAME(dbcF_staged)(num_elements,1)&&DBCF_NAME(dbcF_strided)(dst_real,dst_imag,dst_stride,dst_stride))
+    {
+        dbcf_index b=DBCF_NAME(dbcF_stage_block)(num_elements);
+        if(b>howmany) b=howmany;
+        work=(DBCF_Type*)dbcF_alloc(&ws,2*(num_elements+DBCF_STAGE_PAD)*b*(dbcf_index)sizeof(DBCF_Type));
+        if(work)
+        {
+            DBCF_NAME(dbcF_fft_many_staged)(num_elements,howmany,b,
+                src_real,src_imag,
+                src_stride,src_dist,
+                dst_real,dst_imag,
+                dst_stride,dst_dist,
+                work,work+(num_elements+DBCF_STAGE_PAD)*b,
+                inverse,
+                plan,
+                scale);
+            dbcF_release(&ws,work);
+            if(plan) dbcF_release(&ws,plan);
+            return 0;
+        }
+    }
+    DBCF_NAME(dbcF_fft_many_run)(num_elements,howmany,
+        src_real,src_imag,
+        src_stride,src_dist,
+        dst_real,dst_imag,
+        dst_stride,dst_dist,
+        inverse,
+        plan,
+        scale);
+    if(plan) dbcF_release(&ws,plan);
+    return 0;
+}
+
+/*
+    Multi-dimensional transforms.
+    The arrays are row-major, with dims[rank-1] being the contiguous
+    dimension (all indices are multiplied by stride). The last dimension
+    is transformed as a batch of contiguous rows. Each of the others is
+    transformed in blocks of DBCF_ND_BLOCK columns (i.e. consecutive
+    elements in memory), which are copied into a contiguous work buffer
+    and back, so that every 1D transform takes the contiguous (SIMD) path,
+    and the strided accesses touch whole cache lines.
+*/
+
+/*
+    Transform in-place the columns of outer consecutive matrices of
+    n rows by inner columns. work_real, work_imag shall have room for
+    n*DBCF_ND_BLOCK elements each.
+*/
+static void DBCF_NAME(dbcF_fft_columns)(
+    dbcf_index n,dbcf_index inner,dbcf_index outer,
+    DBCF_Type *real,DBCF_Type *imag,
+    dbcf_index stride,
+    DBCF_Type *work_real,DBCF_Type *work_imag,
+    int inverse,
+    dbcf_plan *plan,
+    DBCF_Type scale)
+{
+    dbcf_index o,j,k,l,b;
+    for(o=0;o<outer;++o)
+    {
+        DBCF_Type *R=real+o*n*inner*stride,*I=imag+o*n*inner*stride;
+        for(j=0;j<inner;j+=b)
+        {
+            b=inner-j;
+            if(b>DBCF_ND_BLOCK) b=DBCF_ND_BLOCK;
+            for(k=0;k<n;++k)
+                for(l=0;l<b;++l)
+                {
+                    work_real[l*n+k]=R[(k*inner+j+l)*stride];
+                    work_imag[l*n+k]=I[(k*inner+j+l)*stride];
+                }
+            DBCF_NAME(dbcF_fft_many_run)(n,b,
+                work_real,work_imag,
+                1,n,
+                work_real,work_imag,
+                1,n,
+                inverse,
+                plan,
+                scale);
+            for(k=0;k<n;++k)
+                for(l=0;l<b;++l)
+                {
+                    R[(k*inner+j+l)*stride]=work_real[l*n+k];
+                    I[(k*inner+j+l)*stride]=work_imag[l*n+k];
+                }
+        }
+    }
+}
+
+static int DBCF_NAME(dbcF_fft_nd)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index stride,
+    int inverse,
+    DBCF_Type scale,
+    dbcF_workspace ws)
+{
+    unsigned char *buf,*mem=0;
+    DBCF_Type *wr=0,*wi=0;
+    dbcF_workspace pws;
+    dbcf_plan *plan;
+    dbcf_index d,total=1,inner,maxn=0;
+#ifdef DBCF_butterfly_multipass_optimized
+    dbcf_index alignment=64;
+#else
+    dbcf_index alignment=0;
+#endif
+    int ret;
+    if(rank<1||!dims) return DBCF_ERROR_INVALID_ARGUMENT;
+    for(d=0;d<rank;++d)
+    {
+        if(dims[d]<0) return DBCF_ERROR_INVALID_ARGUMENT;
+        total*=dims[d];
+        if(d<rank-1&&dims[d]>maxn) maxn=dims[d];
+    }
+    if(total==0) return 0;
+    ret=DBCF_NAME(dbcF_check_arguments)(
+        src_real,src_imag,
+        stride,stride,
+        dst_real,dst_imag,
+        stride,stride);
+    if(ret) return ret;
+    if(rank>1)
+    {
+        if(!(mem=(unsigned char*)dbcF_alloc(&ws,2*maxn*DBCF_ND_BLOCK*(dbcf_index)sizeof(DBCF_Type)+alignment))) return DBCF_ERROR_OUT_OF_MEMORY;
+        buf=mem;
+        if(alignment)
+        {
+            dbcf_index offset=((dbcf_index)buf)&(alignment-1);
+            if(offset) buf+=alignment-offset;
+        }
+        wr=(DBCF_Type*)buf;
+        wi=wr+maxn*DBCF_ND_BLOCK;
+    }
+    inner=dims[rank-1];
+    /* The plans are released after each dimension, so they share pws. */
+    pws=ws;
+    plan=DBCF_NAME(dbcF_many_plan)(inner,inverse,&pws,&ret);
+    if(!ret)
+    {
+        DBCF_NAME(dbcF_fft_many_run)(inner,total/inner,
+            src_real,src_imag,
+            stride,stride*inner,
+            dst_real,dst_imag,
+            stride,stride*inner,
+            inverse,
+            plan,
+            (rank==1?scale:DBCF_ONE));
+        if(plan) dbcF_release(&pws,plan);
+    }
+    for(d=rank-1;d>0&&!ret;--d)
+    {
+        dbcf_index n=dims[d-1];
+        pws=ws;
+        plan=DBCF_NAME(dbcF_many_plan)(n,inverse,&pws,&ret);
+        if(ret) break;
+        DBCF_NAME(dbcF_fft_columns)(n,inner,total/(n*inner),
+            dst_real,dst_imag,
+            stride,
+            wr,wi,
+            inverse,
+            plan,
+            (d==1?scale:DBCF_ONE));
+        if(plan) dbcF_release(&pws,plan);
+        inner*=n;
+    }
+    dbcF_release(&ws,mem);
+    return ret;
+}
+
+/* Workspace bytes dbcF_fft_nd needs (0 for invalid arguments). */
+static dbcf_index DBCF_NAME(dbcF_fft_nd_workspace)(dbcf_index rank,const dbcf_index *dims)
+{
+    dbcf_index d,maxn=0,ret=0,plan=0;
+    if(rank<1||!dims) return 0;
+    for(d=0;d<rank;++d)
+    {
+        dbcf_index size;
+        if(dims[d]<0) return 0;
+        if(d<rank-1&&dims[d]>maxn) maxn=dims[d];
+        size=DBCF_NAME(dbcF_many_plan_workspace)(dims[d]);
+        if(size>plan) plan=size;
+    }
+    if(rank>1) ret=DBCF_WORKSPACE_CHUNK(2*maxn*DBCF_ND_BLOCK*(dbcf_index)sizeof(DBCF_Type)+64);
+    return ret+plan;
+}
+
+/*
+    Out-of-core transforms: the four-step algorithm (Bailey) for
+    N=N1*N2, with the input x[n1+N1*n2] viewed as N2 rows of N1 columns.
+    Pass 1 transforms the columns (size N2), multiplies them by the
+    twiddles w^(n1*k2), w=exp(-+2*pi*i/N), and writes them transposed to
+    dst (as contiguous rows). Pass 2 transforms the columns of dst (size
+    N1) in place, which gives X[k2+N2*k1] at k2+N2*k1. Both passes go
+    over blocks of up to B adjacent columns, staged in the work buffer,
+    so each I/O call moves B consecutive elements (or, for the write of
+    pass 1, whole rows).
+*/
+
+/* Workspace bytes dbcF_fft_io needs for blocks of b columns. */
+static dbcf_index DBCF_NAME(dbcF_fft_io_workspace)(dbcf_index n,dbcf_index b)
+{
+    dbcf_index n1=dbcF_io_split(n),n2=n/n1,size=(dbcf_index)sizeof(DBCF_Type);
+    dbcf_index p1=DBCF_NAME(dbcF_many_plan_workspace)(n1),p2=DBCF_NAME(dbcF_many_plan_workspace)(n2);
+    return DBCF_WORKSPACE_CHUNK(2*b*n2*size)+DBCF_WORKSPACE_CHUNK(2*b*size)+DBCF_WORKSPACE_CHUNK(2*n2*size)+(p1>p2?p1:p2);
+}
+
+/* (w^(p*k)-1), 0<=k<m, as in dbcF_compute_twiddles_npot. */
+static void DBCF_NAME(dbcF_io_twiddles)(dbcf_index n,dbcf_index p,dbcf_index m,DBCF_Type *real,DBCF_Type *imag,int inverse)
+{
+    dbcf_index i,k;
+    real[0]=DBCF_ZERO;
+    imag[0]=DBCF_ZERO;
+    for(i=1;i<m;i*=2)
+    {
+        DBCF_Type X,Y;
+        DBCF_NAME(dbcF_cexpm1_root)(p*i,n,inverse,&X,&Y);
+        for(k=0;k<i&&i+k<m;++k)
+        {
+            real[i+k]=(X*real[k]-Y*imag[k])+(X+real[k]);
+            imag[i+k]=(Y*real[k]+X*imag[k])+(Y+imag[k]);
+        }
+    }
+}
+
+static int DBCF_NAME(dbcF_fft_io)(
+    dbcf_index num_elements,
+    const dbcf_io *src,
+    const dbcf_io *dst,
+    int inverse,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws,pws;
+    dbcf_plan *plan;
+    DBCF_Type *wr,*wi,*seg,*tr,*ti;
+    dbcf_index n=num_elements,n1,n2,b,B,i,j,k,l;
+    dbcf_index size=(dbcf_index)sizeof(DBCF_Type),esize=2*size;
+    int ret=0;
+    if(n<0||!src||!dst||src==dst||!src->read||!dst->read||!dst->write) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(n==0) return 0;
+    n1=dbcF_io_split(n);
+    n2=n/n1;
+    /* The largest block that fits. */
+    B=(work_size-DBCF_NAME(dbcF_fft_io_workspace)(n,0))/(2*(n2+1)*size);
+    if(B>n2) B=n2;
+    if(B<1||!work) return DBCF_ERROR_INVALID_ARGUMENT;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbcF_fft_io_workspace)(n,B));
+    if(ret) return ret;
+    wr=(DBCF_Type*)dbcF_alloc(&ws,2*B*n2*size);
+    wi=wr+B*n2;
+    seg=(DBCF_Type*)dbcF_alloc(&ws,2*B*size);
+    tr=(DBCF_Type*)dbcF_alloc(&ws,2*n2*size);
+    ti=tr+n2;
+    /* Pass 1. */
+    pws=ws;
+    plan=DBCF_NAME(dbcF_many_plan)(n2,inverse,&pws,&ret);
+    if(ret) return ret;
+    for(i=0;i<n1&&!ret;i+=b)
+    {
+        b=(n1-i<B?n1-i:B);
+        for(k=0;k<n2&&!ret;++k)
+        {
+            if(src->read(src->user,(k*n1+i)*esize,b*esize,seg)) {ret=DBCF_ERROR_IO;break;}
+            for(l=0;l<b;++l)
+            {
+                wr[l*n2+k]=seg[2*l+0];
+                wi[l*n2+k]=seg[2*l+1];
+            }
+        }
+        if(ret) break;
+        DBCF_NAME(dbcF_fft_many_run)(n2,b,
+            wr,wi,
+            1,n2,
+            wr,wi,
+            1,n2,
+            inverse,
+            plan,
+            DBCF_ONE);
+        for(l=0;l<b&&!ret;++l)
+        {
+            DBCF_Type *xr=wr+l*n2,*xi=wi+l*n2;
+            DBCF_NAME(dbcF_io_twiddles)(n,i+l,n2,tr,ti,inverse);
+            for(k=0;k<n2;++k)
+            {
+                DBCF_Type c=DBCF_ONE+tr[k],s=ti[k],x=xr[k],y=xi[k];
+                xr[k]=x*c-y*s;
+                xi[k]=x*s+y*c;
+            }
+            for(k=0;k<n2;k+=B)
+            {
+                dbcf_index m=(n2-k<B?n2-k:B);
+                for(j=0;j<m;++j)
+                {
+                    seg[2*j+0]=xr[k+j];
+                    seg[2*j+1]=xi[k+j];
+                }
+                if(dst->write(dst->user,((i+l)*n2+k)*esize,m*esize,seg)) {ret=DBCF_ERROR_IO;break;}
+            }
+        }
+    }
+    if(plan) dbcF_release(&pws,plan);
+    if(ret) return ret;
+    /* Pass 2. */
+    pws=ws;
+    plan=DBCF_NAME(dbcF_many_plan)(n1,inverse,&pws,&ret);
+    if(ret) return ret;
+    for(k=0;k<n2&&!ret;k+=b)
+    {
+        b=(n2-k<B?n2-k:B);
+        for(i=0;i<n1;++i)
+        {
+            if(dst->read(dst->user,(i*n2+k)*esize,b*esize,seg)) {ret=DBCF_ERROR_IO;break;}
+            for(l=0;l<b;++l)
+            {
+                wr[l*n1+i]=seg[2*l+0];
+                wi[l*n1+i]=seg[2*l+1];
+            }
+        }
+        if(ret) break;
+        DBCF_NAME(dbcF_fft_many_run)(n1,b,
+            wr,wi,
+            1,n1,
+            wr,wi,
+            1,n1,
+            inverse,
+            plan,
+            scale);
+        for(i=0;i<n1;++i)
+        {
+            for(l=0;l<b;++l)
+            {
+                seg[2*l+0]=wr[l*n1+i];
+                seg[2*l+1]=wi[l*n1+i];
+            }
+            if(dst->write(dst->user,(i*n2+k)*esize,b*esize,seg)) {ret=DBCF_ERROR_IO;break;}
+        }
+    }
+    if(plan) dbcF_release(&pws,plan);
+    return ret;
+}
+
+/* Workspace bytes for blocks of DBCF_IO_BLOCK columns (or fewer, if N2 is smaller). */
+static dbcf_index DBCF_NAME(dbcF_fft_io_default_workspace)(dbcf_index n)
+{
+    dbcf_index n2;
+    if(n<1) return 0;
+    n2=n/dbcF_io_split(n);
+    return DBCF_NAME(dbcF_fft_io_workspace)(n,(n2<DBCF_IO_BLOCK?n2:DBCF_IO_BLOCK));
+}
+
+static int DBCF_NAME(dbcF_fft_io_heap)(
+    dbcf_index num_elements,
+    const dbcf_io *src,
+    const dbcf_io *dst,
+    int inverse,
+    DBCF_Type scale)
+{
+    dbcf_index size=DBCF_NAME(dbcF_fft_io_default_workspace)(num_elements);
+    void *work;
+    int ret;
+    if(num_elements<1) return DBCF_NAME(dbcF_fft_io)(num_elements,src,dst,inverse,scale,0,0);
+    if(!(work=dbcf_malloc(size))) return DBCF_ERROR_OUT_OF_MEMORY;
+    ret=DBCF_NAME(dbcF_fft_io)(num_elements,src,dst,inverse,scale,work,size);
+    dbcf_free(work);
+    return ret;
+}
+
+/*
+    Distributed transforms: the four-step algorithm of dbcF_fft_io for
+    N=A*B over P ranks, with A=n1, B=n2 forward, and A=n2, B=n1 inverse.
+    Rank r holds the A/P columns r*A/P+j of x[a+A*b] (B rows of A), each
+    contiguous: src[j*B+b]. Phase 1 (dbcF_dist_columns) transforms them
+    (size B), multiplies them by the twiddles, and packs them into the P
+    blocks of send: block s holds the rows s*B/P+t of the columns of the
+    rank, transposed (at t*A/P+j, the real parts, then the imaginary
+    ones). After the exchange, which brings block r of every rank s to
+    rank r, phase 2 puts them into the B/P rows of dst (dbcF_dist_unpack)
+    and transforms those (size A, dbcF_dist_rows).
+*/
+
+/* Workspace bytes of a rank: send (and recv, if exchange), the twiddles, and the plans. */
+static dbcf_index DBCF_NAME(dbcF_dist_workspace)(dbcf_index a,dbcf_index b,dbcf_index p,int exchange)
+{
+    dbcf_index size=(dbcf_index)sizeof(DBCF_Type),local=2*(a/p)*b*size;
+    dbcf_index pa=DBCF_NAME(dbcF_many_plan_workspace)(a),pb=DBCF_NAME(dbcF_many_plan_workspace)(b);
+    return (exchange?2:1)*DBCF_WORKSPACE_CHUNK(local)+DBCF_WORKSPACE_CHUNK(2*b*size)+(pa>pb?pa:pb);
+}
+
+/* Phase 1 of rank r: the columns, from src (through dst) to send. */
+static int DBCF_NAME(dbcF_dist_columns)(
+    dbcf_index a,dbcf_index b,dbcf_index p,dbcf_index r,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type *send,
+    int inverse,
+    dbcF_workspace ws)
+{
+    dbcf_index ca=a/p,cb=b/p,j,k,s,t;
+    dbcf_plan *plan;
+    DBCF_Type *tr,*ti;
+    int ret;
+    if(!(tr=(DBCF_Type*)dbcF_alloc(&ws,2*b*(dbcf_index)sizeof(DBCF_Type)))) return DBCF_ERROR_OUT_OF_MEMORY;
+    ti=tr+b;
+    plan=DBCF_NAME(dbcF_many_plan)(b,inverse,&ws,&ret);
+    if(!ret)
+    {
+        DBCF_NAME(dbcF_fft_many_run)(b,ca,
+            src_real,src_imag,
+            1,b,
+            dst_real,dst_imag,
+            1,b,
+            inverse,
+            plan,
+            DBCF_ONE);
+        for(j=0;j<ca;++j)
+        {
+            const DBCF_Type *xr=dst_real+j*b,*xi=dst_imag+j*b;
+            DBCF_NAME(dbcF_io_twiddles)(a*b,r*ca+j,b,tr,ti,inverse);
+            for(s=0;s<p;++s)
+            {
+                DBCF_Type *br=send+2*s*ca*cb,*bi=br+ca*cb;
+                for(t=0;t<cb;++t)
+                {
+                    k=s*cb+t;
+                    br[t*ca+j]=xr[k]*(DBCF_ONE+tr[k])-xi[k]*ti[k];
+                    bi[t*ca+j]=xr[k]*ti[k]+xi[k]*(DBCF_ONE+tr[k]);
+                }
+            }
+        }
+    }
+    if(plan) dbcF_release(&ws,plan);
+    dbcF_release(&ws,tr);
+    return ret;
+}
+
+/* Phase 2: the block of rank s (see dbcF_dist_columns) into the rows of dst. */
+static void DBCF_NAME(dbcF_dist_unpack)(
+    dbcf_index a,dbcf_index b,dbcf_index p,dbcf_index s,
+    const DBCF_Type *block,
+    DBCF_Type *dst_real,DBCF_Type *dst_imag)
+{
+    dbcf_index ca=a/p,cb=b/p,j,t;
+    for(t=0;t<cb;++t)
+        for(j=0;j<ca;++j)
+        {
+            dst_real[t*a+s*ca+j]=block[t*ca+j];
+            dst_imag[t*a+s*ca+j]=block[ca*cb+t*ca+j];
+        }
+}
+
+/* Phase 2: the rows of dst, in place. */
+static int DBCF_NAME(dbcF_dist_rows)(
+    dbcf_index a,dbcf_index b,dbcf_index p,
+    DBCF_Type *dst_real,DBCF_Type *dst_imag,
+    int inverse,
+    DBCF_Type scale,
+    dbcF_workspace ws)
+{
+    dbcf_plan *plan;
+    int ret;
+    plan=DBCF_NAME(dbcF_many_plan)(a,inverse,&ws,&ret);
+    if(ret) return ret;
+    DBCF_NAME(dbcF_fft_many_run)(a,b/p,
+        dst_real,dst_imag,
+        1,a,
+        dst_real,dst_imag,
+        1,a,
+        inverse,
+        plan,
+        scale);
+    if(plan) dbcF_release(&ws,plan);
+    return 0;
+}
+
+/* Whether n1*n2 can be split between p ranks (or nodes). */
+static int DBCF_NAME(dbcF_dist_valid)(dbcf_index n1,dbcf_index n2,int p)
+{
+    if(n1<1||n2<1||p<1||n1%p||n2%p) return 0;
+    if(n1>(DBCF_POW2(8*sizeof(dbcf_index)-2)/(dbcf_index)sizeof(DBCF_Type))/n2) return 0;
+#ifdef DBC_FFT_NO_NPOT
+    if((n1&(n1-1))||(n2&(n2-1))) return 0;
+#endif
+    return 1;
+}
+
+static int DBCF_NAME(dbcF_fft_dist)(
+    dbcf_index n1,dbcf_index n2,
+    const dbcf_dist *dist,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    int inverse,
+    DBCF_Type scale,
+    dbcF_workspace ws)
+{
+    dbcf_index a=(inverse?n2:n1),b=(inverse?n1:n2),p,s,local,block;
+    DBCF_Type *send,*recv;
+    int ret;
+    if(!dist||!dist->alltoall||!DBCF_NAME(dbcF_dist_valid)(n1,n2,dist->num_ranks)) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(dist->rank<0||dist->rank>=dist->num_ranks||!src_real||!src_imag||!dst_real||!dst_imag) return DBCF_ERROR_INVALID_ARGUMENT;
+    p=dist->num_ranks;
+    local=a/p*b;
+    block=2*(a/p)*(b/p);
+    send=(DBCF_Type*)dbcF_alloc(&ws,2*local*(dbcf_index)sizeof(DBCF_Type));
+    recv=(send?(DBCF_Type*)dbcF_alloc(&ws,2*local*(dbcf_index)sizeof(DBCF_Type)):0);
+    if(!recv) ret=DBCF_ERROR_OUT_OF_MEMORY;
+    else ret=DBCF_NAME(dbcF_dist_columns)(a,b,p,dist->rank,src_real,src_imag,dst_real,dst_imag,send,inverse,ws);
+    if(!ret&&dist->alltoall(dist->user,send,recv,block*(dbcf_index)sizeof(DBCF_Type))) ret=DBCF_ERROR_IO;
+    if(!ret)
+    {
+        for(s=0;s<p;++s) DBCF_NAME(dbcF_dist_unpack)(a,b,p,s,recv+s*block,dst_real,dst_imag);
+        ret=DBCF_NAME(dbcF_dist_rows)(a,b,p,dst_real,dst_imag,inverse,scale,ws);
+    }
+    if(recv) dbcF_release(&ws,recv);
+    if(send) dbcF_release(&ws,send);
+    return ret;
+}
+
+static int DBCF_NAME(dbcF_fft_dist_w)(
+    dbcf_index n1,dbcf_index n2,
+    const dbcf_dist *dist,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    int inverse,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    if(!dist||!DBCF_NAME(dbcF_dist_valid)(n1,n2,dist->num_ranks)) return DBCF_ERROR_INVALID_ARGUMENT;
+    ret=dbcF_workspace_init(&ws,work,work_size,
+        DBCF_NAME(dbcF_dist_workspace)(inverse?n2:n1,inverse?n1:n2,dist->num_ranks,1));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft_dist)(n1,n2,dist,src_real,src_imag,dst_real,dst_imag,inverse,scale,ws);
+}
+
+/* Task of a node of dbcF_fft_numa, for phase 1 (phase==0) or 2. */
+typedef struct DBCF_NAME(dbcF_numa_task)
+{
+    dbcf_index a,b,p,r;
+    int inverse,phase,ret;
+    DBCF_Type scale;
+    const DBCF_Type *src_real,*src_imag;
+    DBCF_Type *dst_real,*dst_imag;
+    DBCF_Type *send;
+    struct DBCF_NAME(dbcF_numa_task) *tasks;
+    void *handle;
+} DBCF_NAME(dbcF_numa_task);
+
+static void DBCF_NAME(dbcF_numa_run)(void *arg)
+{
+    DBCF_NAME(dbcF_numa_task) *task=(DBCF_NAME(dbcF_numa_task)*)arg;
+    dbcf_index i,a=task->a,b=task->b,p=task->p,r=task->r,block=2*(a/p)*(b/p);
+    if(task->phase==0)
+    {
+        /* Allocated (and first touched) on this node. */
+        task->send=(DBCF_Type*)dbcf_malloc(2*(a/p)*b*(dbcf_index)sizeof(DBCF_Type));
+        if(!task->send) {task->ret=DBCF_ERROR_OUT_OF_MEMORY;return;}
+        task->ret=DBCF_NAME(dbcF_dist_columns)(a,b,p,r,task->src_real,task->src_imag,task->dst_real,task->dst_imag,task->send,task->inverse,dbcF_heap);
+        return;
+    }
+    /* Starting with the next node, so that the nodes are not all read by all at once. */
+    for(i=1;i<=p;++i)
+    {
+        dbcf_index s=(r+i)%p;
+        DBCF_NAME(dbcF_dist_unpack)(a,b,p,s,task->tasks[s].send+r*block,task->dst_real,task->dst_imag);
+    }
+    task->ret=DBCF_NAME(dbcF_dist_rows)(a,b,p,task->dst_real,task->dst_imag,task->inverse,task->scale,dbcF_heap);
+}
+
+static int DBCF_NAME(dbcF_fft_numa)(
+    dbcf_index n1,dbcf_index n2,
+    const dbcf_numa *numa,
+    const DBCF_Type *const *src_real,const DBCF_Type *const *src_imag,
+          DBCF_Type *const *dst_real,      DBCF_Type *const *dst_imag,
+    int inverse,
+    DBCF_Type scale)
+{
+    DBCF_NAME(dbcF_numa_task) *tasks;
+    dbcf_index p,r;
+    int phase,ret=0;
+    if(!numa||!src_real||!src_imag||!dst_real||!dst_imag) return DBCF_ERROR_INVALID_ARGUMENT;
+    p=numa->num_nodes;
+    if(p<1||!DBCF_NAME(dbcF_dist_valid)(n1,n2,numa->num_nodes)) return DBCF_ERROR_INVALID_ARGUMENT;
+    for(r=0;r<p;++r)
+        if(!src_real[r]||!src_imag[r]||!dst_real[r]||!dst_imag[r]) return DBCF_ERROR_INVALID_ARGUMENT;
+    tasks=(DBCF_NAME(dbcF_numa_task)*)dbcf_malloc(p*(dbcf_index)sizeof(DBCF_NAME(dbcF_numa_task)));
+    if(!tasks) return DBCF_ERROR_OUT_OF_MEMORY;
+    for(r=0;r<p;++r)
+    {
+        DBCF_NAME(dbcF_numa_task) *task=&tasks[r];
+        task->a=(inverse?n2:n1);
+        task->b=(inverse?n1:n2);
+        task->p=p;
+        task->r=r;
+        task->inverse=inverse;
+        task->ret=0;
+        task->scale=scale;
+        task->src_real=src_real[r];
+        task->src_imag=src_imag[r];
+        task->dst_real=dst_real[r];
+        task->dst_imag=dst_imag[r];
+        task->send=0;
+        task->tasks=tasks;
+    }
+    /* Joining all the tasks of phase 1 is the only synchronization the exchange needs. */
+    for(phase=0;phase<2&&!ret;++phase)
+    {
+        for(r=0;r<p;++r)
+        {
+            tasks[r].phase=phase;
+            tasks[r].handle=(numa->spawn&&numa->join?numa->spawn((int)r,DBCF_NAME(dbcF_numa_run),&tasks[r],numa->user):0);
+            if(!tasks[r].handle) DBCF_NAME(dbcF_numa_run)(&tasks[r]);
+        }
+        for(r=0;r<p;++r)
+        {
+            if(tasks[r].handle) numa->join(tasks[r].handle,numa->user);
+            if(tasks[r].ret) ret=tasks[r].ret;
+        }
+    }
+    for(r=0;r<p;++r) dbcf_free(tasks[r].send);
+    dbcf_free(tasks);
+    return ret;
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_execute,c)(
+    dbcf_plan *plan,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_execute)(plan,
+        src_real,src_imag,
+        1,1,
+        dst_real,dst_imag,
+        1,1,
+        scale);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_execute,i)(
+    dbcf_plan *plan,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_execute)(plan,
+        src,(src?src+1:src),
+        (src?2:0),(src?2:0),
+        dst,dst+1,
+        2,2,
+        scale);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_execute,s)(
+    dbcf_plan *plan,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_execute)(plan,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        scale);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_fft_plan_set_window)(
+    dbcf_plan *plan,
+    const DBCF_Type *window)
+{
+    if(!plan||plan->type_tag!=(const void*)&DBCF_NAME(dbcF_type_tag)) return DBCF_ERROR_INVALID_ARGUMENT;
+    plan->window=(const void*)window;
+    return 0;
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_convolve,c)(
+    dbcf_index signal_length,
+    const DBCF_Type *signal_real,const DBCF_Type *signal_imag,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel_real,const DBCF_Type *kernel_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_convolve)(
+        signal_length,
+        signal_real,signal_imag,
+        1,1,
+        kernel_length,
+        kernel_real,kernel_imag,
+        1,1,
+        dst_real,dst_imag,
+        1,1,
+        0,
+        scale);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_convolve,i)(
+    dbcf_index signal_length,
+    const DBCF_Type *signal,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_convolve)(
+        signal_length,
+        signal,(signal?signal+1:signal),
+        (signal?2:0),(signal?2:0),
+        kernel_length,
+        kernel,(kernel?kernel+1:kernel),
+        (kernel?2:0),(kernel?2:0),
+        dst,dst+1,
+        2,2,
+        0,
+        scale);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_correlate,c)(
+    dbcf_index signal_length,
+    const DBCF_Type *signal_real,const DBCF_Type *signal_imag,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel_real,const DBCF_Type *kernel_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_convolve)(
+        signal_length,
+        signal_real,signal_imag,
+        1,1,
+        kernel_length,
+        kernel_real,kernel_imag,
+        1,1,
+        dst_real,dst_imag,
+        1,1,
+        1,
+        scale);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_correlate,i)(
+    dbcf_index signal_length,
+    const DBCF_Type *signal,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_convolve)(
+        signal_length,
+        signal,(signal?signal+1:signal),
+        (signal?2:0),(signal?2:0),
+        kernel_length,
+        kernel,(kernel?kernel+1:kernel),
+        (kernel?2:0),(kernel?2:0),
+        dst,dst+1,
+        2,2,
+        1,
+        scale);
+}
+
+DBCF_DEF dbcf_conv *DBCF_NAME2(dbc_conv_create,c)(
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel_real,const DBCF_Type *kernel_imag,
+    dbcf_index block_length,
+    int flags)
+{
+    return DBCF_NAME(dbcF_conv_create)(
+        kernel_length,
+        kernel_real,kernel_imag,
+        1,1,
+        block_length,
+        flags);
+}
+
+DBCF_DEF dbcf_conv *DBCF_NAME2(dbc_conv_create,i)(
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel,
+    dbcf_index block_length,
+    int flags)
+{
+    return DBCF_NAME(dbcF_conv_create)(
+        kernel_length,
+        kernel,(kernel?kernel+1:kernel),
+        (kernel?2:0),(kernel?2:0),
+        block_length,
+        flags);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_conv_execute,c)(
+    dbcf_conv *conv,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_conv_execute)(conv,
+        src_real,src_imag,
+        1,1,
+        dst_real,dst_imag,
+        1,1,
+        scale);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_conv_execute,i)(
+    dbcf_conv *conv,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_conv_execute)(conv,
+        src,(src?src+1:src),
+        (src?2:0),(src?2:0),
+        dst,dst+1,
+        2,2,
+        scale);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_conv_reset)(
+    dbcf_conv *conv)
+{
+    dbcf_index i;
+    DBCF_Type *h;
+    if(!conv||conv->type_tag!=(const void*)&DBCF_NAME(dbcF_type_tag)) return DBCF_ERROR_INVALID_ARGUMENT;
+    h=(DBCF_Type*)conv->history_real;
+    for(i=0;i<2*(conv->kernel_length-1);++i) h[i]=DBCF_ZERO;
+    return 0;
+}
+
+DBCF_DEF dbcf_stft *DBCF_NAME(dbc_stft_create)(
+    dbcf_index fft_size,
+    dbcf_index hop,
+    const DBCF_Type *window,
+    int flags)
+{
+    return DBCF_NAME(dbcF_stft_create)(fft_size,hop,window,flags);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_stft_execute,c)(
+    dbcf_stft *stft,
+    dbcf_index src_length,
+    const DBCF_Type *src,
+          DBCF_Type *dst_real,DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_stft_execute)(stft,src_length,src,dst_real,dst_imag,1,scale);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_stft_execute,i)(
+    dbcf_stft *stft,
+    dbcf_index src_length,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_stft_execute)(stft,src_length,src,dst,(dst?dst+1:dst),2,scale);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_istft_execute,c)(
+    dbcf_stft *stft,
+    dbcf_index num_frames,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_istft_execute)(stft,num_frames,src_real,src_imag,1,dst,scale);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_istft_execute,i)(
+    dbcf_stft *stft,
+    dbcf_index num_frames,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_istft_execute)(stft,num_frames,src,(src?src+1:src),2,dst,scale);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_stft_reset)(
+    dbcf_stft *stft)
+{
+    dbcf_index i;
+    DBCF_Type *h;
+    if(!stft||stft->type_tag!=(const void*)&DBCF_NAME(dbcF_type_tag)) return DBCF_ERROR_INVALID_ARGUMENT;
+    h=(DBCF_Type*)stft->history;
+    for(i=0;i<stft->fft_size;++i) h[i]=DBCF_ZERO;
+    stft->fill=0;
+    return 0;
+}
+
+DBCF_DEF dbcf_index DBCF_NAME(dbc_fft_workspace_size)(
+    dbcf_index num_elements)
+{
+    dbcf_index ret=DBCF_NAME(dbcF_fft_workspace)(num_elements),size;
+    size=DBCF_NAME(dbcF_rfft_workspace)(num_elements);
+    if(size>ret) ret=size;
+    size=DBCF_NAME(dbcF_many_plan_workspace)(num_elements)+DBCF_NAME(dbcF_many_stage_workspace)(num_elements);
+    if(size>ret) ret=size;
+    return ret;
+}
+
+DBCF_DEF dbcf_index DBCF_NAME(dbc_fft2d_workspace_size)(
+    dbcf_index num_rows,dbcf_index num_columns)
+{
+    dbcf_index dims[2];
+    dims[0]=num_rows;
+    dims[1]=num_columns;
+    return DBCF_NAME(dbcF_fft_nd_workspace)(2,dims);
+}
+
+DBCF_DEF dbcf_index DBCF_NAME(dbc_fftnd_workspace_size)(
+    dbcf_index rank,const dbcf_index *dims)
+{
+    return DBCF_NAME(dbcF_fft_nd_workspace)(rank,dims);
+}
+
+DBCF_DEF dbcf_index DBCF_NAME(dbc_fft_io_workspace_size)(
+    dbcf_index num_elements)
+{
+    return DBCF_NAME(dbcF_fft_io_default_workspace)(num_elements);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft,io)(
+    dbcf_index num_elements,
+    const dbcf_io *src,
+    const dbcf_io *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_io_heap)(num_elements,src,dst,0,scale);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft,io_w)(
+    dbcf_index num_elements,
+    const dbcf_io *src,
+    const dbcf_io *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME(dbcF_fft_io)(num_elements,src,dst,0,scale,work,work_size);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft,io)(
+    dbcf_index num_elements,
+    const dbcf_io *src,
+    const dbcf_io *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_io_heap)(num_elements,src,dst,1,scale);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft,io_w)(
+    dbcf_index num_elements,
+    const dbcf_io *src,
+    const dbcf_io *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME(dbcF_fft_io)(num_elements,src,dst,1,scale,work,work_size);
+}
+
+DBCF_DEF dbcf_index DBCF_NAME(dbc_fft_dist_workspace_size)(
+    dbcf_index n1,dbcf_index n2,
+    int num_ranks)
+{
+    dbcf_index f,i;
+    if(!DBCF_NAME(dbcF_dist_valid)(n1,n2,num_ranks)) return 0;
+    f=DBCF_NAME(dbcF_dist_workspace)(n1,n2,num_ranks,1);
+    i=DBCF_NAME(dbcF_dist_workspace)(n2,n1,num_ranks,1);
+    return (f>i?f:i);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_dist,c)(
+    dbcf_index n1,dbcf_index n2,
+    const dbcf_dist *dist,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_dist)(n1,n2,dist,src_real,src_imag,dst_real,dst_imag,0,scale,dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_dist,c_w)(
+    dbcf_index n1,dbcf_index n2,
+    const dbcf_dist *dist,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME(dbcF_fft_dist_w)(n1,n2,dist,src_real,src_imag,dst_real,dst_imag,0,scale,work,work_size);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_dist,c)(
+    dbcf_index n1,dbcf_index n2,
+    const dbcf_dist *dist,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_dist)(n1,n2,dist,src_real,src_imag,dst_real,dst_imag,1,scale,dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_dist,c_w)(
+    dbcf_index n1,dbcf_index n2,
+    const dbcf_dist *dist,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME(dbcF_fft_dist_w)(n1,n2,dist,src_real,src_imag,dst_real,dst_imag,1,scale,work,work_size);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_numa,c)(
+    dbcf_index n1,dbcf_index n2,
+    const dbcf_numa *numa,
+    const DBCF_Type *const *src_real,const DBCF_Type *const *src_imag,
+          DBCF_Type *const *dst_real,      DBCF_Type *const *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_numa)(n1,n2,numa,src_real,src_imag,dst_real,dst_imag,0,scale);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_numa,c)(
+    dbcf_index n1,dbcf_index n2,
+    const dbcf_numa *numa,
+    const DBCF_Type *const *src_real,const DBCF_Type *const *src_imag,
+          DBCF_Type *const *dst_real,      DBCF_Type *const *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_numa)(n1,n2,numa,src_real,src_imag,dst_real,dst_imag,1,scale);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft,c)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        1,1,
+        dst_real,dst_imag,
+        1,1,
+        0,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft,c_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        1,1,
+        dst_real,dst_imag,
+        1,1,
+        0,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft,c)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        1,1,
+        dst_real,dst_imag,
+        1,1,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft,c_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        1,1,
+        dst_real,dst_imag,
+        1,1,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft,i)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src,(src?src+1:src),
+        (src?2:0),(src?2:0),
+        dst,dst+1,
+        (src?2:0),(src?2:0),
+        0,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft,i_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src,(src?src+1:src),
+        (src?2:0),(src?2:0),
+        dst,dst+1,
+        (src?2:0),(src?2:0),
+        0,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft,i)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src,(src?src+1:src),
+        (src?2:0),(src?2:0),
+        dst,dst+1,
+        (src?2:0),(src?2:0),
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft,i_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src,(src?src+1:src),
+        (src?2:0),(src?2:0),
+        dst,dst+1,
+        (src?2:0),(src?2:0),
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft,s)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        0,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft,s_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        0,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft,s)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft,s_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_many,c)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_many)(num_elements,howmany,
+        src_real,src_imag,
+        1,num_elements,
+        dst_real,dst_imag,
+        1,num_elements,
+        0,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_many,c_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft_many)(num_elements,howmany,
+        src_real,src_imag,
+        1,num_elements,
+        dst_real,dst_imag,
+        1,num_elements,
+        0,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_many,i)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_many)(num_elements,howmany,
+        src,(src?src+1:src),
+        2,2*num_elements,
+        dst,dst+1,
+        2,2*num_elements,
+        0,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_many,i_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft_many)(num_elements,howmany,
+        src,(src?src+1:src),
+        2,2*num_elements,
+        dst,dst+1,
+        2,2*num_elements,
+        0,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_many,s)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_many)(num_elements,howmany,
+        src_real,src_imag,
+        src_stride,src_dist,
+        dst_real,dst_imag,
+        dst_stride,dst_dist,
+        0,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft_many,s_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft_many)(num_elements,howmany,
+        src_real,src_imag,
+        src_stride,src_dist,
+        dst_real,dst_imag,
+        dst_stride,dst_dist,
+        0,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_many,c)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_many)(num_elements,howmany,
+        src_real,src_imag,
+        1,num_elements,
+        dst_real,dst_imag,
+        1,num_elements,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_many,c_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft_many)(num_elements,howmany,
+        src_real,src_imag,
+        1,num_elements,
+        dst_real,dst_imag,
+        1,num_elements,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_many,i)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_many)(num_elements,howmany,
+        src,(src?src+1:src),
+        2,2*num_elements,
+        dst,dst+1,
+        2,2*num_elements,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_many,i_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft_many)(num_elements,howmany,
+        src,(src?src+1:src),
+        2,2*num_elements,
+        dst,dst+1,
+        2,2*num_elements,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_many,s)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_many)(num_elements,howmany,
+        src_real,src_imag,
+        src_stride,src_dist,
+        dst_real,dst_imag,
+        dst_stride,dst_dist,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft_many,s_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft_many)(num_elements,howmany,
+        src_real,src_imag,
+        src_stride,src_dist,
+        dst_real,dst_imag,
+        dst_stride,dst_dist,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft2d,c)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    dbcf_index dims[2];
+    dims[0]=num_rows;
+    dims[1]=num_columns;
+    return DBCF_NAME(dbcF_fft_nd)(2,dims,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        1,
+        0,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft2d,c_w)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    dbcf_index dims[2];
+    dims[0]=num_rows;
+    dims[1]=num_columns;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft2d_workspace_size)(num_rows,num_columns));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft_nd)(2,dims,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        1,
+        0,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft2d,i)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    dbcf_index dims[2];
+    dims[0]=num_rows;
+    dims[1]=num_columns;
+    return DBCF_NAME(dbcF_fft_nd)(2,dims,
+        src,(src?src+1:src),
+        dst,dst+1,
+        2,
+        0,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fft2d,i_w)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    dbcf_index dims[2];
+    dims[0]=num_rows;
+    dims[1]=num_columns;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft2d_workspace_size)(num_rows,num_columns));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft_nd)(2,dims,
+        src,(src?src+1:src),
+        dst,dst+1,
+        2,
+        0,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fftnd,c)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_nd)(rank,dims,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        1,
+        0,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fftnd,c_w)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fftnd_workspace_size)(rank,dims));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft_nd)(rank,dims,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        1,
+        0,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fftnd,i)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_nd)(rank,dims,
+        src,(src?src+1:src),
+        dst,dst+1,
+        2,
+        0,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_fftnd,i_w)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fftnd_workspace_size)(rank,dims));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft_nd)(rank,dims,
+        src,(src?src+1:src),
+        dst,dst+1,
+        2,
+        0,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft2d,c)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    dbcf_index dims[2];
+    dims[0]=num_rows;
+    dims[1]=num_columns;
+    return DBCF_NAME(dbcF_fft_nd)(2,dims,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        1,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft2d,c_w)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    dbcf_index dims[2];
+    dims[0]=num_rows;
+    dims[1]=num_columns;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft2d_workspace_size)(num_rows,num_columns));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft_nd)(2,dims,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        1,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft2d,i)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    dbcf_index dims[2];
+    dims[0]=num_rows;
+    dims[1]=num_columns;
+    return DBCF_NAME(dbcF_fft_nd)(2,dims,
+        src,(src?src+1:src),
+        dst,dst+1,
+        2,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifft2d,i_w)(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    dbcf_index dims[2];
+    dims[0]=num_rows;
+    dims[1]=num_columns;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft2d_workspace_size)(num_rows,num_columns));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft_nd)(2,dims,
+        src,(src?src+1:src),
+        dst,dst+1,
+        2,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifftnd,c)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_nd)(rank,dims,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        1,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifftnd,c_w)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fftnd_workspace_size)(rank,dims));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft_nd)(rank,dims,
+        src_real,src_imag,
+        dst_real,dst_imag,
+        1,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifftnd,i)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft_nd)(rank,dims,
+        src,(src?src+1:src),
+        dst,dst+1,
+        2,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_ifftnd,i_w)(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fftnd_workspace_size)(rank,dims));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft_nd)(rank,dims,
+        src,(src?src+1:src),
+        dst,dst+1,
+        2,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_rfft,c)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_rfft)(num_elements,
+        src,
+        1,
+        dst_real,dst_imag,
+        1,1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_rfft,c_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_rfft)(num_elements,
+        src,
+        1,
+        dst_real,dst_imag,
+        1,1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_rfft,i)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_rfft)(num_elements,
+        src,
+        1,
+        dst,dst+1,
+        2,2,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_rfft,i_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_rfft)(num_elements,
+        src,
+        1,
+        dst,dst+1,
+        2,2,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_rfft,s)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+    dbcf_index src_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_rfft)(num_elements,
+        src,
+        src_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_rfft,s_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+    dbcf_index src_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_rfft)(num_elements,
+        src,
+        src_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_irfft,c)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_irfft)(num_elements,
+        src_real,src_imag,
+        1,1,
+        dst,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_irfft,c_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_irfft)(num_elements,
+        src_real,src_imag,
+        1,1,
+        dst,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_irfft,i)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_irfft)(num_elements,
+        src,(src?src+1:src),
+        2,2,
+        dst,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_irfft,i_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_irfft)(num_elements,
+        src,(src?src+1:src),
+        2,2,
+        dst,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_irfft,s)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_irfft)(num_elements,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst,
+        dst_stride,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_irfft,s_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_irfft)(num_elements,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst,
+        dst_stride,
+        scale,
+        ws);
+}
+
+/*
+    Real-to-real transforms: the DCT and DST of types II-IV, and the MDCT.
+    The transforms are computed in blocks (as in dbcF_fft_many_staged):
+    the pre-processing pass gathers the block into contiguous complex rows,
+    which are transformed as a batch by dbcF_fft_many_run (one transform
+    per SIMD lane for small sizes), and the post-processing pass writes
+    the results to dst. For even n=2*h:
+    - DCT-II (Makhoul's algorithm): v[k]=x[2*k], v[n-1-k]=x[2*k+1] is
+      transformed as a real sequence (the FFT of z[k]=v[2*k]+i*v[2*k+1] of
+      length h, split as in dbcF_rfft), and X[k]=Re(exp(-i*pi*k/(2*n))*V[k]).
+    - DCT-III: the same steps in reverse order.
+    - DCT-IV: the FFT of length h of
+      z[k]=(x[2*k]+i*x[n-1-2*k])*exp(-i*pi*(4*k+1)/(4*n)), after which
+      X[2*k]-i*X[n-1-2*k]=exp(-i*pi*k/n)*Z[k].
+    Odd sizes use FFTs of length n (types II, III), or 2*n (type IV, of
+    x[k]*exp(-i*pi*(2*k+1)/(4*n)) padded with zeros). The DSTs are the DCTs
+    of the same type with the signs of the odd inputs (odd outputs for
+    type III) flipped, and the outputs (inputs) in reverse order. The MDCT
+    is the DCT-IV of the input folded to n elements, and the IMDCT unfolds
+    the DCT-IV to 2*n elements.
+*/
+
+/*
+    Compute exp(-2*pi*i*(a+b*k)/q), for 0<=k<m.
+    As in dbcF_compute_twiddles_npot, at most O(log(m)) operations are
+    involved in calculating any given twiddle.
+*/
+static void DBCF_NAME(dbcF_r2r_twiddles)(dbcf_index m,dbcf_index a,dbcf_index b,dbcf_index q,DBCF_Type *real,DBCF_Type *imag)
+{
+    dbcf_index i,j,k;
+    DBCF_Type X,Y;
+    if(m<1) return;
+    real[0]=DBCF_ZERO;
+    imag[0]=DBCF_ZERO;
+    for(i=1;i<m;i*=2)
+    {
+        DBCF_NAME(dbcF_cexpm1_root)(b*i,q,0,&X,&Y);
+        j=(m-i<i?m-i:i);
+        for(k=0;k<j;++k)
+        {
+            real[i+k]=(X*real[k]-Y*imag[k])+(X+real[k]);
+            imag[i+k]=(Y*real[k]+X*imag[k])+(Y+imag[k]);
+        }
+    }
+    DBCF_NAME(dbcF_cexpm1_root)(a,q,0,&X,&Y);
+    X=DBCF_ONE+X;
+    for(k=0;k<m;++k)
+    {
+        DBCF_Type x=DBCF_ONE+real[k],y=imag[k];
+        real[k]=x*X-y*Y;
+        imag[k]=x*Y+y*X;
+    }
+}
+
+/* Size of the inner FFTs. */
+static dbcf_index DBCF_NAME(dbcF_r2r_size)(dbcf_index n,int type4)
+{
+    if(!(n&1)) return n>>1;
+    return (type4?2*n:n);
+}
+
+/* Workspace bytes dbcF_dct23 or dbcF_dct4 need. */
+static dbcf_index DBCF_NAME(dbcF_r2r_workspace)(dbcf_index n,int type4)
+{
+    dbcf_index m,b,size;
+    if(n<1) return 0;
+    m=DBCF_NAME(dbcF_r2r_size)(n,type4);
+    b=DBCF_NAME(dbcF_stage_block)(m);
+    if(type4) size=4*(m<n?m:n)+n;
+    else      size=4*((n>>1)+1)+2*m;
+    size=DBCF_WORKSPACE_CHUNK((size+2*m*b)*(dbcf_index)sizeof(DBCF_Type));
+    return size+DBCF_NAME(dbcF_many_plan_workspace)(m);
+}
+
+/*
+    DCT-II (inverse==0) or DCT-III (inverse==1), or the DST of the same
+    type (sine==1), of howmany transforms of size n>0.
+*/
+static int DBCF_NAME(dbcF_dct23)(
+    dbcf_index n,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    int inverse,
+    int sine,
+    DBCF_Type scale,
+    dbcF_workspace ws)
+{
+    dbcf_index h=n>>1,e=(n+1)>>1,m=DBCF_NAME(dbcF_r2r_size)(n,0),b,j,k,l;
+    DBCF_Type half=DBCF_ONE/(DBCF_ONE+DBCF_ONE),sign=(sine?-DBCF_ONE:DBCF_ONE);
+    DBCF_Type *tr,*ti,*wr,*wi,*vr,*vi,*zr,*zi;
+    dbcf_plan *plan;
+    int ret;
+    b=DBCF_NAME(dbcF_stage_block)(m);
+    if(b>howmany) b=howmany;
+    plan=DBCF_NAME(dbcF_many_plan)(m,inverse,&ws,&ret);
+    if(ret) return ret;
+    tr=(DBCF_Type*)dbcF_alloc(&ws,(4*(h+1)+2*m+2*m*b)*(dbcf_index)sizeof(DBCF_Type));
+    if(!tr)
+    {
+        if(plan) dbcF_release(&ws,plan);
+        return DBCF_ERROR_OUT_OF_MEMORY;
+    }
+    ti=tr+(h+1);vr=ti+(h+1);vi=vr+(h+1);wr=vi+(h+1);wi=wr+m;zr=wi+m;zi=zr+m*b;
+    DBCF_PROFILE_ENTER(DBCF_PROFILE_TWIDDLES);
+    DBCF_NAME(dbcF_r2r_twiddles)(h+1,0,1,4*n,tr,ti);
+    if(!(n&1)) DBCF_NAME(dbcF_r2r_twiddles)(h,0,1,n,wr,wi);
+    DBCF_PROFILE_LEAVE(DBCF_PROFILE_TWIDDLES);
+    /* The DST-II has its outputs, and the DST-III its inputs, reversed. */
+    if(sine&&!inverse) {dst+=(n-1)*dst_stride;dst_stride=-dst_stride;}
+    if(sine&& inverse) {src+=(n-1)*src_stride;src_stride=-src_stride;}
+    for(j=0;j<howmany;j+=b)
+    {
+        if(b>howmany-j) b=howmany-j;
+        if(!inverse)
+        {
+            for(l=0;l<b;++l)
+            {
+                const DBCF_Type *x=src+(j+l)*src_dist;
+                DBCF_Type *r=zr+l*m,*s=zi+l*m;
+                for(k=0;k<n;++k)
+                {
+                    DBCF_Type y=(k<e?x[2*k*src_stride]:sign*x[(2*(n-k)-1)*src_stride]);
+                    if(n&1)     {r[k]=y;s[k]=DBCF_ZERO;}
+                    else if(k&1) s[k>>1]=y;
+                    else         r[k>>1]=y;
+                }
+            }
+            DBCF_NAME(dbcF_fft_many_run)(m,b,zr,zi,1,m,zr,zi,1,m,0,plan,scale);
+            for(l=0;l<b;++l)
+            {
+                DBCF_Type *y=dst+(j+l)*dst_dist;
+                const DBCF_Type *r=zr+l*m,*s=zi+l*m;
+                if(n&1)
+                {
+                    y[0]=r[0];
+                    for(k=1;k<=h;++k)
+                    {
+                        y[ k   *dst_stride]= r[k]*tr[k]-s[k]*ti[k];
+                        y[(n-k)*dst_stride]=-r[k]*ti[k]-s[k]*tr[k];
+                    }
+                    continue;
+                }
+                y[0]=r[0]+s[0];
+                y[h*dst_stride]=(r[0]-s[0])*tr[h];
+                for(k=1;k<h;++k)
+                {
+                    /* V[k]=(Z[k]+conj(Z[h-k]))/2+w^k*(Z[k]-conj(Z[h-k]))/(2*i). */
+                    DBCF_Type ar=half*(r[k]+r[h-k]),ai=half*(s[k]-s[h-k]);
+                    DBCF_Type br=half*(s[k]+s[h-k]),bi=half*(r[h-k]-r[k]);
+                    DBCF_Type xr=ar+wr[k]*br-wi[k]*bi,xi=ai+wr[k]*bi+wi[k]*br;
+                    y[ k   *dst_stride]= xr*tr[k]-xi*ti[k];
+                    y[(n-k)*dst_stride]=-xr*ti[k]-xi*tr[k];
+                }
+            }
+        }
+        else
+        {
+            for(l=0;l<b;++l)
+            {
+                const DBCF_Type *x=src+(j+l)*src_dist;
+                DBCF_Type *r=zr+l*m,*s=zi+l*m;
+                /* The inverse of the post-processing of the DCT-II. */
+                vr[0]=x[0];
+                vi[0]=DBCF_ZERO;
+                for(k=1;2*k<n;++k)
+                {
+                    DBCF_Type p=x[k*src_stride],q=x[(n-k)*src_stride];
+                    vr[k]= tr[k]*p-ti[k]*q;
+                    vi[k]=-ti[k]*p-tr[k]*q;
+                }
+                if(n&1)
+                {
+                    r[0]=vr[0];
+                    s[0]=vi[0];
+                    for(k=1;k<=h;++k)
+                    {
+                        r[k]=vr[k];
+                        s[k]=vi[k];
+                        r[n-k]= vr[k];
+                        s[n-k]=-vi[k];
+                    }
+                    continue;
+                }
+                vr[h]=(tr[h]+tr[h])*x[h*src_stride];
+                vi[h]=DBCF_ZERO;
+                /* Z[k]=(V[k]+conj(V[h-k]))/2+i*conj(w^k)*(V[k]-conj(V[h-k]))/2. */
+                for(k=0;k<h;++k)
+                {
+                    DBCF_Type ar=half*(vr[k]+vr[h-k]),ai=half*(vi[k]-vi[h-k]);
+                    DBCF_Type dr=half*(vr[k]-vr[h-k]),di=half*(vi[k]+vi[h-k]);
+                    DBCF_Type br=wr[k]*dr+wi[k]*di,bi=wr[k]*di-wi[k]*dr;
+                    r[k]=ar-bi;
+                    s[k]=ai+br;
+                }
+            }
+            DBCF_NAME(dbcF_fft_many_run)(m,b,zr,zi,1,m,zr,zi,1,m,1,plan,((n&1)?half*scale:scale));
+            for(l=0;l<b;++l)
+            {
+                DBCF_Type *y=dst+(j+l)*dst_dist;
+                const DBCF_Type *r=zr+l*m,*s=zi+l*m;
+                for(k=0;k<n;++k)
+                {
+                    DBCF_Type v=((n&1)?r[k]:(k&1)?s[k>>1]:r[k>>1]);
+                    if(k<e) y[2*k*dst_stride]=v;
+                    else    y[(2*(n-k)-1)*dst_stride]=sign*v;
+                }
+            }
+        }
+    }
+    dbcF_release(&ws,tr);
+    if(plan) dbcF_release(&ws,plan);
+    return 0;
+}
+
+/*
+    DCT-IV, or DST-IV (sine==1), of howmany transforms of size n>0;
+    mdct==1 computes the MDCT (src has 2*n elements), mdct==2 the IMDCT
+    (dst has 2*n elements), of even n.
+*/
+static int DBCF_NAME(dbcF_dct4)(
+    dbcf_index n,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    int mdct,
+    int sine,
+    DBCF_Type scale,
+    dbcF_workspace ws)
+{
+    dbcf_index h=n>>1,m=DBCF_NAME(dbcF_r2r_size)(n,1),t=(m<n?m:n),b,j,k,l;
+    DBCF_Type sign=(sine?-DBCF_ONE:DBCF_ONE);
+    DBCF_Type *pr,*pi,*qr,*qi,*u,*zr,*zi;
+    dbcf_plan *plan;
+    int ret;
+    b=DBCF_NAME(dbcF_stage_block)(m);
+    if(b>howmany) b=howmany;
+    plan=DBCF_NAME(dbcF_many_plan)(m,0,&ws,&ret);
+    if(ret) return ret;
+    pr=(DBCF_Type*)dbcF_alloc(&ws,(4*t+n+2*m*b)*(dbcf_index)sizeof(DBCF_Type));
+    if(!pr)
+    {
+        if(plan) dbcF_release(&ws,plan);
+        return DBCF_ERROR_OUT_OF_MEMORY;
+    }
+    pi=pr+t;qr=pi+t;qi=qr+t;u=qi+t;zr=u+n;zi=zr+m*b;
+    DBCF_PROFILE_ENTER(DBCF_PROFILE_TWIDDLES);
+    if(n&1)
+    {
+        DBCF_NAME(dbcF_r2r_twiddles)(n,1,2,8*n,pr,pi);
+        DBCF_NAME(dbcF_r2r_twiddles)(n,0,1,4*n,qr,qi);
+    }
+    else
+    {
+        DBCF_NAME(dbcF_r2r_twiddles)(h,1,4,8*n,pr,pi);
+        DBCF_NAME(dbcF_r2r_twiddles)(h,0,1,2*n,qr,qi);
+    }
+    DBCF_PROFILE_LEAVE(DBCF_PROFILE_TWIDDLES);
+    /* The DST-IV has its outputs reversed. */
+    if(sine) {dst+=(n-1)*dst_stride;dst_stride=-dst_stride;}
+    for(j=0;j<howmany;j+=b)
+    {
+        if(b>howmany-j) b=howmany-j;
+        for(l=0;l<b;++l)
+        {
+            const DBCF_Type *x=src+(j+l)*src_dist;
+            DBCF_Type *r=zr+l*m,*s=zi+l*m;
+            dbcf_index stride=src_stride;
+            if(mdct==1)
+            {
+                /* Fold (a,b,c,d) to (-reverse(c)-d,a-reverse(b)). */
+                for(k=0;k<h;++k)
+                    u[k]=-x[(3*h-1-k)*src_stride]-x[(3*h+k)*src_stride];
+                for(k=h;k<n;++k)
+                    u[k]= x[(k-h)*src_stride]-x[(3*h-1-k)*src_stride];
+                x=u;
+                stride=1;
+            }
+            if(n&1)
+            {
+                for(k=0;k<n;++k)
+                {
+                    DBCF_Type y=((k&1)?sign*x[k*stride]:x[k*stride]);
+                    r[k]=y*pr[k];
+                    s[k]=y*pi[k];
+                }
+                for(k=n;k<m;++k)
+                {
+                    r[k]=DBCF_ZERO;
+                    s[k]=DBCF_ZERO;
+                }
+                continue;
+            }
+            for(k=0;k<h;++k)
+            {
+                DBCF_Type a=x[2*k*stride],c=sign*x[(n-1-2*k)*stride];
+                r[k]=a*pr[k]-c*pi[k];
+                s[k]=a*pi[k]+c*pr[k];
+            }
+        }
+        DBCF_NAME(dbcF_fft_many_run)(m,b,zr,zi,1,m,zr,zi,1,m,0,plan,scale);
+        for(l=0;l<b;++l)
+        {
+            DBCF_Type *y=dst+(j+l)*dst_dist;
+            const DBCF_Type *r=zr+l*m,*s=zi+l*m;
+            dbcf_index stride=dst_stride;
+            if(mdct==2)
+            {
+                y=u;
+                stride=1;
+            }
+            if(n&1)
+            {
+                for(k=0;k<n;++k)
+                    y[k*stride]=r[k]*qr[k]-s[k]*qi[k];
+            }
+            else
+            {
+                for(k=0;k<h;++k)
+                {
+                    y[ 2*k     *stride]=  r[k]*qr[k]-s[k]*qi[k];
+                    y[(n-1-2*k)*stride]=-(r[k]*qi[k]+s[k]*qr[k]);
+                }
+            }
+            if(mdct==2)
+            {
+                /* Unfold to (v2,-reverse(v2),-reverse(v1),-v1). */
+                y=dst+(j+l)*dst_dist;
+                for(k=0;k<h;++k)
+                    y[k*dst_stride]= u[k+h];
+                for(k=h;k<3*h;++k)
+                    y[k*dst_stride]=-u[3*h-1-k];
+                for(k=3*h;k<2*n;++k)
+                    y[k*dst_stride]=-u[k-3*h];
+            }
+        }
+    }
+    dbcF_release(&ws,pr);
+    if(plan) dbcF_release(&ws,plan);
+    return 0;
+}
+
+static int DBCF_NAME(dbcF_r2r)(
+    int kind,
+    dbcf_index n,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    dbcF_workspace ws)
+{
+    int mdct=(kind==DBCF_R2R_MDCT?1:kind==DBCF_R2R_IMDCT?2:0);
+    if(n<1||howmany<1) return 0;
+    if(mdct&&((n&1)||src==dst)) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(src==dst&&(src_stride!=dst_stride||src_dist!=dst_dist)) return DBCF_ERROR_INVALID_ARGUMENT;
+    if(!src)
+    {
+        dbcf_index j,k,size=(mdct==2?2*n:n);
+        for(j=0;j<howmany;++j)
+            for(k=0;k<size;++k)
+                dst[j*dst_dist+k*dst_stride]=DBCF_ZERO;
+        return 0;
+    }
+    switch(kind)
+    {
+        case DBCF_R2R_DCT2: return DBCF_NAME(dbcF_dct23)(n,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,0,0,scale,ws);
+        case DBCF_R2R_DCT3: return DBCF_NAME(dbcF_dct23)(n,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,1,0,scale,ws);
+        case DBCF_R2R_DST2: return DBCF_NAME(dbcF_dct23)(n,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,0,1,scale,ws);
+        case DBCF_R2R_DST3: return DBCF_NAME(dbcF_dct23)(n,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,1,1,scale,ws);
+        case DBCF_R2R_DCT4: return DBCF_NAME(dbcF_dct4)(n,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,0,0,scale,ws);
+        case DBCF_R2R_DST4: return DBCF_NAME(dbcF_dct4)(n,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,0,1,scale,ws);
+        default:            return DBCF_NAME(dbcF_dct4)(n,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,mdct,0,scale,ws);
+    }
+}
+
+DBCF_DEF dbcf_index DBCF_NAME(dbc_dct_workspace_size)(
+    dbcf_index num_elements)
+{
+    dbcf_index ret=DBCF_NAME(dbcF_r2r_workspace)(num_elements,0),size;
+    size=DBCF_NAME(dbcF_r2r_workspace)(num_elements,1);
+    return (size>ret?size:ret);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_dct2)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DCT2,num_elements,1,
+        src,
+        1,num_elements,
+        dst,
+        1,num_elements,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_dct2,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DCT2,num_elements,1,
+        src,
+        1,num_elements,
+        dst,
+        1,num_elements,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_dct2_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DCT2,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_dct2_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DCT2,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_dct3)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DCT3,num_elements,1,
+        src,
+        1,num_elements,
+        dst,
+        1,num_elements,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_dct3,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DCT3,num_elements,1,
+        src,
+        1,num_elements,
+        dst,
+        1,num_elements,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_dct3_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DCT3,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_dct3_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DCT3,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_dct4)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DCT4,num_elements,1,
+        src,
+        1,num_elements,
+        dst,
+        1,num_elements,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_dct4,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DCT4,num_elements,1,
+        src,
+        1,num_elements,
+        dst,
+        1,num_elements,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_dct4_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DCT4,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_dct4_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DCT4,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_dst2)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DST2,num_elements,1,
+        src,
+        1,num_elements,
+        dst,
+        1,num_elements,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_dst2,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DST2,num_elements,1,
+        src,
+        1,num_elements,
+        dst,
+        1,num_elements,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_dst2_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DST2,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_dst2_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DST2,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_dst3)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DST3,num_elements,1,
+        src,
+        1,num_elements,
+        dst,
+        1,num_elements,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_dst3,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DST3,num_elements,1,
+        src,
+        1,num_elements,
+        dst,
+        1,num_elements,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_dst3_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DST3,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_dst3_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DST3,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_dst4)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DST4,num_elements,1,
+        src,
+        1,num_elements,
+        dst,
+        1,num_elements,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_dst4,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DST4,num_elements,1,
+        src,
+        1,num_elements,
+        dst,
+        1,num_elements,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_dst4_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DST4,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_dst4_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_DST4,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_mdct)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_MDCT,num_elements,1,
+        src,
+        1,2*num_elements,
+        dst,
+        1,num_elements,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_mdct,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_MDCT,num_elements,1,
+        src,
+        1,2*num_elements,
+        dst,
+        1,num_elements,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_mdct_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_MDCT,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_mdct_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_MDCT,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_imdct)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_IMDCT,num_elements,1,
+        src,
+        1,num_elements,
+        dst,
+        1,2*num_elements,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_imdct,_w)(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_IMDCT,num_elements,1,
+        src,
+        1,num_elements,
+        dst,
+        1,2*num_elements,
+        scale,
+        ws);
+}
+
+DBCF_DEF int DBCF_NAME(dbc_imdct_many)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_IMDCT,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int DBCF_NAME2(dbc_imdct_many,_w)(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_dct_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_r2r)(DBCF_R2R_IMDCT,num_elements,howmany,
+        src,
+        src_stride,src_dist,
+        dst,
+        dst_stride,dst_dist,
+        scale,
+        ws);
+}
+
+#if defined(__cplusplus) && !defined(DBC_FFT_NO_CPP_OVERLOADS)
+DBCF_DEF int dbc_fft(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        1,1,
+        dst_real,dst_imag,
+        1,1,
+        0,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int dbc_fft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        1,1,
+        dst_real,dst_imag,
+        1,1,
+        0,
+        scale,
+        ws);
+}
+
+DBCF_DEF int dbc_ifft(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        1,1,
+        dst_real,dst_imag,
+        1,1,
+        1,
+        scale,
+        dbcF_heap);
+}
+
+DBCF_DEF int dbc_ifft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        1,1,
+        dst_real,dst_imag,
+        1,1,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int dbc_fft(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src,(src?src+1:src),
+        (src?2:0),(src?2:0),
+        dst,dst+1,
+        (src?2:0),(src?2:0),
+        0,
+        scale,
+        dbcF_heap);
 }
 
-#define DBCF_DEF_SIMD_PASS(name,type,size,simd,load_t,load_d,store_d,add,sub,mul,block)\
-static void name(                                                                             \
-    dbcf_index log2n,                                                                         \
-    dbcf_index log2c,                                                                         \
-    type *real,type *imag,                                                                    \
-    int inverse,                                                                              \
-	dbcf_index log2t,                                                                         \
-    const type *tr,const type *ti)                                                            \
-{                                                                                             \
-    dbcf_index n=DBCF_POW2(log2n),h=n>>1;                                                     \
-    dbcf_index c=DBCF_POW2(log2c);                                                            \
-    dbcf_index i;                                                                             \
-    type *LR=real;                                                                            \
-    type *HR=real+h;                                                                          \
-    type *LI=imag;                                                                            \
-    type *HI=imag+h;                                                                          \
-                                                                                              \
-    if(log2n-1<=log2t)                                                                        \
-    {                                                                                         \
-        /*  We have as much precomputed twiddles            */                                \
-        /*  as the block needs, so we supply them directly. */                                \
-        if(h>size) for(i=0;i<c;++i)                                                           \
-        {                                                                                     \
-            /* Unroll x2. Slightly faster. */                                                 \
-            dbcf_index d;                                                                     \
-            for(d=0;d<h;)                                                                     \
-            {                                                                                 \
-                simd c=load_t(tr+d),s=load_t(ti+d);                                           \
-                simd xl=load_d(LR+d),yl=load_d(LI+d);                                         \
-                simd xr=load_d(HR+d),yr=load_d(HI+d);                                         \
-                simd x=sub(mul(c,xr),mul(s,yr)),y=add(mul(s,xr),mul(c,yr));                   \
-                store_d(add(xl,x),LR+d);store_d(add(yl,y),LI+d);                              \
-                store_d(sub(xl,x),HR+d);store_d(sub(yl,y),HI+d);                              \
-                d+=size;                                                                      \
-                c=load_t(tr+d);s=load_t(ti+d);                                                \
-                xl=load_d(LR+d);yl=load_d(LI+d);                                              \
-                xr=load_d(HR+d);yr=load_d(HI+d);                                              \
-                x=sub(mul(c,xr),mul(s,yr));y=add(mul(s,xr),mul(c,yr));                        \
-                store_d(add(xl,x),LR+d);store_d(add(yl,y),LI+d);                              \
-                store_d(sub(xl,x),HR+d);store_d(sub(yl,y),HI+d);                              \
-                d+=size;                                                                      \
-            }                                                                                 \
-            LR+=n;LI+=n;                                                                      \
-            HR+=n;HI+=n;                                                                      \
-        }                                                                                     \
-        else for(i=0;i<c;++i)                                                                 \
-        {                                                                                     \
-            simd C=load_t(tr),S=load_t(ti);                                                   \
-            simd xl=load_d(LR),yl=load_d(LI);                                                 \
-            simd xr=load_d(HR),yr=load_d(HI);                                                 \
-            simd x=sub(mul(C,xr),mul(S,yr)),y=add(mul(S,xr),mul(C,yr));                       \
-            store_d(add(xl,x),LR);store_d(add(yl,y),LI);                                      \
-            store_d(sub(xl,x),HR);store_d(sub(yl,y),HI);                                      \
-            LR+=n;LI+=n;                                                                      \
-            HR+=n;HI+=n;                                                                      \
-        }                                                                                     \
-    }                                                                                         \
-    else                                                                                      \
-    {                                                                                         \
-        for(i=0;i<c;++i)                                                                      \
-        {                                                                                     \
-            block(log2n,log2n-1,LR,LI,HR,HI,1.0f,0.0f,inverse,tr,ti);                         \
-            LR+=n;LI+=n;                                                                      \
-            HR+=n;HI+=n;                                                                      \
-        }                                                                                     \
-    }                                                                                         \
+DBCF_DEF int dbc_fft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src,(src?src+1:src),
+        (src?2:0),(src?2:0),
+        dst,dst+1,
+        (src?2:0),(src?2:0),
+        0,
+        scale,
+        ws);
 }
 
-/* Not actually SIMDified, but at least uses the right instruction level. */
-#define DBCF_DEF_SIMD_FFT8(name,type,suffix,lsuffix)\
-static void name(type *real,type *imag,int inverse) {dbcF_fft8_##suffix(real,imag,1,1,inverse,0.70710678118654752438##lsuffix);}
+DBCF_DEF int dbc_ifft(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src,(src?src+1:src),
+        (src?2:0),(src?2:0),
+        dst,dst+1,
+        (src?2:0),(src?2:0),
+        1,
+        scale,
+        dbcF_heap);
+}
 
-#define DBCF_DEF_SIMD_COMPUTE_TWIDDLES(name,type,size,simd,lsuffix,load,store,fill,add,sub,mul,cexpm1)\
-static void name(dbcf_index log2n,dbcf_index log2b,type *real,type *imag,int inverse)         \
-{                                                                                             \
-    dbcf_index i;                                                                             \
-    real[0]=0.0##lsuffix;                                                                     \
-    imag[0]=0.0##lsuffix;                                                                     \
-    for(i=0;i<log2b;++i)                                                                      \
-    {                                                                                         \
-        dbcf_index j,k=DBCF_POW2(i);                                                          \
-        type x,y;                                                                             \
-        cexpm1(log2n-i,&x,&y);                                                                \
-        if(!inverse) y=-y;                                                                    \
-        if(k>=size)                                                                           \
-        {                                                                                     \
-            simd X=fill(x);                                                                   \
-            simd Y=fill(y);                                                                   \
-            for(j=0;j<k;j+=size)                                                              \
-            {                                                                                 \
-                simd R=load(real+j);                                                          \
-                simd I=load(imag+j);                                                          \
-                store(add(sub(mul(X,R),mul(Y,I)),add(X,R)),real+k+j);                         \
-                store(add(add(mul(Y,R),mul(X,I)),add(Y,I)),imag+k+j);                         \
-            }                                                                                 \
-        }                                                                                     \
-        else for(j=0;j<k;++j)                                                                 \
-        {                                                                                     \
-            real[k+j]=(x*real[j]-y*imag[j])+(x+real[j]);                                      \
-            imag[k+j]=(y*real[j]+x*imag[j])+(y+imag[j]);                                      \
-        }                                                                                     \
-    }                                                                                         \
-    for(i=0;i<DBCF_POW2(log2b);++i)                                                           \
-        real[i]=1.0##lsuffix+real[i];                                                         \
+DBCF_DEF int dbc_ifft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src,(src?src+1:src),
+        (src?2:0),(src?2:0),
+        dst,dst+1,
+        (src?2:0),(src?2:0),
+        1,
+        scale,
+        ws);
 }
 
-#define DBCF_DEF_SIMD_FUNCTIONS(decl,type,size,suffix,lsuffix)\
-    decl DBCF_DEF_SIMD_BLOCK(dbcF_butterfly_block_##size##suffix##_uu,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix          ,dbcF_load##size##suffix          ,dbcF_store##size##suffix          ,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_cexp_##suffix)\
-    decl DBCF_DEF_SIMD_BLOCK(dbcF_butterfly_block_##size##suffix##_au,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix##_aligned,dbcF_load##size##suffix          ,dbcF_store##size##suffix          ,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_cexp_##suffix)\
-    decl DBCF_DEF_SIMD_BLOCK(dbcF_butterfly_block_##size##suffix##_ua,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix          ,dbcF_load##size##suffix##_aligned,dbcF_store##size##suffix##_aligned,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_cexp_##suffix)\
-    decl DBCF_DEF_SIMD_BLOCK(dbcF_butterfly_block_##size##suffix##_aa,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix##_aligned,dbcF_load##size##suffix##_aligned,dbcF_store##size##suffix##_aligned,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_cexp_##suffix)\
-    decl DBCF_DEF_SIMD_PASS(dbcF_butterfly_pass_##size##suffix##_uu,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix          ,dbcF_load##size##suffix          ,dbcF_store##size##suffix          ,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_butterfly_block_##size##suffix##_uu)\
-    decl DBCF_DEF_SIMD_PASS(dbcF_butterfly_pass_##size##suffix##_au,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix##_aligned,dbcF_load##size##suffix          ,dbcF_store##size##suffix          ,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_butterfly_block_##size##suffix##_au)\
-    decl DBCF_DEF_SIMD_PASS(dbcF_butterfly_pass_##size##suffix##_ua,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix          ,dbcF_load##size##suffix##_aligned,dbcF_store##size##suffix##_aligned,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_butterfly_block_##size##suffix##_ua)\
-    decl DBCF_DEF_SIMD_PASS(dbcF_butterfly_pass_##size##suffix##_aa,type,size,dbcf_simd##size##suffix,dbcF_load##size##suffix##_aligned,dbcF_load##size##suffix##_aligned,dbcF_store##size##suffix##_aligned,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_butterfly_block_##size##suffix##_aa)\
-    decl DBCF_DEF_SIMD_COMPUTE_TWIDDLES(dbcF_compute_twiddles_##size##suffix##_u,type,size,dbcf_simd##size##suffix,lsuffix,dbcF_load##size##suffix          ,dbcF_store##size##suffix          ,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_cexpm1_##suffix)\
-    decl DBCF_DEF_SIMD_COMPUTE_TWIDDLES(dbcF_compute_twiddles_##size##suffix##_a,type,size,dbcf_simd##size##suffix,lsuffix,dbcF_load##size##suffix##_aligned,dbcF_store##size##suffix##_aligned,dbcF_fill##size##suffix,dbcF_add##size##suffix,dbcF_sub##size##suffix,dbcF_mul##size##suffix,dbcF_cexpm1_##suffix)\
-    decl DBCF_DEF_SIMD_FFT8(dbcF_fft8_##size##suffix,type,suffix,lsuffix)
+DBCF_DEF int dbc_fft(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        0,
+        scale,
+        dbcF_heap);
+}
 
-#ifndef DBC_FFT_NO_FLOAT
-static void dbcF_cexpm1_f(dbcf_index log2n,float  *real,float  *imag);
-static void dbcF_cexp_f(dbcf_index log2n,float  *real,float  *imag);
-static void dbcF_fft8_f(float *real,float *imag,dbcf_index real_stride,dbcf_index imag_stride,int inverse,float c);
-#endif
-#ifndef DBC_FFT_NO_DOUBLE
-static void dbcF_cexpm1_d(dbcf_index log2n,double *real,double *imag);
-static void dbcF_cexp_d(dbcf_index log2n,double *real,double *imag);
-static void dbcF_fft8_d(double *real,double *imag,dbcf_index real_stride,dbcf_index imag_stride,int inverse,double c);
-#endif
+DBCF_DEF int dbc_fft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        0,
+        scale,
+        ws);
+}
 
-#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD4F)
-DBCF_DEF_SIMD_FUNCTIONS(DBCF_DECL_SIMD4F ,float , 4,f,f)
-#endif
-#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD2D)
-DBCF_DEF_SIMD_FUNCTIONS(DBCF_DECL_SIMD2D ,double, 2,d,e0)
-#endif
-#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD8F)
-DBCF_DEF_SIMD_FUNCTIONS(DBCF_DECL_SIMD8F ,float , 8,f,f)
-#endif
-#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD4D)
-DBCF_DEF_SIMD_FUNCTIONS(DBCF_DECL_SIMD4D ,double, 4,d,e0)
-#endif
-#if !defined(DBC_FFT_NO_FLOAT) && !defined(DBCF_NO_SIMD16F)
-DBCF_DEF_SIMD_FUNCTIONS(DBCF_DECL_SIMD16F,float ,16,f,f)
-#endif
-#if !defined(DBC_FFT_NO_DOUBLE) && !defined(DBCF_NO_SIMD8D)
-DBCF_DEF_SIMD_FUNCTIONS(DBCF_DECL_SIMD8D ,double, 8,d,e0)
-#endif
+DBCF_DEF int dbc_ifft(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        1,
+        scale,
+        dbcF_heap);
+}
 
-#define DBCF_TRY_SIMD_PASS(type,size,suffix,SUFFIX)\
-    if(simd_flags&DBCF_HAS_SIMD##size##SUFFIX)                                                                        \
-    {                                                                                                                 \
-        int alignt=DBCF_IS_ALIGNED(tr  ,size*sizeof(type))&&DBCF_IS_ALIGNED(ti  ,size*sizeof(type));                  \
-        int alignd=DBCF_IS_ALIGNED(real,size*sizeof(type))&&DBCF_IS_ALIGNED(imag,size*sizeof(type));                  \
-        if(((size<<2)>>log2n)<=1&&((size<<1)>>log2t)<=1)                                                              \
-        {                                                                                                             \
-            if(alignt) dbcF_compute_twiddles_##size##suffix##_a(log2n,log2t,tr,ti,inverse);                           \
-            else       dbcF_compute_twiddles_##size##suffix##_u(log2n,log2t,tr,ti,inverse);                           \
-            switch(2*alignd+alignt)                                                                                   \
-            {                                                                                                         \
-                case 0: dbcF_butterfly_pass_##size##suffix##_uu(log2n,log2c,real,imag,inverse,log2t,tr,ti); break;    \
-                case 1: dbcF_butterfly_pass_##size##suffix##_au(log2n,log2c,real,imag,inverse,log2t,tr,ti); break;    \
-                case 2: dbcF_butterfly_pass_##size##suffix##_ua(log2n,log2c,real,imag,inverse,log2t,tr,ti); break;    \
-                case 3: dbcF_butterfly_pass_##size##suffix##_aa(log2n,log2c,real,imag,inverse,log2t,tr,ti); break;    \
-            }                                                                                                         \
-            return 1;                                                                                                 \
-        }                                                                                                             \
-    }
+DBCF_DEF int dbc_ifft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    dbcF_workspace ws;
+    int ret;
+    ret=dbcF_workspace_init(&ws,work,work_size,DBCF_NAME(dbc_fft_workspace_size)(num_elements));
+    if(ret) return ret;
+    return DBCF_NAME(dbcF_fft)(num_elements,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        1,
+        scale,
+        ws);
+}
+
+DBCF_DEF int dbc_rfft(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_rfft,c)(num_elements,src,dst_real,dst_imag,scale);
+}
+
+DBCF_DEF int dbc_rfft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_rfft,c_w)(num_elements,src,dst_real,dst_imag,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_rfft(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_rfft,i)(num_elements,src,dst,scale);
+}
 
-#ifndef DBC_FFT_NO_FLOAT
-static dbcf_index dbcF_butterfly_pass_optimized_float(
-    dbcf_index log2n,
-    dbcf_index log2c,
-    float *real,float *imag,
-    int inverse,
-	dbcf_index log2t,
-    float *tr,float *ti,
-    int simd_flags)
+DBCF_DEF int dbc_rfft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
 {
-#ifndef DBCF_NO_SIMD16F
-    DBCF_TRY_SIMD_PASS(float,16,f,F);
-#endif
-#ifndef DBCF_NO_SIMD8F
-    DBCF_TRY_SIMD_PASS(float,8,f,F);
-#endif
-#ifndef DBCF_NO_SIMD4F
-    DBCF_TRY_SIMD_PASS(float,4,f,F);
-#endif
-    return 0;
+    return DBCF_NAME2(dbc_rfft,i_w)(num_elements,src,dst,scale,work,work_size);
 }
 
-/* Returns the number of passes actually performed (always contiguous, starting from log2n-depth+1). */
-static dbcf_index dbcF_butterfly_multipass_optimized_float(
-    dbcf_index log2n,
-    dbcf_index log2c,
-    dbcf_index depth,
-    float *real,float *imag,
-    dbcf_index real_stride,dbcf_index imag_stride,
-    int inverse,
-    float *tr,float *ti)
+DBCF_DEF int dbc_rfft(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+    dbcf_index src_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale)
 {
-    dbcf_index ret=0;
-    int simd_flags;
-    if(real_stride!=1||imag_stride!=1) return 0;
-    simd_flags=dbcf_detect_simd();
-    if(!(simd_flags&(DBCF_HAS_SIMD4F|DBCF_HAS_SIMD8F|DBCF_HAS_SIMD16F))) return 0;
-    if(DBCF_TWIDDLES_BUF_LOG2<3) return 0;
-    if(depth==log2n&&depth>=3)
-    {
-        dbcf_index j,m=DBCF_POW2(log2n+log2c-3);
-#ifndef DBCF_NO_SIMD16F
-        if(simd_flags&DBCF_HAS_SIMD16F) {for(j=0;j<m;++j) {dbcF_fft8_16f(real+8*j,imag+8*j,inverse);} goto ok;}
-#endif
-#ifndef DBCF_NO_SIMD8F
-        if(simd_flags&DBCF_HAS_SIMD8F)  {for(j=0;j<m;++j) {dbcF_fft8_8f (real+8*j,imag+8*j,inverse);} goto ok;}
-#endif
-#ifndef DBCF_NO_SIMD4F
-        if(simd_flags&DBCF_HAS_SIMD4F)  {for(j=0;j<m;++j) {dbcF_fft8_4f (real+8*j,imag+8*j,inverse);} goto ok;}
-#endif
-        return 0;
-        ok: depth-=3; ret=3;
-    }
-    if(log2n-depth+1>3)
-    {
-        dbcf_index log2d;
-        for(log2d=log2n-depth+1;log2d<=log2n;++log2d)
-        {
-            dbcf_index log2t=(log2d-1<DBCF_TWIDDLES_BUF_LOG2?log2d-1:DBCF_TWIDDLES_BUF_LOG2);
-            if(dbcF_butterfly_pass_optimized_float(log2d,log2c+log2n-log2d,real,imag,inverse,log2t,tr,ti,simd_flags)) ++ret;
-            else break;
-        }
-        return ret;
-    }
-    return 0;
+    return DBCF_NAME2(dbc_rfft,s)(num_elements,
+        src,
+        src_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        scale);
 }
-#endif /* DBC_FFT_NO_FLOAT */
 
-#ifndef DBC_FFT_NO_DOUBLE
-static dbcf_index dbcF_butterfly_pass_optimized_double(
-    dbcf_index log2n,
-    dbcf_index log2c,
-    double *real,double *imag,
-    int inverse,
-	dbcf_index log2t,
-    double *tr,double *ti,
-    int simd_flags)
+DBCF_DEF int dbc_rfft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+    dbcf_index src_stride,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
 {
-#ifndef DBCF_NO_SIMD8D
-    DBCF_TRY_SIMD_PASS(double,8,d,D);
-#endif
-#ifndef DBCF_NO_SIMD4D
-    DBCF_TRY_SIMD_PASS(double,4,d,D);
-#endif
-#ifndef DBCF_NO_SIMD2D
-    DBCF_TRY_SIMD_PASS(double,2,d,D);
-#endif
-    return 0;
+    return DBCF_NAME2(dbc_rfft,s_w)(num_elements,
+        src,
+        src_stride,
+        dst_real,dst_imag,
+        dst_real_stride,dst_imag_stride,
+        scale,work,work_size);
 }
 
-/* Returns the number of passes actually performed (always contiguous, starting from log2n-depth+1). */
-static dbcf_index dbcF_butterfly_multipass_optimized_double(
-    dbcf_index log2n,
-    dbcf_index log2c,
-    dbcf_index depth,
-    double *real,double *imag,
-    dbcf_index real_stride,dbcf_index imag_stride,
-    int inverse,
-    double *tr,double *ti)
+DBCF_DEF int dbc_irfft(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst,
+    DBCF_Type scale)
 {
-    dbcf_index ret=0;
-    int simd_flags;
-    if(real_stride!=1||imag_stride!=1) return 0;
-    simd_flags=dbcf_detect_simd();
-    if(!(simd_flags&(DBCF_HAS_SIMD2D|DBCF_HAS_SIMD4D))) return 0;
-    if(DBCF_TWIDDLES_BUF_LOG2<2) return 0;
-    if(depth==log2n&&depth>=3)
-    {
-        dbcf_index j,m=DBCF_POW2(log2n+log2c-3);
-#ifndef DBCF_NO_SIMD8D
-        if(simd_flags&DBCF_HAS_SIMD8D) {for(j=0;j<m;++j) {dbcF_fft8_8d(real+8*j,imag+8*j,inverse);} goto ok;}
-#endif
-#ifndef DBCF_NO_SIMD4D
-        if(simd_flags&DBCF_HAS_SIMD4D) {for(j=0;j<m;++j) {dbcF_fft8_4d(real+8*j,imag+8*j,inverse);} goto ok;}
-#endif
-#ifndef DBCF_NO_SIMD2D
-        if(simd_flags&DBCF_HAS_SIMD2D) {for(j=0;j<m;++j) {dbcF_fft8_2d(real+8*j,imag+8*j,inverse);} goto ok;}
-#endif
-        ok: depth-=3; ret=3;
-    }
-    if(log2n-depth+1>3)
-    {
-        dbcf_index log2d;
-        for(log2d=log2n-depth+1;log2d<=log2n;++log2d)
-        {
-            dbcf_index log2t=(log2d-1<DBCF_TWIDDLES_BUF_LOG2?log2d-1:DBCF_TWIDDLES_BUF_LOG2);
-            if(dbcF_butterfly_pass_optimized_double(log2d,log2c+log2n-log2d,real,imag,inverse,log2t,tr,ti,simd_flags)) ++ret;
-            else break;
-        }
-        return ret;
-    }
-    return 0;
+    return DBCF_NAME2(dbc_irfft,c)(num_elements,src_real,src_imag,dst,scale);
 }
-#endif /* DBC_FFT_NO_DOUBLE */
 
-#endif /* DBC_FFT_NO_SIMD */
+DBCF_DEF int dbc_irfft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_irfft,c_w)(num_elements,src_real,src_imag,dst,scale,work,work_size);
+}
 
-static void dbcF_init()
+DBCF_DEF int dbc_irfft(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
 {
-#if !defined(DBC_FFT_NO_SIMD) && !defined(dbcf_detect_simd) && defined(DBC_FFT_CACHE_CPU_DETECTION)
-    (void)dbcf_detect_simd();
-#endif
+    return DBCF_NAME2(dbc_irfft,i)(num_elements,src,dst,scale);
 }
 
-/* Instantiations */
-#define DBC_FFT_INSTANTIATION
+DBCF_DEF int dbc_irfft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_irfft,i_w)(num_elements,src,dst,scale,work,work_size);
+}
 
-#ifndef DBC_FFT_NO_FLOAT
+DBCF_DEF int dbc_irfft(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_irfft,s)(num_elements,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst,
+        dst_stride,
+        scale);
+}
 
-#define DBCF_Type float
-#define DBCF_Id f
-#define DBCF_LITERAL(x) DBCF_CONCAT(x,f)
-#ifndef DBC_FFT_NO_SIMD
-#define DBCF_butterfly_multipass_optimized dbcF_butterfly_multipass_optimized_float
-#endif
-#include __FILE__
-#undef DBCF_Type
-#undef DBCF_Id
-#undef DBCF_LITERAL
-#ifndef DBC_FFT_NO_SIMD
-#undef DBCF_butterfly_multipass_optimized
-#endif
+DBCF_DEF int dbc_irfft_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_real_stride,dbcf_index src_imag_stride,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_irfft,s_w)(num_elements,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
+        dst,
+        dst_stride,
+        scale,work,work_size);
+}
 
-#endif /* DBC_FFT_NO_FLOAT */
+DBCF_DEF int dbc_fft_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_fft_many,c)(num_elements,howmany,src_real,src_imag,dst_real,dst_imag,scale);
+}
 
-#ifndef DBC_FFT_NO_DOUBLE
+DBCF_DEF int dbc_fft_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_fft_many,c_w)(num_elements,howmany,src_real,src_imag,dst_real,dst_imag,scale,work,work_size);
+}
 
-#define DBCF_Type double
-#define DBCF_Id d
-#define DBCF_LITERAL(x) (x)
-#ifndef DBC_FFT_NO_SIMD
-#define DBCF_butterfly_multipass_optimized dbcF_butterfly_multipass_optimized_double
-#endif
-#include __FILE__
-#undef DBCF_Type
-#undef DBCF_Id
-#undef DBCF_LITERAL
-#ifndef DBC_FFT_NO_SIMD
-#undef DBCF_butterfly_multipass_optimized
-#endif
+DBCF_DEF int dbc_fft_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_fft_many,i)(num_elements,howmany,src,dst,scale);
+}
 
-#endif /* DBC_FFT_NO_DOUBLE */
+DBCF_DEF int dbc_fft_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_fft_many,i_w)(num_elements,howmany,src,dst,scale,work,work_size);
+}
 
-#ifndef DBC_FFT_NO_LONGDOUBLE
+DBCF_DEF int dbc_fft_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_fft_many,s)(num_elements,howmany,
+        src_real,src_imag,
+        src_stride,src_dist,
+        dst_real,dst_imag,
+        dst_stride,dst_dist,
+        scale);
+}
 
-#define DBCF_Type long double
-#define DBCF_Id l
-#define DBCF_LITERAL(x) DBCF_CONCAT(x,l)
-#include __FILE__
-#undef DBCF_Type
-#undef DBCF_Id
-#undef DBCF_LITERAL
+DBCF_DEF int dbc_fft_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_fft_many,s_w)(num_elements,howmany,
+        src_real,src_imag,
+        src_stride,src_dist,
+        dst_real,dst_imag,
+        dst_stride,dst_dist,
+        scale,work,work_size);
+}
 
-#endif /* DBC_FFT_NO_LONGDOUBLE */
+DBCF_DEF int dbc_ifft_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_ifft_many,c)(num_elements,howmany,src_real,src_imag,dst_real,dst_imag,scale);
+}
 
-#undef DBC_FFT_INSTANTIATION
+DBCF_DEF int dbc_ifft_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_ifft_many,c_w)(num_elements,howmany,src_real,src_imag,dst_real,dst_imag,scale,work,work_size);
+}
 
-#endif /* defined(DBC_FFT_IMPLEMENTATION) && !defined(DBC_FFT_DECLARATION) && !defined(DBC_FFT_INSTANTIATION) */
+DBCF_DEF int dbc_ifft_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_ifft_many,i)(num_elements,howmany,src,dst,scale);
+}
 
-/*============================================================================*/
-/* Instantiation section. */
+DBCF_DEF int dbc_ifft_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_ifft_many,i_w)(num_elements,howmany,src,dst,scale,work,work_size);
+}
 
-#ifdef DBC_FFT_INSTANTIATION
+DBCF_DEF int dbc_ifft_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_ifft_many,s)(num_elements,howmany,
+        src_real,src_imag,
+        src_stride,src_dist,
+        dst_real,dst_imag,
+        dst_stride,dst_dist,
+        scale);
+}
 
-#ifndef DBCF_ZERO
-#define DBCF_ZERO DBCF_LITERAL(0.0)
-#endif
-#ifndef DBCF_ONE
-#define DBCF_ONE  DBCF_LITERAL(1.0)
-#endif
+DBCF_DEF int dbc_ifft_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_ifft_many,s_w)(num_elements,howmany,
+        src_real,src_imag,
+        src_stride,src_dist,
+        dst_real,dst_imag,
+        dst_stride,dst_dist,
+        scale,work,work_size);
+}
 
-/*
-    Compute exp(2*pi*i/n)-1.
-    We don't actually need to depend on <math.h>.
-*/
-static void DBCF_NAME(dbcF_cexpm1)(dbcf_index log2n,DBCF_Type *real,DBCF_Type *imag)
+DBCF_DEF int dbc_fft2d(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
 {
-#ifdef DBCF_cexpm1
-    DBCF_cexpm1(log2n,real,imag);
-#else
-    /* All coefficients are entered with sub-ULP precision, even for float128. */
-    static DBCF_Type table[][2]={
-        { DBCF_LITERAL(0.0e0)                                       ,DBCF_LITERAL(0.0e0)                                       },
-        {-DBCF_LITERAL(2.0e0)                                       ,DBCF_LITERAL(0.0e0)                                       },
-        {-DBCF_LITERAL(1.0e0)                                       ,DBCF_LITERAL(1.0e0)                                       },
-        {-DBCF_LITERAL(2.928932188134524755991556378951509607151e-1),DBCF_LITERAL(7.071067811865475244008443621048490392848e-1)},
-        {-DBCF_LITERAL(7.612046748871324387181681060321171317758e-2),DBCF_LITERAL(3.826834323650897717284599840303988667613e-1)},
-        {-DBCF_LITERAL(1.921471959676955087381776386576096302606e-2),DBCF_LITERAL(1.950903220161282678482848684770222409276e-1)},
-        {-DBCF_LITERAL(4.815273327803113755163046890520078424525e-3),DBCF_LITERAL(9.801714032956060199419556388864184586113e-2)},
-        {-DBCF_LITERAL(1.204543794827607285228395240899305556796e-3),DBCF_LITERAL(4.906767432741801425495497694268265831474e-2)},
-        {-DBCF_LITERAL(3.011813037957798842343503338278031499389e-4),DBCF_LITERAL(2.454122852291228803173452945928292506546e-2)},
-        {-DBCF_LITERAL(7.529816085545907835350880361677564939353e-5),DBCF_LITERAL(1.227153828571992607940826195100321214037e-2)},
-        {-DBCF_LITERAL(1.882471739885734300956227143228382608274e-5),DBCF_LITERAL(6.135884649154475359640234590372580917057e-3)},
-        {-DBCF_LITERAL(4.706190423828488419874299880100447012366e-6),DBCF_LITERAL(3.067956762965976270145365490919842518944e-3)},
-        {-DBCF_LITERAL(1.176548298090070974289828473980951732077e-6),DBCF_LITERAL(1.533980186284765612303697150264079079954e-3)},
-        {-DBCF_LITERAL(2.941371177808397717822612343228837361006e-7),DBCF_LITERAL(7.669903187427045269385683579485766431409e-4)},
-        {-DBCF_LITERAL(7.353428214885526851929261214305179884431e-8),DBCF_LITERAL(3.834951875713955890724616811813812633950e-4)},
-        {-DBCF_LITERAL(1.838357070619165308459709028549492394875e-8),DBCF_LITERAL(1.917475973107033074399095619890009334688e-4)},
-        {-DBCF_LITERAL(4.595892687109028066860393851041105696810e-9),DBCF_LITERAL(9.587379909597734587051721097647635118706e-5)}
-    };
-    if(log2n<(dbcf_index)(sizeof(table)/(sizeof(table[0]))))
-    {
-        *real=table[log2n][0];
-        *imag=table[log2n][1];
-    }
-    else
-    {
-        /* For small x Taylor series is accurate to couple of ULPs, even for float128. */
-        dbcf_index n=((dbcf_index)1)<<log2n;
-        const DBCF_Type C1=DBCF_LITERAL(1.0e0);
-        const DBCF_Type C2=DBCF_LITERAL(5.0e-1);
-        const DBCF_Type C3=DBCF_LITERAL(1.666666666666666666666666666666666666666e-1);
-        const DBCF_Type C4=DBCF_LITERAL(4.166666666666666666666666666666666666666e-2);
-        const DBCF_Type C5=DBCF_LITERAL(8.333333333333333333333333333333333333333e-3);
-        const DBCF_Type C6=DBCF_LITERAL(1.388888888888888888888888888888888888888e-3);
-        const DBCF_Type C7=DBCF_LITERAL(1.984126984126984126984126984126984126984e-4);
-        const DBCF_Type C8=DBCF_LITERAL(2.480158730158730158730158730158730158730e-5);
-        DBCF_Type x=DBCF_LITERAL(6.283185307179586476925286766559005768)/(DBCF_Type)n;
-        DBCF_Type x2=x*x;
-        *real=-x2*(C2-x2*(C4-x2*(C6-x2*C8)));
-        *imag=x*(C1-x2*(C3-x2*(C5-x2*C7)));
-    }
-#endif
+    return DBCF_NAME2(dbc_fft2d,c)(num_rows,num_columns,src_real,src_imag,dst_real,dst_imag,scale);
 }
 
-static void DBCF_NAME(dbcF_cexp)(dbcf_index log2n,DBCF_Type *real,DBCF_Type *imag)
+DBCF_DEF int dbc_fft2d_w(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
 {
-    DBCF_NAME(dbcF_cexpm1)(log2n,real,imag);
-    *real=DBCF_ONE+*real;
+    return DBCF_NAME2(dbc_fft2d,c_w)(num_rows,num_columns,src_real,src_imag,dst_real,dst_imag,scale,work,work_size);
 }
 
-/*
-    Compute exp(2*pi*i*k/n), for 0<=k<b.
-    At most O(log(n)) arithmetic operations (and, therefore, roundoff errors)
-    are involved in calculating any given twiddle.
-*/
-static void DBCF_NAME(dbcF_compute_twiddles)(dbcf_index log2n,dbcf_index log2b,DBCF_Type *real,DBCF_Type *imag,int inverse)
+DBCF_DEF int dbc_fft2d(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
 {
-    dbcf_index i;
-    real[0]=DBCF_ZERO;
-    imag[0]=DBCF_ZERO;
-    for(i=0;i<log2b;++i)
-    {
-        dbcf_index j,k=DBCF_POW2(i);
-        /*
-            Note: accuracy seems to be slightly better when working
-            with (cos-1,sin), rather than (cos,sin).
-        */
-        DBCF_Type x,y;
-        DBCF_NAME(dbcF_cexpm1)(log2n-i,&x,&y);
-        if(!inverse) y=-y;
-        for(j=0;j<k;++j)
-        {
-            real[k+j]=(x*real[j]-y*imag[j])+(x+real[j]);
-            imag[k+j]=(y*real[j]+x*imag[j])+(y+imag[j]);
-        }
-    }
-    for(i=0;i<DBCF_POW2(log2b);++i)
-        real[i]=DBCF_ONE+real[i];
+    return DBCF_NAME2(dbc_fft2d,i)(num_rows,num_columns,src,dst,scale);
 }
 
-#ifndef DBC_FFT_NO_NPOT
-/*
-    Compute exp(2*pi*i*(p/q))-1.
-    We don't actually need to depend on <math.h>.
-*/
-static void DBCF_NAME(dbcF_cexpm1_npot)(dbcf_index p,dbcf_index q,DBCF_Type *real,DBCF_Type *imag)
+DBCF_DEF int dbc_fft2d_w(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
 {
-#ifdef DBCF_cexpm1_npot
-    DBCF_cexpm1_npot(p,q,real,imag);
-#else
-    dbcf_index i;
-    DBCF_Type C=DBCF_ONE,S=DBCF_ONE;
-    DBCF_Type x=DBCF_LITERAL(6.283185307179586476925286766559005768)*(DBCF_Type)p/(DBCF_Type)q,x2=x*x;
-    DBCF_Type I=DBCF_LITERAL(32.0);
-    for(i=32;i>=0;--i)
-    {
-        DBCF_Type J=(DBCF_LITERAL(2.0)*I+DBCF_LITERAL(3.0)),K=I+I+DBCF_LITERAL(3.0);
-        J=J*J;
-        C=DBCF_LITERAL(1.0)-x2*C/(J+K);
-        S=DBCF_LITERAL(1.0)-x2*S/(J-K);
-        I=I-DBCF_LITERAL(1.0);
-    }
-    C=-C*DBCF_LITERAL(0.5)*x2;
-    S=S*x;
-    *real=C;
-    *imag=S;
-#endif
+    return DBCF_NAME2(dbc_fft2d,i_w)(num_rows,num_columns,src,dst,scale,work,work_size);
 }
 
-static void DBCF_NAME(dbcF_compute_twiddles_npot)(dbcf_index n,DBCF_Type *real,DBCF_Type *imag,int inverse)
+DBCF_DEF int dbc_fftnd(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
 {
-    /* Note: always gets called with even n. */
-    dbcf_index i,j,k,m=n>>1,h=(m+2)>>1;
-    if(n<1) return;
-    real[0]=DBCF_ZERO;
-    imag[0]=DBCF_ZERO;
-    /*
-        Note: accuracy is somewhat better when working with (cos-1,sin),
-        rather than (cos,sin).
-    */
-    for(i=1;i<h;i*=2)
-    {
-        DBCF_Type X,Y;
-        DBCF_NAME(dbcF_cexpm1_npot)(i,n,&X,&Y);
-        if(!inverse) Y=-Y;
-        j=(h<i*2?h-i:i);
-        for(k=0;k<j;++k)
-        {
-            real[i+k]=(X*real[k]-Y*imag[k])+(X+real[k]);
-            imag[i+k]=(Y*real[k]+X*imag[k])+(Y+imag[k]);
-        }
-    }
-    for(i=0;i<h;++i) real[i]=DBCF_ONE+real[i];
-    for(i=h;i<m;++i)
-    {
-        real[i]=-real[m-i];
-        imag[i]= imag[m-i];
-    }
-    for(i=0;i<m;++i)
-    {
-        real[m+i]=-real[i];
-        imag[m+i]=-imag[i];
-    }
+    return DBCF_NAME2(dbc_fftnd,c)(rank,dims,src_real,src_imag,dst_real,dst_imag,scale);
 }
-#endif
 
-/* Bit-reversal permutations. */
-static void DBCF_NAME(dbcF_bitreversal_swap)(dbcf_index log2n,DBCF_Type *src,dbcf_index src_stride,DBCF_Type *dst,dbcf_index dst_stride)
+DBCF_DEF int dbc_fftnd_w(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
 {
-    dbcf_index i,n=DBCF_POW2(log2n),h=n>>1;
-    if(log2n<=8)
-    {
-#ifndef DBC_FFT_NO_BITREVERSE_TABLE
-        const unsigned char *idx=dbcF_bitreverse_table+DBCF_POW2(log2n);
-#endif
-        for(i=0;i<n;++i)
-        {
-#ifndef DBC_FFT_NO_BITREVERSE_TABLE
-            dbcf_index j=(dbcf_index)(idx[i]);
-#else
-            dbcf_index j=dbcF_bitreverse(i,log2n);
-#endif
-            DBCF_Type x=src[i*src_stride];
-            DBCF_Type y=dst[j*dst_stride];
-            src[i*src_stride]=y;
-            dst[j*dst_stride]=x;
-        }
-    }
-    else
-    {
-        DBCF_NAME(dbcF_bitreversal_swap)(log2n-1,src           ,2*src_stride,dst             ,dst_stride);
-        DBCF_NAME(dbcF_bitreversal_swap)(log2n-1,src+src_stride,2*src_stride,dst+h*dst_stride,dst_stride);
-    }
+    return DBCF_NAME2(dbc_fftnd,c_w)(rank,dims,src_real,src_imag,dst_real,dst_imag,scale,work,work_size);
 }
 
-static void DBCF_NAME(dbcF_bitreversal_permutation)(dbcf_index log2n,const DBCF_Type *src,dbcf_index src_stride,DBCF_Type *dst,dbcf_index dst_stride,DBCF_Type *tmp)
+DBCF_DEF int dbc_fftnd(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
 {
-    dbcf_index i,n=DBCF_POW2(log2n),h=n>>1;
-    if(src_stride==0)
-    {
-        DBCF_Type x=src[0];
-        for(i=0;i<n;++i)
-            dst[i*dst_stride]=x;
-    }
-    else if(src==dst)
-    {
-        /* In-place case. */
-        if(log2n<=8)
-        {
-#ifndef DBC_FFT_NO_BITREVERSE_TABLE
-            const unsigned char *idx=dbcF_bitreverse_table+DBCF_POW2(log2n);
-#endif
-            for(i=0;i<n;++i)
-            {
-#ifndef DBC_FFT_NO_BITREVERSE_TABLE
-                dbcf_index j=(dbcf_index)(idx[i]);
-#else
-                dbcf_index j=dbcF_bitreverse(i,log2n);
-#endif
-                if(i<j)
-                {
-                    DBCF_Type x=dst[i*dst_stride];
-                    DBCF_Type y=dst[j*dst_stride];
-                    dst[i*dst_stride]=y;
-                    dst[j*dst_stride]=x;
-                }
-            }
-        }
-        else if(log2n<=2*(DBCF_Q)+2||log2n<=16)
-        {
-            /* Exchange 0X...X1's and 1X...X0's */
-            DBCF_NAME(dbcF_bitreversal_swap)(log2n-2,dst+dst_stride,2*dst_stride,dst+h*dst_stride,2*dst_stride);
-            /* Reverse 0X...X0's */
-            DBCF_NAME(dbcF_bitreversal_permutation)(log2n-2,dst                 ,2*dst_stride,dst                 ,2*dst_stride,tmp);
-            /* Reverse 1X...X1's */
-            DBCF_NAME(dbcF_bitreversal_permutation)(log2n-2,dst+(h+1)*dst_stride,2*dst_stride,dst+(h+1)*dst_stride,2*dst_stride,tmp);
-        }
-        else
-        {
-            /*
-                The algorithm is based on
-                "Towards an Optimal Bit-Reversal Permutation Program"
-                by Larry Carter and Kang Su Gatlin.
-            */
-            dbcf_index a,b,c,log2m=log2n-2*(DBCF_Q);
-            dbcf_index m=DBCF_POW2(log2m);
-            dbcf_index pow2q=DBCF_POW2(DBCF_Q);
-            for(b=0;b<m;++b)
-            {
-                dbcf_index ib=dbcF_bitreverse(b,log2m);
-                if(ib<b) continue;
-                for(a=0;a<pow2q;++a)
-                    for(c=0;c<pow2q;++c)
-                        tmp[(a<<(DBCF_Q))^c]=dst[((a<<(log2n-(DBCF_Q)))^(b<<(DBCF_Q))^c)*dst_stride];
-                for(c=0;c<pow2q;++c)
-                {
-                    dbcf_index ic=dbcF_bitreverse(c,(DBCF_Q));
-                    for(a=0;a<pow2q;++a)
-                    {
+    return DBCF_NAME2(dbc_fftnd,i)(rank,dims,src,dst,scale);
+}
 
-                        dbcf_index ia=dbcF_bitreverse(a,(DBCF_Q));
-                        DBCF_Type t;
-                        i=(ic<<(log2n-(DBCF_Q)))^(ib<<(DBCF_Q))^ia;
-                        t=dst[i*dst_stride];
-                        dst[i*dst_stride]=tmp[(a<<(DBCF_Q))^c];
-                        tmp[(a<<(DBCF_Q))^c]=t;
-                    }
-                }
-                if(b!=ib)
-                    for(a=0;a<pow2q;++a)
-                        for(c=0;c<pow2q;++c)
-                            dst[((a<<(log2n-(DBCF_Q)))^(b<<(DBCF_Q))^c)*dst_stride]=tmp[(a<<(DBCF_Q))^c];
-            }
-        }
-    }
-    else
-    {
-        if(log2n<=8)
-        {
-#ifndef DBC_FFT_NO_BITREVERSE_TABLE
-            const unsigned char *idx=dbcF_bitreverse_table+DBCF_POW2(log2n);
-#endif
-            for(i=0;i<n;++i)
-            {
-#ifndef DBC_FFT_NO_BITREVERSE_TABLE
-                dbcf_index j=(dbcf_index)(idx[i]);
-#else
-                dbcf_index j=dbcF_bitreverse(i,log2n);
-#endif
-                dst[j*dst_stride]=src[i*src_stride];
-            }
-        }
-        else if(log2n<=16)
-        {
-            DBCF_NAME(dbcF_bitreversal_permutation)(log2n-1,src           ,2*src_stride,dst             ,dst_stride,tmp);
-            DBCF_NAME(dbcF_bitreversal_permutation)(log2n-1,src+src_stride,2*src_stride,dst+h*dst_stride,dst_stride,tmp);
-        }
-        else
-        {
-            /*
-                Do one pass, and call the in-place case. This turns out to be faster,
-                especially for smaller Q.
-            */
-            for(i=0;i<h;++i)
-            {
-                dst[ i   *dst_stride]=src[(2*i  )*src_stride];
-                dst[(i+h)*dst_stride]=src[(2*i+1)*src_stride];
-            }
-            DBCF_NAME(dbcF_bitreversal_permutation)(log2n-1,dst             ,dst_stride,dst             ,dst_stride,tmp);
-            DBCF_NAME(dbcF_bitreversal_permutation)(log2n-1,dst+h*dst_stride,dst_stride,dst+h*dst_stride,dst_stride,tmp);
-        }
-    }
+DBCF_DEF int dbc_fftnd_w(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_fftnd,i_w)(rank,dims,src,dst,scale,work,work_size);
 }
 
-/* Hand-coded (I)FFT for size 8. */
-static void DBCF_NAME(dbcF_fft8)(
-    DBCF_Type *real,DBCF_Type *imag,
-    dbcf_index real_stride,dbcf_index imag_stride,
-    int inverse,DBCF_Type c)
+DBCF_DEF int dbc_ifft2d(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
 {
-    DBCF_Type r0,r1,r2,r3,r4,r5,r6,r7;
-    DBCF_Type i0,i1,i2,i3,i4,i5,i6,i7;
-    DBCF_Type R0,R1,R2,R3,R4,R5,R6,R7;
-    DBCF_Type I0,I1,I2,I3,I4,I5,I6,I7;
-    DBCF_Type p5,m5,p7,m7;
-    r0=real[0*real_stride];i0=imag[0*imag_stride];
-    r1=real[1*real_stride];i1=imag[1*imag_stride];
-    r2=real[2*real_stride];i2=imag[2*imag_stride];
-    r3=real[3*real_stride];i3=imag[3*imag_stride];
-    r4=real[4*real_stride];i4=imag[4*imag_stride];
-    r5=real[5*real_stride];i5=imag[5*imag_stride];
-    r6=real[6*real_stride];i6=imag[6*imag_stride];
-    r7=real[7*real_stride];i7=imag[7*imag_stride];
-    R0=r0+r1;R1=r0-r1;I0=i0+i1;I1=i0-i1;
-    R2=r2+r3;R3=r2-r3;I2=i2+i3;I3=i2-i3;
-    R4=r4+r5;R5=r4-r5;I4=i4+i5;I5=i4-i5;
-    R6=r6+r7;R7=r6-r7;I6=i6+i7;I7=i6-i7;
-    if(!inverse)
-    {
-        r0=R0+R2;i0=I0+I2;
-        r1=R1+I3;i1=I1-R3;
-        r2=R0-R2;i2=I0-I2;
-        r3=R1-I3;i3=I1+R3;
-        r4=R4+R6;i4=I4+I6;
-        r5=R5+I7;i5=I5-R7;
-        r6=R4-R6;i6=I4-I6;
-        r7=R5-I7;i7=I5+R7;
-        p5=c*(r5+i5);m5=c*(r5-i5);
-        p7=c*(r7+i7);m7=c*(r7-i7);
-        real[0*real_stride]=r0+r4;imag[0*imag_stride]=i0+i4;
-        real[1*real_stride]=r1+p5;imag[1*imag_stride]=i1-m5;
-        real[2*real_stride]=r2+i6;imag[2*imag_stride]=i2-r6;
-        real[3*real_stride]=r3-m7;imag[3*imag_stride]=i3-p7;
-        real[4*real_stride]=r0-r4;imag[4*imag_stride]=i0-i4;
-        real[5*real_stride]=r1-p5;imag[5*imag_stride]=i1+m5;
-        real[6*real_stride]=r2-i6;imag[6*imag_stride]=i2+r6;
-        real[7*real_stride]=r3+m7;imag[7*imag_stride]=i3+p7;
-    }
-    else
-    {
-        r0=R0+R2;i0=I0+I2;
-        r1=R1-I3;i1=I1+R3;
-        r2=R0-R2;i2=I0-I2;
-        r3=R1+I3;i3=I1-R3;
-        r4=R4+R6;i4=I4+I6;
-        r5=R5-I7;i5=I5+R7;
-        r6=R4-R6;i6=I4-I6;
-        r7=R5+I7;i7=I5-R7;
-        p5=c*(r5+i5);m5=c*(r5-i5);
-        p7=c*(r7+i7);m7=c*(r7-i7);
-        real[0*real_stride]=r0+r4;imag[0*imag_stride]=i0+i4;
-        real[1*real_stride]=r1+m5;imag[1*imag_stride]=i1+p5;
-        real[2*real_stride]=r2-i6;imag[2*imag_stride]=i2+r6;
-        real[3*real_stride]=r3-p7;imag[3*imag_stride]=i3+m7;
-        real[4*real_stride]=r0-r4;imag[4*imag_stride]=i0-i4;
-        real[5*real_stride]=r1-m5;imag[5*imag_stride]=i1-p5;
-        real[6*real_stride]=r2+i6;imag[6*imag_stride]=i2-r6;
-        real[7*real_stride]=r3+p7;imag[7*imag_stride]=i3-m7;
-    }
+    return DBCF_NAME2(dbc_ifft2d,c)(num_rows,num_columns,src_real,src_imag,dst_real,dst_imag,scale);
 }
 
-/*
-    Compute a part of a butterfly of size n, on a block of size b,
-    ensuring that each computed twiddle is touched by
-    at most O(log(n)) arithmetic operations, to improve accuracy.
-    The individual computed twiddles are products of precomputed
-    twiddles (tr, ti) with recursively passed multipliers (C, S).
-*/
-static void DBCF_NAME(dbcF_butterfly_block)(
-    dbcf_index log2n,
-    dbcf_index log2b,
-    DBCF_Type *LR,DBCF_Type *LI,
-    DBCF_Type *HR,DBCF_Type *HI,
-    dbcf_index real_stride,dbcf_index imag_stride,
-    DBCF_Type C,DBCF_Type S,
-    int inverse,
-    const DBCF_Type *tr,const DBCF_Type *ti)
+DBCF_DEF int dbc_ifft2d_w(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
 {
-    dbcf_index b=DBCF_POW2(log2b),h=b>>1;
-    DBCF_Type X,Y;
-    if(log2b<=DBCF_TWIDDLES_BUF_LOG2)
-    {
-        /* The block is small, we have enough precomputed twiddles. */
-        dbcf_index i,j=0,k=0;
-        for(i=0;i<b;++i)
-        {
-            DBCF_Type c=C*tr[i]-S*ti[i];
-            DBCF_Type s=S*tr[i]+C*ti[i];
-            DBCF_Type xl=LR[j],yl=LI[k];
-            DBCF_Type xr=HR[j],yr=HI[k];
-            DBCF_Type x=c*xr-s*yr;
-            DBCF_Type y=s*xr+c*yr;
-            LR[j]=xl+x;
-            LI[k]=yl+y;
-            HR[j]=xl-x;
-            HI[k]=yl-y;
-            j+=real_stride;
-            k+=imag_stride;
-        }
-    }
-    else
-    {
-        /* The block is large, we process it's halves recursively. */
-        DBCF_NAME(dbcF_cexp)(log2n-log2b+1,&X,&Y);
-        if(!inverse) Y=-Y;
-        DBCF_NAME(dbcF_butterfly_block)(log2n,log2b-1,LR              ,LI              ,HR              ,HI              ,real_stride,imag_stride,C      ,S      ,inverse,tr,ti);
-        DBCF_NAME(dbcF_butterfly_block)(log2n,log2b-1,LR+h*real_stride,LI+h*imag_stride,HR+h*real_stride,HI+h*imag_stride,real_stride,imag_stride,C*X-S*Y,S*X+C*Y,inverse,tr,ti);
-    }
+    return DBCF_NAME2(dbc_ifft2d,c_w)(num_rows,num_columns,src_real,src_imag,dst_real,dst_imag,scale,work,work_size);
 }
 
-/* Compute a butterfly pass over c blocks of size n. */
-static void DBCF_NAME(dbcF_butterfly_pass)(
-    dbcf_index log2n,
-    dbcf_index log2c,
-    DBCF_Type *real,DBCF_Type *imag,
-    dbcf_index real_stride,dbcf_index imag_stride,
-    int inverse,
-	dbcf_index log2t,
-    const DBCF_Type *tr,const DBCF_Type *ti)
+DBCF_DEF int dbc_ifft2d(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
 {
-    dbcf_index n=DBCF_POW2(log2n),h=n>>1;
-    dbcf_index c=DBCF_POW2(log2c);
-    dbcf_index i;
-    DBCF_Type *LR=real,*HR=real+h*real_stride;
-    DBCF_Type *LI=imag,*HI=imag+h*imag_stride;
-    if(log2n==0) return;
-    if(log2n-1<=log2t)
-    {
-        /*
-            We have as much precomputed twiddles
-            as the block needs, so we supply them directly.
-        */
-        if(h>1)
-        {
-            for(i=0;i<c;++i)
-            {
-                dbcf_index d,j=0,k=0;
-                for(d=0;d<h;d+=2)
-                {
-                    /* Unroll x2. Slightly faster. */
-                    DBCF_Type C,S,xl,yl,xr,yr,x,y;
-                    C=tr[d];S=ti[d];
-                    xl=LR[j];yl=LI[k];
-                    xr=HR[j];yr=HI[k];
-                    x=C*xr-S*yr;y=S*xr+C*yr;
-                    LR[j]=xl+x;LI[k]=yl+y;
-                    HR[j]=xl-x;HI[k]=yl-y;
-                    j+=real_stride;k+=imag_stride;
-                    C=tr[d+1];S=ti[d+1];
-                    xl=LR[j];yl=LI[k];
-                    xr=HR[j];yr=HI[k];
-                    x=C*xr-S*yr;y=S*xr+C*yr;
-                    LR[j]=xl+x;LI[k]=yl+y;
-                    HR[j]=xl-x;HI[k]=yl-y;
-                    j+=real_stride;k+=imag_stride;
-                }
-                LR+=n*real_stride;LI+=n*imag_stride;
-                HR+=n*real_stride;HI+=n*imag_stride;
-            }
-        }
-        else
-        {
-            for(i=0;i<c;++i)
-            {
-                DBCF_Type xl,yl,xr,yr;
-                xl=LR[0];yl=LI[0];
-                xr=HR[0];yr=HI[0];
-                LR[0]=xl+xr;LI[0]=yl+yr;
-                HR[0]=xl-xr;HI[0]=yl-yr;
-                LR+=n*real_stride;LI+=n*imag_stride;
-                HR+=n*real_stride;HI+=n*imag_stride;
-            }
-        }
-    }
-    else
-    {
-        /* We compute butterfly recursively, supplying only t precomputed twiddles. */
-        for(i=0;i<c;++i)
-        {
-            DBCF_NAME(dbcF_butterfly_block)(log2n,log2n-1,LR,LI,HR,HI,real_stride,imag_stride,DBCF_ONE,DBCF_ZERO,inverse,tr,ti);
-            LR+=n*real_stride;LI+=n*imag_stride;
-            HR+=n*real_stride;HI+=n*imag_stride;
-        }
-    }
+    return DBCF_NAME2(dbc_ifft2d,i)(num_rows,num_columns,src,dst,scale);
 }
 
-/* Compute a series of butterfly passes from (log2n-depth+1,log2c+depth+1) to (log2n,log2c). */
-static void DBCF_NAME(dbcF_butterfly_multipass)(
-    dbcf_index log2n,
-    dbcf_index log2c,
-    dbcf_index depth,
-    DBCF_Type *real,DBCF_Type *imag,
-    dbcf_index real_stride,dbcf_index imag_stride,
-    int inverse,
-    DBCF_Type *tr,DBCF_Type *ti)
+DBCF_DEF int dbc_ifft2d_w(
+    dbcf_index num_rows,dbcf_index num_columns,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
 {
-    while(depth>0)
-    {
-        dbcf_index log2d,log2t;
-#if defined(DBCF_butterfly_multipass_optimized)
-        dbcf_index d=DBCF_butterfly_multipass_optimized(
-            log2n,log2c,depth,
-            real,imag,
-            real_stride,imag_stride,
-            inverse,
-            tr,ti);
-        if(d>0) {depth-=d;continue;}
-#endif
-        if(depth==log2n&&depth>=3)
-        {
-            dbcf_index j,m=DBCF_POW2(log2n+log2c-3);
-            DBCF_NAME(dbcF_cexp)(3,tr,ti);
-            for(j=0;j<m;++j)
-                DBCF_NAME(dbcF_fft8)(real+8*real_stride*j,imag+8*imag_stride*j,real_stride,imag_stride,inverse,tr[0]);
-            depth-=3;
-            continue;
-        }
-        log2d=log2n-depth+1;
-        log2t=(log2d-1<DBCF_TWIDDLES_BUF_LOG2?log2d-1:DBCF_TWIDDLES_BUF_LOG2);
-        DBCF_NAME(dbcF_compute_twiddles)(log2d,log2t,tr,ti,inverse);
-        DBCF_NAME(dbcF_butterfly_pass)(
-            log2d,
-            log2c+log2n-log2d,
-            real,imag,
-            real_stride,imag_stride,
-            inverse,
-            log2t,
-            tr,ti);
-        depth-=1;
-    }
+    return DBCF_NAME2(dbc_ifft2d,i_w)(num_rows,num_columns,src,dst,scale,work,work_size);
 }
 
-static void DBCF_NAME(dbcF_butterfly)(
-    dbcf_index log2n,
-    DBCF_Type *real,DBCF_Type *imag,
-    dbcf_index real_stride,dbcf_index imag_stride,
-    int inverse,
-    DBCF_Type *tmp)
+DBCF_DEF int dbc_ifftnd(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_ifftnd,c)(rank,dims,src_real,src_imag,dst_real,dst_imag,scale);
+}
+
+DBCF_DEF int dbc_ifftnd_w(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_ifftnd,c_w)(rank,dims,src_real,src_imag,dst_real,dst_imag,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_ifftnd(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
 {
-    DBCF_Type *tr=tmp;
-    DBCF_Type *ti=tmp+DBCF_TWIDDLES_BUF_SIZE;
-    if(log2n>12)
-    {
-        DBCF_NAME(dbcF_butterfly)(
-            log2n-1,
-            real,imag,
-            real_stride,imag_stride,
-            inverse,
-            tmp);
-        DBCF_NAME(dbcF_butterfly)(
-            log2n-1,
-            real+DBCF_POW2(log2n-1)*real_stride,imag+DBCF_POW2(log2n-1)*imag_stride,
-            real_stride,imag_stride,
-            inverse,
-            tmp);
-        DBCF_NAME(dbcF_butterfly_multipass)(
-            log2n,0,1,
-            real,imag,
-            real_stride,imag_stride,
-            inverse,
-            tr,ti);
-    }
-    else
-    {
-        DBCF_NAME(dbcF_butterfly_multipass)(
-            log2n,0,log2n,
-            real,imag,
-            real_stride,imag_stride,
-            inverse,
-            tr,ti);
-    }
+    return DBCF_NAME2(dbc_ifftnd,i)(rank,dims,src,dst,scale);
 }
 
-#ifdef DBCF_butterfly_multipass_optimized
-/*
-    Only provide (de)interleave if we have an optimized (SIMD)
-    implementation, which actually cares about it.
-*/
-static void DBCF_NAME(dbcF_deinterleave)(DBCF_Type *dst,dbcf_index log2n,DBCF_Type *tmp)
+DBCF_DEF int dbc_ifftnd_w(
+    dbcf_index rank,const dbcf_index *dims,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
 {
-    dbcf_index n=DBCF_POW2(log2n),h=n>>1;
-    if(n<=2) return;
-    if(n<=DBCF_TMP_BUF_SIZE)
-    {
-        dbcf_index i,h=n>>1;
-        DBCF_Type *real=tmp,*imag=tmp+h;
-        for(i=0;i<h;++i)
-        {
-            real[i]=dst[2*i+0];
-            imag[i]=dst[2*i+1];
-        }
-        for(i=0;i<n;++i) dst[i]=tmp[i];
-        return;
-    }
-    DBCF_NAME(dbcF_bitreversal_permutation)(log2n  ,dst  ,1,dst  ,1,tmp);
-    DBCF_NAME(dbcF_bitreversal_permutation)(log2n-1,dst  ,1,dst  ,1,tmp);
-    DBCF_NAME(dbcF_bitreversal_permutation)(log2n-1,dst+h,1,dst+h,1,tmp);
+    return DBCF_NAME2(dbc_ifftnd,i_w)(rank,dims,src,dst,scale,work,work_size);
 }
 
-static void DBCF_NAME(dbcF_interleave)(DBCF_Type *dst,dbcf_index log2n,DBCF_Type *tmp)
+DBCF_DEF int dbc_fft_execute(
+    dbcf_plan *plan,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
 {
-    dbcf_index n=DBCF_POW2(log2n),h=n>>1;
-    if(n<=2) return;
-    if(n<=DBCF_TMP_BUF_SIZE)
-    {
-        dbcf_index i,h=n>>1;
-        const DBCF_Type *real=dst,*imag=dst+h;
-        for(i=0;i<h;++i)
-        {
-            tmp[2*i+0]=real[i];
-            tmp[2*i+1]=imag[i];
-        }
-        for(i=0;i<n;++i) dst[i]=tmp[i];
-        return;
-    }
-    DBCF_NAME(dbcF_bitreversal_permutation)(log2n-1,dst  ,1,dst  ,1,tmp);
-    DBCF_NAME(dbcF_bitreversal_permutation)(log2n-1,dst+h,1,dst+h,1,tmp);
-    DBCF_NAME(dbcF_bitreversal_permutation)(log2n  ,dst  ,1,dst  ,1,tmp);
+    return DBCF_NAME2(dbc_fft_execute,c)(plan,src_real,src_imag,dst_real,dst_imag,scale);
 }
-#endif /* DBCF_butterfly_multipass_optimized */
 
-/* Power-of-2 case. */
-static int DBCF_NAME(dbcF_fft_pot)(
-    dbcf_index num_elements,
+DBCF_DEF int dbc_fft_execute(
+    dbcf_plan *plan,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_fft_execute,i)(plan,src,dst,scale);
+}
+
+DBCF_DEF int dbc_fft_execute(
+    dbcf_plan *plan,
     const DBCF_Type *src_real,const DBCF_Type *src_imag,
     dbcf_index src_real_stride,dbcf_index src_imag_stride,
           DBCF_Type *dst_real,      DBCF_Type *dst_imag,
     dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
-    int inverse,
     DBCF_Type scale)
 {
-#ifndef DBC_FFT_NO_SIMD
-    DBCF_ALIGNED(32) DBCF_Type dummy[2]={DBCF_ZERO,DBCF_ZERO};
-    DBCF_ALIGNED(32) DBCF_Type tmp[DBCF_TMP_BUF_SIZE];
-#else
-    DBCF_Type dummy[2]={DBCF_ZERO,DBCF_ZERO};
-    DBCF_Type tmp[DBCF_TMP_BUF_SIZE];
-#endif
-    dbcf_index n=num_elements;
-    dbcf_index log2n=(dbcf_index)-1;
-    dbcf_index i;
-#ifdef DBCF_butterfly_multipass_optimized
-    /* Deinterleave dst to make better use of SIMD. */
-    int needs_deinterleave=(dst_real_stride==2&&dst_imag_stride==2&&dst_imag==dst_real+1&&num_elements>16);
-#endif
-    while(n) {n>>=1;++log2n;}
-    if(!src_real) {src_real=dummy  ;src_real_stride=0;}
-    if(!src_imag) {src_imag=dummy+1;src_imag_stride=0;}
-    DBCF_NAME(dbcF_bitreversal_permutation)(log2n,src_real,src_real_stride,dst_real,dst_real_stride,tmp);
-    DBCF_NAME(dbcF_bitreversal_permutation)(log2n,src_imag,src_imag_stride,dst_imag,dst_imag_stride,tmp);
-#ifdef DBCF_butterfly_multipass_optimized
-    if(needs_deinterleave)
-    {
-        DBCF_NAME(dbcF_deinterleave)(dst_real,log2n+1,tmp);
-        DBCF_NAME(dbcF_butterfly)(
-            log2n,
-            dst_real,dst_real+num_elements,
-            1,1,
-            inverse,tmp);
-    }
-    else
-#endif
-    DBCF_NAME(dbcF_butterfly)(
-        log2n,
+    return DBCF_NAME2(dbc_fft_execute,s)(plan,
+        src_real,src_imag,
+        src_real_stride,src_imag_stride,
         dst_real,dst_imag,
         dst_real_stride,dst_imag_stride,
-        inverse,tmp);
-#ifdef DBCF_butterfly_multipass_optimized
-    if(needs_deinterleave) DBCF_NAME(dbcF_interleave)(dst_real,log2n+1,tmp);
-#endif
-    if(scale!=DBCF_ONE) for(i=0;i<num_elements;++i)
-    {
-        dst_real[i]=dst_real[i]*scale;
-        dst_imag[i]=dst_imag[i]*scale;
-    }
-    return 0;
+        scale);
 }
 
-#ifndef DBC_FFT_NO_NPOT
-/* Non-power-of-2 case. */
-static int DBCF_NAME(dbcF_fft_npot)(
-    dbcf_index n,
+DBCF_DEF int dbc_fft_plan_set_window(
+    dbcf_plan *plan,
+    const DBCF_Type *window)
+{
+    return DBCF_NAME(dbc_fft_plan_set_window)(plan,window);
+}
+
+DBCF_DEF int dbc_convolve(
+    dbcf_index signal_length,
+    const DBCF_Type *signal_real,const DBCF_Type *signal_imag,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel_real,const DBCF_Type *kernel_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_convolve,c)(signal_length,signal_real,signal_imag,kernel_length,kernel_real,kernel_imag,dst_real,dst_imag,scale);
+}
+
+DBCF_DEF int dbc_convolve(
+    dbcf_index signal_length,
+    const DBCF_Type *signal,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_convolve,i)(signal_length,signal,kernel_length,kernel,dst,scale);
+}
+
+DBCF_DEF int dbc_correlate(
+    dbcf_index signal_length,
+    const DBCF_Type *signal_real,const DBCF_Type *signal_imag,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel_real,const DBCF_Type *kernel_imag,
+          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_correlate,c)(signal_length,signal_real,signal_imag,kernel_length,kernel_real,kernel_imag,dst_real,dst_imag,scale);
+}
+
+DBCF_DEF int dbc_correlate(
+    dbcf_index signal_length,
+    const DBCF_Type *signal,
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_correlate,i)(signal_length,signal,kernel_length,kernel,dst,scale);
+}
+
+DBCF_DEF dbcf_conv *dbc_conv_create(
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel_real,const DBCF_Type *kernel_imag,
+    dbcf_index block_length,
+    int flags)
+{
+    return DBCF_NAME2(dbc_conv_create,c)(kernel_length,kernel_real,kernel_imag,block_length,flags);
+}
+
+DBCF_DEF dbcf_conv *dbc_conv_create(
+    dbcf_index kernel_length,
+    const DBCF_Type *kernel,
+    dbcf_index block_length,
+    int flags)
+{
+    return DBCF_NAME2(dbc_conv_create,i)(kernel_length,kernel,block_length,flags);
+}
+
+DBCF_DEF int dbc_conv_execute(
+    dbcf_conv *conv,
     const DBCF_Type *src_real,const DBCF_Type *src_imag,
-    dbcf_index src_real_stride,dbcf_index src_imag_stride,
           DBCF_Type *dst_real,      DBCF_Type *dst_imag,
-    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
-    int inverse,
     DBCF_Type scale)
 {
-    unsigned char *buf,*mem=0;
-    DBCF_Type *ar,*ai,*br,*bi,*tr,*ti;
-    /*
-        M has the same value as m, but different type. This avoids
-        dbcf_index->DBCF_Type cast, in case the custom type does
-        not provide it.
-    */
-    DBCF_Type M=DBCF_ONE;
-    dbcf_index i,j,log2m=0,m;
-#ifdef DBCF_butterfly_multipass_optimized
-    dbcf_index alignment=64;
-#else
-    dbcf_index alignment=0;
-#endif
-    while(DBCF_POW2(log2m)<2*n-1) {++log2m;M=M+M;}
-    m=DBCF_POW2(log2m);
-    if(!(mem=(unsigned char*)dbcf_malloc((4*m+4*n)*(dbcf_index)sizeof(DBCF_Type)+alignment))) return DBCF_ERROR_OUT_OF_MEMORY;
-    buf=mem;
-    if(alignment)
-    {
-        dbcf_index offset=((dbcf_index)buf)&(alignment-1);
-        if(offset) buf+=alignment-offset;
-    }
-    ar=(DBCF_Type*)buf+0*m;
-    ai=(DBCF_Type*)buf+1*m;
-    br=(DBCF_Type*)buf+2*m;
-    bi=(DBCF_Type*)buf+3*m;
-    tr=(DBCF_Type*)buf+4*m+0*n;
-    ti=(DBCF_Type*)buf+4*m+2*n;
-    DBCF_NAME(dbcF_compute_twiddles_npot)(2*n,tr,ti,inverse);
-    for(i=0,j=0;i<n;++i)
-    {
-        DBCF_Type c=tr[j],s=ti[j];
-        DBCF_Type x=src_real[i*src_real_stride],y=src_imag[i*src_imag_stride];
-        ar[i]=x*c-y*s;
-        ai[i]=x*s+y*c;
-        br[i]= c;
-        bi[i]=-s;
-        if(i>0)
-        {
-            br[m-i]= c;
-            bi[m-i]=-s;
-        }
-        j+=(2*i+1);
-        if(j>=2*n) j-=2*n;
-    }
-    for(i=n;i<m;++i)
-    {
-        ar[i]=DBCF_ZERO;
-        ai[i]=DBCF_ZERO;
-    }
-    for(i=n;i<=m-n;++i)
-    {
-        br[i]=DBCF_ZERO;
-        bi[i]=DBCF_ZERO;
-    }
-    /*
-        Note: the scale factors for FFTs are (1/M,1,scale), rather than, say,
-        (1,1,scale/M). This helps to keep intermediate results from
-        overflowing/underflowing, when the range is limited (fixed-point,
-        maybe half-floats).
-    */
-    DBCF_NAME(dbcF_fft_pot)(m,ar,ai,1,1,ar,ai,1,1,0,DBCF_ONE/M);
-    DBCF_NAME(dbcF_fft_pot)(m,br,bi,1,1,br,bi,1,1,0,DBCF_ONE);
-    for(i=0;i<m;++i)
-    {
-        DBCF_Type c=br[i],s=bi[i],x=ar[i],y=ai[i];
-        ar[i]=c*x-s*y;
-        ai[i]=c*y+s*x;
-    }
-    DBCF_NAME(dbcF_fft_pot)(m,ar,ai,1,1,ar,ai,1,1,1,scale);
-    for(i=0,j=0;i<n;++i)
-    {
-        DBCF_Type c=tr[j],s=ti[j],x=ar[i],y=ai[i];
-        dst_real[i*dst_real_stride]=c*x-s*y;
-        dst_imag[i*dst_imag_stride]=c*y+s*x;
-        j+=(2*i+1);
-        if(j>=2*n) j-=2*n;
-    }
-    dbcf_free(mem);
-    return 0;
+    return DBCF_NAME2(dbc_conv_execute,c)(conv,src_real,src_imag,dst_real,dst_imag,scale);
+}
+
+DBCF_DEF int dbc_conv_execute(
+    dbcf_conv *conv,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_conv_execute,i)(conv,src,dst,scale);
+}
+
+DBCF_DEF dbcf_stft *dbc_stft_create(
+    dbcf_index fft_size,
+    dbcf_index hop,
+    const DBCF_Type *window,
+    int flags)
+{
+    return DBCF_NAME(dbc_stft_create)(fft_size,hop,window,flags);
+}
+
+DBCF_DEF int dbc_stft_execute(
+    dbcf_stft *stft,
+    dbcf_index src_length,
+    const DBCF_Type *src,
+          DBCF_Type *dst_real,DBCF_Type *dst_imag,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_stft_execute,c)(stft,src_length,src,dst_real,dst_imag,scale);
+}
+
+DBCF_DEF int dbc_stft_execute(
+    dbcf_stft *stft,
+    dbcf_index src_length,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_stft_execute,i)(stft,src_length,src,dst,scale);
+}
+
+DBCF_DEF int dbc_istft_execute(
+    dbcf_stft *stft,
+    dbcf_index num_frames,
+    const DBCF_Type *src_real,const DBCF_Type *src_imag,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_istft_execute,c)(stft,num_frames,src_real,src_imag,dst,scale);
+}
+
+DBCF_DEF int dbc_istft_execute(
+    dbcf_stft *stft,
+    dbcf_index num_frames,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME2(dbc_istft_execute,i)(stft,num_frames,src,dst,scale);
+}
+
+DBCF_DEF int dbc_dct2(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbc_dct2)(num_elements,src,dst,scale);
+}
+
+DBCF_DEF int dbc_dct2_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_dct2,_w)(num_elements,src,dst,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_dct2_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbc_dct2_many)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale);
+}
+
+DBCF_DEF int dbc_dct2_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_dct2_many,_w)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_dct3(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale)
+{
+    return DBCF_NAME(dbc_dct3)(num_elements,src,dst,scale);
 }
-#endif /* DBC_FFT_NO_NPOT */
 
-static int DBCF_NAME(dbcF_fft)(
+DBCF_DEF int dbc_dct3_w(
     dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-    dbcf_index src_real_stride,dbcf_index src_imag_stride,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
-    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
-    int inverse,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_dct3,_w)(num_elements,src,dst,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_dct3_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
     DBCF_Type scale)
 {
-    dbcF_init();
-    if(num_elements<1) return 0;
-    if(src_real==dst_real&&src_real_stride!=dst_real_stride) return DBCF_ERROR_INVALID_ARGUMENT;
-    if(src_imag==dst_imag&&src_imag_stride!=dst_imag_stride) return DBCF_ERROR_INVALID_ARGUMENT;
-    if(src_imag==dst_real) return DBCF_ERROR_INVALID_ARGUMENT;
-    if(src_real==dst_imag) return DBCF_ERROR_INVALID_ARGUMENT;
-    if(num_elements&(num_elements-1))
-#ifndef DBC_FFT_NO_NPOT
-        return DBCF_NAME(dbcF_fft_npot)(
-            num_elements,
-            src_real,src_imag,
-            src_real_stride,src_imag_stride,
-            dst_real,dst_imag,
-            dst_real_stride,dst_imag_stride,
-            inverse,
-            scale);
-#else
-        return DBCF_ERROR_INVALID_ARGUMENT;
-#endif /* DBC_FFT_NO_NPOT*/
-    return DBCF_NAME(dbcF_fft_pot)(
-        num_elements,
-        src_real,src_imag,
-        src_real_stride,src_imag_stride,
-        dst_real,dst_imag,
-        dst_real_stride,dst_imag_stride,
-        inverse,
-        scale);
+    return DBCF_NAME(dbc_dct3_many)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale);
 }
 
-DBCF_DEF int DBCF_NAME2(dbc_fft,c)(
+DBCF_DEF int dbc_dct3_many_w(
     dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_dct3_many,_w)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_dct4(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
     DBCF_Type scale)
 {
-    return DBCF_NAME(dbcF_fft)(num_elements,
-        src_real,src_imag,
-        1,1,
-        dst_real,dst_imag,
-        1,1,
-        0,
-        scale);
+    return DBCF_NAME(dbc_dct4)(num_elements,src,dst,scale);
 }
 
-DBCF_DEF int DBCF_NAME2(dbc_ifft,c)(
+DBCF_DEF int dbc_dct4_w(
     dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_dct4,_w)(num_elements,src,dst,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_dct4_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
     DBCF_Type scale)
 {
-    return DBCF_NAME(dbcF_fft)(num_elements,
-        src_real,src_imag,
-        1,1,
-        dst_real,dst_imag,
-        1,1,
-        1,
-        scale);
+    return DBCF_NAME(dbc_dct4_many)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale);
 }
 
-DBCF_DEF int DBCF_NAME2(dbc_fft,i)(
+DBCF_DEF int dbc_dct4_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_dct4_many,_w)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_dst2(
     dbcf_index num_elements,
     const DBCF_Type *src,
           DBCF_Type *dst,
     DBCF_Type scale)
 {
-    return DBCF_NAME(dbcF_fft)(num_elements,
-        src,(src?src+1:src),
-        (src?2:0),(src?2:0),
-        dst,dst+1,
-        (src?2:0),(src?2:0),
-        0,
-        scale);
+    return DBCF_NAME(dbc_dst2)(num_elements,src,dst,scale);
 }
 
-DBCF_DEF int DBCF_NAME2(dbc_ifft,i)(
+DBCF_DEF int dbc_dst2_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_dst2,_w)(num_elements,src,dst,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_dst2_many(
     dbcf_index num_elements,
+    dbcf_index howmany,
     const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
           DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
     DBCF_Type scale)
 {
-    return DBCF_NAME(dbcF_fft)(num_elements,
-        src,(src?src+1:src),
-        (src?2:0),(src?2:0),
-        dst,dst+1,
-        (src?2:0),(src?2:0),
-        1,
-        scale);
+    return DBCF_NAME(dbc_dst2_many)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale);
 }
 
-DBCF_DEF int DBCF_NAME2(dbc_fft,s)(
+DBCF_DEF int dbc_dst2_many_w(
     dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-    dbcf_index src_real_stride,dbcf_index src_imag_stride,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
-    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_dst2_many,_w)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_dst3(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
     DBCF_Type scale)
 {
-    return DBCF_NAME(dbcF_fft)(num_elements,
-        src_real,src_imag,
-        src_real_stride,src_imag_stride,
-        dst_real,dst_imag,
-        dst_real_stride,dst_imag_stride,
-        0,
-        scale);
+    return DBCF_NAME(dbc_dst3)(num_elements,src,dst,scale);
 }
 
-DBCF_DEF int DBCF_NAME2(dbc_ifft,s)(
+DBCF_DEF int dbc_dst3_w(
     dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-    dbcf_index src_real_stride,dbcf_index src_imag_stride,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
-    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_dst3,_w)(num_elements,src,dst,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_dst3_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
     DBCF_Type scale)
 {
-    return DBCF_NAME(dbcF_fft)(num_elements,
-        src_real,src_imag,
-        src_real_stride,src_imag_stride,
-        dst_real,dst_imag,
-        dst_real_stride,dst_imag_stride,
-        1,
-        scale);
+    return DBCF_NAME(dbc_dst3_many)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale);
 }
 
-#if defined(__cplusplus) && !defined(DBC_FFT_NO_CPP_OVERLOADS)
-DBCF_DEF int dbc_fft(
+DBCF_DEF int dbc_dst3_many_w(
     dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_dst3_many,_w)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_dst4(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
     DBCF_Type scale)
 {
-    return DBCF_NAME(dbcF_fft)(num_elements,
-        src_real,src_imag,
-        1,1,
-        dst_real,dst_imag,
-        1,1,
-        0,
-        scale);
+    return DBCF_NAME(dbc_dst4)(num_elements,src,dst,scale);
 }
 
-DBCF_DEF int dbc_ifft(
+DBCF_DEF int dbc_dst4_w(
     dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_dst4,_w)(num_elements,src,dst,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_dst4_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
     DBCF_Type scale)
 {
-    return DBCF_NAME(dbcF_fft)(num_elements,
-        src_real,src_imag,
-        1,1,
-        dst_real,dst_imag,
-        1,1,
-        1,
-        scale);
+    return DBCF_NAME(dbc_dst4_many)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale);
 }
 
-DBCF_DEF int dbc_fft(
+DBCF_DEF int dbc_dst4_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_dst4_many,_w)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_mdct(
     dbcf_index num_elements,
     const DBCF_Type *src,
           DBCF_Type *dst,
     DBCF_Type scale)
 {
-    return DBCF_NAME(dbcF_fft)(num_elements,
-        src,(src?src+1:src),
-        (src?2:0),(src?2:0),
-        dst,dst+1,
-        (src?2:0),(src?2:0),
-        0,
-        scale);
+    return DBCF_NAME(dbc_mdct)(num_elements,src,dst,scale);
 }
 
-DBCF_DEF int dbc_ifft(
+DBCF_DEF int dbc_mdct_w(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_mdct,_w)(num_elements,src,dst,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_mdct_many(
     dbcf_index num_elements,
+    dbcf_index howmany,
     const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
           DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
     DBCF_Type scale)
 {
-    return DBCF_NAME(dbcF_fft)(num_elements,
-        src,(src?src+1:src),
-        (src?2:0),(src?2:0),
-        dst,dst+1,
-        (src?2:0),(src?2:0),
-        1,
-        scale);
+    return DBCF_NAME(dbc_mdct_many)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale);
 }
 
-DBCF_DEF int dbc_fft(
+DBCF_DEF int dbc_mdct_many_w(
     dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-    dbcf_index src_real_stride,dbcf_index src_imag_stride,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
-    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_mdct_many,_w)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_imdct(
+    dbcf_index num_elements,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
     DBCF_Type scale)
 {
-    return DBCF_NAME(dbcF_fft)(num_elements,
-        src_real,src_imag,
-        src_real_stride,src_imag_stride,
-        dst_real,dst_imag,
-        dst_real_stride,dst_imag_stride,
-        0,
-        scale);
+    return DBCF_NAME(dbc_imdct)(num_elements,src,dst,scale);
 }
 
-DBCF_DEF int dbc_ifft(
+DBCF_DEF int dbc_imdct_w(
     dbcf_index num_elements,
-    const DBCF_Type *src_real,const DBCF_Type *src_imag,
-    dbcf_index src_real_stride,dbcf_index src_imag_stride,
-          DBCF_Type *dst_real,      DBCF_Type *dst_imag,
-    dbcf_index dst_real_stride,dbcf_index dst_imag_stride,
+    const DBCF_Type *src,
+          DBCF_Type *dst,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_imdct,_w)(num_elements,src,dst,scale,work,work_size);
+}
+
+DBCF_DEF int dbc_imdct_many(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
     DBCF_Type scale)
 {
-    return DBCF_NAME(dbcF_fft)(num_elements,
-        src_real,src_imag,
-        src_real_stride,src_imag_stride,
-        dst_real,dst_imag,
-        dst_real_stride,dst_imag_stride,
-        1,
-        scale);
+    return DBCF_NAME(dbc_imdct_many)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale);
+}
+
+DBCF_DEF int dbc_imdct_many_w(
+    dbcf_index num_elements,
+    dbcf_index howmany,
+    const DBCF_Type *src,
+    dbcf_index src_stride,dbcf_index src_dist,
+          DBCF_Type *dst,
+    dbcf_index dst_stride,dbcf_index dst_dist,
+    DBCF_Type scale,
+    void *work,dbcf_index work_size)
+{
+    return DBCF_NAME2(dbc_imdct_many,_w)(num_elements,howmany,src,src_stride,src_dist,dst,dst_stride,dst_dist,scale,work,work_size);
 }
 #endif /* defined(__cplusplus) && !defined(DBC_FFT_NO_CPP_OVERLOADS) */
 